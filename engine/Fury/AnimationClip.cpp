@@ -1,4 +1,5 @@
 #include "Fury/AnimationClip.h"
+#include "Fury/BufferManager.h"
 #include "Fury/Log.h"
 
 namespace fury
@@ -17,6 +18,9 @@ namespace fury
 	AnimationClip::~AnimationClip()
 	{
 		FURYD << "AnimationClip " << m_Name << " destoried!";
+
+		if (auto manager = BufferManager::Instance())
+			manager->DecreaseMemory(m_MemoryBytes, MemoryCategory::ANIMATION);
 	}
 
 	void AnimationClip::CalculateDuration()
@@ -44,6 +48,9 @@ namespace fury
 			if (sclCount > 0)
 				Try(channel->scalings[sclCount - 1].tick);
 		}
+
+		// loaders call this once the clip is complete.
+		UpdateMemory();
 	}
 
 	float AnimationClip::GetDuration() const
@@ -139,4 +146,24 @@ namespace fury
 		else
 			return nullptr;
 	}
+
+	void AnimationClip::UpdateMemory()
+	{
+		uint64_t bytes = 0;
+		for (const auto &channel : m_Channels)
+		{
+			bytes += sizeof(AnimationChannel) + channel->name.capacity();
+			bytes += (channel->rotations.capacity() + channel->positions.capacity() + channel->scalings.capacity()) * sizeof(KeyFrame);
+		}
+
+		if (auto manager = BufferManager::Instance())
+		{
+			if (bytes > m_MemoryBytes)
+				manager->IncreaseMemory(bytes - m_MemoryBytes, MemoryCategory::ANIMATION);
+			else
+				manager->DecreaseMemory(m_MemoryBytes - bytes, MemoryCategory::ANIMATION);
+
+			m_MemoryBytes = bytes;
+		}
+	}
 }
\ No newline at end of file
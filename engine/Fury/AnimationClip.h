@@ -1,6 +1,7 @@
 #ifndef _FURY_ANIMATION_CLIP_H_
 #define _FURY_ANIMATION_CLIP_H_
 
+#include <cstdint>
 #include <vector>
 
 #include "Fury/Entity.h"
@@ -59,6 +60,9 @@ namespace fury
 
 		bool m_Loop = true;
 
+		// keyframe memory reported to BufferManager.
+		uint64_t m_MemoryBytes = 0;
+
 	public:
 
 		AnimationClip(const std::string &name, int ticksPerSecond = 24);
@@ -94,6 +98,10 @@ namespace fury
 		ChannelPtr GetChannel(const std::string &name) const;
 
 		ChannelPtr GetChannelAt(unsigned int index) const;
+
+	private:
+
+		void UpdateMemory();
 	};
 
 }
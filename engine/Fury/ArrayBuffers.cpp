@@ -1,7 +1,10 @@
 #include "Fury/ArrayBuffers.h"
+#include "Fury/BufferManager.h"
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
 
+#include "lz4.h"
+
 namespace fury
 {
 	template<class DataType>
@@ -17,6 +20,13 @@ namespace fury
 	ArrayBuffer<DataType>::~ArrayBuffer()
 	{
 		DeleteBuffer();
+		ReportMemory(0, 0);
+
+		if (!IsResident())
+		{
+			if (auto manager = BufferManager::Instance())
+				manager->DecreaseMemory(m_EvictedSize * sizeof(DataType), MemoryCategory::MESH_CPU_SAVED);
+		}
 	}
 
 	template<class DataType>
@@ -28,9 +38,14 @@ namespace fury
 	template<class DataType>
 	void ArrayBuffer<DataType>::UpdateBuffer()
 	{
-		int sizeNew = Data.size();
+		int sizeNew = GetSize();
 		bool sizeChanged = false;
 		bool isNewBuffer = false;
+		uint64_t gpuBytes = m_GPUBytes;
+
+		// the gpu copy was lost, e.g. by DeleteBuffer.
+		if (m_Dirty && !IsResident())
+			RestoreData();
 
 		if (sizeNew != m_SizeOld)
 		{
@@ -51,12 +66,19 @@ namespace fury
 			glBindBuffer(m_BufferTarget, m_ID);
 
 			if (sizeChanged || isNewBuffer)
+			{
 				glBufferData(m_BufferTarget, sizeNew * sizeof(DataType), Data.data(), m_BufferUsage);
+				gpuBytes = sizeNew * sizeof(DataType);
+			}
 			else
+			{
 				glBufferSubData(m_BufferTarget, 0, sizeNew * sizeof(DataType), Data.data());
+			}
 
 			glBindBuffer(m_BufferTarget, 0);
 		}
+
+		ReportMemory(Data.capacity() * sizeof(DataType) + m_Compressed.capacity(), gpuBytes);
 	}
 
 	template<class DataType>
@@ -67,6 +89,8 @@ namespace fury
 		if (m_ID != 0)
 			glDeleteBuffers(1, &m_ID);
 		m_ID = 0;
+
+		ReportMemory(m_CPUBytes, 0);
 	}
 
 	template<class DataType>
@@ -85,6 +109,91 @@ namespace fury
 		}
 	}
 
+	template<class DataType>
+	unsigned int ArrayBuffer<DataType>::GetSize() const
+	{
+		return IsResident() ? Data.size() : m_EvictedSize;
+	}
+
+	template<class DataType>
+	bool ArrayBuffer<DataType>::IsResident() const
+	{
+		return m_Compressed.empty();
+	}
+
+	template<class DataType>
+	bool ArrayBuffer<DataType>::EvictData()
+	{
+		if (!IsResident() || Data.empty() || m_ID == 0 || m_Dirty)
+			return false;
+
+		int srcSize = Data.size() * sizeof(DataType);
+		m_Compressed.resize(LZ4_compressBound(srcSize));
+
+		int size = LZ4_compress_default((const char*)Data.data(), &m_Compressed[0], srcSize, m_Compressed.size());
+		if (size <= 0)
+		{
+			FURYW << Name << " failed to compress, keeping it resident.";
+			std::vector<char>().swap(m_Compressed);
+			return false;
+		}
+
+		m_Compressed.resize(size);
+		m_Compressed.shrink_to_fit();
+		m_EvictedSize = Data.size();
+
+		std::vector<DataType>().swap(Data);
+
+		if (auto manager = BufferManager::Instance())
+			manager->IncreaseMemory(srcSize, MemoryCategory::MESH_CPU_SAVED);
+
+		ReportMemory(m_Compressed.capacity(), m_GPUBytes);
+		return true;
+	}
+
+	template<class DataType>
+	void ArrayBuffer<DataType>::RestoreData()
+	{
+		if (IsResident())
+			return;
+
+		int dstSize = m_EvictedSize * sizeof(DataType);
+		Data.resize(m_EvictedSize);
+
+		int size = LZ4_decompress_safe(m_Compressed.data(), (char*)Data.data(), m_Compressed.size(), dstSize);
+		if (size != dstSize)
+			FURYE << Name << " failed to decompress!";
+
+		std::vector<char>().swap(m_Compressed);
+		m_EvictedSize = 0;
+
+		if (auto manager = BufferManager::Instance())
+			manager->DecreaseMemory(dstSize, MemoryCategory::MESH_CPU_SAVED);
+
+		ReportMemory(Data.capacity() * sizeof(DataType), m_GPUBytes);
+	}
+
+	template<class DataType>
+	void ArrayBuffer<DataType>::ReportMemory(uint64_t cpuBytes, uint64_t gpuBytes)
+	{
+		auto manager = BufferManager::Instance();
+		if (manager == nullptr)
+			return;
+
+		if (cpuBytes > m_CPUBytes)
+			manager->IncreaseMemory(cpuBytes - m_CPUBytes, MemoryCategory::MESH_CPU);
+		else if (cpuBytes < m_CPUBytes)
+			manager->DecreaseMemory(m_CPUBytes - cpuBytes, MemoryCategory::MESH_CPU);
+
+		if (gpuBytes > m_GPUBytes)
+			manager->IncreaseMemory(gpuBytes - m_GPUBytes, MemoryCategory::MESH_GPU);
+		else if (gpuBytes < m_GPUBytes)
+			manager->DecreaseMemory(m_GPUBytes - gpuBytes, MemoryCategory::MESH_GPU);
+
+		m_CPUBytes = cpuBytes;
+		m_GPUBytes = gpuBytes;
+	}
+
 	template class ArrayBuffer<float>;
 
 	template class ArrayBuffer<int>;
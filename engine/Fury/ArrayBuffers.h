@@ -1,6 +1,7 @@
 #ifndef _FURY_ARRAYBUFFERS_H_
 #define _FURY_ARRAYBUFFERS_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,17 @@ namespace fury
 
 		unsigned int m_BufferUsage;
 
+		// last sizes reported to BufferManager.
+
+		uint64_t m_CPUBytes = 0;
+
+		uint64_t m_GPUBytes = 0;
+
+		// lz4 copy of Data while it's evicted.
+		std::vector<char> m_Compressed;
+
+		unsigned int m_EvictedSize = 0;
+
 	public:
 
 		std::string Name;
@@ -44,6 +56,22 @@ namespace fury
 		unsigned int GetID() const;
 
 		void SetBufferUsage(unsigned int usage);
+
+		// element count, also valid while Data is evicted.
+		unsigned int GetSize() const;
+
+		bool IsResident() const;
+
+		// compresses Data and frees it, only once it's uploaded and not dirty.
+		// Data must be restored before it's read or written again.
+		bool EvictData();
+
+		// brings Data back from the compressed copy, does nothing if it's resident.
+		void RestoreData();
+
+	protected:
+
+		void ReportMemory(uint64_t cpuBytes, uint64_t gpuBytes);
 	};
 
 	typedef ArrayBuffer<float> ArrayBufferf;
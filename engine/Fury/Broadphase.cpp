@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <iterator>
+
+#include "Fury/Broadphase.h"
+#include "Fury/SceneNode.h"
+
+#ifdef FURY_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace fury
+{
+	Broadphase::Ptr Broadphase::Create()
+	{
+		return std::make_shared<Broadphase>();
+	}
+
+	Broadphase::~Broadphase()
+	{
+		for (auto &proxy : m_Proxies)
+		{
+			if (!proxy.alive)
+				continue;
+
+			if (auto node = proxy.node.lock())
+				node->OnTransformChange->Disconnect(proxy.signalKey);
+		}
+	}
+
+	unsigned int Broadphase::AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		int stale = -1;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			auto it = m_ProxyMap.find(sceneNode.get());
+			if (it != m_ProxyMap.end())
+			{
+				if (m_Proxies[it->second].node.lock() == sceneNode)
+					return it->second;
+
+				// a destroyed node lived at this address.
+				stale = it->second;
+			}
+		}
+
+		if (stale >= 0)
+			ReleaseProxy(stale);
+
+		unsigned int id;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			if (m_FreeProxies.empty())
+			{
+				id = m_Proxies.size();
+				m_Proxies.push_back(Proxy());
+				for (unsigned int axis = 0; axis < 3; axis++)
+				{
+					m_Min[axis].push_back(0.0f);
+					m_Max[axis].push_back(0.0f);
+				}
+			}
+			else
+			{
+				id = m_FreeProxies.back();
+				m_FreeProxies.pop_back();
+				m_Proxies[id] = Proxy();
+			}
+
+			auto &proxy = m_Proxies[id];
+			proxy.node = sceneNode;
+			proxy.address = sceneNode.get();
+			proxy.alive = true;
+
+			m_ProxyMap.emplace(proxy.address, id);
+		}
+
+		// the signal calls back under its own lock, so connect outside of ours.
+		Broadphase::Ptr selfPtr = shared_from_this();
+		m_Proxies[id].signalKey = sceneNode->OnTransformChange->Connect(selfPtr, &Broadphase::OnSceneNodeTransformChange);
+
+		RefreshProxy(id);
+		if (m_Proxies[id].valid)
+		{
+			m_Order.push_back(id);
+			m_Inserted++;
+		}
+
+		return id;
+	}
+
+	void Broadphase::AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		if (!sceneNode->GetWorldAABB().GetInfinite())
+			AddSceneNode(sceneNode);
+
+		for (unsigned int i = 0; i < sceneNode->GetChildCount(); i++)
+			AddSceneNodeRecursively(sceneNode->GetChildAt(i));
+	}
+
+	void Broadphase::RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		int id = GetProxy(sceneNode);
+		if (id >= 0)
+			ReleaseProxy(id);
+	}
+
+	void Broadphase::UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		OnSceneNodeTransformChange(sceneNode);
+	}
+
+	void Broadphase::Clear()
+	{
+		for (unsigned int i = 0; i < m_Proxies.size(); i++)
+		{
+			if (m_Proxies[i].alive)
+				ReleaseProxy(i);
+		}
+	}
+
+	unsigned int Broadphase::Update()
+	{
+		std::vector<unsigned int> dirty;
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			dirty.swap(m_Dirty);
+			for (auto id : dirty)
+				m_Proxies[id].dirty = false;
+		}
+
+		for (auto id : dirty)
+		{
+			auto &proxy = m_Proxies[id];
+			if (!proxy.alive)
+				continue;
+
+			bool wasValid = proxy.valid;
+			RefreshProxy(id);
+
+			if (proxy.valid && !wasValid)
+			{
+				m_Order.push_back(id);
+				m_Inserted++;
+			}
+			else if (!proxy.valid && wasValid)
+			{
+				m_OrderDirty = true;
+			}
+		}
+
+		if (m_OrderDirty)
+		{
+			m_OrderDirty = false;
+			m_Order.erase(std::remove_if(m_Order.begin(), m_Order.end(), [this](unsigned int id)
+			{
+				return !m_Proxies[id].alive || !m_Proxies[id].valid;
+			}), m_Order.end());
+		}
+
+		ChooseAxis();
+		SortOrder();
+		Sweep();
+
+		// pairs naming released proxies end here, their slots can be reused now.
+		m_BeginPairs.clear();
+		m_EndPairs.clear();
+		std::set_difference(m_Pairs.begin(), m_Pairs.end(), m_LastPairs.begin(), m_LastPairs.end(), std::back_inserter(m_BeginPairs));
+		std::set_difference(m_LastPairs.begin(), m_LastPairs.end(), m_Pairs.begin(), m_Pairs.end(), std::back_inserter(m_EndPairs));
+		m_LastPairs = m_Pairs;
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_FreeProxies.insert(m_FreeProxies.end(), m_ReleasedProxies.begin(), m_ReleasedProxies.end());
+			m_ReleasedProxies.clear();
+		}
+
+		return m_Pairs.size();
+	}
+
+	const std::vector<Broadphase::Pair> &Broadphase::GetPairs() const
+	{
+		return m_Pairs;
+	}
+
+	const std::vector<Broadphase::Pair> &Broadphase::GetBeginPairs() const
+	{
+		return m_BeginPairs;
+	}
+
+	const std::vector<Broadphase::Pair> &Broadphase::GetEndPairs() const
+	{
+		return m_EndPairs;
+	}
+
+	std::shared_ptr<SceneNode> Broadphase::GetSceneNode(unsigned int proxy) const
+	{
+		if (proxy >= m_Proxies.size() || !m_Proxies[proxy].alive)
+			return nullptr;
+
+		return m_Proxies[proxy].node.lock();
+	}
+
+	int Broadphase::GetProxy(const std::shared_ptr<SceneNode> &sceneNode) const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		auto it = m_ProxyMap.find(sceneNode.get());
+		if (it == m_ProxyMap.end() || m_Proxies[it->second].node.lock() != sceneNode)
+			return -1;
+
+		return it->second;
+	}
+
+	unsigned int Broadphase::GetProxyCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_ProxyMap.size();
+	}
+
+	unsigned int Broadphase::GetSweepAxis() const
+	{
+		return m_Axis;
+	}
+
+	void Broadphase::OnSceneNodeTransformChange(const std::shared_ptr<SceneNode> &sender)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		auto it = m_ProxyMap.find(sender.get());
+		if (it != m_ProxyMap.end())
+			MarkDirty(it->second);
+	}
+
+	void Broadphase::MarkDirty(unsigned int proxy)
+	{
+		if (m_Proxies[proxy].dirty)
+			return;
+
+		m_Proxies[proxy].dirty = true;
+		m_Dirty.push_back(proxy);
+	}
+
+	void Broadphase::RefreshProxy(unsigned int proxy)
+	{
+		auto node = m_Proxies[proxy].node.lock();
+		if (node == nullptr)
+		{
+			m_Proxies[proxy].valid = false;
+			return;
+		}
+
+		auto aabb = node->GetWorldAABB();
+		m_Proxies[proxy].valid = !aabb.GetInfinite() && aabb.Valid();
+
+		Vector4 min = aabb.GetMin(), max = aabb.GetMax();
+		m_Min[0][proxy] = min.x;
+		m_Min[1][proxy] = min.y;
+		m_Min[2][proxy] = min.z;
+		m_Max[0][proxy] = max.x;
+		m_Max[1][proxy] = max.y;
+		m_Max[2][proxy] = max.z;
+	}
+
+	void Broadphase::ReleaseProxy(unsigned int proxy)
+	{
+		auto &data = m_Proxies[proxy];
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_ProxyMap.erase(data.address);
+			data.alive = false;
+			m_ReleasedProxies.push_back(proxy);
+		}
+
+		if (auto node = data.node.lock())
+			node->OnTransformChange->Disconnect(data.signalKey);
+
+		data.node.reset();
+		m_OrderDirty = true;
+	}
+
+	void Broadphase::ChooseAxis()
+	{
+		unsigned int count = m_Order.size();
+		if (count < 2)
+			return;
+
+		// variance of the centers, fewer aabbs overlap along the axis they're most spread on.
+		double sum[3] = { 0, 0, 0 }, sumSq[3] = { 0, 0, 0 };
+		for (auto id : m_Order)
+		{
+			for (unsigned int axis = 0; axis < 3; axis++)
+			{
+				double center = 0.5 * ((double)m_Min[axis][id] + m_Max[axis][id]);
+				sum[axis] += center;
+				sumSq[axis] += center * center;
+			}
+		}
+
+		double variance[3];
+		for (unsigned int axis = 0; axis < 3; axis++)
+			variance[axis] = sumSq[axis] / count - (sum[axis] / count) * (sum[axis] / count);
+
+		unsigned int best = m_Axis;
+		for (unsigned int axis = 0; axis < 3; axis++)
+		{
+			if (variance[axis] > variance[best])
+				best = axis;
+		}
+
+		// switching means a full sort, so only for a clear win.
+		if (best != m_Axis && variance[best] > variance[m_Axis] * 1.5)
+		{
+			m_Axis = best;
+			m_Inserted = count;
+		}
+	}
+
+	void Broadphase::SortOrder()
+	{
+		const auto &min = m_Min[m_Axis];
+		unsigned int count = m_Order.size();
+
+		if (m_Inserted > count / 8)
+		{
+			std::sort(m_Order.begin(), m_Order.end(), [&min](unsigned int a, unsigned int b)
+			{
+				return min[a] < min[b];
+			});
+		}
+		else
+		{
+			// coherent motion keeps the order almost sorted.
+			for (unsigned int i = 1; i < count; i++)
+			{
+				unsigned int id = m_Order[i];
+				float key = min[id];
+				unsigned int j = i;
+				while (j > 0 && min[m_Order[j - 1]] > key)
+				{
+					m_Order[j] = m_Order[j - 1];
+					j--;
+				}
+				m_Order[j] = id;
+			}
+		}
+
+		m_Inserted = 0;
+	}
+
+	void Broadphase::Sweep()
+	{
+		unsigned int count = m_Order.size();
+		unsigned int axis0 = m_Axis, axis1 = (m_Axis + 1) % 3, axis2 = (m_Axis + 2) % 3;
+
+		// gather in sweep order so the inner loop reads memory linearly.
+		unsigned int axes[3] = { axis0, axis1, axis2 };
+		for (unsigned int k = 0; k < 3; k++)
+		{
+			auto &sortedMin = m_SortedMin[k];
+			auto &sortedMax = m_SortedMax[k];
+			sortedMin.resize(count);
+			sortedMax.resize(count);
+			for (unsigned int i = 0; i < count; i++)
+			{
+				sortedMin[i] = m_Min[axes[k]][m_Order[i]];
+				sortedMax[i] = m_Max[axes[k]][m_Order[i]];
+			}
+		}
+
+		const float *min0 = m_SortedMin[0].data(), *max0 = m_SortedMax[0].data();
+		const float *min1 = m_SortedMin[1].data(), *max1 = m_SortedMax[1].data();
+		const float *min2 = m_SortedMin[2].data(), *max2 = m_SortedMax[2].data();
+
+		m_Pairs.clear();
+		for (unsigned int i = 0; i < count; i++)
+		{
+			float end = max0[i];
+			unsigned int j = i + 1;
+
+#ifdef FURY_SSE
+			// 4 candidates per step, mins are sorted so the in range lanes are a prefix.
+			__m128 end4 = _mm_set1_ps(end);
+			__m128 lo1 = _mm_set1_ps(min1[i]), hi1 = _mm_set1_ps(max1[i]);
+			__m128 lo2 = _mm_set1_ps(min2[i]), hi2 = _mm_set1_ps(max2[i]);
+
+			bool passed = false;
+			for (; j + 4 <= count; j += 4)
+			{
+				int inRange = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(min0 + j), end4));
+				if (inRange == 0)
+				{
+					passed = true;
+					break;
+				}
+
+				__m128 overlap = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min1 + j), hi1), _mm_cmple_ps(lo1, _mm_loadu_ps(max1 + j)));
+				overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(min2 + j), hi2), _mm_cmple_ps(lo2, _mm_loadu_ps(max2 + j))));
+
+				int hits = _mm_movemask_ps(overlap) & inRange;
+				for (unsigned int k = 0; hits != 0; k++, hits >>= 1)
+				{
+					if (hits & 1)
+					{
+						unsigned int a = m_Order[i], b = m_Order[j + k];
+						m_Pairs.push_back(a < b ? Pair(a, b) : Pair(b, a));
+					}
+				}
+
+				if (inRange != 0xF)
+				{
+					passed = true;
+					break;
+				}
+			}
+
+			if (passed)
+				continue;
+#endif
+
+			for (; j < count && min0[j] <= end; j++)
+			{
+				if (min1[j] <= max1[i] && min1[i] <= max1[j] && min2[j] <= max2[i] && min2[i] <= max2[j])
+				{
+					unsigned int a = m_Order[i], b = m_Order[j];
+					m_Pairs.push_back(a < b ? Pair(a, b) : Pair(b, a));
+				}
+			}
+		}
+
+		std::sort(m_Pairs.begin(), m_Pairs.end());
+	}
+}
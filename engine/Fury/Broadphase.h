@@ -0,0 +1,155 @@
+#ifndef _FURY_BROADPHASE_H_
+#define _FURY_BROADPHASE_H_
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Fury/BoxBounds.h"
+
+namespace fury
+{
+	class SceneNode;
+
+	// finds overlapping pairs of scene node world aabbs by sweep and prune.
+	// proxies keep their order along the sweep axis between updates, so a frame where bodies
+	// moved a little costs an almost sorted insertion sort plus one sweep instead of n^2 tests.
+	// nodes are refreshed when their transform changes, call UpdateSceneNode after changing
+	// a node's model aabb without moving it. nodes with infinite or invalid aabbs never overlap.
+	class FURY_API Broadphase : public std::enable_shared_from_this<Broadphase>
+	{
+	public:
+
+		typedef std::shared_ptr<Broadphase> Ptr;
+
+		// proxy indices, first < second.
+		typedef std::pair<unsigned int, unsigned int> Pair;
+
+		static Ptr Create();
+
+	protected:
+
+		class Proxy
+		{
+		public:
+
+			std::weak_ptr<SceneNode> node;
+
+			// key in m_ProxyMap, kept because the node may be gone by the time it's released.
+			const SceneNode *address = nullptr;
+
+			size_t signalKey = 0;
+
+			bool alive = false;
+
+			// queued in m_Dirty.
+			bool dirty = false;
+
+			// aabb is usable.
+			bool valid = false;
+		};
+
+		std::vector<Proxy> m_Proxies;
+
+		// per proxy, indexed by axis.
+		std::vector<float> m_Min[3];
+
+		std::vector<float> m_Max[3];
+
+		// node to proxy, by address since names needn't be unique.
+		std::unordered_map<const SceneNode*, unsigned int> m_ProxyMap;
+
+		std::vector<unsigned int> m_FreeProxies;
+
+		// released last update, not reused until pairs naming them were reported as ended.
+		std::vector<unsigned int> m_ReleasedProxies;
+
+		// guards m_ProxyMap and m_Dirty, transforms may change on worker threads.
+		mutable std::mutex m_Mutex;
+
+		std::vector<unsigned int> m_Dirty;
+
+		// valid proxies sorted by min along m_Axis.
+		std::vector<unsigned int> m_Order;
+
+		unsigned int m_Axis = 0;
+
+		unsigned int m_Inserted = 0;
+
+		bool m_OrderDirty = false;
+
+		// sweep scratch in m_Order.
+		std::vector<float> m_SortedMin[3];
+
+		std::vector<float> m_SortedMax[3];
+
+		std::vector<Pair> m_Pairs;
+
+		std::vector<Pair> m_LastPairs;
+
+		std::vector<Pair> m_BeginPairs;
+
+		std::vector<Pair> m_EndPairs;
+
+	public:
+
+		virtual ~Broadphase();
+
+		// returns the node's proxy, adding a node twice returns the same proxy.
+		unsigned int AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
+
+		// adds nodes with finite aabbs under sceneNode, including itself.
+		void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode);
+
+		void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
+
+		// queues the node's aabb to be read on the next update.
+		void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode);
+
+		void Clear();
+
+		// refreshes moved proxies, restores the sweep order and finds this frame's pairs.
+		// returns the number of overlapping pairs.
+		unsigned int Update();
+
+		// pairs overlapping at the last update, sorted.
+		const std::vector<Pair> &GetPairs() const;
+
+		// pairs that started overlapping at the last update.
+		const std::vector<Pair> &GetBeginPairs() const;
+
+		// pairs that stopped overlapping, or lost a node, at the last update.
+		const std::vector<Pair> &GetEndPairs() const;
+
+		// null for removed or expired nodes.
+		std::shared_ptr<SceneNode> GetSceneNode(unsigned int proxy) const;
+
+		// -1 if the node wasn't added.
+		int GetProxy(const std::shared_ptr<SceneNode> &sceneNode) const;
+
+		unsigned int GetProxyCount() const;
+
+		// 0, 1 or 2 for x, y or z, the axis with the largest spread of aabb centers.
+		unsigned int GetSweepAxis() const;
+
+	protected:
+
+		void OnSceneNodeTransformChange(const std::shared_ptr<SceneNode> &sender);
+
+		void MarkDirty(unsigned int proxy);
+
+		void RefreshProxy(unsigned int proxy);
+
+		void ReleaseProxy(unsigned int proxy);
+
+		void ChooseAxis();
+
+		void SortOrder();
+
+		void Sweep();
+	};
+}
+
+#endif // _FURY_BROADPHASE_H_
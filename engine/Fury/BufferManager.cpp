@@ -1,4 +1,5 @@
 #include "Fury/BufferManager.h"
+#include "Fury/Log.h"
 
 namespace fury
 {
@@ -37,27 +38,92 @@ namespace fury
 		m_Buffers.clear();
 	}
 
-	void BufferManager::IncreaseMemory(unsigned int byte, bool gpu)
+	void BufferManager::IncreaseMemory(uint64_t byte, MemoryCategory category)
 	{
-		if (gpu)
-			m_GPUMemories += byte;
-		else
-			m_GPUMemories += byte;
+		auto &stat = m_MemoryStats[(size_t)category];
+		uint64_t current = stat.current.fetch_add(byte, std::memory_order_relaxed) + byte;
+
+		uint64_t peak = stat.peak.load(std::memory_order_relaxed);
+		while (current > peak && !stat.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed));
+
+		uint64_t budget = stat.budget.load(std::memory_order_relaxed);
+		if (budget > 0 && current > budget && !stat.exceeded.exchange(true))
+		{
+			FURYW << EnumUtil::MemoryCategoryToString(category) << " memory over budget: " << current << " / " << budget << " bytes";
+			OnBudgetExceeded->Emit(std::move(category), std::move(current));
+		}
+	}
+
+	void BufferManager::DecreaseMemory(uint64_t byte, MemoryCategory category)
+	{
+		auto &stat = m_MemoryStats[(size_t)category];
+		uint64_t current = stat.current.fetch_sub(byte, std::memory_order_relaxed) - byte;
+
+		if (current <= stat.budget.load(std::memory_order_relaxed))
+			stat.exceeded.store(false);
+	}
+
+	uint64_t BufferManager::GetMemory(MemoryCategory category) const
+	{
+		return m_MemoryStats[(size_t)category].current.load(std::memory_order_relaxed);
+	}
+
+	uint64_t BufferManager::GetPeakMemory(MemoryCategory category) const
+	{
+		return m_MemoryStats[(size_t)category].peak.load(std::memory_order_relaxed);
+	}
+
+	uint64_t BufferManager::GetMemory(bool gpu) const
+	{
+		uint64_t total = 0;
+		for (size_t i = 0; i < m_MemoryStats.size(); i++)
+		{
+			if ((MemoryCategory)i != MemoryCategory::MESH_CPU_SAVED && EnumUtil::MemoryCategoryOnGPU((MemoryCategory)i) == gpu)
+				total += m_MemoryStats[i].current.load(std::memory_order_relaxed);
+		}
+		return total;
+	}
+
+	unsigned int BufferManager::GetMemoryInMegaByte(bool gpu) const
+	{
+		return (unsigned int)(GetMemory(gpu) / 1000000);
+	}
+
+	void BufferManager::SetBudget(MemoryCategory category, uint64_t byte)
+	{
+		auto &stat = m_MemoryStats[(size_t)category];
+		stat.budget.store(byte, std::memory_order_relaxed);
+		stat.exceeded.store(false);
+
+		// report right away if we're already over it.
+		IncreaseMemory(0, category);
 	}
 
-	void BufferManager::DecreaseMemory(unsigned int byte, bool gpu)
+	uint64_t BufferManager::GetBudget(MemoryCategory category) const
 	{
-		if (gpu)
-			m_GPUMemories -= byte;
-		else
-			m_CPUMemories -= byte;
+		return m_MemoryStats[(size_t)category].budget.load(std::memory_order_relaxed);
 	}
 
-	unsigned int BufferManager::GetMemoryInMegaByte(bool gpu)
+	bool BufferManager::IsOverBudget(MemoryCategory category) const
 	{
-		if (gpu)
-			return m_GPUMemories / 1000000;
-		else
-			return m_CPUMemories / 1000000;
+		return m_MemoryStats[(size_t)category].exceeded.load();
+	}
+
+	void BufferManager::ResetPeaks()
+	{
+		for (auto &stat : m_MemoryStats)
+			stat.peak.store(stat.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	void BufferManager::Dump(std::ostream &stream) const
+	{
+		for (size_t i = 0; i < m_MemoryStats.size(); i++)
+		{
+			auto &stat = m_MemoryStats[i];
+			stream << EnumUtil::MemoryCategoryToString((MemoryCategory)i) << " " <<
+				stat.current.load(std::memory_order_relaxed) << " " <<
+				stat.peak.load(std::memory_order_relaxed) << " " <<
+				stat.budget.load(std::memory_order_relaxed) << "\n";
+		}
 	}
 }
\ No newline at end of file
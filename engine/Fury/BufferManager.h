@@ -1,10 +1,15 @@
 #ifndef _FURY_BUFFER_MANAGER_H_
 #define _FURY_BUFFER_MANAGER_H_
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
 #include <unordered_map>
 #include <type_traits>
 
 #include "Fury/Buffer.h"
+#include "Fury/EnumUtil.h"
 #include "Fury/Signal.h"
 #include "Fury/Singleton.h"
 
@@ -16,15 +21,32 @@ namespace fury
 
 		typedef std::shared_ptr<BufferManager> Ptr;
 
+		// category, bytes in use. emitted once when a category goes over its budget,
+		// again after it dropped below and exceeds it another time. may be emitted from worker threads.
+		Signal<MemoryCategory, uint64_t>::Ptr OnBudgetExceeded = Signal<MemoryCategory, uint64_t>::Create();
+
 	private:
 
-		std::unordered_map<size_t, std::weak_ptr<Buffer>> m_Buffers;
+		class MemoryStat
+		{
+		public:
 
-		// in byte
-		unsigned int m_CPUMemories = 0;
+			std::atomic<uint64_t> current;
+
+			std::atomic<uint64_t> peak;
+
+			// 0 = unlimited
+			std::atomic<uint64_t> budget;
+
+			std::atomic<bool> exceeded;
+
+			MemoryStat() : current(0), peak(0), budget(0), exceeded(false) {}
+		};
+
+		std::unordered_map<size_t, std::weak_ptr<Buffer>> m_Buffers;
 
 		// in byte
-		unsigned int m_GPUMemories = 0;
+		std::array<MemoryStat, (size_t)MemoryCategory::LENGTH> m_MemoryStats;
 
 	public:
 
@@ -34,7 +56,7 @@ namespace fury
 			static_assert(std::is_base_of<Buffer, BufferType>::value, "BufferType should extend Buffer Class");
 
 			auto it = m_Buffers.find(buffer->GetBufferId());
-			if (it != m_Buffers.end())
+			if (it == m_Buffers.end())
 			{
 				m_Buffers.emplace(buffer->GetBufferId(), std::static_pointer_cast<Buffer>(buffer));
 				return true;
@@ -55,11 +77,34 @@ namespace fury
 
 		void ReleaseAll();
 
-		void IncreaseMemory(unsigned int byte, bool gpu = true);
+		// thread safe.
+		void IncreaseMemory(uint64_t byte, MemoryCategory category);
+
+		// thread safe.
+		void DecreaseMemory(uint64_t byte, MemoryCategory category);
+
+		uint64_t GetMemory(MemoryCategory category) const;
+
+		uint64_t GetPeakMemory(MemoryCategory category) const;
+
+		// sum of all gpu or cpu categories.
+		uint64_t GetMemory(bool gpu) const;
+
+		unsigned int GetMemoryInMegaByte(bool gpu = true) const;
+
+		// 0 disables the budget.
+		void SetBudget(MemoryCategory category, uint64_t byte);
+
+		uint64_t GetBudget(MemoryCategory category) const;
+
+		bool IsOverBudget(MemoryCategory category) const;
 
-		void DecreaseMemory(unsigned int byte, bool gpu = true);
+		// peaks restart from the current values.
+		void ResetPeaks();
 
-		unsigned int GetMemoryInMegaByte(bool gpu = true);
+		// one line per category: name current peak budget, in bytes.
+		// stable format, meant to be diffed by memory regression checks.
+		void Dump(std::ostream &stream) const;
 	};
 }
 
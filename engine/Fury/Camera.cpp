@@ -23,6 +23,7 @@ namespace fury
 		ptr->m_ProjectionMatrix = m_ProjectionMatrix;
 		ptr->m_Frustum = m_Frustum;
 		ptr->m_ShadowAABB = m_ShadowAABB;
+		ptr->m_ShadowFar = m_ShadowFar;
 		return ptr;
 	}
 
@@ -7,6 +7,8 @@ namespace fury
 {
 	class BoxBounds;
 
+	class Frustum;
+
 	class SphereBounds;
 
 	class Vector4;
@@ -26,6 +28,12 @@ namespace fury
 		virtual bool IsInsideFast(const BoxBounds &aabb) const = 0;
 
 		virtual bool IsInsideFast(Vector4 point) const = 0;
+
+		// frusta this collider is the union of, for managers that cull per view like PortalManager.
+		// colliders that aren't made of frusta have none.
+		virtual unsigned int GetFrustumCount() const { return 0; }
+
+		virtual const Frustum* GetFrustumAt(unsigned int index) const { return nullptr; }
 	};
 }
 
@@ -0,0 +1,146 @@
+#include "Fury/BoxBounds.h"
+#include "Fury/ConvexVolume.h"
+#include "Fury/Frustum.h"
+#include "Fury/SphereBounds.h"
+
+namespace fury
+{
+	ConvexVolume::ConvexVolume(const Frustum &frustum)
+	{
+		auto planes = frustum.GetPlanes();
+		m_Planes.assign(planes.begin(), planes.end());
+	}
+
+	void ConvexVolume::AddPlane(const Plane &plane)
+	{
+		m_Planes.push_back(plane);
+	}
+
+	const std::vector<Plane> &ConvexVolume::GetPlanes() const
+	{
+		return m_Planes;
+	}
+
+	void ConvexVolume::ClipPolygon(std::vector<Vector4> &polygon) const
+	{
+		std::vector<Vector4> clipped;
+
+		for (const auto &plane : m_Planes)
+		{
+			if (polygon.size() < 3)
+				break;
+
+			clipped.clear();
+			for (unsigned int i = 0; i < polygon.size(); i++)
+			{
+				Vector4 current = polygon[i];
+				Vector4 next = polygon[(i + 1) % polygon.size()];
+				float dc = plane.GetDistance(current);
+				float dn = plane.GetDistance(next);
+
+				if (dc >= 0.0f)
+					clipped.push_back(current);
+
+				if ((dc >= 0.0f) != (dn >= 0.0f))
+				{
+					float t = dc / (dc - dn);
+					Vector4 point = current + (next - current) * t;
+					point.w = 1.0f;
+					clipped.push_back(point);
+				}
+			}
+
+			polygon.swap(clipped);
+		}
+
+		if (polygon.size() < 3)
+			polygon.clear();
+	}
+
+	Side ConvexVolume::IsInside(const SphereBounds &bsphere) const
+	{
+		if (bsphere.GetInfinite())
+			return Side::IN;
+
+		bool straddle = false;
+		for (const auto &plane : m_Planes)
+		{
+			Side side = plane.IsInside(bsphere);
+			if (side == Side::OUT)
+				return Side::OUT;
+			else if (side == Side::STRADDLE)
+				straddle = true;
+		}
+
+		return straddle ? Side::STRADDLE : Side::IN;
+	}
+
+	Side ConvexVolume::IsInside(const BoxBounds &aabb) const
+	{
+		if (aabb.GetInfinite())
+			return Side::IN;
+
+		bool straddle = false;
+		for (const auto &plane : m_Planes)
+		{
+			Side side = plane.IsInside(aabb);
+			if (side == Side::OUT)
+				return Side::OUT;
+			else if (side == Side::STRADDLE)
+				straddle = true;
+		}
+
+		return straddle ? Side::STRADDLE : Side::IN;
+	}
+
+	Side ConvexVolume::IsInside(Vector4 point) const
+	{
+		bool straddle = false;
+		for (const auto &plane : m_Planes)
+		{
+			Side side = plane.IsInside(point);
+			if (side == Side::OUT)
+				return Side::OUT;
+			else if (side == Side::STRADDLE)
+				straddle = true;
+		}
+
+		return straddle ? Side::STRADDLE : Side::IN;
+	}
+
+	bool ConvexVolume::IsInsideFast(const SphereBounds &bsphere) const
+	{
+		if (bsphere.GetInfinite())
+			return true;
+
+		for (const auto &plane : m_Planes)
+		{
+			if (!plane.IsInsideFast(bsphere))
+				return false;
+		}
+		return true;
+	}
+
+	bool ConvexVolume::IsInsideFast(const BoxBounds &aabb) const
+	{
+		if (aabb.GetInfinite())
+			return true;
+
+		for (const auto &plane : m_Planes)
+		{
+			if (!plane.IsInsideFast(aabb))
+				return false;
+		}
+		return true;
+	}
+
+	bool ConvexVolume::IsInsideFast(Vector4 point) const
+	{
+		for (const auto &plane : m_Planes)
+		{
+			if (!plane.IsInsideFast(point))
+				return false;
+		}
+		return true;
+	}
+}
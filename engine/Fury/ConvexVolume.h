@@ -0,0 +1,48 @@
+#ifndef _FURY_CONVEX_VOLUME_H_
+#define _FURY_CONVEX_VOLUME_H_
+
+#include <vector>
+
+#include "Fury/Collidable.h"
+#include "Fury/Plane.h"
+
+namespace fury
+{
+	class Frustum;
+
+	// intersection of any number of planes, normals point inside.
+	// used for frusta narrowed through portals.
+	class FURY_API ConvexVolume : public Collidable
+	{
+	protected:
+
+		std::vector<Plane> m_Planes;
+
+	public:
+
+		ConvexVolume() {}
+
+		ConvexVolume(const Frustum &frustum);
+
+		void AddPlane(const Plane &plane);
+
+		const std::vector<Plane> &GetPlanes() const;
+
+		// clips a convex polygon against all planes, the polygon is empty if it's fully outside.
+		void ClipPolygon(std::vector<Vector4> &polygon) const;
+
+		virtual Side IsInside(const SphereBounds &bsphere) const override;
+
+		virtual Side IsInside(const BoxBounds &aabb) const override;
+
+		virtual Side IsInside(Vector4 point) const override;
+
+		virtual bool IsInsideFast(const SphereBounds &bsphere) const override;
+
+		virtual bool IsInsideFast(const BoxBounds &aabb) const override;
+
+		virtual bool IsInsideFast(Vector4 point) const override;
+	};
+}
+
+#endif // _FURY_CONVEX_VOLUME_H_
@@ -0,0 +1,126 @@
+#ifdef _FURY_COROUTINE_IMP_
+
+#include <fstream>
+
+#include "Fury/Coroutine.h"
+#include "Fury/FileUtil.h"
+#include "Fury/Log.h"
+#include "Fury/Scene.h"
+#include "Fury/Texture.h"
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	void CoroutineUtil::WorkerAwaiter::await_suspend(std::coroutine_handle<> handle)
+	{
+		// the coroutine might be resumed before Spawn returns, don't touch this afterwards.
+		auto token = this->token;
+		ThreadUtil::Instance()->Spawn([handle, token]
+		{
+			Resume(handle, token);
+		});
+	}
+
+	bool CoroutineUtil::MainThreadAwaiter::await_ready() const
+	{
+		return ThreadUtil::Instance()->IsMainThread() && !token.IsCancelled();
+	}
+
+	void CoroutineUtil::MainThreadAwaiter::await_suspend(std::coroutine_handle<> handle)
+	{
+		auto token = this->token;
+		ThreadUtil::Instance()->SpawnOnMainThread([handle, token]
+		{
+			Resume(handle, token);
+		});
+	}
+
+	void CoroutineUtil::FileAwaiter::await_suspend(std::coroutine_handle<> handle)
+	{
+		auto threadUtil = ThreadUtil::Instance();
+		bool mainThread = threadUtil->IsMainThread();
+
+		threadUtil->Spawn([this, handle, mainThread]
+		{
+			auto token = this->token;
+			if (!token.IsCancelled())
+			{
+				std::ifstream stream(filePath, std::ios::binary | std::ios::ate);
+				if (stream)
+				{
+					output.resize((size_t)stream.tellg());
+					stream.seekg(0, std::ios::beg);
+					result = output.empty() || (bool)stream.read(&output[0], output.size());
+				}
+
+				if (!result)
+					FURYW << "Failed to read file: " << filePath;
+			}
+
+			if (mainThread)
+				ThreadUtil::Instance()->SpawnOnMainThread([handle, token] { Resume(handle, token); });
+			else
+				Resume(handle, token);
+		});
+	}
+
+	void CoroutineUtil::TextureAwaiter::await_suspend(std::coroutine_handle<> handle)
+	{
+		ThreadUtil::Instance()->Spawn([this, handle]
+		{
+			auto token = this->token;
+			if (token.IsCancelled())
+			{
+				ThreadUtil::Instance()->SpawnOnMainThread([handle, token] { Resume(handle, token); });
+				return;
+			}
+
+			// decoding happens here, only the gl upload waits for the main thread.
+			auto pixels = std::make_shared<std::vector<unsigned char>>();
+			int width = 0, height = 0, channels = 0;
+			bool loaded = FileUtil::LoadImage(Scene::Path(filePath), *pixels, width, height, channels);
+
+			ThreadUtil::Instance()->SpawnOnMainThread([this, handle, token, pixels, width, height, channels, loaded]
+			{
+				if (loaded && !token.IsCancelled())
+				{
+					texture->CreateFromPixels(filePath, *pixels, width, height, channels, srgb, mipMap);
+					result = texture->GetID() != 0;
+				}
+
+				Resume(handle, token);
+			});
+		});
+	}
+
+	CoroutineUtil::WorkerAwaiter CoroutineUtil::ToWorker(CancelToken token)
+	{
+		return WorkerAwaiter{ token };
+	}
+
+	CoroutineUtil::MainThreadAwaiter CoroutineUtil::ToMainThread(CancelToken token)
+	{
+		return MainThreadAwaiter{ token };
+	}
+
+	CoroutineUtil::FileAwaiter CoroutineUtil::ReadFile(const std::string &filePath, std::vector<char> &output, CancelToken token)
+	{
+		return FileAwaiter{ filePath, output, token };
+	}
+
+	CoroutineUtil::TextureAwaiter CoroutineUtil::UploadTexture(const std::shared_ptr<Texture> &texture, const std::string &filePath,
+		bool srgb, bool mipMap, CancelToken token)
+	{
+		return TextureAwaiter{ texture, filePath, srgb, mipMap, token };
+	}
+
+	void CoroutineUtil::Resume(std::coroutine_handle<> handle, const CancelToken &token)
+	{
+		if (token.IsCancelled())
+			handle.destroy();
+		else
+			handle.resume();
+	}
+}
+
+#endif // _FURY_COROUTINE_IMP_
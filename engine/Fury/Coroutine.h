@@ -0,0 +1,204 @@
+#ifdef _FURY_COROUTINE_IMP_
+
+#ifndef _FURY_COROUTINE_H_
+#define _FURY_COROUTINE_H_
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Macros.h"
+
+namespace fury
+{
+	class Texture;
+
+	// shared flag, a cancelled coroutine is destroyed at its next suspension point instead of resumed.
+	class FURY_API CancelToken
+	{
+	protected:
+
+		std::shared_ptr<std::atomic<bool>> m_Cancelled;
+
+	public:
+
+		CancelToken() : m_Cancelled(std::make_shared<std::atomic<bool>>(false)) {}
+
+		void Cancel()
+		{
+			m_Cancelled->store(true, std::memory_order_release);
+		}
+
+		bool IsCancelled() const
+		{
+			return m_Cancelled->load(std::memory_order_acquire);
+		}
+	};
+
+	// fire and forget coroutine, starts on the calling thread and runs until its first co_await.
+	class FURY_API Async
+	{
+	public:
+
+		class State
+		{
+		public:
+
+			std::atomic<bool> done{ false };
+
+			std::atomic<bool> cancelled{ false };
+		};
+
+		class promise_type
+		{
+		public:
+
+			std::shared_ptr<State> state = std::make_shared<State>();
+
+			bool returned = false;
+
+			~promise_type()
+			{
+				// destroyed without reaching co_return means it was cancelled.
+				if (!returned)
+					state->cancelled.store(true, std::memory_order_relaxed);
+				state->done.store(true, std::memory_order_release);
+			}
+
+			Async get_return_object() { return Async(state); }
+
+			std::suspend_never initial_suspend() noexcept { return {}; }
+
+			std::suspend_never final_suspend() noexcept { return {}; }
+
+			void return_void() { returned = true; }
+
+			void unhandled_exception() { std::terminate(); }
+		};
+
+	protected:
+
+		std::shared_ptr<State> m_State;
+
+	public:
+
+		Async(const std::shared_ptr<State> &state) : m_State(state) {}
+
+		bool IsDone() const
+		{
+			return m_State->done.load(std::memory_order_acquire);
+		}
+
+		bool IsCancelled() const
+		{
+			return IsDone() && m_State->cancelled.load(std::memory_order_relaxed);
+		}
+	};
+
+	// awaitables on top of ThreadUtil, e.g.
+	// Async Load(Texture::Ptr texture, CancelToken token)
+	// {
+	//     co_await CoroutineUtil::ToWorker(token);
+	//     ... heavy work ...
+	//     co_await CoroutineUtil::ToMainThread(token);
+	//     ... gl work ...
+	// }
+	class FURY_API CoroutineUtil final
+	{
+	public:
+
+		class WorkerAwaiter
+		{
+		public:
+
+			CancelToken token;
+
+			bool await_ready() const { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle);
+
+			void await_resume() const {}
+		};
+
+		class MainThreadAwaiter
+		{
+		public:
+
+			CancelToken token;
+
+			bool await_ready() const;
+
+			void await_suspend(std::coroutine_handle<> handle);
+
+			void await_resume() const {}
+		};
+
+		class FileAwaiter
+		{
+		public:
+
+			std::string filePath;
+
+			std::vector<char> &output;
+
+			CancelToken token;
+
+			bool result = false;
+
+			bool await_ready() const { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle);
+
+			bool await_resume() const { return result; }
+		};
+
+		class TextureAwaiter
+		{
+		public:
+
+			std::shared_ptr<Texture> texture;
+
+			std::string filePath;
+
+			bool srgb;
+
+			bool mipMap;
+
+			CancelToken token;
+
+			bool result = false;
+
+			bool await_ready() const { return false; }
+
+			void await_suspend(std::coroutine_handle<> handle);
+
+			bool await_resume() const { return result; }
+		};
+
+		// continues on a worker thread.
+		static WorkerAwaiter ToWorker(CancelToken token = CancelToken());
+
+		// continues on the main thread during ThreadUtil::Update, doesn't suspend if already there.
+		static MainThreadAwaiter ToMainThread(CancelToken token = CancelToken());
+
+		// reads the whole file on a worker, continues on the main thread if awaited from there,
+		// otherwise on the worker.
+		static FileAwaiter ReadFile(const std::string &filePath, std::vector<char> &output, CancelToken token = CancelToken());
+
+		// decodes the image on a worker and uploads it on the main thread, always continues on the main thread.
+		static TextureAwaiter UploadTexture(const std::shared_ptr<Texture> &texture, const std::string &filePath,
+			bool srgb, bool mipMap, CancelToken token = CancelToken());
+
+	protected:
+
+		// resumes the coroutine, or destroys it if the token was cancelled.
+		static void Resume(std::coroutine_handle<> handle, const CancelToken &token);
+	};
+}
+
+#endif // _FURY_COROUTINE_H_
+
+#endif // _FURY_COROUTINE_IMP_
@@ -1,3 +1,7 @@
+#include <chrono>
+#include <cmath>
+#include <thread>
+
 #include <SFML/Window.hpp>
 
 #include "Fury/BufferManager.h"
@@ -8,8 +12,12 @@
 #include "Fury/InputUtil.h"
 #include "Fury/Log.h"
 #include "Fury/MeshUtil.h"
+#include "Fury/ModelParser.h"
+#include "Fury/ParticleSystem.h"
+#include "Fury/Pipeline.h"
 #include "Fury/RenderUtil.h"
 #include "Fury/ThreadUtil.h"
+#include "Fury/Transform.h"
 #include "Fury/Vector4.h"
 
 namespace fury
@@ -18,6 +26,16 @@ namespace fury
 
 	Signal<>::Ptr Engine::OnFixedUpdate = Signal<>::Create();
 
+	std::atomic<bool> Engine::m_Running(false);
+
+	float Engine::m_Interpolation = 0.0f;
+
+	// half millisecond buckets up to 50 ms.
+
+	Histogram Engine::m_FrameTimes(0.5f, 100);
+
+	Histogram Engine::m_WorkTimes(0.5f, 100);
+
 	bool Engine::Initialize(sf::Window &window, int numThreads, LogLevel level, const char* logfile,
 		bool console, const LogFormatter &formatter, bool append)
 	{
@@ -41,6 +59,8 @@ namespace fury
 		FbxParser::Initialize();
 #endif
 
+		ModelParser::Initialize();
+
 		int flag = gl::LoadGLFunctions();
 
 		RenderUtil::Initialize();
@@ -135,6 +155,30 @@ namespace fury
 	{
 		ThreadUtil::Instance()->Update();
 		OnUpdate->Emit(std::move(dt));
+		ParticleSystem::SimulateAll(dt);
+	}
+
+	void Engine::UpdatePipelined(float dt, const std::shared_ptr<Pipeline> &pipeline,
+		const std::function<void()> &simulate, const std::function<void()> &render)
+	{
+		auto &threadUtil = ThreadUtil::Instance();
+
+		// main thread callbacks may touch the scene, run them before the simulation starts.
+		threadUtil->Update();
+
+		ThreadUtil::Counter counter(0);
+		threadUtil->Spawn([dt, &simulate]
+		{
+			float value = dt;
+			OnUpdate->Emit(std::move(value));
+			ParticleSystem::SimulateAll(dt);
+			simulate();
+		}, &counter);
+
+		render();
+
+		threadUtil->Wait(counter);
+		pipeline->SwapFrames();
 	}
 
 	void Engine::FixedUpdate()
@@ -142,6 +186,170 @@ namespace fury
 		OnFixedUpdate->Emit();
 	}
 
+	void Engine::Run(sf::Window &window, const std::function<void()> &fixedUpdate, const std::function<void(float)> &update,
+		const std::function<void(float)> &draw, const LoopOptions &options)
+	{
+		typedef std::chrono::steady_clock Clock;
+		typedef std::chrono::duration<double> Seconds;
+
+		const double step = options.fixedStep > 0.0f ? options.fixedStep : 1.0 / 25.0;
+		const auto framePeriod = std::chrono::duration_cast<Clock::duration>(Seconds(options.maxFrameRate > 0.0f ? 1.0 / options.maxFrameRate : 0.0));
+		const auto spinTime = std::chrono::duration_cast<Clock::duration>(Seconds(options.spinTime));
+
+		double accumulator = 0.0;
+		auto frameStart = Clock::now();
+		GLsync fence = nullptr;
+
+		// whole fixed steps for the elapsed time, then transforms are interpolated by what's left.
+		auto simulate = [&]
+		{
+			unsigned int steps = 0;
+			while (accumulator >= step && steps < options.maxFixedSteps && m_Running)
+			{
+				Transform::SyncAll();
+				FixedUpdate();
+				if (fixedUpdate)
+					fixedUpdate();
+
+				accumulator -= step;
+				steps++;
+			}
+
+			// too far behind, slow the simulation down instead of spiraling.
+			if (accumulator >= step)
+				accumulator = std::fmod(accumulator, step);
+
+			m_Interpolation = (float)(accumulator / step);
+			Transform::InterpolateAll(m_Interpolation);
+		};
+
+		m_Running = true;
+
+		while (m_Running && window.isOpen())
+		{
+			// pace before reading input, so a capped frame acts on the freshest input.
+			if (framePeriod.count() > 0)
+			{
+				auto target = frameStart + framePeriod;
+				auto remaining = target - Clock::now();
+				if (remaining > spinTime)
+					std::this_thread::sleep_for(remaining - spinTime);
+
+				while (Clock::now() < target)
+					std::this_thread::yield();
+			}
+
+			if (fence != nullptr)
+			{
+				glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+				glDeleteSync(fence);
+				fence = nullptr;
+			}
+
+			auto now = Clock::now();
+			double frameTime = Seconds(now - frameStart).count();
+			frameStart = now;
+
+			m_FrameTimes.Add((float)(frameTime * 1000.0));
+
+			RenderUtil::Instance()->BeginFrame();
+
+			sf::Event event;
+			while (window.pollEvent(event))
+			{
+				if (event.type == sf::Event::Closed)
+				{
+					m_Running = false;
+					break;
+				}
+
+				HandleEvent(event);
+#ifdef _FURY_GUI_IMP_
+				Gui::HandleEvent(event);
+#endif
+			}
+
+			if (!m_Running)
+				break;
+
+			accumulator += frameTime;
+			float dt = (float)frameTime;
+
+#ifdef _FURY_GUI_IMP_
+			Gui::NewFrame(dt);
+#endif
+
+			if (options.pipeline != nullptr)
+			{
+				UpdatePipelined(dt, options.pipeline, [&]
+				{
+					simulate();
+					if (update)
+						update(dt);
+				}, [&]
+				{
+					if (draw)
+						draw(dt);
+				});
+			}
+			else
+			{
+				simulate();
+
+				Update(dt);
+				if (update)
+					update(dt);
+
+				if (draw)
+					draw(dt);
+			}
+
+#ifdef _FURY_GUI_IMP_
+			Gui::Render();
+#endif
+
+			window.display();
+
+			if (options.limitLatency)
+				fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+			RenderUtil::Instance()->EndFrame();
+
+			m_WorkTimes.Add((float)(Seconds(Clock::now() - frameStart).count() * 1000.0));
+		}
+
+		if (fence != nullptr)
+			glDeleteSync(fence);
+
+		m_Running = false;
+	}
+
+	void Engine::Stop()
+	{
+		m_Running = false;
+	}
+
+	float Engine::GetInterpolation()
+	{
+		return m_Interpolation;
+	}
+
+	const Histogram &Engine::GetFrameTimes()
+	{
+		return m_FrameTimes;
+	}
+
+	const Histogram &Engine::GetWorkTimes()
+	{
+		return m_WorkTimes;
+	}
+
+	void Engine::ClearFrameTimes()
+	{
+		m_FrameTimes.Clear();
+		m_WorkTimes.Clear();
+	}
+
 	std::pair<int, int> Engine::GetGLVersion()
 	{
 		return std::make_pair<int, int>(gl::GetMajorVersion(), gl::GetMinorVersion());
@@ -1,6 +1,7 @@
 #ifndef _FURY_ENGINE_H_
 #define _FURY_ENGINE_H_
 
+#include <atomic>
 #include <iostream>
 #include <functional>
 #include <string>
@@ -8,15 +9,45 @@
 #include <SFML/Window/Window.hpp>
 #include <SFML/Window/Event.hpp>
 
+#include "Fury/Histogram.h"
 #include "Fury/Log.h"
 #include "Fury/Signal.h"
 
 namespace fury
 {
+	class Pipeline;
+
 	class FURY_API Engine 
 	{
 	public:
 
+		// settings of Run's loop.
+		class LoopOptions
+		{
+		public:
+
+			// seconds per fixed update.
+			float fixedStep;
+
+			// fixed updates per frame at most, time beyond that is dropped instead of caught up.
+			unsigned int maxFixedSteps;
+
+			// frames per second, 0 doesn't cap.
+			float maxFrameRate;
+
+			// the end of a capped frame's wait is spent yielding, sleeping can overshoot by a scheduler tick.
+			float spinTime;
+
+			// wait for the gpu to finish the previous frame before reading input, so the cpu
+			// can't queue frames ahead of it. costs some throughput for less input latency.
+			bool limitLatency;
+
+			// if set, simulation runs on a worker while the last capture draws, see UpdatePipelined.
+			std::shared_ptr<Pipeline> pipeline;
+
+			LoopOptions() : fixedStep(1.0f / 25.0f), maxFixedSteps(5), maxFrameRate(0.0f), spinTime(0.002f), limitLatency(false) {}
+		};
+
 		static bool Initialize(sf::Window &window, int numThreads, LogLevel level = LogLevel::EROR, const char* logfile = nullptr, 
 			bool console = true, const LogFormatter &formatter = Formatter::Simple, bool append = false);
 
@@ -26,11 +57,50 @@ namespace fury
 
 		static Signal<>::Ptr OnFixedUpdate;
 
+		// emits OnUpdate, then steps particle systems.
 		static void Update(float dt);
 
+		// frame pipelining: OnUpdate, particle systems and simulate (game logic, ending with Pipeline::Capture) run on a worker
+		// while render draws the previous capture on the main thread. pipeline's frames are swapped
+		// once both returned, so rendering lags the simulation by exactly one frame.
+		static void UpdatePipelined(float dt, const std::shared_ptr<Pipeline> &pipeline,
+			const std::function<void()> &simulate, const std::function<void()> &render);
+
 		static void FixedUpdate();
 
+		// runs until the window closes or Stop is called. a frame paces itself to maxFrameRate, polls
+		// events, runs whole fixed steps (Transform::SyncAll, OnFixedUpdate, fixedUpdate) for the elapsed
+		// time, interpolates every Transform by the leftover fraction of a step, then updates (Update,
+		// update) and draws (draw, Gui) and displays. update and draw get the frame time in seconds.
+		// in pipelined mode fixed steps, interpolation and update run on a worker, update should end with Pipeline::Capture.
+		static void Run(sf::Window &window, const std::function<void()> &fixedUpdate, const std::function<void(float)> &update,
+			const std::function<void(float)> &draw, const LoopOptions &options = LoopOptions());
+
+		static void Stop();
+
+		// leftover fraction of a fixed step Run last interpolated transforms by, in [0, 1).
+		static float GetInterpolation();
+
+		// milliseconds between frame starts, pacing included.
+		static const Histogram &GetFrameTimes();
+
+		// milliseconds of work per frame, without pacing waits.
+		static const Histogram &GetWorkTimes();
+
+		static void ClearFrameTimes();
+
 		static std::pair<int, int> GetGLVersion();
+
+	protected:
+
+		// Stop may be called from a pipelined simulation on a worker.
+		static std::atomic<bool> m_Running;
+
+		static float m_Interpolation;
+
+		static Histogram m_FrameTimes;
+
+		static Histogram m_WorkTimes;
 	};
 }
 
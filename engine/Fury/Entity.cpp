@@ -61,7 +61,7 @@ namespace fury
 	size_t Entity::SetName(const std::string &name)
 	{
 		m_Name = name;
-		m_HashCode = std::hash<std::string>()(name);
+		m_HashCode = Name(name).GetHash();
 		return m_HashCode;
 	}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 
+#include "Fury/Name.h"
 #include "Fury/TypeComparable.h"
 #include "Fury/Serializable.h"
 
@@ -7,6 +7,7 @@
 #include <typeindex>
 
 #include "Macros.h"
+#include "Fury/Name.h"
 
 namespace fury
 {
@@ -68,9 +69,9 @@ namespace fury
 		}
 
 		template<class ObjectType>
-		std::shared_ptr<ObjectType> Remove(const std::string &name)
+		std::shared_ptr<ObjectType> Remove(const Name &name)
 		{
-			return Remove<ObjectType>(std::hash<std::string>()(name));
+			return Remove<ObjectType>(name.GetHash());
 		}
 
 		template<class ObjectType>
@@ -114,9 +115,9 @@ namespace fury
 		}
 
 		template<class ObjectType>
-		std::shared_ptr<ObjectType> Get(const std::string &name)
+		std::shared_ptr<ObjectType> Get(const Name &name)
 		{
-			return Get<ObjectType>(std::hash<std::string>()(name));
+			return Get<ObjectType>(name.GetHash());
 		}
 
 		template<class ObjectType>
@@ -178,7 +178,8 @@ namespace fury
 	{
 		std::make_pair(ShaderType::OTHER, "other"), 
 		std::make_pair(ShaderType::STATIC_MESH, "static_mesh"), 
-		std::make_pair(ShaderType::SKINNED_MESH, "skinned_mesh")
+		std::make_pair(ShaderType::SKINNED_MESH, "skinned_mesh"), 
+		std::make_pair(ShaderType::PARTICLE, "particle")
 	};
 
 	const std::vector<std::pair<ShaderTexture, std::string>> EnumUtil::m_ShaderTexture =
@@ -196,6 +197,17 @@ namespace fury
 		GL_LINE_STRIP
 	};
 
+	const std::vector<std::pair<MemoryCategory, std::string>> EnumUtil::m_MemoryCategory =
+	{
+		std::make_pair(MemoryCategory::MESH_CPU, "mesh_cpu"),
+		std::make_pair(MemoryCategory::MESH_GPU, "mesh_gpu"),
+		std::make_pair(MemoryCategory::TEXTURE, "texture"),
+		std::make_pair(MemoryCategory::RENDER_TARGET, "render_target"),
+		std::make_pair(MemoryCategory::ANIMATION, "animation"),
+		std::make_pair(MemoryCategory::SCENE_GRAPH, "scene_graph"),
+		std::make_pair(MemoryCategory::MESH_CPU_SAVED, "mesh_cpu_saved")
+	};
+
 
 	std::string EnumUtil::ClearModeToString(ClearMode mode)
 	{
@@ -306,6 +318,8 @@ namespace fury
 			return "transparent";
 		case DrawMode::LIGHT:
 			return "light";
+		case DrawMode::PARTICLE:
+			return "particle";
 		case DrawMode::QUAD:
 		default:
 			return "quad";
@@ -320,6 +334,8 @@ namespace fury
 			return DrawMode::TRANSPARENT;
 		else if (name == "light")
 			return DrawMode::LIGHT;
+		else if (name == "particle")
+			return DrawMode::PARTICLE;
 		else
 			return DrawMode::QUAD;
 	}
@@ -484,4 +500,15 @@ namespace fury
 	{
 		return m_LineMode[(unsigned int)mode];
 	}
+
+	std::string EnumUtil::MemoryCategoryToString(MemoryCategory category)
+	{
+		return m_MemoryCategory[(unsigned int)category].second;
+	}
+
+	bool EnumUtil::MemoryCategoryOnGPU(MemoryCategory category)
+	{
+		return category == MemoryCategory::MESH_GPU || category == MemoryCategory::TEXTURE ||
+			category == MemoryCategory::RENDER_TARGET;
+	}
 }
\ No newline at end of file
@@ -61,7 +61,8 @@ namespace fury
 		OPAQUE,
 		TRANSPARENT,
 		LIGHT,
-		QUAD
+		QUAD,
+		PARTICLE
 	};
 
 	enum class TextureFormat : unsigned int
@@ -138,7 +139,8 @@ namespace fury
 	{
 		OTHER = 0,
 		STATIC_MESH,
-		SKINNED_MESH
+		SKINNED_MESH,
+		PARTICLE
 	};
 
 	enum class ShaderTexture : unsigned int
@@ -156,6 +158,19 @@ namespace fury
 		LINE_STRIP
 	};
 
+	enum class MemoryCategory : unsigned int
+	{
+		MESH_CPU = 0,
+		MESH_GPU,
+		TEXTURE,
+		RENDER_TARGET,
+		ANIMATION,
+		SCENE_GRAPH,
+		// not in use, raw size of vertex data static meshes evicted. see Mesh::SetStatic.
+		MESH_CPU_SAVED,
+		LENGTH
+	};
+
 	class FURY_API EnumUtil final
 	{
 	private:
@@ -190,6 +205,8 @@ namespace fury
 
 		static const std::vector<unsigned int> m_LineMode;
 
+		static const std::vector<std::pair<MemoryCategory, std::string>> m_MemoryCategory;
+
 	public:
 
 		static std::string ClearModeToString(ClearMode mode);
@@ -275,6 +292,12 @@ namespace fury
 
 
 		static unsigned int LineModeToUnit(LineMode mode);
+
+
+		static std::string MemoryCategoryToString(MemoryCategory category);
+
+		// true for categories that live in video memory.
+		static bool MemoryCategoryOnGPU(MemoryCategory category);
 	};
 }
 
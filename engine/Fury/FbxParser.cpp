@@ -862,6 +862,9 @@ namespace fury
 		if (m_ImportOptions.Flags & FbxImportFlags::OPTIMIZE_MESH)
 			MeshUtil::OptimizeMesh(mesh);
 
+		if (m_ImportOptions.Flags & FbxImportFlags::STATIC_MESH)
+			mesh->SetStatic(true);
+
 		return mesh;
 	}
 
@@ -35,7 +35,8 @@ namespace fury
 		BAKE_CURVE_ANIM	= 0x0400,
 		OPTIMIZE_ANIM	= 0x0800, 
 		BAKE_LAYERS		= 0x1000, 
-		AUTO_PAIR_CLIP	= 0x2000
+		AUTO_PAIR_CLIP	= 0x2000,
+		STATIC_MESH		= 0x4000
 	};
 
 	struct FbxImportOptions
@@ -0,0 +1,147 @@
+#include <cassert>
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+#include "Fury/FrameArena.h"
+
+namespace fury
+{
+	const size_t FrameArena::ChunkSize;
+
+	std::atomic<unsigned int> FrameArena::m_FrameIndex(0);
+
+	std::atomic<size_t> FrameArena::m_HeapAllocations(0);
+
+	FrameArena &FrameArena::Get()
+	{
+		static thread_local FrameArena t_Arena;
+		return t_Arena;
+	}
+
+	void FrameArena::BeginFrame()
+	{
+		m_FrameIndex.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	size_t FrameArena::GetHeapAllocations()
+	{
+		return m_HeapAllocations.load(std::memory_order_relaxed);
+	}
+
+	FrameArena::FrameArena() : m_Frame(m_FrameIndex.load(std::memory_order_relaxed))
+	{
+#ifndef NDEBUG
+		m_LiveCount = 0;
+#endif
+	}
+
+	FrameArena::~FrameArena()
+	{
+		for (auto &chunk : m_Chunks)
+			std::free(chunk.data);
+	}
+
+	void* FrameArena::Allocate(size_t size, size_t alignment)
+	{
+		unsigned int frame = m_FrameIndex.load(std::memory_order_relaxed);
+		if (frame != m_Frame)
+		{
+			assert(m_LiveCount.load(std::memory_order_acquire) == 0 && "frame allocation outlived its frame");
+			m_Frame = frame;
+			Rewind();
+		}
+
+		if (size == 0)
+			size = 1;
+
+		while (true)
+		{
+			if (m_CurrentChunk < m_Chunks.size())
+			{
+				auto &chunk = m_Chunks[m_CurrentChunk];
+				uintptr_t base = (uintptr_t)chunk.data;
+				uintptr_t aligned = (base + m_Offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+				size_t end = (size_t)(aligned - base) + size;
+				if (end <= chunk.size)
+				{
+					m_Offset = end;
+#ifndef NDEBUG
+					m_LiveCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+					return (void*)aligned;
+				}
+
+				// try the next chunk, only the last one may be partially filled.
+				if (m_CurrentChunk + 1 < m_Chunks.size())
+				{
+					m_CurrentChunk++;
+					m_Offset = 0;
+					continue;
+				}
+			}
+
+			AddChunk(size + alignment);
+			m_CurrentChunk = m_Chunks.size() - 1;
+			m_Offset = 0;
+		}
+	}
+
+	void FrameArena::Deallocate(void* ptr, size_t size)
+	{
+		// give the memory back if it was the last allocation, which is what a growing vector does.
+		if (this == &Get() && m_CurrentChunk < m_Chunks.size())
+		{
+			auto &chunk = m_Chunks[m_CurrentChunk];
+			if ((char*)ptr + std::max<size_t>(size, 1) == chunk.data + m_Offset)
+				m_Offset = (char*)ptr - chunk.data;
+		}
+
+#ifndef NDEBUG
+		m_LiveCount.fetch_sub(1, std::memory_order_release);
+#endif
+	}
+
+	size_t FrameArena::GetUsedBytes() const
+	{
+		size_t used = m_Offset;
+		for (size_t i = 0; i < m_CurrentChunk && i < m_Chunks.size(); i++)
+			used += m_Chunks[i].size;
+		return used;
+	}
+
+	size_t FrameArena::GetCapacity() const
+	{
+		size_t capacity = 0;
+		for (auto &chunk : m_Chunks)
+			capacity += chunk.size;
+		return capacity;
+	}
+
+	void FrameArena::Rewind()
+	{
+		// last frame didn't fit into one chunk, replace them with a single one that does.
+		if (m_Chunks.size() > 1)
+		{
+			size_t capacity = GetCapacity();
+			for (auto &chunk : m_Chunks)
+				std::free(chunk.data);
+			m_Chunks.clear();
+
+			AddChunk(capacity);
+		}
+
+		m_CurrentChunk = 0;
+		m_Offset = 0;
+	}
+
+	void FrameArena::AddChunk(size_t minSize)
+	{
+		Chunk chunk;
+		chunk.size = std::max(minSize, ChunkSize);
+		chunk.data = (char*)std::malloc(chunk.size);
+		m_Chunks.push_back(chunk);
+
+		m_HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+	}
+}
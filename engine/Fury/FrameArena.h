@@ -0,0 +1,129 @@
+#ifndef _FURY_FRAME_ARENA_H_
+#define _FURY_FRAME_ARENA_H_
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "Macros.h"
+
+namespace fury
+{
+	// per thread bump allocator for data that only lives during one frame.
+	// memory is rewound by the first allocation of a new frame, so steady state frames don't touch the heap.
+	// nothing allocated from the arena may be alive by then, debug builds assert it.
+	class FURY_API FrameArena final
+	{
+	protected:
+
+		class Chunk
+		{
+		public:
+
+			char* data;
+
+			size_t size;
+		};
+
+		static const size_t ChunkSize = 64 * 1024;
+
+		static std::atomic<unsigned int> m_FrameIndex;
+
+		static std::atomic<size_t> m_HeapAllocations;
+
+		std::vector<Chunk> m_Chunks;
+
+		size_t m_CurrentChunk = 0;
+
+		size_t m_Offset = 0;
+
+#ifndef NDEBUG
+		// allocations that weren't deallocated yet, may be decreased by other threads.
+		std::atomic<size_t> m_LiveCount;
+#endif
+
+		unsigned int m_Frame = 0;
+
+	public:
+
+		// arena of the calling thread.
+		static FrameArena &Get();
+
+		// called by RenderUtil::BeginFrame.
+		static void BeginFrame();
+
+		// chunks allocated from the heap by all arenas so far.
+		static size_t GetHeapAllocations();
+
+		FrameArena();
+
+		~FrameArena();
+
+		FrameArena(const FrameArena&) = delete;
+
+		FrameArena& operator = (const FrameArena&) = delete;
+
+		void* Allocate(size_t size, size_t alignment);
+
+		void Deallocate(void* ptr, size_t size);
+
+		size_t GetUsedBytes() const;
+
+		size_t GetCapacity() const;
+
+	protected:
+
+		void Rewind();
+
+		void AddChunk(size_t minSize);
+	};
+
+	// stl allocator on top of the arena of the thread that created it.
+	// containers using it must not outlive that thread or be kept across frames.
+	template<typename T>
+	class FrameAllocator
+	{
+		template<typename U>
+		friend class FrameAllocator;
+
+	protected:
+
+		FrameArena* m_Arena;
+
+	public:
+
+		typedef T value_type;
+
+		FrameAllocator() : m_Arena(&FrameArena::Get()) {}
+
+		template<typename U>
+		FrameAllocator(const FrameAllocator<U> &other) : m_Arena(other.m_Arena) {}
+
+		T* allocate(size_t n)
+		{
+			return static_cast<T*>(m_Arena->Allocate(n * sizeof(T), alignof(T)));
+		}
+
+		void deallocate(T* ptr, size_t n)
+		{
+			m_Arena->Deallocate(ptr, n * sizeof(T));
+		}
+
+		template<typename U>
+		bool operator == (const FrameAllocator<U> &other) const
+		{
+			return m_Arena == other.m_Arena;
+		}
+
+		template<typename U>
+		bool operator != (const FrameAllocator<U> &other) const
+		{
+			return m_Arena != other.m_Arena;
+		}
+	};
+
+	template<typename T>
+	using FrameVector = std::vector<T, FrameAllocator<T>>;
+}
+
+#endif // _FURY_FRAME_ARENA_H_
@@ -165,6 +165,16 @@ namespace fury
 		return true;
 	}
 
+	unsigned int Frustum::GetFrustumCount() const
+	{
+		return 1;
+	}
+
+	const Frustum* Frustum::GetFrustumAt(unsigned int index) const
+	{
+		return index == 0 ? this : nullptr;
+	}
+
 	std::array<Vector4, 8> Frustum::GetCurrentCorners() const
 	{
 		return m_CurrentCorners;
@@ -175,6 +185,11 @@ namespace fury
 		return m_BaseCorners;
 	}
 
+	std::array<Plane, 6> Frustum::GetPlanes() const
+	{
+		return m_Planes;
+	}
+
 	Matrix4 Frustum::GetTransformMatrix() const
 	{
 		return m_Transform;
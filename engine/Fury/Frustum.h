@@ -52,11 +52,18 @@ namespace fury
 
 		virtual bool IsInsideFast(Vector4 point) const;
 
+		virtual unsigned int GetFrustumCount() const;
+
+		virtual const Frustum* GetFrustumAt(unsigned int index) const;
+
 		// ntl, ntr, nbl, nbr, ftl, ftr, fbl, fbr
 		std::array<Vector4, 8> GetCurrentCorners() const;
 
 		std::array<Vector4, 8> GetBaseCorners() const;
 
+		// top, bottom, left, right, near, far. normals point inside.
+		std::array<Plane, 6> GetPlanes() const;
+
 		Matrix4 GetTransformMatrix() const;
 
 		BoxBounds GetBoxBounds() const;
@@ -6,19 +6,25 @@
 #include "Fury/AnimationUtil.h"
 #include "Fury/ArrayBuffers.h"
 #include "Fury/BoxBounds.h"
+#include "Fury/Broadphase.h"
 #include "Fury/Buffer.h"
 #include "Fury/BufferManager.h"
 #include "Fury/Camera.h"
 #include "Fury/Component.h"
+#include "Fury/Coroutine.h"
 #include "Fury/Color.h"
 #include "Fury/Collidable.h"
+#include "Fury/ConvexVolume.h"
 #include "Fury/Engine.h"
 #include "Fury/Entity.h"
 #include "Fury/EntityManager.h"
 #include "Fury/FileUtil.h"
+#include "Fury/FrameArena.h"
 #include "Fury/FbxParser.h"
 #include "Fury/Frustum.h"
 #include "Fury/Gui.h"
+#include "Fury/HLOD.h"
+#include "Fury/Histogram.h"
 #include "Fury/InputUtil.h"
 #include "Fury/Joint.h"
 #include "Fury/Light.h"
@@ -27,15 +33,23 @@
 #include "Fury/Material.h"
 #include "Fury/Matrix4.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshBVH.h"
 #include "Fury/MeshRender.h"
 #include "Fury/MeshUtil.h"
+#include "Fury/ModelParser.h"
+#include "Fury/Name.h"
 #include "Fury/OcTree.h"
 #include "Fury/OcTreeNode.h"
+#include "Fury/OcclusionBuffer.h"
 #include "Fury/Plane.h"
 #include "Fury/Quaternion.h"
+#include "Fury/ParticleSystem.h"
 #include "Fury/Pass.h"
 #include "Fury/Pipeline.h"
+#include "Fury/PVS.h"
+#include "Fury/PortalManager.h"
 #include "Fury/PrelightPipeline.h"
+#include "Fury/RenderFrame.h"
 #include "Fury/RenderQuery.h"
 #include "Fury/RenderUtil.h"
 #include "Fury/Scene.h"
@@ -45,11 +59,13 @@
 #include "Fury/Shader.h"
 #include "Fury/Singleton.h"
 #include "Fury/SphereBounds.h"
+#include "Fury/TaskGraph.h"
 #include "Fury/Texture.h"
 #include "Fury/ThreadUtil.h"
 #include "Fury/Transform.h"
 #include "Fury/TypeComparable.h"
 #include "Fury/Uniform.h"
 #include "Fury/Vector4.h"
+#include "Fury/WorkStealingQueue.h"
 
 #endif // _FURY_FURY_H_
\ No newline at end of file
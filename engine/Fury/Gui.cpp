@@ -1,6 +1,8 @@
 #include <map>
 #include <cstddef> // offsetof
 #include <array>
+#include <sstream>
+#include <vector>
 
 #include "ImGui/imconfig.h"
 #include "Imgui/imgui.h"
@@ -12,6 +14,7 @@
 #include "Fury/Texture.h"
 #include "Fury/Shader.h"
 #include "Fury/Log.h"
+#include "Fury/Engine.h"
 #include "Fury/EnumUtil.h"
 #include "Fury/EntityManager.h"
 #include "Fury/Frustum.h"
@@ -297,7 +300,7 @@ namespace fury
 			};
 
 			m_Shader->Bind();
-			m_Shader->BindMatrix("ProjMtx", &ortho_projection[0][0]);
+			m_Shader->BindMatrix(FURY_NAME("ProjMtx"), &ortho_projection[0][0]);
 
 			glBindVertexArray(m_VAO);
 
@@ -411,7 +414,7 @@ namespace fury
 
 		void ShowDefault(float dt)
 		{
-			static bool showProfilerWindow = true, showGBufferWindow = false, showShadowBufferWindow = false;
+			static bool showProfilerWindow = true, showGBufferWindow = false, showShadowBufferWindow = false, showMemoryWindow = false;
 
 			ImGui::Begin("Profiler", &showProfilerWindow, ImVec2(240, 350), 1.0f,
 				ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_ShowBorders | ImGuiWindowFlags_NoCollapse);
@@ -427,6 +430,22 @@ namespace fury
 				ImGui::PlotVar("FPS", curFps, 1, upper_bound, 210, 30);
 			}
 
+			// frame time distribution since start, or the last Engine::ClearFrameTimes.
+			{
+				const auto &frameTimes = Engine::GetFrameTimes();
+				if (frameTimes.GetSampleCount() > 0)
+				{
+					static std::vector<float> buckets;
+					buckets.resize(frameTimes.GetBucketCount());
+					for (unsigned int i = 0; i < buckets.size(); i++)
+						buckets[i] = (float)frameTimes.GetBucket(i);
+
+					ImGui::PlotHistogram("##frame_times", &buckets[0], buckets.size(), 0, nullptr, 0.0f, FLT_MAX, ImVec2(210, 30));
+					ImGui::Text("Frame: %.1f p99 %.1f max %.1f ms", frameTimes.GetPercentile(0.5f), frameTimes.GetPercentile(0.99f), frameTimes.GetMax());
+					ImGui::Text("Work: %.1f p99 %.1f ms", Engine::GetWorkTimes().GetPercentile(0.5f), Engine::GetWorkTimes().GetPercentile(0.99f));
+				}
+			}
+
 			ImGui::Separator();
 
 			ImGui::Text("CPU Mem: %u mb", BufferManager::Instance()->GetMemoryInMegaByte(false));
@@ -439,6 +458,11 @@ namespace fury
 			ImGui::Text("Mesh: %i", RenderUtil::Instance()->GetMeshCount());
 			ImGui::Text("SkinnedMesh: %i", RenderUtil::Instance()->GetSkinnedMeshCount());
 			ImGui::Text("Light: %i", RenderUtil::Instance()->GetLightCount());
+			ImGui::Text("Particles: %u", RenderUtil::Instance()->GetParticleCount());
+			ImGui::Text("Culled By Sphere: %u / %u", RenderUtil::Instance()->GetSphereCullCount(), RenderUtil::Instance()->GetCullTestCount());
+			ImGui::Text("Culled By Occlusion: %u / %u", RenderUtil::Instance()->GetOcclusionCullCount(), RenderUtil::Instance()->GetOcclusionTestCount());
+			ImGui::Text("Culled By Distance: %u, Shadow: %u", RenderUtil::Instance()->GetDistanceCullCount(), RenderUtil::Instance()->GetShadowDistanceCullCount());
+			ImGui::Text("Culled By Screen Size: %u, Shadow: %u", RenderUtil::Instance()->GetScreenSizeCullCount(), RenderUtil::Instance()->GetShadowScreenSizeCullCount());
 
 			// switches
 			{
@@ -458,14 +482,69 @@ namespace fury
 				ImGui::Checkbox("Use Cascaded Shadow Map", &use_csm);
 				Pipeline::Active->SetSwitch(PipelineSwitch::CASCADED_SHADOW_MAP, use_csm);
 
+				static bool use_occlusion_culling = false;
+				ImGui::Checkbox("Use Occlusion Culling", &use_occlusion_culling);
+				Pipeline::Active->SetSwitch(PipelineSwitch::OCCLUSION_CULLING, use_occlusion_culling);
+
 				ImGui::Separator();
 
 				ImGui::Checkbox("Show GBuffer Window", &showGBufferWindow);
 				ImGui::Checkbox("Show ShadowBuffer Window", &showShadowBufferWindow);
+				ImGui::Checkbox("Show Memory Window", &showMemoryWindow);
 			}
 
 			ImGui::End();
 
+			if (showMemoryWindow)
+			{
+				auto manager = BufferManager::Instance();
+
+				ImGui::SetNextWindowPos(ImVec2(250, 0), ImGuiSetCond_FirstUseEver);
+				ImGui::Begin("Memory", &showMemoryWindow, ImVec2(420, 220), 1.0f,
+					ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_ShowBorders | ImGuiWindowFlags_NoCollapse);
+
+				ImGui::Columns(4, "memory_columns");
+				ImGui::Text("Category"); ImGui::NextColumn();
+				ImGui::Text("Current mb"); ImGui::NextColumn();
+				ImGui::Text("Peak mb"); ImGui::NextColumn();
+				ImGui::Text("Budget"); ImGui::NextColumn();
+				ImGui::Separator();
+
+				for (unsigned int i = 0; i < (unsigned int)MemoryCategory::LENGTH; i++)
+				{
+					auto category = (MemoryCategory)i;
+					auto current = manager->GetMemory(category);
+					auto budget = manager->GetBudget(category);
+
+					ImGui::Text("%s", EnumUtil::MemoryCategoryToString(category).c_str()); ImGui::NextColumn();
+					ImGui::Text("%.2f", current / 1000000.0); ImGui::NextColumn();
+					ImGui::Text("%.2f", manager->GetPeakMemory(category) / 1000000.0); ImGui::NextColumn();
+
+					if (budget > 0)
+						ImGui::ProgressBar((float)((double)current / budget), ImVec2(-1, 0));
+					else
+						ImGui::Text("-");
+					ImGui::NextColumn();
+				}
+
+				ImGui::Columns(1);
+				ImGui::Separator();
+
+				if (ImGui::Button("Reset Peaks"))
+					manager->ResetPeaks();
+
+				ImGui::SameLine();
+
+				if (ImGui::Button("Dump To Log"))
+				{
+					std::ostringstream stream;
+					manager->Dump(stream);
+					FURYI << "Memory:\n" << stream.str();
+				}
+
+				ImGui::End();
+			}
+
 			if (showShadowBufferWindow)
 			{
 				ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x - 300, ImGui::GetIO().DisplaySize.y - 300), ImGuiSetCond_FirstUseEver);
@@ -527,27 +606,27 @@ namespace fury
 					auto render = RenderUtil::Instance();
 
 					blitShader->Bind();
-					blitShader->BindMatrix("matrix", dirMatrices[0]);
+					blitShader->BindMatrix(FURY_NAME("matrix"), dirMatrices[0]);
 					render->Blit(ptr, img0, blitShader);
 
 					blitShader->Bind();
-					blitShader->BindMatrix("matrix", dirMatrices[1]);
+					blitShader->BindMatrix(FURY_NAME("matrix"), dirMatrices[1]);
 					render->Blit(ptr, img1, blitShader);
 
 					blitShader->Bind();
-					blitShader->BindMatrix("matrix", dirMatrices[2]);
+					blitShader->BindMatrix(FURY_NAME("matrix"), dirMatrices[2]);
 					render->Blit(ptr, img2, blitShader);
 
 					blitShader->Bind();
-					blitShader->BindMatrix("matrix", dirMatrices[3]);
+					blitShader->BindMatrix(FURY_NAME("matrix"), dirMatrices[3]);
 					render->Blit(ptr, img3, blitShader);
 
 					blitShader->Bind();
-					blitShader->BindMatrix("matrix", dirMatrices[4]);
+					blitShader->BindMatrix(FURY_NAME("matrix"), dirMatrices[4]);
 					render->Blit(ptr, img4, blitShader);
 
 					blitShader->Bind();
-					blitShader->BindMatrix("matrix", dirMatrices[5]);
+					blitShader->BindMatrix(FURY_NAME("matrix"), dirMatrices[5]);
 					render->Blit(ptr, img5, blitShader);
 
 					ImGui::Text("CubeTexture Buffer: ");
@@ -604,19 +683,19 @@ namespace fury
 					auto render = RenderUtil::Instance();
 
 					blitShader->Bind();
-					blitShader->BindFloat("index", 0);
+					blitShader->BindFloat(FURY_NAME("index"), 0);
 					render->Blit(ptr, img0, blitShader);
 
 					blitShader->Bind();
-					blitShader->BindFloat("index", 1);
+					blitShader->BindFloat(FURY_NAME("index"), 1);
 					render->Blit(ptr, img1, blitShader);
 
 					blitShader->Bind();
-					blitShader->BindFloat("index", 2);
+					blitShader->BindFloat(FURY_NAME("index"), 2);
 					render->Blit(ptr, img2, blitShader);
 
 					blitShader->Bind();
-					blitShader->BindFloat("index", 3);
+					blitShader->BindFloat(FURY_NAME("index"), 3);
 					render->Blit(ptr, img3, blitShader);
 
 					ImGui::Text("ArrayTexture Buffer: ");
@@ -645,19 +724,19 @@ namespace fury
 				ImVec2 imgSize(ImGui::GetIO().DisplaySize.x / 4, ImGui::GetIO().DisplaySize.y / 4);
 
 				ImGui::Text("Depth Buffer: ");
-				if (auto ptr = Pipeline::Active->GetTextureByName("gbuffer_depth"))
+				if (auto ptr = Pipeline::Active->GetTextureByName(FURY_NAME("gbuffer_depth")))
 					ImGui::Image((ImTextureID)ptr->GetID(), imgSize, ImVec2(0, 1), ImVec2(1, 0));
 
 				ImGui::Text("Normal Buffer: ");
-				if (auto ptr = Pipeline::Active->GetTextureByName("gbuffer_normal"))
+				if (auto ptr = Pipeline::Active->GetTextureByName(FURY_NAME("gbuffer_normal")))
 					ImGui::Image((ImTextureID)ptr->GetID(), imgSize, ImVec2(0, 1), ImVec2(1, 0));
 
 				ImGui::Text("Diffuse Buffer: ");
-				if (auto ptr = Pipeline::Active->GetTextureByName("gbuffer_diffuse"))
+				if (auto ptr = Pipeline::Active->GetTextureByName(FURY_NAME("gbuffer_diffuse")))
 					ImGui::Image((ImTextureID)ptr->GetID(), imgSize, ImVec2(0, 1), ImVec2(1, 0));
 
 				ImGui::Text("Light Buffer: ");
-				if (auto ptr = Pipeline::Active->GetTextureByName("gbuffer_light"))
+				if (auto ptr = Pipeline::Active->GetTextureByName(FURY_NAME("gbuffer_light")))
 					ImGui::Image((ImTextureID)ptr->GetID(), imgSize, ImVec2(0, 1), ImVec2(1, 0));
 
 				ImGui::End();
@@ -0,0 +1,455 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <tuple>
+
+#include "Fury/HLOD.h"
+#include "Fury/FileUtil.h"
+#include "Fury/Log.h"
+#include "Fury/Material.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/MeshUtil.h"
+#include "Fury/Scene.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Texture.h"
+#include "Fury/Uniform.h"
+
+namespace fury
+{
+	HLOD::Ptr HLOD::Create()
+	{
+		return std::make_shared<HLOD>();
+	}
+
+	HLOD::~HLOD()
+	{
+		Clear();
+	}
+
+	unsigned int HLOD::Build(const std::shared_ptr<SceneNode> &root, float cellSize, float switchDistance, const Options &options)
+	{
+		if (cellSize <= 0.0f)
+		{
+			FURYE << "HLOD cell size must be positive!";
+			return 0;
+		}
+
+		Clear();
+
+		// ordered, so cluster indices don't depend on hashing.
+		std::map<std::tuple<int, int, int>, std::vector<std::shared_ptr<SceneNode>>> cells;
+
+		std::vector<std::shared_ptr<SceneNode>> stack(1, root);
+		while (!stack.empty())
+		{
+			auto node = stack.back();
+			stack.pop_back();
+
+			for (unsigned int i = 0; i < node->GetChildCount(); i++)
+				stack.push_back(node->GetChildAt(i));
+
+			if (!IsMergeable(*node))
+				continue;
+
+			Vector4 center = node->GetWorldAABB().GetCenter();
+			auto key = std::make_tuple((int)std::floor(center.x / cellSize), (int)std::floor(center.y / cellSize),
+				(int)std::floor(center.z / cellSize));
+			cells[key].push_back(node);
+		}
+
+		unsigned int count = 0;
+		for (const auto &pair : cells)
+		{
+			if (pair.second.size() < std::max(1u, options.minNodes))
+				continue;
+
+			std::string name = "hlod_" + std::to_string(std::get<0>(pair.first)) + "_" +
+				std::to_string(std::get<1>(pair.first)) + "_" + std::to_string(std::get<2>(pair.first));
+
+			if (AddCluster(name, pair.second, switchDistance, root, options) >= 0)
+				count++;
+		}
+
+		FURYI << "HLOD built " << count << " clusters from " << cells.size() << " cells.";
+
+		return count;
+	}
+
+	int HLOD::AddCluster(const std::string &name, const std::vector<std::shared_ptr<SceneNode>> &nodes,
+		float switchDistance, const std::shared_ptr<SceneNode> &parent, const Options &options)
+	{
+		std::vector<std::shared_ptr<SceneNode>> members;
+		std::vector<std::shared_ptr<Material>> materials;
+		for (const auto &node : nodes)
+		{
+			if (!IsMergeable(*node) || m_Proxies.find(node.get()) != m_Proxies.end())
+				continue;
+
+			members.push_back(node);
+
+			auto render = node->GetComponent<MeshRender>();
+			for (unsigned int i = 0; i < render->GetMaterialCount(); i++)
+			{
+				auto material = render->GetMaterial(i);
+				if (std::find(materials.begin(), materials.end(), material) == materials.end())
+					materials.push_back(material);
+			}
+		}
+
+		if (members.empty())
+		{
+			FURYW << "HLOD cluster " << name << " has no static meshes to merge!";
+			return -1;
+		}
+
+		Cluster cluster;
+		cluster.switchDistance = switchDistance;
+		cluster.bounds = BoxBounds(true);
+
+		// one square tile per material.
+		unsigned int tileSize = std::max(4u, options.tileSize);
+		unsigned int tilesPerRow = (unsigned int)std::ceil(std::sqrt((float)materials.size()));
+		cluster.atlasSize = tilesPerRow * tileSize;
+		cluster.pixels.assign(cluster.atlasSize * cluster.atlasSize * 4, 255);
+
+		for (unsigned int i = 0; i < materials.size(); i++)
+			FillTile(materials[i], cluster.pixels, cluster.atlasSize, (i % tilesPerRow) * tileSize, (i / tilesPerRow) * tileSize, tileSize);
+
+		// merge in world space, uvs move into their material's tile. tiled uvs are clamped,
+		// proxies are only seen from far away.
+		std::vector<float> positions, uvs;
+		std::vector<unsigned int> tiles, indices;
+		bool castShadows = false;
+
+		for (const auto &node : members)
+		{
+			auto render = node->GetComponent<MeshRender>();
+			auto mesh = render->GetMesh();
+			Matrix4 worldMatrix = node->GetWorldMatrix();
+
+			cluster.members.push_back(node->GetName());
+			cluster.bounds.Encapsulate(node->GetWorldAABB());
+			castShadows = castShadows || mesh->GetCastShadows();
+
+			bool evicted = !mesh->IsCPUDataResident();
+			mesh->RestoreCPUData();
+
+			const auto &srcPositions = mesh->Positions.Data;
+			const auto &srcUVs = mesh->UVs.Data;
+			unsigned int numVertices = srcPositions.size() / 3;
+			bool hasUV = srcUVs.size() == numVertices * 2;
+
+			unsigned int subMeshCount = std::max(1u, mesh->GetSubMeshCount());
+			for (unsigned int s = 0; s < subMeshCount; s++)
+			{
+				const auto &srcIndices = mesh->GetSubMeshCount() > 0 ? mesh->GetSubMeshAt(s)->Indices.Data : mesh->Indices.Data;
+
+				unsigned int tile = std::find(materials.begin(), materials.end(), render->GetMaterial(s)) - materials.begin();
+				float tileU = (float)((tile % tilesPerRow) * tileSize), tileV = (float)((tile / tilesPerRow) * tileSize);
+
+				// submeshes sharing a vertex with another material get their own copy.
+				std::vector<int> remap(numVertices, -1);
+				for (auto index : srcIndices)
+				{
+					if (remap[index] < 0)
+					{
+						remap[index] = tiles.size();
+
+						Vector4 position = worldMatrix.Multiply(Vector4(srcPositions[index * 3], srcPositions[index * 3 + 1], srcPositions[index * 3 + 2], 1.0f));
+						positions.push_back(position.x);
+						positions.push_back(position.y);
+						positions.push_back(position.z);
+
+						float u = hasUV ? std::min(1.0f, std::max(0.0f, srcUVs[index * 2])) : 0.5f;
+						float v = hasUV ? std::min(1.0f, std::max(0.0f, srcUVs[index * 2 + 1])) : 0.5f;
+
+						// half a texel inset so bilinear filtering doesn't bleed into the next tile.
+						uvs.push_back((tileU + 0.5f + u * (tileSize - 1)) / cluster.atlasSize);
+						uvs.push_back((tileV + 0.5f + v * (tileSize - 1)) / cluster.atlasSize);
+
+						tiles.push_back(tile);
+					}
+					indices.push_back(remap[index]);
+				}
+			}
+
+			if (evicted)
+				mesh->EvictCPUData();
+		}
+
+		unsigned int srcTriangles = indices.size() / 3;
+
+		// vertex clustering: vertices of a material sharing a grid cell collapse into their average,
+		// triangles losing an edge are dropped.
+		if (options.simplifyCellSize > 0.0f)
+		{
+			Vector4 min = cluster.bounds.GetMin();
+			float invCell = 1.0f / options.simplifyCellSize;
+			Vector4 size = cluster.bounds.GetSize();
+			uint64_t nx = (uint64_t)(size.x * invCell) + 1, ny = (uint64_t)(size.y * invCell) + 1, nz = (uint64_t)(size.z * invCell) + 1;
+
+			std::unordered_map<uint64_t, unsigned int> cells;
+			std::vector<unsigned int> remap(tiles.size());
+			std::vector<float> sums;
+			std::vector<unsigned int> counts, newTiles;
+
+			for (unsigned int i = 0; i < tiles.size(); i++)
+			{
+				uint64_t x = std::min(nx - 1, (uint64_t)std::max(0.0f, (positions[i * 3] - min.x) * invCell));
+				uint64_t y = std::min(ny - 1, (uint64_t)std::max(0.0f, (positions[i * 3 + 1] - min.y) * invCell));
+				uint64_t z = std::min(nz - 1, (uint64_t)std::max(0.0f, (positions[i * 3 + 2] - min.z) * invCell));
+				uint64_t key = ((tiles[i] * nz + z) * ny + y) * nx + x;
+
+				auto it = cells.find(key);
+				unsigned int target;
+				if (it == cells.end())
+				{
+					target = counts.size();
+					cells.emplace(key, target);
+					sums.resize(sums.size() + 5, 0.0f);
+					counts.push_back(0);
+					newTiles.push_back(tiles[i]);
+				}
+				else
+				{
+					target = it->second;
+				}
+
+				remap[i] = target;
+				counts[target]++;
+				for (unsigned int c = 0; c < 3; c++)
+					sums[target * 5 + c] += positions[i * 3 + c];
+				for (unsigned int c = 0; c < 2; c++)
+					sums[target * 5 + 3 + c] += uvs[i * 2 + c];
+			}
+
+			positions.resize(counts.size() * 3);
+			uvs.resize(counts.size() * 2);
+			for (unsigned int i = 0; i < counts.size(); i++)
+			{
+				float inv = 1.0f / counts[i];
+				for (unsigned int c = 0; c < 3; c++)
+					positions[i * 3 + c] = sums[i * 5 + c] * inv;
+				for (unsigned int c = 0; c < 2; c++)
+					uvs[i * 2 + c] = sums[i * 5 + 3 + c] * inv;
+			}
+			tiles.swap(newTiles);
+
+			unsigned int kept = 0;
+			for (unsigned int i = 0; i + 2 < indices.size(); i += 3)
+			{
+				unsigned int a = remap[indices[i]], b = remap[indices[i + 1]], c = remap[indices[i + 2]];
+				if (a == b || b == c || a == c)
+					continue;
+
+				indices[kept++] = a;
+				indices[kept++] = b;
+				indices[kept++] = c;
+			}
+			indices.resize(kept);
+		}
+
+		if (indices.empty())
+		{
+			FURYW << "HLOD cluster " << name << " simplified to nothing!";
+			return -1;
+		}
+
+		auto mesh = Mesh::Create(name);
+		mesh->Positions.Data.swap(positions);
+		mesh->UVs.Data.swap(uvs);
+		mesh->Indices.Data.swap(indices);
+		mesh->SetStatic(true);
+		mesh->SetCastShadows(castShadows);
+		MeshUtil::CalculateNormal(mesh);
+		mesh->CalculateAABB();
+
+		// average albedo stands in until the atlas is uploaded.
+		float average[3] = { 0.0f, 0.0f, 0.0f };
+		unsigned int numPixels = cluster.atlasSize * cluster.atlasSize;
+		for (unsigned int i = 0; i < numPixels; i++)
+		{
+			for (unsigned int c = 0; c < 3; c++)
+				average[c] += cluster.pixels[i * 4 + c];
+		}
+
+		auto material = Material::Create(name);
+		material->SetUniform(Material::DIFFUSE_FACTOR, Uniform1f::Create({ 1.0f }));
+		material->SetUniform(Material::DIFFUSE_COLOR, Uniform3f::Create({ average[0] / (numPixels * 255.0f),
+			average[1] / (numPixels * 255.0f), average[2] / (numPixels * 255.0f) }));
+
+		auto proxy = SceneNode::Create(name);
+		proxy->AddComponent(MeshRender::Create(material, mesh));
+		if (parent != nullptr)
+			parent->AddChild(proxy);
+		proxy->Recompose(true);
+
+		cluster.proxy = proxy;
+		cluster.mesh = mesh;
+		cluster.material = material;
+
+		unsigned int index = m_Clusters.size();
+		for (const auto &member : members)
+		{
+			auto &entry = m_Members[member.get()];
+			entry.node = member;
+			entry.cluster = index;
+		}
+		m_Proxies[proxy.get()] = index;
+
+		FURYD << "HLOD cluster " << name << " [nodes: " << members.size() << " materials: " << materials.size() <<
+			" tris: " << srcTriangles << " -> " << mesh->Indices.Data.size() / 3 << "]";
+
+		m_Clusters.push_back(std::move(cluster));
+
+		return index;
+	}
+
+	void HLOD::UpdateBuffer()
+	{
+		for (auto &cluster : m_Clusters)
+		{
+			if (cluster.pixels.empty())
+				continue;
+
+			cluster.atlas = Texture::Create(cluster.proxy->GetName() + "_atlas");
+			cluster.atlas->SetWrapMode(WrapMode::CLAMP_TO_EDGE);
+			cluster.atlas->CreateFromPixels("", cluster.pixels, cluster.atlasSize, cluster.atlasSize, 4, true, true);
+			cluster.material->SetTexture(Material::DIFFUSE_TEXTURE, cluster.atlas);
+			cluster.material->SetUniform(Material::DIFFUSE_COLOR, Uniform3f::Create({ 1.0f, 1.0f, 1.0f }));
+
+			std::vector<unsigned char>().swap(cluster.pixels);
+		}
+	}
+
+	void HLOD::Clear()
+	{
+		for (auto &cluster : m_Clusters)
+			cluster.proxy->RemoveFromParent();
+
+		m_Clusters.clear();
+		m_Members.clear();
+		m_Proxies.clear();
+	}
+
+	unsigned int HLOD::GetClusterCount() const
+	{
+		return m_Clusters.size();
+	}
+
+	std::shared_ptr<SceneNode> HLOD::GetProxy(unsigned int cluster) const
+	{
+		return cluster < m_Clusters.size() ? m_Clusters[cluster].proxy : nullptr;
+	}
+
+	BoxBounds HLOD::GetClusterBounds(unsigned int cluster) const
+	{
+		return cluster < m_Clusters.size() ? m_Clusters[cluster].bounds : BoxBounds();
+	}
+
+	unsigned int HLOD::GetMemberCount(unsigned int cluster) const
+	{
+		return cluster < m_Clusters.size() ? m_Clusters[cluster].members.size() : 0;
+	}
+
+	int HLOD::GetClusterIndex(const SceneNode &sceneNode, bool &proxy) const
+	{
+		const SceneNode *source = sceneNode.GetRenderSource();
+
+		auto it = m_Members.find(source);
+		if (it != m_Members.end() && !it->second.node.expired())
+		{
+			proxy = false;
+			return it->second.cluster;
+		}
+
+		auto proxyIt = m_Proxies.find(source);
+		if (proxyIt != m_Proxies.end())
+		{
+			proxy = true;
+			return proxyIt->second;
+		}
+
+		return -1;
+	}
+
+	bool HLOD::IsFar(unsigned int cluster, Vector4 viewer) const
+	{
+		const Cluster &target = m_Clusters[cluster];
+		return target.bounds.GetDistance(viewer) > target.switchDistance;
+	}
+
+	bool HLOD::IsMergeable(const SceneNode &sceneNode)
+	{
+		auto render = sceneNode.GetComponent<MeshRender>();
+		if (render == nullptr || !render->GetRenderable())
+			return false;
+
+		auto mesh = render->GetMesh();
+		return mesh->GetStatic() && !mesh->IsSkinnedMesh();
+	}
+
+	void HLOD::FillTile(const std::shared_ptr<Material> &material, std::vector<unsigned char> &pixels,
+		unsigned int atlasSize, unsigned int x, unsigned int y, unsigned int tileSize)
+	{
+		std::vector<unsigned char> source;
+		int width = 0, height = 0, channels = 0;
+
+		auto texture = material != nullptr ? material->GetTexture(Material::DIFFUSE_TEXTURE) : nullptr;
+		if (texture != nullptr && !texture->GetFilePath().empty())
+			FileUtil::LoadImage(Scene::Path(texture->GetFilePath()), source, width, height, channels);
+
+		if (source.empty())
+		{
+			// untextured, use the diffuse color.
+			unsigned char color[3] = { 255, 255, 255 };
+			auto uniform = material != nullptr ? std::dynamic_pointer_cast<Uniform3f>(material->GetUniform(Material::DIFFUSE_COLOR)) : nullptr;
+			if (uniform != nullptr)
+			{
+				for (unsigned int c = 0; c < 3; c++)
+					color[c] = (unsigned char)(std::min(1.0f, std::max(0.0f, uniform->GetDataAt(c))) * 255.0f + 0.5f);
+			}
+
+			for (unsigned int ty = 0; ty < tileSize; ty++)
+			{
+				for (unsigned int tx = 0; tx < tileSize; tx++)
+				{
+					unsigned char* dest = &pixels[((y + ty) * atlasSize + x + tx) * 4];
+					dest[0] = color[0];
+					dest[1] = color[1];
+					dest[2] = color[2];
+					dest[3] = 255;
+				}
+			}
+			return;
+		}
+
+		// box filter, each tile texel averages the source texels it covers.
+		for (unsigned int ty = 0; ty < tileSize; ty++)
+		{
+			int y0 = ty * height / tileSize, y1 = std::max(y0 + 1, (int)((ty + 1) * height / tileSize));
+			for (unsigned int tx = 0; tx < tileSize; tx++)
+			{
+				int x0 = tx * width / tileSize, x1 = std::max(x0 + 1, (int)((tx + 1) * width / tileSize));
+
+				unsigned int sum[4] = { 0, 0, 0, 0 };
+				for (int sy = y0; sy < y1; sy++)
+				{
+					for (int sx = x0; sx < x1; sx++)
+					{
+						const unsigned char* src = &source[(sy * width + sx) * channels];
+						for (int c = 0; c < 3; c++)
+							sum[c] += src[std::min(c, channels - 1)];
+						sum[3] += channels == 4 ? src[3] : 255;
+					}
+				}
+
+				unsigned int count = (y1 - y0) * (x1 - x0);
+				unsigned char* dest = &pixels[((y + ty) * atlasSize + x + tx) * 4];
+				for (unsigned int c = 0; c < 4; c++)
+					dest[c] = (unsigned char)(sum[c] / count);
+			}
+		}
+	}
+}
@@ -0,0 +1,142 @@
+#ifndef _FURY_HLOD_H_
+#define _FURY_HLOD_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Fury/BoxBounds.h"
+
+namespace fury
+{
+	class Material;
+
+	class Mesh;
+
+	class SceneNode;
+
+	class Texture;
+
+	// hierarchical lod: clusters of static mesh nodes are merged into one simplified proxy node
+	// with a single atlased material. a scene manager with this set draws the proxy instead of the
+	// cluster's nodes once the viewer is beyond the cluster's switch distance, see SceneManager::SetHLOD.
+	// members and proxies are identified by node, RenderFrame proxies by their live node.
+	// building makes no gl calls, the atlases are uploaded by UpdateBuffer.
+	class FURY_API HLOD
+	{
+	public:
+
+		typedef std::shared_ptr<HLOD> Ptr;
+
+		static Ptr Create();
+
+		class Options
+		{
+		public:
+
+			// edge of the vertex clustering grid in world units, 0 keeps all vertices.
+			float simplifyCellSize;
+
+			// pixels per material in the atlas.
+			unsigned int tileSize;
+
+			// smaller clusters aren't worth a proxy.
+			unsigned int minNodes;
+
+			Options() : simplifyCellSize(0.0f), tileSize(64), minNodes(2) {}
+		};
+
+	protected:
+
+		class Cluster
+		{
+		public:
+
+			BoxBounds bounds;
+
+			float switchDistance = 0.0f;
+
+			std::vector<std::string> members;
+
+			std::shared_ptr<SceneNode> proxy;
+
+			// the proxy's render only keeps weak pointers.
+			std::shared_ptr<Mesh> mesh;
+
+			std::shared_ptr<Material> material;
+
+			std::shared_ptr<Texture> atlas;
+
+			// rgba8, released once uploaded.
+			std::vector<unsigned char> pixels;
+
+			unsigned int atlasSize = 0;
+		};
+
+		class Member
+		{
+		public:
+
+			// a destroyed member's address may be reused by an unrelated node.
+			std::weak_ptr<SceneNode> node;
+
+			unsigned int cluster = 0;
+		};
+
+		std::vector<Cluster> m_Clusters;
+
+		// keyed by node address, names needn't be unique.
+		std::unordered_map<const SceneNode*, Member> m_Members;
+
+		// proxy node to cluster index, clusters own their proxies.
+		std::unordered_map<const SceneNode*, unsigned int> m_Proxies;
+
+	public:
+
+		virtual ~HLOD();
+
+		// groups the static mesh nodes under root by the grid cell of their world aabb center,
+		// proxies become root's children. clusters built before are cleared first, so their
+		// proxies aren't merged again. returns the number of clusters built.
+		// add the proxies to the scene manager afterwards, see GetProxy.
+		unsigned int Build(const std::shared_ptr<SceneNode> &root, float cellSize, float switchDistance,
+			const Options &options = Options());
+
+		// authored cluster, merges nodes' static meshes into a proxy named name under parent,
+		// proxies of existing clusters are skipped. returns the cluster index, -1 if there's nothing to merge.
+		int AddCluster(const std::string &name, const std::vector<std::shared_ptr<SceneNode>> &nodes,
+			float switchDistance, const std::shared_ptr<SceneNode> &parent, const Options &options = Options());
+
+		// creates the atlas textures, gl thread only.
+		void UpdateBuffer();
+
+		// removes the proxies from their parents.
+		void Clear();
+
+		unsigned int GetClusterCount() const;
+
+		std::shared_ptr<SceneNode> GetProxy(unsigned int cluster) const;
+
+		BoxBounds GetClusterBounds(unsigned int cluster) const;
+
+		unsigned int GetMemberCount(unsigned int cluster) const;
+
+		// -1 for nodes in no cluster, proxy tells members and proxies apart.
+		// RenderFrame proxies resolve to their live node's cluster.
+		int GetClusterIndex(const SceneNode &sceneNode, bool &proxy) const;
+
+		// true if viewer is farther than the cluster's switch distance from its bounds.
+		bool IsFar(unsigned int cluster, Vector4 viewer) const;
+
+	protected:
+
+		static bool IsMergeable(const SceneNode &sceneNode);
+
+		// resamples material's diffuse texture, or fills its diffuse color, into a tile.
+		static void FillTile(const std::shared_ptr<Material> &material, std::vector<unsigned char> &pixels,
+			unsigned int atlasSize, unsigned int x, unsigned int y, unsigned int tileSize);
+	};
+}
+
+#endif // _FURY_HLOD_H_
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Fury/Histogram.h"
+
+namespace fury
+{
+	Histogram::Histogram(float bucketWidth, unsigned int bucketCount)
+		: m_Buckets(std::max(bucketCount, 1u), 0), m_BucketWidth(bucketWidth > 0.0f ? bucketWidth : 1.0f)
+	{
+
+	}
+
+	void Histogram::Add(float value)
+	{
+		unsigned int index = m_Buckets.size() - 1;
+		if (value < m_BucketWidth * index)
+			index = value > 0.0f ? (unsigned int)(value / m_BucketWidth) : 0;
+
+		m_Buckets[index]++;
+		m_SampleCount++;
+		m_Sum += value;
+
+		if (value > m_Max)
+			m_Max = value;
+	}
+
+	void Histogram::Clear()
+	{
+		std::fill(m_Buckets.begin(), m_Buckets.end(), 0);
+		m_SampleCount = 0;
+		m_Sum = 0.0;
+		m_Max = 0.0f;
+	}
+
+	unsigned int Histogram::GetSampleCount() const
+	{
+		return m_SampleCount;
+	}
+
+	unsigned int Histogram::GetBucketCount() const
+	{
+		return m_Buckets.size();
+	}
+
+	float Histogram::GetBucketWidth() const
+	{
+		return m_BucketWidth;
+	}
+
+	unsigned int Histogram::GetBucket(unsigned int index) const
+	{
+		return index < m_Buckets.size() ? m_Buckets[index] : 0;
+	}
+
+	float Histogram::GetMean() const
+	{
+		return m_SampleCount > 0 ? (float)(m_Sum / m_SampleCount) : 0.0f;
+	}
+
+	float Histogram::GetMax() const
+	{
+		return m_Max;
+	}
+
+	float Histogram::GetPercentile(float fraction) const
+	{
+		if (m_SampleCount == 0)
+			return 0.0f;
+
+		unsigned int target = (unsigned int)std::ceil(fraction * m_SampleCount);
+		unsigned int count = 0;
+
+		for (unsigned int i = 0; i < m_Buckets.size() - 1; i++)
+		{
+			count += m_Buckets[i];
+			if (count >= target)
+				return m_BucketWidth * (i + 1);
+		}
+
+		// the overflow bucket has no upper edge.
+		return m_Max;
+	}
+}
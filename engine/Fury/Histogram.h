@@ -0,0 +1,51 @@
+#ifndef _FURY_HISTOGRAM_H_
+#define _FURY_HISTOGRAM_H_
+
+#include <vector>
+
+#include "Macros.h"
+
+namespace fury
+{
+	// counts samples in fixed width buckets starting at 0, samples past the last bucket land in it.
+	// used for frame times, see Engine::GetFrameTimes.
+	class FURY_API Histogram
+	{
+	protected:
+
+		std::vector<unsigned int> m_Buckets;
+
+		float m_BucketWidth;
+
+		unsigned int m_SampleCount = 0;
+
+		double m_Sum = 0.0;
+
+		float m_Max = 0.0f;
+
+	public:
+
+		Histogram(float bucketWidth = 1.0f, unsigned int bucketCount = 64);
+
+		void Add(float value);
+
+		void Clear();
+
+		unsigned int GetSampleCount() const;
+
+		unsigned int GetBucketCount() const;
+
+		float GetBucketWidth() const;
+
+		unsigned int GetBucket(unsigned int index) const;
+
+		float GetMean() const;
+
+		float GetMax() const;
+
+		// upper edge of the bucket holding the given fraction of samples, e.g. 0.99 for the 99th percentile.
+		float GetPercentile(float fraction) const;
+	};
+}
+
+#endif // _FURY_HISTOGRAM_H_
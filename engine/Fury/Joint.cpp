@@ -13,7 +13,7 @@ namespace fury
 
 	std::shared_ptr<Joint> Joint::FindFromRoot(const std::string &name, const std::shared_ptr<Joint> &root)
 	{
-		size_t nameHash = std::hash<std::string>()(name);
+		size_t nameHash = Name(name).GetHash();
 		if (root->m_HashCode == nameHash)
 			return root;
 
@@ -103,7 +103,10 @@ namespace fury
 		ptr->m_OutterAngle = m_OutterAngle;
 		ptr->m_Falloff = m_Falloff;
 		ptr->m_Radius = m_Radius;
+		ptr->m_CastShadows = m_CastShadows;
 		ptr->m_AABB = m_AABB;
+		// the volume only depends on the properties above, share it instead of rebuilding.
+		ptr->m_Mesh = m_Mesh;
 		return ptr;
 	}
 
@@ -11,12 +11,24 @@
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
+#include <thread>
 #include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstdint>
 
 #include "Fury/ThreadUtil.h"
 #include "Fury/Singleton.h"
 
+// records above this level are compiled out, 0 = EROR ... 3 = DBUG.
+#ifndef FURY_LOG_MAX_LEVEL
+#define FURY_LOG_MAX_LEVEL 3
+#endif
+
 namespace fury
 {
 	enum class FURY_API LogLevel : int
@@ -27,6 +39,7 @@ namespace fury
 		DBUG = 3
 	};
 
+	// what formatters see, built on the writer thread.
 	class FURY_API Record
 	{
 	public:
@@ -39,10 +52,13 @@ namespace fury
 
 		size_t line = 0;
 
-		std::stringstream stream;
+		std::thread::id thread;
+
+		bool mainThread = true;
 
-		Record(LogLevel level, const char* function, const char* file, int line)
-			: func(function), file(file), line(line)
+		std::string message;
+
+		void Set(LogLevel level, const char* function, const char* file, int line)
 		{
 			switch (level)
 			{
@@ -60,25 +76,101 @@ namespace fury
 				break;
 			}
 
+			func = function;
 			auto start = func.find(' ') + 1;
 			auto end = func.find('(');
 			func = func.substr(start, end - start);
 
+			this->file = file;
 #ifdef _MSC_VER
 			start = this->file.find_last_of('\\');
 #else
 			start = this->file.find_last_of('/');
 #endif
 			this->file = this->file.substr(start + 1);
+
+			this->line = line;
+		}
+	};
+
+	// the temporary FURYD & co. stream into, formats the message into a per thread string.
+	class FURY_API RecordStream
+	{
+	protected:
+
+		class StringBuf : public std::streambuf
+		{
+		public:
+
+			std::string text;
+
+		protected:
+
+			virtual int_type overflow(int_type c) override
+			{
+				if (c != traits_type::eof())
+					text.push_back((char)c);
+				return c;
+			}
+
+			virtual std::streamsize xsputn(const char* s, std::streamsize n) override
+			{
+				text.append(s, (size_t)n);
+				return n;
+			}
+		};
+
+		class ThreadStream
+		{
+		public:
+
+			StringBuf buffer;
+
+			std::ostream stream;
+
+			std::ios_base::fmtflags flags;
+
+			ThreadStream() : stream(&buffer), flags(stream.flags()) {}
+		};
+
+		static ThreadStream &GetThreadStream()
+		{
+			static thread_local ThreadStream t_Stream;
+			return t_Stream;
+		}
+
+	public:
+
+		LogLevel level;
+
+		const char* func;
+
+		const char* file;
+
+		int line;
+
+		RecordStream(LogLevel level, const char* function, const char* file, int line)
+			: level(level), func(function), file(file), line(line)
+		{
+			auto &stream = GetThreadStream();
+			stream.buffer.text.clear();
+			stream.stream.flags(stream.flags);
+			stream.stream.precision(6);
+			stream.stream.fill(' ');
 		}
 
 		template<typename T>
-		Record& operator << (const T& data)
+		RecordStream& operator << (const T& data)
 		{
-			stream << data;
-			stream.flush();
+			GetThreadStream().stream << data;
 			return *this;
 		}
+
+		// the formatted message, swapped out so the string's capacity gets recycled.
+		std::string &GetText() const
+		{
+			return GetThreadStream().buffer.text;
+		}
 	};
 
 	struct FURY_API Formatter
@@ -87,8 +179,8 @@ namespace fury
 		{
 			stream << "[" << record.level << "]";
 
-			if (!ThreadUtil::Instance()->IsMainThread())
-				stream << "[" << std::this_thread::get_id() << "]";
+			if (!record.mainThread)
+				stream << "[" << record.thread << "]";
 
 			stream << "[" << record.func << "][" << record.line << "]: ";
 		};
@@ -97,8 +189,8 @@ namespace fury
 		{
 			stream << "[" << record.level << "]";
 
-			if (!ThreadUtil::Instance()->IsMainThread())
-				stream << "[" << std::this_thread::get_id() << "]";
+			if (!record.mainThread)
+				stream << "[" << record.thread << "]";
 
 			stream << "[" << record.file << "][" << record.func << "][" << record.line << "]: ";
 		};
@@ -106,17 +198,74 @@ namespace fury
 
 	typedef std::function<void(std::ostream&, const Record&)> LogFormatter;
 
-	// thread safe
+	// thread safe.
+	// each thread pushes into its own lock free ring, a background thread formats the records
+	// and writes them in batches, so logging never waits on io.
 	template<int instance>
 	class FURY_API Log : public Singleton<Log<instance>, LogLevel, const char*, bool, const LogFormatter&, bool>
 	{
 	private:
 
-		std::mutex m_StreamMutex;
+		class Entry
+		{
+		public:
+
+			LogLevel level;
+
+			const char* func;
+
+			const char* file;
+
+			int line;
+
+			std::thread::id thread;
+
+			bool mainThread;
+
+			uint64_t sequence;
+
+			std::string message;
+		};
+
+		// single producer (the owner thread), single consumer (the writer thread).
+		class Buffer
+		{
+		public:
+
+			static const uint64_t Capacity = 1024;
+
+			std::unique_ptr<Entry[]> entries;
+
+			std::atomic<uint64_t> head;
+
+			std::atomic<uint64_t> tail;
+
+			// the owner thread exited, the writer frees the buffer once it's drained.
+			std::atomic<bool> retired;
+
+			Buffer() : entries(new Entry[Capacity]), head(0), tail(0), retired(false) {}
+		};
+
+		class BufferHolder
+		{
+		public:
+
+			std::shared_ptr<Buffer> buffer;
+
+			unsigned int generation = 0;
+
+			~BufferHolder()
+			{
+				if (buffer)
+					buffer->retired.store(true, std::memory_order_release);
+			}
+		};
+
+		static std::atomic<unsigned int> m_NextGeneration;
 
-		std::ostream& m_ConsoleStream = std::cout;
+		unsigned int m_Generation;
 
-		std::ofstream m_FileStream;
+		std::FILE* m_FileStream = nullptr;
 
 		bool m_FileOutput = false;
 
@@ -127,22 +276,55 @@ namespace fury
 
 		LogLevel m_LogLevel = LogLevel::DBUG;
 
+		std::atomic<uint64_t> m_Sequence;
+
+		std::mutex m_BufferMutex;
+
+		std::vector<std::shared_ptr<Buffer>> m_Buffers;
+
+		std::mutex m_WakeMutex;
+
+		std::condition_variable m_WakeCondition;
+
+		std::atomic<bool> m_WakeRequested;
+
+		std::atomic<bool> m_Stop;
+
+		std::thread m_Writer;
+
+		// writer thread only.
+
+		std::vector<Entry*> m_Batch;
+
+		std::vector<std::pair<Buffer*, uint64_t>> m_Drained;
+
+		Record m_Record;
+
+		std::ostringstream m_Text;
+
 	public:
 
 		Log(LogLevel level, const char* logfile, bool console, const LogFormatter &formatter, bool append)
-			: m_LogLevel(level), m_FileOutput(logfile != nullptr), m_ConsoleOutput(console), m_Formatter(formatter)
+			: m_Generation(++m_NextGeneration), m_FileOutput(logfile != nullptr), m_ConsoleOutput(console), m_Formatter(formatter),
+			m_LogLevel(level), m_Sequence(0), m_WakeRequested(false), m_Stop(false)
 		{
 			if (m_FileOutput)
 			{
-				m_FileStream.open(logfile, std::ofstream::out | (append ? std::ostream::app : std::ofstream::trunc));
-				ASSERT_MSG(m_FileStream.good(), "Log file not found!");
+				m_FileStream = std::fopen(logfile, append ? "a" : "w");
+				ASSERT_MSG(m_FileStream != nullptr, "Log file not found!");
 			}
+
+			m_Writer = std::thread([this] { WriterLoop(); });
 		}
 
 		virtual ~Log()
 		{
-			if (m_FileOutput)
-				m_FileStream.close();
+			m_Stop.store(true);
+			Wake();
+			m_Writer.join();
+
+			if (m_FileStream != nullptr)
+				std::fclose(m_FileStream);
 		}
 
 		void SetLevel(LogLevel level)
@@ -155,24 +337,181 @@ namespace fury
 			return m_LogLevel;
 		}
 
-		void operator += (const Record& record)
+		void operator += (const RecordStream& record)
 		{
-			std::lock_guard<std::mutex> lock(m_StreamMutex);
+			Buffer* buffer = GetThreadBuffer();
 
-			if (m_ConsoleOutput)
+			uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+			while (tail - buffer->head.load(std::memory_order_acquire) >= Buffer::Capacity)
 			{
-				m_Formatter(m_ConsoleStream, record);
-				m_ConsoleStream << record.stream.str() << "\n";
+				// full, the writer is behind.
+				Wake();
+				std::this_thread::yield();
 			}
 
-			if (m_FileOutput)
+			Entry &entry = buffer->entries[tail & (Buffer::Capacity - 1)];
+			entry.level = record.level;
+			entry.func = record.func;
+			entry.file = record.file;
+			entry.line = record.line;
+			entry.thread = std::this_thread::get_id();
+			entry.mainThread = ThreadUtil::IsMainThread();
+			entry.sequence = m_Sequence.fetch_add(1, std::memory_order_relaxed);
+			entry.message.swap(record.GetText());
+
+			buffer->tail.store(tail + 1, std::memory_order_release);
+
+			// warnings & errors go out right away, everything else is batched.
+			if (record.level <= LogLevel::WARN || tail + 1 - buffer->head.load(std::memory_order_relaxed) > Buffer::Capacity / 2)
+				Wake();
+		}
+
+		// blocks until everything logged so far is written.
+		void Flush()
+		{
+			while (true)
+			{
+				bool empty = true;
+				{
+					std::lock_guard<std::mutex> lock(m_BufferMutex);
+					for (auto &buffer : m_Buffers)
+					{
+						if (buffer->head.load(std::memory_order_acquire) != buffer->tail.load(std::memory_order_acquire))
+						{
+							empty = false;
+							break;
+						}
+					}
+				}
+
+				if (empty)
+					return;
+
+				Wake();
+				std::this_thread::yield();
+			}
+		}
+
+	private:
+
+		Buffer* GetThreadBuffer()
+		{
+			static thread_local BufferHolder t_Holder;
+
+			if (t_Holder.buffer == nullptr || t_Holder.generation != m_Generation)
+			{
+				if (t_Holder.buffer)
+					t_Holder.buffer->retired.store(true, std::memory_order_release);
+
+				t_Holder.buffer = std::make_shared<Buffer>();
+				t_Holder.generation = m_Generation;
+
+				std::lock_guard<std::mutex> lock(m_BufferMutex);
+				m_Buffers.push_back(t_Holder.buffer);
+			}
+
+			return t_Holder.buffer.get();
+		}
+
+		void Wake()
+		{
+			if (!m_WakeRequested.exchange(true))
+			{
+				std::lock_guard<std::mutex> lock(m_WakeMutex);
+				m_WakeCondition.notify_one();
+			}
+		}
+
+		void WriterLoop()
+		{
+			while (true)
+			{
+				bool stop = m_Stop.load();
+
+				if (Drain() > 0)
+					continue;
+
+				if (stop)
+					return;
+
+				std::unique_lock<std::mutex> lock(m_WakeMutex);
+				m_WakeCondition.wait_for(lock, std::chrono::milliseconds(10), [this] { return m_WakeRequested.load(); });
+				m_WakeRequested.store(false);
+			}
+		}
+
+		size_t Drain()
+		{
+			std::lock_guard<std::mutex> lock(m_BufferMutex);
+
+			m_Batch.clear();
+			m_Drained.clear();
+
+			for (auto &buffer : m_Buffers)
 			{
-				m_Formatter(m_FileStream, record);
-				m_FileStream << record.stream.str() << "\n";
-				m_FileStream.flush();
+				uint64_t head = buffer->head.load(std::memory_order_relaxed);
+				uint64_t tail = buffer->tail.load(std::memory_order_acquire);
+				for (uint64_t i = head; i < tail; i++)
+					m_Batch.push_back(&buffer->entries[i & (Buffer::Capacity - 1)]);
+
+				if (tail != head)
+					m_Drained.emplace_back(buffer.get(), tail);
 			}
+
+			// keep the global order across threads.
+			std::sort(m_Batch.begin(), m_Batch.end(), [](const Entry* a, const Entry* b)
+			{
+				return a->sequence < b->sequence;
+			});
+
+			m_Text.str("");
+			for (auto entry : m_Batch)
+			{
+				m_Record.Set(entry->level, entry->func, entry->file, entry->line);
+				m_Record.thread = entry->thread;
+				m_Record.mainThread = entry->mainThread;
+				m_Record.message.swap(entry->message);
+
+				m_Formatter(m_Text, m_Record);
+				m_Text << m_Record.message << "\n";
+
+				// hand the capacity back to the producer.
+				m_Record.message.swap(entry->message);
+			}
+
+			for (auto &pair : m_Drained)
+				pair.first->head.store(pair.second, std::memory_order_release);
+
+			// free buffers of threads that are gone.
+			m_Buffers.erase(std::remove_if(m_Buffers.begin(), m_Buffers.end(), [](const std::shared_ptr<Buffer> &buffer)
+			{
+				return buffer->retired.load(std::memory_order_acquire) &&
+					buffer->head.load(std::memory_order_relaxed) == buffer->tail.load(std::memory_order_acquire);
+			}), m_Buffers.end());
+
+			if (!m_Batch.empty())
+			{
+				auto text = m_Text.str();
+
+				if (m_ConsoleOutput)
+				{
+					std::fwrite(text.data(), 1, text.size(), stdout);
+					std::fflush(stdout);
+				}
+
+				if (m_FileStream != nullptr)
+				{
+					std::fwrite(text.data(), 1, text.size(), m_FileStream);
+					std::fflush(m_FileStream);
+				}
+			}
+
+			return m_Batch.size();
 		}
 	};
+
+	template<int instance>
+	std::atomic<unsigned int> Log<instance>::m_NextGeneration(0);
 }
 
 #ifdef _MSC_VER
@@ -181,8 +520,8 @@ namespace fury
 #define FURY_FUNC_NAME __PRETTY_FUNCTION__
 #endif
 
-#define FURY_LOG_IF(instance, level)	if (fury::Log<instance>::Instance() && level <= fury::Log<instance>::Instance()->GetLevel())
-#define FURY_LOG(instance, level) 		FURY_LOG_IF(instance, level) *fury::Log<instance>::Instance() += fury::Record(level, FURY_FUNC_NAME, __FILE__, __LINE__)
+#define FURY_LOG_IF(instance, level)	if ((int)(level) <= FURY_LOG_MAX_LEVEL && fury::Log<instance>::Instance() && level <= fury::Log<instance>::Instance()->GetLevel())
+#define FURY_LOG(instance, level) 		FURY_LOG_IF(instance, level) *fury::Log<instance>::Instance() += fury::RecordStream(level, FURY_FUNC_NAME, __FILE__, __LINE__)
 
 #define FURY_DEBUG(instance) 			FURY_LOG(instance, fury::LogLevel::DBUG)
 #define FURY_INFO(instance) 			FURY_LOG(instance, fury::LogLevel::INFO)
@@ -199,4 +538,4 @@ namespace fury
 #define FURYW							FURYW_(0)
 #define FURYE 							FURYE_(0)
 
-#endif // _FURY_LOG_H_
\ No newline at end of file
+#endif // _FURY_LOG_H_
@@ -38,4 +38,9 @@ do {} while (false)
 
 #define FURY_MIPMAP_LEVEL 5
 
+// sse intrinsics are available, include <xmmintrin.h> where they're used.
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define FURY_SSE
+#endif
+
 #endif // _FURY_MACROS_H_
\ No newline at end of file
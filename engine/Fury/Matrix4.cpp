@@ -8,11 +8,11 @@
 
 namespace fury
 {
-	std::string Matrix4::PROJECTION_MATRIX = "projection_matrix";
+	constexpr Name Matrix4::PROJECTION_MATRIX;
 
-	std::string Matrix4::INVERT_VIEW_MATRIX = "invert_view_matrix";
+	constexpr Name Matrix4::INVERT_VIEW_MATRIX;
 
-	std::string Matrix4::WORLD_MATRIX = "world_matrix";
+	constexpr Name Matrix4::WORLD_MATRIX;
 	
 	Matrix4::Matrix4()
 	{
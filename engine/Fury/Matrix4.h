@@ -5,6 +5,7 @@
 #include <initializer_list>
 
 #include "Macros.h"
+#include "Fury/Name.h"
 
 namespace fury
 {
@@ -27,11 +28,11 @@ namespace fury
 	{
 	public:
 
-		static std::string PROJECTION_MATRIX;
+		static constexpr Name PROJECTION_MATRIX = Name("projection_matrix");
 
-		static std::string INVERT_VIEW_MATRIX;
+		static constexpr Name INVERT_VIEW_MATRIX = Name("invert_view_matrix");
 
-		static std::string WORLD_MATRIX;
+		static constexpr Name WORLD_MATRIX = Name("world_matrix");
 
 		float Raw[16];
 
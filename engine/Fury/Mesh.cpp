@@ -1,8 +1,11 @@
+#include <algorithm>
+#include <cmath>
 #include <stack>
 
 #include "Fury/Log.h"
 #include "Fury/GLLoader.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshBVH.h"
 #include "Fury/SceneNode.h"
 #include "Fury/Joint.h"
 
@@ -63,7 +66,8 @@ namespace fury
 
 	void SubMesh::DeleteRawData()
 	{
-		Indices.Data.clear();
+		// the index count is still needed to draw, so keep the compressed copy.
+		Indices.EvictData();
 	}
 
 	std::type_index SubMesh::GetTypeIndex() const
@@ -107,6 +111,8 @@ namespace fury
 		if (!Entity::Load(wrapper, false))
 			return false;
 
+		ClearBVH();
+
 		if (!LoadArray(wrapper, "positions", Positions.Data))
 		{
 			FURYE << "positions not found!";
@@ -128,9 +134,11 @@ namespace fury
 		}
 
 		LoadMemberValue(wrapper, "cast_shadows", m_CastShadows);
+		LoadMemberValue(wrapper, "static", m_Static);
 
 		// model aabb
 		LoadMemberValue(wrapper, "aabb", m_AABB);
+		CalculateBSphere();
 
 		// subMeshes
 		if (!LoadArray(wrapper, "submeshes", [&](const void* node) -> bool
@@ -160,9 +168,15 @@ namespace fury
 
 		Entity::Save(wrapper, false);
 
+		bool evicted = !IsCPUDataResident();
+		RestoreCPUData();
+
 		SaveKey(wrapper, "cast_shadows");
 		SaveValue(wrapper, m_CastShadows);
 
+		SaveKey(wrapper, "static");
+		SaveValue(wrapper, m_Static);
+
 		SaveKey(wrapper, "positions");
 		SaveArray(wrapper, Positions.Data);
 
@@ -198,6 +212,9 @@ namespace fury
 		SaveKey(wrapper, "aabb");
 		SaveValue(wrapper, m_AABB);
 
+		if (evicted)
+			EvictCPUData();
+
 		if (object)
 			EndObject(wrapper);
 	}
@@ -280,6 +297,9 @@ namespace fury
 			for (auto subMesh : m_SubMeshes)
 				if (subMesh != nullptr)
 					subMesh->UpdateBuffer();
+
+			if (m_Static && !m_Dirty)
+				EvictCPUData();
 		}
 	}
 
@@ -308,10 +328,14 @@ namespace fury
 	void Mesh::CalculateAABB(const Vector4& min, const Vector4& max)
 	{
 		m_AABB.SetMinMax(min, max);
+		m_BSphere.SetCenterRadius(m_AABB.GetCenter(), (max - min).Length() * 0.5f);
 	}
 
 	void Mesh::CalculateAABB()
 	{
+		bool evicted = !IsCPUDataResident();
+		RestoreCPUData();
+
 		m_AABB.SetDirty(true);
 
 		if (IsSkinnedMesh())
@@ -356,6 +380,11 @@ namespace fury
 					Positions.Data[index + 2], 1.0f));
 			}
 		}
+
+		CalculateBSphere();
+
+		if (evicted)
+			EvictCPUData();
 	}
 
 	BoxBounds Mesh::GetAABB() const
@@ -363,6 +392,77 @@ namespace fury
 		return m_AABB;
 	}
 
+	SphereBounds Mesh::GetBSphere() const
+	{
+		return m_BSphere;
+	}
+
+	void Mesh::CalculateBSphere()
+	{
+		// the aabb already covers the current pose of skinned meshes, and evicted data isn't worth restoring.
+		unsigned int count = Positions.Data.size() / 3;
+		if (IsSkinnedMesh() || count == 0)
+		{
+			Vector4 min = m_AABB.GetMin(), max = m_AABB.GetMax();
+			m_BSphere.SetCenterRadius(m_AABB.GetCenter(), (max - min).Length() * 0.5f);
+			return;
+		}
+
+		const float* positions = &Positions.Data[0];
+		auto GetPosition = [positions](unsigned int index) -> Vector4
+		{
+			return Vector4(positions[index * 3], positions[index * 3 + 1], positions[index * 3 + 2], 1.0f);
+		};
+
+		auto GetFarthest = [&](Vector4 from) -> Vector4
+		{
+			Vector4 farthest = from;
+			float maxDistance = 0.0f;
+			for (unsigned int i = 0; i < count; i++)
+			{
+				Vector4 position = GetPosition(i);
+				float distance = (position - from).SquareLength();
+				if (distance > maxDistance)
+				{
+					maxDistance = distance;
+					farthest = position;
+				}
+			}
+			return farthest;
+		};
+
+		// ritter, start from the two points farthest apart along a greedy search and grow for outliers.
+		Vector4 a = GetFarthest(GetPosition(0));
+		Vector4 b = GetFarthest(a);
+		Vector4 center = (a + b) * 0.5f;
+		float radius = (b - a).Length() * 0.5f;
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			Vector4 position = GetPosition(i);
+			float distance = (position - center).Length();
+			if (distance > radius)
+			{
+				float newRadius = (radius + distance) * 0.5f;
+				center = center + (position - center) * ((newRadius - radius) / distance);
+				radius = newRadius;
+			}
+		}
+
+		// the sphere around the aabb center is sometimes tighter, e.g. for boxes.
+		Vector4 boxCenter = m_AABB.GetCenter();
+		float boxRadius = 0.0f;
+		for (unsigned int i = 0; i < count; i++)
+			boxRadius = std::max(boxRadius, (GetPosition(i) - boxCenter).SquareLength());
+		boxRadius = std::sqrt(boxRadius);
+
+		center.w = boxCenter.w = 1.0f;
+		if (boxRadius < radius)
+			m_BSphere.SetCenterRadius(boxCenter, boxRadius);
+		else
+			m_BSphere.SetCenterRadius(center, radius);
+	}
+
 	bool Mesh::GetCastShadows() const
 	{
 		return m_CastShadows;
@@ -372,4 +472,94 @@ namespace fury
 	{
 		m_CastShadows = state;
 	}
+
+	bool Mesh::GetStatic() const
+	{
+		return m_Static;
+	}
+
+	void Mesh::SetStatic(bool state)
+	{
+		m_Static = state;
+
+		if (!m_Static)
+			RestoreCPUData();
+		else if (!m_Dirty)
+			EvictCPUData();
+	}
+
+	bool Mesh::IsCPUDataResident() const
+	{
+		if (!Positions.IsResident() || !Normals.IsResident() || !Tangents.IsResident() ||
+			!UVs.IsResident() || !Indices.IsResident())
+			return false;
+
+		for (auto &subMesh : m_SubMeshes)
+		{
+			if (!subMesh->Indices.IsResident())
+				return false;
+		}
+
+		return true;
+	}
+
+	void Mesh::EvictCPUData()
+	{
+		if (IsSkinnedMesh())
+			return;
+
+		uint64_t saved = 0;
+		auto Evict = [&saved](ArrayBufferf &buffer)
+		{
+			if (buffer.EvictData())
+				saved += buffer.GetSize() * sizeof(float);
+		};
+
+		Evict(Positions);
+		Evict(Normals);
+		Evict(Tangents);
+		Evict(UVs);
+
+		if (Indices.EvictData())
+			saved += Indices.GetSize() * sizeof(unsigned int);
+
+		for (auto &subMesh : m_SubMeshes)
+		{
+			if (subMesh->Indices.EvictData())
+				saved += subMesh->Indices.GetSize() * sizeof(unsigned int);
+		}
+
+		if (saved > 0)
+			FURYD << m_Name << " evicted " << saved / 1024 << " kb of vertex data.";
+	}
+
+	void Mesh::RestoreCPUData()
+	{
+		Positions.RestoreData();
+		Normals.RestoreData();
+		Tangents.RestoreData();
+		UVs.RestoreData();
+		Weights.RestoreData();
+		IDs.RestoreData();
+		Indices.RestoreData();
+
+		for (auto &subMesh : m_SubMeshes)
+			subMesh->Indices.RestoreData();
+	}
+
+	std::shared_ptr<MeshBVH> Mesh::GetBVH(bool build)
+	{
+		if (m_BVH == nullptr && build)
+		{
+			auto bvh = MeshBVH::Create();
+			if (bvh->Build(*this))
+				m_BVH = bvh;
+		}
+		return m_BVH;
+	}
+
+	void Mesh::ClearBVH()
+	{
+		m_BVH.reset();
+	}
 }
\ No newline at end of file
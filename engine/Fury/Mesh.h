@@ -8,6 +8,7 @@
 #include "Fury/ArrayBuffers.h"
 #include "Fury/BoxBounds.h"
 #include "Fury/Buffer.h"
+#include "Fury/SphereBounds.h"
 
 namespace fury
 {
@@ -48,6 +49,8 @@ namespace fury
 
 	class Joint;
 
+	class MeshBVH;
+
 	class FURY_API Mesh : public Entity, public Buffer
 	{
 	public:
@@ -56,6 +59,8 @@ namespace fury
 
 		friend class FbxParser;
 
+		friend class ModelParser;
+
 		typedef std::shared_ptr<Mesh> Ptr;
 
 		static Ptr Create(const std::string &name);
@@ -66,6 +71,8 @@ namespace fury
 
 		BoxBounds m_AABB;
 
+		SphereBounds m_BSphere;
+
 		std::vector<SubMesh::Ptr> m_SubMeshes;
 
 		std::unordered_map<std::string, std::shared_ptr<Joint>> m_JointMap;
@@ -76,6 +83,10 @@ namespace fury
 
 		bool m_CastShadows = false;
 
+		bool m_Static = false;
+
+		std::shared_ptr<MeshBVH> m_BVH;
+
 	public:
 
 		ArrayBufferf Positions;
@@ -127,9 +138,34 @@ namespace fury
 
 		BoxBounds GetAABB() const;
 
+		// tight model space bounding sphere, updated with the aabb and on load.
+		SphereBounds GetBSphere() const;
+
 		bool GetCastShadows() const;
 
 		void SetCastShadows(bool state);
+
+		// static meshes drop their cpu vertex data after upload and keep an lz4 copy,
+		// call RestoreCPUData before reading or changing the arrays. skinned meshes are never evicted.
+		bool GetStatic() const;
+
+		void SetStatic(bool state);
+
+		bool IsCPUDataResident() const;
+
+		void EvictCPUData();
+
+		void RestoreCPUData();
+
+		// triangle bvh of the bind pose, built on first use when build is true.
+		std::shared_ptr<MeshBVH> GetBVH(bool build = true);
+
+		// call after changing positions or indices, the next GetBVH rebuilds.
+		void ClearBVH();
+
+	protected:
+
+		void CalculateBSphere();
 	};
 }
 
@@ -0,0 +1,477 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Fury/Log.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshBVH.h"
+
+namespace fury
+{
+	static_assert(sizeof(MeshBVH::Node) == 32, "MeshBVH::Node should be 32 bytes");
+
+	MeshBVH::Ptr MeshBVH::Create()
+	{
+		return std::make_shared<MeshBVH>();
+	}
+
+	bool MeshBVH::Build(Mesh &mesh)
+	{
+		bool evicted = !mesh.IsCPUDataResident();
+		mesh.RestoreCPUData();
+
+		bool result;
+		if (mesh.Indices.Data.size() > 0 || mesh.GetSubMeshCount() == 0)
+		{
+			result = Build(mesh.Positions.Data, mesh.Indices.Data);
+		}
+		else
+		{
+			std::vector<unsigned int> indices;
+			for (unsigned int i = 0; i < mesh.GetSubMeshCount(); i++)
+			{
+				auto &subIndices = mesh.GetSubMeshAt(i)->Indices.Data;
+				indices.insert(indices.end(), subIndices.begin(), subIndices.end());
+			}
+			result = Build(mesh.Positions.Data, indices);
+		}
+
+		if (evicted)
+			mesh.EvictCPUData();
+
+		if (result)
+			FURYD << mesh.GetName() << " bvh [tris: " << GetTriangleCount() << " nodes: " << GetNodeCount() << "]";
+
+		return result;
+	}
+
+	bool MeshBVH::Build(const std::vector<float> &positions, const std::vector<unsigned int> &indices)
+	{
+		m_Nodes.clear();
+		m_Triangles.clear();
+		m_Vertices.clear();
+		m_Indices = indices;
+		m_Depth = 0;
+
+		unsigned int triangleCount = indices.size() / 3;
+		if (triangleCount == 0)
+			return false;
+
+		for (auto index : indices)
+		{
+			if (index * 3 + 2 >= positions.size())
+			{
+				FURYE << "Index out of range!";
+				m_Indices.clear();
+				return false;
+			}
+		}
+
+		// per triangle bounds and centroids, indexed by the original triangle.
+		std::vector<float> triMin(triangleCount * 3), triMax(triangleCount * 3), centroids(triangleCount * 3);
+		for (unsigned int i = 0; i < triangleCount; i++)
+		{
+			for (unsigned int k = 0; k < 3; k++)
+			{
+				float a = positions[indices[i * 3] * 3 + k];
+				float b = positions[indices[i * 3 + 1] * 3 + k];
+				float c = positions[indices[i * 3 + 2] * 3 + k];
+				triMin[i * 3 + k] = std::min(a, std::min(b, c));
+				triMax[i * 3 + k] = std::max(a, std::max(b, c));
+				centroids[i * 3 + k] = (triMin[i * 3 + k] + triMax[i * 3 + k]) * 0.5f;
+			}
+		}
+
+		m_Triangles.resize(triangleCount);
+		for (unsigned int i = 0; i < triangleCount; i++)
+			m_Triangles[i] = i;
+
+		auto GetArea = [](const float* min, const float* max) -> float
+		{
+			float dx = max[0] - min[0], dy = max[1] - min[1], dz = max[2] - min[2];
+			return dx * dy + dy * dz + dz * dx;
+		};
+
+		auto SetBounds = [&](Node &node)
+		{
+			for (unsigned int k = 0; k < 3; k++)
+			{
+				node.min[k] = std::numeric_limits<float>::max();
+				node.max[k] = -std::numeric_limits<float>::max();
+			}
+
+			for (unsigned int i = node.first; i < node.first + node.count; i++)
+			{
+				unsigned int triangle = m_Triangles[i];
+				for (unsigned int k = 0; k < 3; k++)
+				{
+					node.min[k] = std::min(node.min[k], triMin[triangle * 3 + k]);
+					node.max[k] = std::max(node.max[k], triMax[triangle * 3 + k]);
+				}
+			}
+		};
+
+		// a binary tree never has more than 2n - 1 nodes, reserving keeps node references valid.
+		m_Nodes.reserve(triangleCount * 2);
+		m_Nodes.push_back(Node());
+		m_Nodes[0].first = 0;
+		m_Nodes[0].count = triangleCount;
+		SetBounds(m_Nodes[0]);
+
+		class Bin
+		{
+		public:
+
+			float min[3];
+
+			float max[3];
+
+			unsigned int count;
+
+			void Reset()
+			{
+				min[0] = min[1] = min[2] = std::numeric_limits<float>::max();
+				max[0] = max[1] = max[2] = -std::numeric_limits<float>::max();
+				count = 0;
+			}
+
+			void Encapsulate(const Bin &other)
+			{
+				for (unsigned int k = 0; k < 3; k++)
+				{
+					min[k] = std::min(min[k], other.min[k]);
+					max[k] = std::max(max[k], other.max[k]);
+				}
+				count += other.count;
+			}
+		};
+
+		Bin bins[BinCount];
+		float rightCosts[BinCount];
+
+		// node index and depth.
+		std::vector<std::pair<unsigned int, unsigned int>> stack;
+		stack.push_back(std::make_pair(0u, 0u));
+
+		while (!stack.empty())
+		{
+			Node &node = m_Nodes[stack.back().first];
+			unsigned int depth = stack.back().second;
+			stack.pop_back();
+
+			m_Depth = std::max(m_Depth, depth);
+
+			if (node.count <= MaxLeafSize)
+				continue;
+
+			float centroidMin[3], centroidMax[3];
+			for (unsigned int k = 0; k < 3; k++)
+			{
+				centroidMin[k] = std::numeric_limits<float>::max();
+				centroidMax[k] = -std::numeric_limits<float>::max();
+			}
+			for (unsigned int i = node.first; i < node.first + node.count; i++)
+			{
+				unsigned int triangle = m_Triangles[i];
+				for (unsigned int k = 0; k < 3; k++)
+				{
+					centroidMin[k] = std::min(centroidMin[k], centroids[triangle * 3 + k]);
+					centroidMax[k] = std::max(centroidMax[k], centroids[triangle * 3 + k]);
+				}
+			}
+
+			// find the cheapest split plane between bins over all axes.
+			float bestCost = std::numeric_limits<float>::max();
+			int bestAxis = -1;
+			unsigned int bestSplit = 0;
+
+			for (int axis = 0; axis < 3; axis++)
+			{
+				float extent = centroidMax[axis] - centroidMin[axis];
+				if (extent <= 0.0f)
+					continue;
+
+				float scale = BinCount / extent;
+				for (auto &bin : bins)
+					bin.Reset();
+
+				for (unsigned int i = node.first; i < node.first + node.count; i++)
+				{
+					unsigned int triangle = m_Triangles[i];
+					unsigned int index = std::min(BinCount - 1, (unsigned int)((centroids[triangle * 3 + axis] - centroidMin[axis]) * scale));
+
+					Bin &bin = bins[index];
+					for (unsigned int k = 0; k < 3; k++)
+					{
+						bin.min[k] = std::min(bin.min[k], triMin[triangle * 3 + k]);
+						bin.max[k] = std::max(bin.max[k], triMax[triangle * 3 + k]);
+					}
+					bin.count++;
+				}
+
+				Bin right;
+				right.Reset();
+				for (unsigned int i = BinCount - 1; i > 0; i--)
+				{
+					right.Encapsulate(bins[i]);
+					rightCosts[i] = right.count > 0 ? GetArea(right.min, right.max) * right.count : 0.0f;
+				}
+
+				Bin left;
+				left.Reset();
+				for (unsigned int i = 0; i < BinCount - 1; i++)
+				{
+					left.Encapsulate(bins[i]);
+					float cost = (left.count > 0 ? GetArea(left.min, left.max) * left.count : 0.0f) + rightCosts[i + 1];
+					if (left.count > 0 && left.count < node.count && cost < bestCost)
+					{
+						bestCost = cost;
+						bestAxis = axis;
+						bestSplit = i + 1;
+					}
+				}
+			}
+
+			// keep a leaf if splitting isn't cheaper than testing all its triangles.
+			if (bestAxis < 0 || bestCost >= GetArea(node.min, node.max) * node.count)
+				continue;
+
+			float scale = BinCount / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+			auto middle = std::partition(m_Triangles.begin() + node.first, m_Triangles.begin() + node.first + node.count,
+				[&](unsigned int triangle)
+			{
+				unsigned int index = std::min(BinCount - 1, (unsigned int)((centroids[triangle * 3 + bestAxis] - centroidMin[bestAxis]) * scale));
+				return index < bestSplit;
+			});
+
+			unsigned int leftCount = (unsigned int)(middle - m_Triangles.begin()) - node.first;
+			if (leftCount == 0 || leftCount == node.count)
+				continue;
+
+			unsigned int leftIndex = m_Nodes.size();
+			m_Nodes.push_back(Node());
+			m_Nodes.push_back(Node());
+
+			Node &leftNode = m_Nodes[leftIndex];
+			leftNode.first = node.first;
+			leftNode.count = leftCount;
+			SetBounds(leftNode);
+
+			Node &rightNode = m_Nodes[leftIndex + 1];
+			rightNode.first = node.first + leftCount;
+			rightNode.count = node.count - leftCount;
+			SetBounds(rightNode);
+
+			node.first = leftIndex;
+			node.count = 0;
+
+			stack.push_back(std::make_pair(leftIndex, depth + 1));
+			stack.push_back(std::make_pair(leftIndex + 1, depth + 1));
+		}
+
+		m_Nodes.shrink_to_fit();
+		UpdateVertices(positions);
+
+		return true;
+	}
+
+	void MeshBVH::Refit(const std::vector<float> &positions)
+	{
+		if (m_Nodes.empty())
+			return;
+
+		UpdateVertices(positions);
+
+		// children are always stored after their parent.
+		for (unsigned int i = m_Nodes.size(); i-- > 0;)
+			UpdateBounds(m_Nodes[i]);
+	}
+
+	bool MeshBVH::Raycast(Vector4 origin, Vector4 direction, RayHit &hit, float maxDistance) const
+	{
+		return Traverse<false>(origin, direction, hit, maxDistance);
+	}
+
+	bool MeshBVH::IntersectSegment(Vector4 from, Vector4 to) const
+	{
+		RayHit hit;
+		return Traverse<true>(from, to - from, hit, 1.0f);
+	}
+
+	unsigned int MeshBVH::GetNodeCount() const
+	{
+		return m_Nodes.size();
+	}
+
+	unsigned int MeshBVH::GetTriangleCount() const
+	{
+		return m_Triangles.size();
+	}
+
+	const std::vector<float> &MeshBVH::GetVertices() const
+	{
+		return m_Vertices;
+	}
+
+	size_t MeshBVH::GetMemoryBytes() const
+	{
+		return m_Nodes.capacity() * sizeof(Node) + m_Triangles.capacity() * sizeof(unsigned int) +
+			m_Vertices.capacity() * sizeof(float) + m_Indices.capacity() * sizeof(unsigned int);
+	}
+
+	template<bool AnyHit>
+	bool MeshBVH::Traverse(Vector4 origin, Vector4 direction, RayHit &hit, float maxDistance) const
+	{
+		if (m_Nodes.empty())
+			return false;
+
+		const float o[3] = { origin.x, origin.y, origin.z };
+		const float d[3] = { direction.x, direction.y, direction.z };
+		const float inv[3] = { 1.0f / d[0], 1.0f / d[1], 1.0f / d[2] };
+
+		float closest = maxDistance;
+		bool found = false;
+
+		// entry distance of the ray into a node, or infinity if it misses within closest.
+		auto Enter = [&](const Node &node) -> float
+		{
+			float tmin = 0.0f, tmax = closest;
+			for (unsigned int k = 0; k < 3; k++)
+			{
+				float t0 = (node.min[k] - o[k]) * inv[k];
+				float t1 = (node.max[k] - o[k]) * inv[k];
+				if (t0 > t1)
+					std::swap(t0, t1);
+				tmin = t0 > tmin ? t0 : tmin;
+				tmax = t1 < tmax ? t1 : tmax;
+			}
+			return tmin <= tmax ? tmin : std::numeric_limits<float>::infinity();
+		};
+
+		// deep trees from degenerate input spill to the heap.
+		unsigned int localStack[64];
+		std::vector<unsigned int> heapStack;
+		unsigned int* stack = localStack;
+		if (m_Depth >= 64)
+		{
+			heapStack.resize(m_Depth + 1);
+			stack = heapStack.data();
+		}
+		unsigned int stackSize = 0;
+
+		if (Enter(m_Nodes[0]) == std::numeric_limits<float>::infinity())
+			return false;
+		stack[stackSize++] = 0;
+
+		while (stackSize > 0)
+		{
+			const Node &node = m_Nodes[stack[--stackSize]];
+
+			if (node.count > 0)
+			{
+				// moller-trumbore, both faces count.
+				for (unsigned int i = node.first; i < node.first + node.count; i++)
+				{
+					const float* v = &m_Vertices[i * 9];
+					float e1[3] = { v[3] - v[0], v[4] - v[1], v[5] - v[2] };
+					float e2[3] = { v[6] - v[0], v[7] - v[1], v[8] - v[2] };
+					float p[3] = { d[1] * e2[2] - d[2] * e2[1], d[2] * e2[0] - d[0] * e2[2], d[0] * e2[1] - d[1] * e2[0] };
+
+					float det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+					if (std::abs(det) < 1e-12f)
+						continue;
+
+					float invDet = 1.0f / det;
+					float s[3] = { o[0] - v[0], o[1] - v[1], o[2] - v[2] };
+					float u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * invDet;
+					if (u < 0.0f || u > 1.0f)
+						continue;
+
+					float q[3] = { s[1] * e1[2] - s[2] * e1[1], s[2] * e1[0] - s[0] * e1[2], s[0] * e1[1] - s[1] * e1[0] };
+					float w = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * invDet;
+					if (w < 0.0f || u + w > 1.0f)
+						continue;
+
+					float t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * invDet;
+					if (t < 0.0f || t > closest)
+						continue;
+
+					closest = t;
+					found = true;
+					hit.distance = t;
+					hit.triangle = m_Triangles[i];
+					hit.u = u;
+					hit.v = w;
+
+					if (AnyHit)
+						return true;
+				}
+			}
+			else
+			{
+				// visit the nearer child first, the farther one is often skipped then.
+				unsigned int near = node.first, far = node.first + 1;
+				float nearDistance = Enter(m_Nodes[near]);
+				float farDistance = Enter(m_Nodes[far]);
+				if (farDistance < nearDistance)
+				{
+					std::swap(near, far);
+					std::swap(nearDistance, farDistance);
+				}
+
+				if (farDistance != std::numeric_limits<float>::infinity())
+					stack[stackSize++] = far;
+				if (nearDistance != std::numeric_limits<float>::infinity())
+					stack[stackSize++] = near;
+			}
+		}
+
+		return found;
+	}
+
+	void MeshBVH::UpdateVertices(const std::vector<float> &positions)
+	{
+		m_Vertices.resize(m_Triangles.size() * 9);
+		for (unsigned int i = 0; i < m_Triangles.size(); i++)
+		{
+			unsigned int triangle = m_Triangles[i];
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				unsigned int index = m_Indices[triangle * 3 + j] * 3;
+				m_Vertices[i * 9 + j * 3] = positions[index];
+				m_Vertices[i * 9 + j * 3 + 1] = positions[index + 1];
+				m_Vertices[i * 9 + j * 3 + 2] = positions[index + 2];
+			}
+		}
+	}
+
+	void MeshBVH::UpdateBounds(Node &node) const
+	{
+		for (unsigned int k = 0; k < 3; k++)
+		{
+			node.min[k] = std::numeric_limits<float>::max();
+			node.max[k] = -std::numeric_limits<float>::max();
+		}
+
+		if (node.count > 0)
+		{
+			for (unsigned int i = node.first * 9; i < (node.first + node.count) * 9; i += 3)
+			{
+				for (unsigned int k = 0; k < 3; k++)
+				{
+					node.min[k] = std::min(node.min[k], m_Vertices[i + k]);
+					node.max[k] = std::max(node.max[k], m_Vertices[i + k]);
+				}
+			}
+		}
+		else
+		{
+			const Node &left = m_Nodes[node.first];
+			const Node &right = m_Nodes[node.first + 1];
+			for (unsigned int k = 0; k < 3; k++)
+			{
+				node.min[k] = std::min(left.min[k], right.min[k]);
+				node.max[k] = std::max(left.max[k], right.max[k]);
+			}
+		}
+	}
+}
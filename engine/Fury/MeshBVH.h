@@ -0,0 +1,113 @@
+#ifndef _FURY_MESH_BVH_H_
+#define _FURY_MESH_BVH_H_
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "Fury/Vector4.h"
+
+namespace fury
+{
+	class Mesh;
+
+	// triangle bvh of a mesh for exact ray and segment queries, built with a binned sah.
+	// keeps its own copy of the triangles in leaf order, so queries don't touch the mesh
+	// and keep working after the mesh evicted its cpu data.
+	class FURY_API MeshBVH
+	{
+	public:
+
+		typedef std::shared_ptr<MeshBVH> Ptr;
+
+		static Ptr Create();
+
+		// 32 bytes, two nodes share a cache line.
+		// inner nodes have count 0 and their children at first and first + 1.
+		class Node
+		{
+		public:
+
+			float min[3];
+
+			unsigned int first;
+
+			float max[3];
+
+			unsigned int count;
+		};
+
+		class RayHit
+		{
+		public:
+
+			float distance = std::numeric_limits<float>::max();
+
+			// index of the triangle in the mesh's index array, divided by 3.
+			unsigned int triangle = 0;
+
+			// barycentric coords of the hit, relative to the 2nd and 3rd vertex.
+			float u = 0.0f;
+
+			float v = 0.0f;
+		};
+
+		static const unsigned int MaxLeafSize = 4;
+
+		static const unsigned int BinCount = 16;
+
+	protected:
+
+		std::vector<Node> m_Nodes;
+
+		// original triangle index of each leaf slot.
+		std::vector<unsigned int> m_Triangles;
+
+		// 9 floats per leaf slot.
+		std::vector<float> m_Vertices;
+
+		std::vector<unsigned int> m_Indices;
+
+		// levels below the root, a traversal has at most one pending node per level.
+		unsigned int m_Depth = 0;
+
+	public:
+
+		// restores the mesh's cpu data if it was evicted, and evicts it again afterwards.
+		bool Build(Mesh &mesh);
+
+		bool Build(const std::vector<float> &positions, const std::vector<unsigned int> &indices);
+
+		// updates the bounds for new vertex positions with the same topology, e.g. a skinned pose.
+		// cheaper than a rebuild but the tree degrades if the pose is far from the one it was built for.
+		void Refit(const std::vector<float> &positions);
+
+		// closest hit along the ray within maxDistance, direction doesn't need to be normalized,
+		// distance is then measured in direction's length.
+		bool Raycast(Vector4 origin, Vector4 direction, RayHit &hit,
+			float maxDistance = std::numeric_limits<float>::max()) const;
+
+		// true if any triangle crosses the segment, stops at the first one.
+		bool IntersectSegment(Vector4 from, Vector4 to) const;
+
+		unsigned int GetNodeCount() const;
+
+		unsigned int GetTriangleCount() const;
+
+		// triangle soup in leaf order, 9 floats per triangle. used to rasterize occluders.
+		const std::vector<float> &GetVertices() const;
+
+		size_t GetMemoryBytes() const;
+
+	protected:
+
+		template<bool AnyHit>
+		bool Traverse(Vector4 origin, Vector4 direction, RayHit &hit, float maxDistance) const;
+
+		void UpdateVertices(const std::vector<float> &positions);
+
+		void UpdateBounds(Node &node) const;
+	};
+}
+
+#endif // _FURY_MESH_BVH_H_
@@ -63,6 +63,22 @@ namespace fury
 			return false;
 		}
 
+		LoadMemberValue(wrapper, "occluder", m_Occluder);
+
+		m_OccluderMesh.reset();
+		if (LoadMemberValue(wrapper, "occluder_mesh", str))
+		{
+			if (auto mesh = Scene::Manager()->Get<Mesh>(str))
+				m_OccluderMesh = mesh;
+			else
+				FURYW << "Occluder mesh " << str << " not found!";
+		}
+
+		m_MaxDrawDistance = 0.0f;
+		m_MaxShadowDistance = 0.0f;
+		LoadMemberValue(wrapper, "max_draw_distance", m_MaxDrawDistance);
+		LoadMemberValue(wrapper, "max_shadow_distance", m_MaxShadowDistance);
+
 		// 
 		// load materials
 		m_Materials.clear();
@@ -107,6 +123,30 @@ namespace fury
 			SaveValue(wrapper, ptr->GetName());
 		}
 
+		if (m_Occluder)
+		{
+			SaveKey(wrapper, "occluder");
+			SaveValue(wrapper, m_Occluder);
+		}
+
+		if (auto ptr = m_OccluderMesh.lock())
+		{
+			SaveKey(wrapper, "occluder_mesh");
+			SaveValue(wrapper, ptr->GetName());
+		}
+
+		if (m_MaxDrawDistance > 0.0f)
+		{
+			SaveKey(wrapper, "max_draw_distance");
+			SaveValue(wrapper, m_MaxDrawDistance);
+		}
+
+		if (m_MaxShadowDistance > 0.0f)
+		{
+			SaveKey(wrapper, "max_shadow_distance");
+			SaveValue(wrapper, m_MaxShadowDistance);
+		}
+
 		// save materials
 		SaveKey(wrapper, "materials");
 		StartArray(wrapper);
@@ -137,6 +177,11 @@ namespace fury
 			auto material = m_Materials[i];
 			clone->SetMaterial(material.lock(), i);
 		}
+
+		clone->SetOccluder(m_Occluder);
+		clone->SetOccluderMesh(m_OccluderMesh.lock());
+		clone->SetMaxDrawDistance(m_MaxDrawDistance);
+		clone->SetMaxShadowDistance(m_MaxShadowDistance);
 		
 		return clone;
 	}
@@ -193,6 +238,49 @@ namespace fury
 		return true;
 	}
 
+	bool MeshRender::GetOccluder() const
+	{
+		return m_Occluder;
+	}
+
+	void MeshRender::SetOccluder(bool value)
+	{
+		m_Occluder = value;
+	}
+
+	void MeshRender::SetOccluderMesh(const std::shared_ptr<Mesh> &mesh)
+	{
+		m_OccluderMesh = mesh;
+	}
+
+	std::shared_ptr<Mesh> MeshRender::GetOccluderMesh() const
+	{
+		if (auto mesh = m_OccluderMesh.lock())
+			return mesh;
+
+		return m_Mesh.lock();
+	}
+
+	float MeshRender::GetMaxDrawDistance() const
+	{
+		return m_MaxDrawDistance;
+	}
+
+	void MeshRender::SetMaxDrawDistance(float distance)
+	{
+		m_MaxDrawDistance = distance;
+	}
+
+	float MeshRender::GetMaxShadowDistance() const
+	{
+		return m_MaxShadowDistance;
+	}
+
+	void MeshRender::SetMaxShadowDistance(float distance)
+	{
+		m_MaxShadowDistance = distance;
+	}
+
 	void MeshRender::OnAttaching(const std::shared_ptr<SceneNode> &node)
 	{
 		Component::OnAttaching(node);
@@ -200,11 +288,16 @@ namespace fury
 			return;
 
 		node->SetModelAABB(m_Mesh.lock()->GetAABB());
+		node->SetModelSphere(m_Mesh.lock()->GetBSphere());
 	}
 
 	void MeshRender::OnDetaching(const std::shared_ptr<SceneNode> &node)
 	{
 		Component::OnDetaching(node);
 		node->SetModelAABB(BoxBounds());
+
+		SphereBounds infinite;
+		infinite.SetInfinite(true);
+		node->SetModelSphere(infinite);
 	}
 }
\ No newline at end of file
@@ -23,6 +23,14 @@ namespace fury
 
 		std::weak_ptr<Mesh> m_Mesh;
 
+		bool m_Occluder = false;
+
+		std::weak_ptr<Mesh> m_OccluderMesh;
+
+		float m_MaxDrawDistance = 0.0f;
+
+		float m_MaxShadowDistance = 0.0f;
+
 	public:
 
 		MeshRender(const std::shared_ptr<Material> &material, const std::shared_ptr<Mesh> &mesh);
@@ -49,6 +57,27 @@ namespace fury
 
 		bool GetRenderable() const;
 
+		// occluders are rasterized for software occlusion culling, see OcclusionBuffer.
+		// the occluder mesh is a simplified stand in that must stay inside the render mesh,
+		// the render mesh itself is used when it's not set.
+		bool GetOccluder() const;
+
+		void SetOccluder(bool value);
+
+		void SetOccluderMesh(const std::shared_ptr<Mesh> &mesh);
+
+		std::shared_ptr<Mesh> GetOccluderMesh() const;
+
+		// distance from the camera to the world sphere beyond which the node isn't drawn,
+		// or doesn't cast shadows. 0 means no limit, see SceneManager::IsDetailVisible.
+		float GetMaxDrawDistance() const;
+
+		void SetMaxDrawDistance(float distance);
+
+		float GetMaxShadowDistance() const;
+
+		void SetMaxShadowDistance(float distance);
+
 	protected:
 
 		virtual void OnAttaching(const std::shared_ptr<SceneNode> &node) override;
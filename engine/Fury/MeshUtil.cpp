@@ -1,16 +1,16 @@
-// Unique vertices finding part was reference to assimp implementation.
-// See: https://github.com/assimp/assimp/blob/master/code/JoinVerticesProcess.cpp
-// License: BSD-License
-
 // Icosphere mesh creation refered to:
 // http://blog.andreaskahler.com/2009/06/creating-icosphere-mesh-in-code.html
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 
 #include "Fury/MathUtil.h"
 #include "Fury/Log.h"
 #include "Fury/Mesh.h"
 #include "Fury/MeshUtil.h"
+#include "Fury/ThreadUtil.h"
 
 namespace fury
 {
@@ -418,6 +418,10 @@ namespace fury
 
 	void MeshUtil::TransformMesh(const std::shared_ptr<Mesh> &mesh, const Matrix4 &matrix, bool updateBuffer) 
 	{
+		// static meshes might have evicted their arrays.
+		mesh->RestoreCPUData();
+		mesh->ClearBVH();
+
 		unsigned int count = mesh->Positions.Data.size();
 		if (count == 0) return;
 
@@ -477,323 +481,235 @@ namespace fury
 		}
 	}
 
-	void MeshUtil::OptimizeMesh(const std::shared_ptr<Mesh> &mesh)
+	void MeshUtil::OptimizeMesh(const std::shared_ptr<Mesh> &mesh, bool allowParallel)
 	{
-		// structs && funcs for faster unique vertex finding.
+		mesh->RestoreCPUData();
+		mesh->ClearBVH();
 
-		struct Vertex
-		{
-			Vector4 Position;
+		const unsigned int verticesCount = mesh->Positions.Data.size() / 3;
+		if (verticesCount == 0)
+			return;
 
-			Vector4 UV;
+		const bool hasNormal = mesh->Normals.Data.size() > 0;
+		const bool hasTangent = mesh->Tangents.Data.size() > 0;
+		const bool hasUV = mesh->UVs.Data.size() > 0;
+		const bool hasWeights = mesh->Weights.Data.size() > 0;
+		const bool hasIDs = mesh->IDs.Data.size() > 0;
 
-			Vector4 Normal;
+		if ((hasWeights || hasIDs) && (!hasWeights || !hasIDs))
+			ASSERT_MSG(false, "Error: Invalid Skin Info!");
 
-			Vector4 Tangent;
+		const float* positions = &mesh->Positions.Data[0];
+		const float* normals = hasNormal ? &mesh->Normals.Data[0] : nullptr;
+		const float* tangents = hasTangent ? &mesh->Tangents.Data[0] : nullptr;
+		const float* uvs = hasUV ? &mesh->UVs.Data[0] : nullptr;
+		const float* weights = hasWeights ? &mesh->Weights.Data[0] : nullptr;
+		const unsigned int* ids = hasIDs ? &mesh->IDs.Data[0] : nullptr;
 
-			unsigned int IDs[4];
+		const float epsilon = 1e-5f;
+		const float squareEpsilon = epsilon * epsilon;
 
-			float Weights[3];
+		// vertices are hashed by a grid cell much larger than epsilon,
+		// so a vertex only probes its neighbor cells when it lies within epsilon of a cell border.
+		const float invCellSize = 1.0f / (epsilon * 16.0f);
 
-			bool HasSameWeights(const float *another, float epsilon)
-			{
-				return !(std::abs(Weights[0] - another[0]) > epsilon ||
-					std::abs(Weights[1] - another[1]) > epsilon ||
-					std::abs(Weights[2] - another[2]) > epsilon);
-			}
+		auto GetCell = [invCellSize](float value) -> int64_t
+		{
+			return (int64_t)std::floor(value * invCellSize);
+		};
 
-			bool HasSameIDs(const unsigned int *another)
-			{
-				return IDs[0] == another[0] && IDs[1] == another[1] &&
-					IDs[2] == another[2] && IDs[3] == another[3];
-			}
+		unsigned int bucketCount = 1;
+		while (bucketCount < verticesCount)
+			bucketCount <<= 1;
+		const uint64_t bucketMask = bucketCount - 1;
 
-			void Empty()
-			{
-				Position.Zero();
-				UV.Zero();
-				Normal.Zero();
-				Tangent.Zero();
-				IDs[0] = IDs[1] = IDs[2] = IDs[3] = 0;
-				Weights[0] = Weights[1] = Weights[2] = 0.0f;
-			}
+		auto GetBucket = [bucketMask](int64_t x, int64_t y, int64_t z) -> unsigned int
+		{
+			uint64_t hash = (uint64_t)x * 0x9E3779B97F4A7C15ULL ^ (uint64_t)y * 0xC2B2AE3D27D4EB4FULL ^ (uint64_t)z * 0x165667B19E3779F9ULL;
+			return (unsigned int)((hash ^ (hash >> 29)) & bucketMask);
 		};
 
-		struct VtxEntry
+		auto SquareDistance = [](const float* data, unsigned int a, unsigned int b, unsigned int stride) -> float
 		{
-			// reference vertex's index
-			int index;
-
-			Vector4 position;
-
-			// distance to storing plane
-			float dist;
-
-			VtxEntry(int index, Vector4 position, float dist)
-				: index(index), position(position), dist(dist) {}
-
-			inline bool operator < (const VtxEntry& other) const
+			float sum = 0.0f;
+			for (unsigned int k = 0; k < stride; k++)
 			{
-				return dist < other.dist;
+				float d = data[a * stride + k] - data[b * stride + k];
+				sum += d * d;
 			}
+			return sum;
 		};
 
-		// read physical data.
-		int verticesCount = mesh->Positions.Data.size() / 3;
-
-		std::vector<VtxEntry> entries;
-		entries.reserve(verticesCount);
-
-		// dividePlane is for spatial sort.
-		// we setup a non-usual plane as a reference plane.
-		// we use vertex's distance to the plane to search near vertices faster.
-		Vector4 dividePlane(0.6f, 0.7f, -0.4f, 1.0f);
-		dividePlane.Normalize();
-
-		bool hasNormal = mesh->Normals.Data.size() > 0;
-		bool hasTangent = mesh->Tangents.Data.size() > 0;
-		bool hasUV = mesh->UVs.Data.size() > 0;
-		bool hasWeights = mesh->Weights.Data.size() > 0;
-		bool hasIDs = mesh->IDs.Data.size() > 0;
-
-		if ((hasWeights || hasIDs) && (!hasWeights || !hasIDs))
-			ASSERT_MSG(false, "Error: Invalid Skin Info!");
-
-		// create Vertex obj from mesh data.
-		auto CreateVertex = [&](Vertex &vtx, int index)
-		{
-			int posIndex = index * 3;
-			int uvIndex = index * 2;
-			int weightIndex = index * 4;
-
-			vtx.Empty();
-			vtx.Position = Vector4(mesh->Positions.Data[posIndex], mesh->Positions.Data[posIndex + 1],
-				mesh->Positions.Data[posIndex + 2]);
-
-			if (hasNormal)
-				vtx.Normal = Vector4(mesh->Normals.Data[posIndex], mesh->Normals.Data[posIndex + 1],
-				mesh->Normals.Data[posIndex + 2]);
-			if (hasTangent)
-				vtx.Tangent = Vector4(mesh->Tangents.Data[posIndex], mesh->Tangents.Data[posIndex + 1],
-				mesh->Tangents.Data[posIndex + 2]);
-			if (hasUV)
-				vtx.UV = Vector4(mesh->UVs.Data[uvIndex], mesh->UVs.Data[uvIndex + 1], 0.0f);
-
+		// same matching rules as the old sorted scan, so the welded topology doesn't change.
+		auto IsSameVertex = [&](unsigned int a, unsigned int b) -> bool
+		{
+			if (SquareDistance(positions, a, b, 3) >= squareEpsilon)
+				return false;
+			if (hasNormal && SquareDistance(normals, a, b, 3) > squareEpsilon)
+				return false;
+			if (hasTangent && SquareDistance(tangents, a, b, 3) > squareEpsilon)
+				return false;
+			if (hasUV && SquareDistance(uvs, a, b, 2) > squareEpsilon)
+				return false;
 			if (hasWeights)
 			{
-				vtx.IDs[0] = mesh->IDs.Data[weightIndex];
-				vtx.IDs[1] = mesh->IDs.Data[weightIndex + 1];
-				vtx.IDs[2] = mesh->IDs.Data[weightIndex + 2];
-				vtx.IDs[3] = mesh->IDs.Data[weightIndex + 3];
-				vtx.Weights[0] = mesh->Weights.Data[posIndex];
-				vtx.Weights[1] = mesh->Weights.Data[posIndex + 1];
-				vtx.Weights[2] = mesh->Weights.Data[posIndex + 2];
+				bool sameWeights = !(std::abs(weights[a * 3] - weights[b * 3]) > epsilon ||
+					std::abs(weights[a * 3 + 1] - weights[b * 3 + 1]) > epsilon ||
+					std::abs(weights[a * 3 + 2] - weights[b * 3 + 2]) > epsilon);
+				bool sameIDs = ids[a * 4] == ids[b * 4] && ids[a * 4 + 1] == ids[b * 4 + 1] &&
+					ids[a * 4 + 2] == ids[b * 4 + 2] && ids[a * 4 + 3] == ids[b * 4 + 3];
+				if (!sameWeights && !sameIDs)
+					return false;
 			}
+			return true;
 		};
 
-		// find nearest points to a given position.
-		auto FindNeighbors = [&dividePlane, &entries](Vector4 pos, float radius, std::vector<unsigned int> &output)
+		auto threads = allowParallel && verticesCount >= ParallelThreshold ? ThreadUtil::Instance() : nullptr;
+		auto ForEachVertex = [&](const std::function<void(unsigned int)> &func)
 		{
-			const float dist = dividePlane * pos;
-			const float minDist = dist - radius, maxDist = dist + radius;
+			if (threads != nullptr)
+				threads->ParallelFor(0, verticesCount, 4096, func);
+			else
+				for (unsigned int i = 0; i < verticesCount; i++)
+					func(i);
+		};
 
-			// clear the array in this strange fashion because a simple clear() would also deallocate
-			// the array which we want to avoid
-			output.erase(output.begin(), output.end());
+		// bucket the vertices, counting sort keeps each bucket in ascending vertex order.
+		std::vector<unsigned int> vertexBuckets(verticesCount);
+		ForEachVertex([&](unsigned int i)
+		{
+			const float* p = positions + i * 3;
+			vertexBuckets[i] = GetBucket(GetCell(p[0]), GetCell(p[1]), GetCell(p[2]));
+		});
 
-			// quick check for positions outside the range
-			if (entries.size() == 0 || maxDist < entries.front().dist || minDist > entries.back().dist)
-				return;
+		std::vector<unsigned int> bucketStart(bucketCount + 1, 0);
+		for (unsigned int i = 0; i < verticesCount; i++)
+			bucketStart[vertexBuckets[i] + 1]++;
+		for (unsigned int i = 0; i < bucketCount; i++)
+			bucketStart[i + 1] += bucketStart[i];
 
-			// do a binary search for the minimal distance to start the iteration there
-			unsigned int index = (unsigned int)entries.size() / 2;
-			unsigned int binaryStepSize = (unsigned int)entries.size() / 4;
-			while (binaryStepSize > 1)
-			{
-				if (entries[index].dist < minDist)
-					index += binaryStepSize;
-				else
-					index -= binaryStepSize;
+		std::vector<unsigned int> bucketVertices(verticesCount);
+		{
+			std::vector<unsigned int> cursor(bucketStart.begin(), bucketStart.end() - 1);
+			for (unsigned int i = 0; i < verticesCount; i++)
+				bucketVertices[cursor[vertexBuckets[i]]++] = i;
+		}
+		vertexBuckets.clear();
+		vertexBuckets.shrink_to_fit();
 
-				binaryStepSize /= 2;
+		// returns the smallest vertex index before 'index' that matches it and passes filter, or index if none does.
+		auto FindFirstMatch = [&](unsigned int index, const std::vector<unsigned char>* filter) -> unsigned int
+		{
+			const float* p = positions + index * 3;
+			int64_t minCell[3], maxCell[3];
+			for (int k = 0; k < 3; k++)
+			{
+				minCell[k] = GetCell(p[k] - epsilon);
+				maxCell[k] = GetCell(p[k] + epsilon);
 			}
 
-			// depending on the direction of the last step we need to single step a bit back or forth
-			// to find the actual beginning element of the range
-			while (index > 0 && entries[index].dist > minDist)
-				index--;
-			while (index < (entries.size() - 1) && entries[index].dist < minDist)
-				index++;
-
-			// now start iterating from there until the first position lays outside of the distance range.
-			// add all positions inside the distance range within the given radius to the result aray
-			std::vector<VtxEntry>::const_iterator it = entries.begin() + index;
-			const float pSquared = radius * radius;
-			while (it->dist < maxDist)
+			unsigned int match = index;
+			for (int64_t x = minCell[0]; x <= maxCell[0]; x++)
 			{
-				if ((it->position - pos).SquareLength() < pSquared)
-					output.push_back(it->index);
-				++it;
-				if (it == entries.end())
-					break;
+				for (int64_t y = minCell[1]; y <= maxCell[1]; y++)
+				{
+					for (int64_t z = minCell[2]; z <= maxCell[2]; z++)
+					{
+						unsigned int bucket = GetBucket(x, y, z);
+						for (unsigned int k = bucketStart[bucket]; k < bucketStart[bucket + 1]; k++)
+						{
+							unsigned int other = bucketVertices[k];
+							if (other >= match)
+								break;
+							if ((filter == nullptr || (*filter)[other]) && IsSameVertex(index, other))
+							{
+								match = other;
+								break;
+							}
+						}
+					}
+				}
 			}
+			return match;
 		};
 
-		for (int i = 0; i < verticesCount; i++)
+		// the parallel pass finds each vertex's first match among all vertices,
+		// it's only final if that match became unique itself, otherwise the serial pass searches again.
+		std::vector<unsigned int> firstMatches;
+		if (threads != nullptr)
 		{
-			int index = i * 3;
-			Vector4 position(mesh->Positions.Data[index], mesh->Positions.Data[index + 1],
-				mesh->Positions.Data[index + 2], 1.0f);
-
-			// store data for unique vtx finding
-			entries.push_back(VtxEntry(i, position, dividePlane * position));
+			firstMatches.resize(verticesCount);
+			ForEachVertex([&](unsigned int i)
+			{
+				firstMatches[i] = FindFirstMatch(i, nullptr);
+			});
 		}
 
-		// find unique vertices
-
-		// spatial sort
-		std::sort(entries.begin(), entries.end());
-
-		// stores our unqiue vertices.
-		std::vector<Vertex> uniqueVertices;
-		uniqueVertices.reserve(verticesCount);
+		// each vertex is replaced by the first unique vertex it matches.
+		std::vector<unsigned char> isUnique(verticesCount, 0);
+		std::vector<unsigned int> replaceIndices(verticesCount);
+		unsigned int uniqueCount = 0;
 
-		// For each vertex the index of the vertex it was replaced by.
-		// Since the maximal number of vertices is 2^31-1, the most significand bit can be used to mark
-		//  whether a new vertex was created for the index (true) or if it was replaced by an existing
-		//  unique vertex (false). This saves an additional std::vector<bool> and greatly enhances
-		//  branching performance.
-		std::vector<unsigned int> replaceIndices(verticesCount, 0xffffffff);
-
-		// stores nearest vertices result to given vertex.
-		std::vector<unsigned int> verticesFound;
-		verticesFound.reserve(10);
-
-		float epsilon = 1e-5f;
-		float squareEpsilon = epsilon * epsilon;
-
-		// iterate through mesh's vertices to find unique vertices.
-		Vertex vtx;
-		for (int i = 0; i < verticesCount; i++)
+		for (unsigned int i = 0; i < verticesCount; i++)
 		{
-			CreateVertex(vtx, i);
+			unsigned int match = threads != nullptr ? firstMatches[i] : i;
+			if (threads == nullptr || (match != i && !isUnique[match]))
+				match = FindFirstMatch(i, &isUnique);
 
-			// find nearest vertices to current vertex.
-			FindNeighbors(vtx.Position, epsilon, verticesFound);
-			unsigned int matchIndex = 0xffffffff;
-
-			// iterate through nearest vertices to test if it's unique.
-			for (unsigned int j = 0; j < verticesFound.size(); j++)
+			if (match == i)
 			{
-				const unsigned int uidx = replaceIndices[verticesFound[j]];
-
-				// check if flag bit is true, ie: already has a replacement?
-				if (uidx & 0x80000000)
-					continue;
-
-				Vertex &vtxu = uniqueVertices[uidx];
-
-				if (hasNormal && (vtxu.Normal - vtx.Normal).SquareLength() > squareEpsilon)
-					continue;
-				if (hasTangent && (vtxu.Tangent - vtx.Tangent).SquareLength() > squareEpsilon)
-					continue;
-				if (hasUV && (vtxu.UV - vtx.UV).SquareLength() > squareEpsilon)
-					continue;
-				if (hasWeights && !vtxu.HasSameWeights(vtx.Weights, epsilon) && !vtxu.HasSameIDs(vtx.IDs))
-					continue;
-
-				// found a unique one, update replacement data.
-				matchIndex = uidx;
-				break;
-			}
-
-			auto &pair = replaceIndices[i];
-
-			// found a replacement vertex among the uniques?
-			if (matchIndex != 0xffffffff)
-			{
-				// store where to found the matching unique vertex
-				// set flag bit to 1
-				replaceIndices[i] = matchIndex | 0x80000000;
+				isUnique[i] = 1;
+				replaceIndices[i] = uniqueCount++;
 			}
 			else
 			{
-				// no unique vertex matches it upto now -> so add it
-				replaceIndices[i] = (unsigned int)uniqueVertices.size();
-				uniqueVertices.push_back(vtx);
+				replaceIndices[i] = replaceIndices[match];
 			}
 		}
-		entries.clear();
+		firstMatches.clear();
+		bucketVertices.clear();
+		bucketStart.clear();
 
-		// move data to mesh
-		const int vtxCount = uniqueVertices.size();
-		const int vtxCount2 = vtxCount * 2;
-		const int vtxCount3 = vtxCount * 3;
-		const int vtxCount4 = vtxCount * 4;
+		// compact in place, a unique vertex never moves to a higher index.
+		auto Compact = [&](std::vector<float> &data, unsigned int stride)
+		{
+			for (unsigned int i = 0; i < verticesCount; i++)
+			{
+				if (isUnique[i])
+				{
+					for (unsigned int k = 0; k < stride; k++)
+						data[replaceIndices[i] * stride + k] = data[i * stride + k];
+				}
+			}
+			data.resize(uniqueCount * stride);
+		};
 
-		// pre allocate some space.
-		mesh->Positions.Data.resize(vtxCount3);
+		Compact(mesh->Positions.Data, 3);
 		if (hasNormal)
-			mesh->Normals.Data.resize(vtxCount3);
+			Compact(mesh->Normals.Data, 3);
 		if (hasTangent)
-			mesh->Tangents.Data.resize(vtxCount3);
+			Compact(mesh->Tangents.Data, 3);
 		if (hasUV)
-			mesh->UVs.Data.resize(vtxCount2);
+			Compact(mesh->UVs.Data, 2);
 		if (hasWeights)
-			mesh->IDs.Data.resize(vtxCount4);
-		if (hasWeights)
-			mesh->Weights.Data.resize(vtxCount3);
-
-		// copy data to mesh.
-		for (unsigned int i = 0; i < uniqueVertices.size(); i++)
 		{
-			Vertex &uVtx = uniqueVertices[i];
-			int posIndex = i * 3;
-			int uvIndex = i * 2;
-			int weightIndex = i * 4;
+			Compact(mesh->Weights.Data, 3);
 
-			mesh->Positions.Data[posIndex] = uVtx.Position.x;
-			mesh->Positions.Data[posIndex + 1] = uVtx.Position.y;
-			mesh->Positions.Data[posIndex + 2] = uVtx.Position.z;
-
-			if (hasNormal)
+			auto &idData = mesh->IDs.Data;
+			for (unsigned int i = 0; i < verticesCount; i++)
 			{
-				mesh->Normals.Data[posIndex] = uVtx.Normal.x;
-				mesh->Normals.Data[posIndex + 1] = uVtx.Normal.y;
-				mesh->Normals.Data[posIndex + 2] = uVtx.Normal.z;
-			}
-
-			if (hasTangent)
-			{
-				mesh->Tangents.Data[posIndex] = uVtx.Tangent.x;
-				mesh->Tangents.Data[posIndex + 1] = uVtx.Tangent.y;
-				mesh->Tangents.Data[posIndex + 2] = uVtx.Tangent.z;
-			}
-
-			if (hasUV)
-			{
-				mesh->UVs.Data[uvIndex] = uVtx.UV.x;
-				mesh->UVs.Data[uvIndex + 1] = uVtx.UV.y;
-			}
-
-			if (hasWeights)
-			{
-				mesh->IDs.Data[weightIndex] = uVtx.IDs[0];
-				mesh->IDs.Data[weightIndex + 1] = uVtx.IDs[1];
-				mesh->IDs.Data[weightIndex + 2] = uVtx.IDs[2];
-				mesh->IDs.Data[weightIndex + 3] = uVtx.IDs[3];
-				mesh->Weights.Data[posIndex] = uVtx.Weights[0];
-				mesh->Weights.Data[posIndex + 1] = uVtx.Weights[1];
-				mesh->Weights.Data[posIndex + 2] = uVtx.Weights[2];
+				if (isUnique[i])
+				{
+					for (unsigned int k = 0; k < 4; k++)
+						idData[replaceIndices[i] * 4 + k] = idData[i * 4 + k];
+				}
 			}
+			idData.resize(uniqueCount * 4);
 		}
 
 		// find correct indices.
-		for (unsigned int i = 0; i < mesh->Indices.Data.size(); i++)
-		{
-			// set most significant bit to 0. ie: remove flag bit.
-			mesh->Indices.Data[i] = replaceIndices[mesh->Indices.Data[i]] & ~0x80000000;
-		}
+		for (auto &index : mesh->Indices.Data)
+			index = replaceIndices[index];
 
 		// correct submeshes
 		unsigned int subMeshCount = mesh->GetSubMeshCount();
@@ -801,157 +717,244 @@ namespace fury
 		{
 			if (auto subMesh = mesh->GetSubMeshAt(i))
 			{
-				for (unsigned int j = 0; j < subMesh->Indices.Data.size(); j++)
-				{
-					subMesh->Indices.Data[j] = replaceIndices[subMesh->Indices.Data[j]] & ~0x80000000;
-				}
+				for (auto &index : subMesh->Indices.Data)
+					index = replaceIndices[index];
 			}
 		}
 
 		FURYD << mesh->GetName() << "[vtx: " << mesh->Positions.Data.size() / 3 << " tris: " << mesh->Indices.Data.size() / 3 << "]";
 	}
 
-	void MeshUtil::CalculateNormal(const std::shared_ptr<Mesh> &mesh) 
+	void MeshUtil::CalculateNormal(const std::shared_ptr<Mesh> &mesh, bool allowParallel) 
 	{
-		mesh->Normals.Data.resize(mesh->Positions.Data.size());
+		mesh->RestoreCPUData();
 
-		for (auto &value : mesh->Normals.Data)
-			value = 0.0f;
+		const unsigned int numTriangles = mesh->Indices.Data.size() / 3;
+		const unsigned int numVertices = mesh->Positions.Data.size() / 3;
 
-		unsigned int numTriangles = mesh->Indices.Data.size() / 3;
-		unsigned int numVertices = mesh->Positions.Data.size() / 3;
-
-		auto GetPositionAt = [&mesh](unsigned int index) -> Vector4
-		{
-			unsigned int j = index * 3;
-			return Vector4(mesh->Positions.Data[j], mesh->Positions.Data[j + 1], mesh->Positions.Data[j + 2]);
-		};
+		mesh->Normals.Data.assign(numVertices * 3, 0.0f);
+		if (numTriangles == 0)
+			return;
 
-		auto SetNormalAt = [&mesh](unsigned int index, Vector4 normal)
-		{
-			unsigned int j = index * 3;
-			mesh->Normals.Data[j] += normal.x;
-			mesh->Normals.Data[j + 1] += normal.y;
-			mesh->Normals.Data[j + 2] += normal.z;
-		};
+		const float* positions = &mesh->Positions.Data[0];
+		const unsigned int* indices = &mesh->Indices.Data[0];
+		float* normals = &mesh->Normals.Data[0];
 
-		for (unsigned int i = 0; i < numTriangles; i++)
+		// area weighted face normals.
+		std::vector<float> faceNormals(numTriangles * 3);
+		ParallelRanges(numTriangles, allowParallel, [&](unsigned int begin, unsigned int end)
 		{
-			unsigned int j = i * 3;
-			unsigned int ia = mesh->Indices.Data[j];
-			unsigned int ib = mesh->Indices.Data[j + 1];
-			unsigned int ic = mesh->Indices.Data[j + 2];
+			for (unsigned int i = begin; i < end; i++)
+			{
+				const float* a = positions + indices[i * 3] * 3;
+				const float* b = positions + indices[i * 3 + 1] * 3;
+				const float* c = positions + indices[i * 3 + 2] * 3;
 
-			Vector4 a = GetPositionAt(ia);
-			Vector4 b = GetPositionAt(ib);
-			Vector4 c = GetPositionAt(ic);
+				float e0[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+				float e1[3] = { c[0] - b[0], c[1] - b[1], c[2] - b[2] };
 
-			Vector4 e0 = b - a;
-			Vector4 e1 = c - b;
-			Vector4 normal = e0.CrossProduct(e1);
+				float* normal = &faceNormals[i * 3];
+				normal[0] = e0[1] * e1[2] - e0[2] * e1[1];
+				normal[1] = e0[2] * e1[0] - e0[0] * e1[2];
+				normal[2] = e0[0] * e1[1] - e0[1] * e1[0];
+			}
+		});
 
-			SetNormalAt(ia, normal);
-			SetNormalAt(ib, normal);
-			SetNormalAt(ic, normal);
-		}
+		// each vertex sums its faces in triangle order, so the result doesn't depend on the thread count.
+		std::vector<unsigned int> offsets, corners;
+		GetVertexCorners(mesh->Indices.Data, numVertices, offsets, corners);
 
-		for (unsigned int i = 0; i < numVertices; i++)
+		ParallelRanges(numVertices, allowParallel, [&](unsigned int begin, unsigned int end)
 		{
-			unsigned int j = i * 3;
-
-			float &x = mesh->Normals.Data[j];
-			float &y = mesh->Normals.Data[j + 1];
-			float &z = mesh->Normals.Data[j + 2];
-
-			Vector4 normal = Vector4(x, y, z).Normalized();
+			for (unsigned int i = begin; i < end; i++)
+			{
+				float x = 0.0f, y = 0.0f, z = 0.0f;
+				for (unsigned int k = offsets[i]; k < offsets[i + 1]; k++)
+				{
+					const float* normal = &faceNormals[(corners[k] / 3) * 3];
+					x += normal[0];
+					y += normal[1];
+					z += normal[2];
+				}
 
-			x = normal.x;
-			y = normal.y;
-			z = normal.z;
-		}
+				Vector4 normal = Vector4(x, y, z).Normalized();
+				normals[i * 3] = normal.x;
+				normals[i * 3 + 1] = normal.y;
+				normals[i * 3 + 2] = normal.z;
+			}
+		});
 	}
 
-	void MeshUtil::CalculateTangent(const std::shared_ptr<Mesh> &mesh) 
+	void MeshUtil::CalculateTangent(const std::shared_ptr<Mesh> &mesh, bool allowParallel) 
 	{
-		if (mesh->Normals.Data.size() == 0 || mesh->UVs.Data.size() == 0)
+		mesh->RestoreCPUData();
+
+		const unsigned int numTriangles = mesh->Indices.Data.size() / 3;
+		const unsigned int numVertices = mesh->Positions.Data.size() / 3;
+
+		if (mesh->Normals.Data.size() != numVertices * 3 || mesh->UVs.Data.size() != numVertices * 2)
 		{
 			FURYW << "Normal and UV data is required.";
 			return;
 		}
 
-		mesh->Tangents.Data.resize(mesh->Positions.Data.size());
-
-		for (auto &value : mesh->Tangents.Data)
-			value = 0.0f;
+		mesh->Tangents.Data.assign(numVertices * 3, 0.0f);
+		if (numTriangles == 0)
+			return;
 
-		unsigned int numTriangles = mesh->Indices.Data.size() / 3;
-		unsigned int numVertices = mesh->Positions.Data.size() / 3;
+		const float* positions = &mesh->Positions.Data[0];
+		const float* normals = &mesh->Normals.Data[0];
+		const float* uvs = &mesh->UVs.Data[0];
+		const unsigned int* indices = &mesh->Indices.Data[0];
+		float* tangents = &mesh->Tangents.Data[0];
 
-		auto GetPositionAt = [&mesh](unsigned int index) -> Vector4
+		// unit face tangents like mikktspace, flipped for mirrored uvs and zero where the uvs are degenerate.
+		std::vector<float> faceTangents(numTriangles * 3);
+		ParallelRanges(numTriangles, allowParallel, [&](unsigned int begin, unsigned int end)
 		{
-			unsigned int j = index * 3;
-			return Vector4(mesh->Positions.Data[j], mesh->Positions.Data[j + 1], mesh->Positions.Data[j + 2]);
-		};
+			for (unsigned int i = begin; i < end; i++)
+			{
+				unsigned int ia = indices[i * 3], ib = indices[i * 3 + 1], ic = indices[i * 3 + 2];
 
-		auto GetUVAt = [&mesh](unsigned int index) -> Vector4
-		{
-			unsigned int j = index * 3;
-			return Vector4(mesh->UVs.Data[j], mesh->UVs.Data[j + 1], 0, 0);
-		};
+				const float* p0 = positions + ia * 3;
+				const float* p1 = positions + ib * 3;
+				const float* p2 = positions + ic * 3;
 
-		auto SetTangentAt = [&mesh](unsigned int index, Vector4 tangent)
-		{
-			unsigned int j = index * 3;
-			mesh->Tangents.Data[j] += tangent.x;
-			mesh->Tangents.Data[j + 1] += tangent.y;
-			mesh->Tangents.Data[j + 2] += tangent.z;
-		};
+				float d1[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+				float d2[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+
+				float t21x = uvs[ib * 2] - uvs[ia * 2], t21y = uvs[ib * 2 + 1] - uvs[ia * 2 + 1];
+				float t31x = uvs[ic * 2] - uvs[ia * 2], t31y = uvs[ic * 2 + 1] - uvs[ia * 2 + 1];
+				float signedArea = t21x * t31y - t21y * t31x;
 
-		for (unsigned int i = 0; i < numTriangles; i++)
+				float* tangent = &faceTangents[i * 3];
+				tangent[0] = tangent[1] = tangent[2] = 0.0f;
+				if (signedArea == 0.0f)
+					continue;
+
+				float os[3] = { t31y * d1[0] - t21y * d2[0], t31y * d1[1] - t21y * d2[1], t31y * d1[2] - t21y * d2[2] };
+				float length = std::sqrt(os[0] * os[0] + os[1] * os[1] + os[2] * os[2]);
+				if (length == 0.0f)
+					continue;
+
+				float scale = (signedArea > 0.0f ? 1.0f : -1.0f) / length;
+				tangent[0] = os[0] * scale;
+				tangent[1] = os[1] * scale;
+				tangent[2] = os[2] * scale;
+			}
+		});
+
+		std::vector<unsigned int> offsets, corners;
+		GetVertexCorners(mesh->Indices.Data, numVertices, offsets, corners);
+
+		// projects v onto the plane of n, returns false if nothing is left.
+		auto Project = [](const float* n, const float* v, float* out) -> bool
 		{
-			unsigned int j = i * 3;
-			unsigned int ia = mesh->Indices.Data[j];
-			unsigned int ib = mesh->Indices.Data[j + 1];
-			unsigned int ic = mesh->Indices.Data[j + 2];
+			float d = n[0] * v[0] + n[1] * v[1] + n[2] * v[2];
+			out[0] = v[0] - n[0] * d;
+			out[1] = v[1] - n[1] * d;
+			out[2] = v[2] - n[2] * d;
 
-			Vector4 p0 = GetPositionAt(ia);
-			Vector4 p1 = GetPositionAt(ib);
-			Vector4 p2 = GetPositionAt(ic);
+			float length = std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+			if (length == 0.0f)
+				return false;
 
-			Vector4 uv0 = GetUVAt(ia);
-			Vector4 uv1 = GetUVAt(ib);
-			Vector4 uv2 = GetUVAt(ic);
+			out[0] /= length;
+			out[1] /= length;
+			out[2] /= length;
+			return true;
+		};
 
-			Vector4 dp0 = p1 - p0;
-			Vector4 dp1 = p2 - p1;
+		// face tangents are projected onto the vertex normal and weighted by the corner angle,
+		// summed in triangle order like the normals.
+		ParallelRanges(numVertices, allowParallel, [&](unsigned int begin, unsigned int end)
+		{
+			for (unsigned int i = begin; i < end; i++)
+			{
+				const float* n = normals + i * 3;
+				const float* p = positions + i * 3;
+				float sum[3] = { 0.0f, 0.0f, 0.0f };
 
-			Vector4 duv0 = uv1 - uv0;
-			Vector4 duv1 = uv2 - uv1;
+				for (unsigned int k = offsets[i]; k < offsets[i + 1]; k++)
+				{
+					unsigned int corner = corners[k];
+					unsigned int triangle = corner / 3;
+
+					float faceTangent[3];
+					if (!Project(n, &faceTangents[triangle * 3], faceTangent))
+						continue;
+
+					const float* next = positions + indices[triangle * 3 + (corner + 1) % 3] * 3;
+					const float* prev = positions + indices[triangle * 3 + (corner + 2) % 3] * 3;
+					float e0[3] = { next[0] - p[0], next[1] - p[1], next[2] - p[2] };
+					float e1[3] = { prev[0] - p[0], prev[1] - p[1], prev[2] - p[2] };
+
+					float angle = 0.0f;
+					if (Project(n, e0, e0) && Project(n, e1, e1))
+					{
+						float cosine = e0[0] * e1[0] + e0[1] * e1[1] + e0[2] * e1[2];
+						angle = std::acos(std::max(-1.0f, std::min(1.0f, cosine)));
+					}
+
+					sum[0] += faceTangent[0] * angle;
+					sum[1] += faceTangent[1] * angle;
+					sum[2] += faceTangent[2] * angle;
+				}
 
-			float cross = (duv0.x * duv1.y - duv0.y * duv1.x);
-			float r = 0.0f;
-			if (cross != 0.0f) r = 1.0f / cross;
+				// gram-schmidt against the normal, any perpendicular will do if no face had usable uvs.
+				float tangent[3];
+				if (!Project(n, sum, tangent))
+				{
+					float axis[3] = { 1.0f, 0.0f, 0.0f };
+					if (std::abs(n[0]) > 0.9f)
+					{
+						axis[0] = 0.0f;
+						axis[1] = 1.0f;
+					}
+					if (!Project(n, axis, tangent))
+						tangent[0] = tangent[1] = tangent[2] = 0.0f;
+				}
+
+				tangents[i * 3] = tangent[0];
+				tangents[i * 3 + 1] = tangent[1];
+				tangents[i * 3 + 2] = tangent[2];
+			}
+		});
+	}
 
-			Vector4 tangent = (dp0 * duv1.y - dp1 * duv0.y) * r;
+	void MeshUtil::ParallelRanges(unsigned int count, bool allowParallel, const std::function<void(unsigned int, unsigned int)> &func)
+	{
+		const unsigned int grainSize = 4096;
 
-			SetTangentAt(ia, tangent);
-			SetTangentAt(ib, tangent);
-			SetTangentAt(ic, tangent);
+		auto &threads = ThreadUtil::Instance();
+		if (!allowParallel || count < ParallelThreshold || threads == nullptr)
+		{
+			func(0, count);
+			return;
 		}
 
-		for (unsigned int i = 0; i < numVertices; i++)
+		unsigned int numRanges = (count + grainSize - 1) / grainSize;
+		threads->ParallelFor(0, numRanges, 1, [&](unsigned int range)
 		{
-			unsigned int j = i * 3;
+			unsigned int begin = range * grainSize;
+			func(begin, std::min(begin + grainSize, count));
+		});
+	}
 
-			float &x = mesh->Tangents.Data[j];
-			float &y = mesh->Tangents.Data[j + 1];
-			float &z = mesh->Tangents.Data[j + 2];
+	void MeshUtil::GetVertexCorners(const std::vector<unsigned int> &indices, unsigned int numVertices,
+		std::vector<unsigned int> &offsets, std::vector<unsigned int> &corners)
+	{
+		unsigned int numCorners = indices.size() / 3 * 3;
 
-			Vector4 tangent = Vector4(x, y, z).Normalized();
+		offsets.assign(numVertices + 1, 0);
+		for (unsigned int i = 0; i < numCorners; i++)
+			offsets[indices[i] + 1]++;
+		for (unsigned int i = 0; i < numVertices; i++)
+			offsets[i + 1] += offsets[i];
 
-			x = tangent.x;
-			y = tangent.y;
-			z = tangent.z;
-		}
+		corners.resize(numCorners);
+		std::vector<unsigned int> cursor(offsets.begin(), offsets.end() - 1);
+		for (unsigned int i = 0; i < numCorners; i++)
+			corners[cursor[indices[i]]++] = i;
 	}
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #ifndef _FURY_MESHUTIL_H_
 #define _FURY_MESHUTIL_H_
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "Macros.h"
 #include "Fury/Matrix4.h"
@@ -31,6 +33,9 @@ namespace fury
 
 	public:
 
+		// meshes with more vertices than this are processed on the thread pool, if there is one.
+		static const unsigned int ParallelThreshold = 65536;
+
 		static std::shared_ptr<Mesh> GetUnitCube();
 
 		static std::shared_ptr<Mesh> GetUnitQuad();
@@ -57,14 +62,28 @@ namespace fury
 		static void TransformMesh(const std::shared_ptr<Mesh> &mesh, const Matrix4 &matrix, bool updateBuffer = false);
 
 		// restruct mesh's data by finding & removing possible reapet vertices.
-		static void OptimizeMesh(const std::shared_ptr<Mesh> &mesh);
+		// vertices are welded through a spatial hash, large meshes in parallel unless allowParallel is false.
+		// the result doesn't depend on the thread count.
+		static void OptimizeMesh(const std::shared_ptr<Mesh> &mesh, bool allowParallel = true);
 
 		// you should calculate normal first, then optimize ur mesh.
-		static void CalculateNormal(const std::shared_ptr<Mesh> &mesh);
+		// large meshes are processed in parallel, the result doesn't depend on the thread count.
+		static void CalculateNormal(const std::shared_ptr<Mesh> &mesh, bool allowParallel = true);
 
-		// TODO: test
 		// you should calculate normal first, then calculate tangent.
-		static void CalculateTangent(const std::shared_ptr<Mesh> &mesh);
+		// tangents follow mikktspace: unit face tangents projected onto the vertex normal and angle weighted.
+		// there's no bitangent sign, tangents are stored as xyz.
+		static void CalculateTangent(const std::shared_ptr<Mesh> &mesh, bool allowParallel = true);
+
+	private:
+
+		// calls func(begin, end) for ranges covering [0, count), on the thread pool if count is large enough.
+		static void ParallelRanges(unsigned int count, bool allowParallel, const std::function<void(unsigned int, unsigned int)> &func);
+
+		// corners (triangle * 3 + i) using each vertex, in ascending order.
+		// vertex i's corners are corners[offsets[i]] to corners[offsets[i + 1]].
+		static void GetVertexCorners(const std::vector<unsigned int> &indices, unsigned int numVertices,
+			std::vector<unsigned int> &offsets, std::vector<unsigned int> &corners);
 	};
 }
 
@@ -0,0 +1,1940 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <unordered_set>
+
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+
+#include "Fury/AnimationClip.h"
+#include "Fury/MathUtil.h"
+#include "Fury/EntityManager.h"
+#include "Fury/Joint.h"
+#include "Fury/Log.h"
+#include "Fury/Material.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/MeshUtil.h"
+#include "Fury/ModelParser.h"
+#include "Fury/Scene.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Texture.h"
+#include "Fury/ThreadUtil.h"
+#include "Fury/Uniform.h"
+
+namespace fury
+{
+	namespace
+	{
+		inline bool IsDigit(char c)
+		{
+			return (unsigned char)(c - '0') < 10;
+		}
+
+		inline bool IsSpace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\r';
+		}
+
+		inline uint64_t LoadEightBytes(const char* str)
+		{
+			uint64_t value;
+			std::memcpy(&value, str, sizeof(uint64_t));
+			return value;
+		}
+
+		// swar: tests 8 ascii chars in one 64bit word (little endian).
+		inline bool IsEightDigits(uint64_t value)
+		{
+			return (((value & 0xF0F0F0F0F0F0F0F0ULL) |
+				(((value + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL);
+		}
+
+		inline uint32_t ParseEightDigits(uint64_t value)
+		{
+			const uint64_t mask = 0x000000FF000000FFULL;
+			const uint64_t mul1 = 0x000F424000000064ULL; // 100 + (1000000ULL << 32)
+			const uint64_t mul2 = 0x0000271000000001ULL; // 1 + (10000ULL << 32)
+			value -= 0x3030303030303030ULL;
+			value = (value * 10) + (value >> 8);
+			value = (((value & mask) * mul1) + (((value >> 16) & mask) * mul2)) >> 32;
+			return (uint32_t)value;
+		}
+
+		const double Pow10Table[] =
+		{
+			1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+		};
+
+		inline const char* SkipSpace(const char* str, const char* end)
+		{
+			while (str < end && IsSpace(*str))
+				str++;
+			return str;
+		}
+
+		inline const char* NextLine(const char* str, const char* end)
+		{
+			auto ptr = (const char*)std::memchr(str, '\n', end - str);
+			return ptr == nullptr ? end : ptr + 1;
+		}
+
+		inline const char* ParseName(const char* str, const char* end, std::string &name)
+		{
+			str = SkipSpace(str, end);
+			const char* last = str;
+			while (last < end && *last != '\n')
+				last++;
+			const char* next = last;
+			while (last > str && IsSpace(*(last - 1)))
+				last--;
+			name.assign(str, last);
+			return next;
+		}
+
+		std::string GetExtension(const std::string &path)
+		{
+			auto pos = path.find_last_of('.');
+			std::string ext = pos == std::string::npos ? "" : path.substr(pos + 1);
+			std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+			return ext;
+		}
+
+		std::string GetStem(const std::string &path)
+		{
+			auto begin = path.find_last_of("\\/");
+			begin = begin == std::string::npos ? 0 : begin + 1;
+			auto end = path.find_last_of('.');
+			if (end == std::string::npos || end < begin)
+				end = path.size();
+			return path.substr(begin, end - begin);
+		}
+
+		// runs func(0..count-1) as at most numThreads ThreadUtil tasks, blocking until all are done.
+		// without ThreadUtil everything runs on the calling thread.
+		void RunParallel(unsigned int count, unsigned int numThreads, const std::function<void(unsigned int)> &func)
+		{
+			numThreads = std::min(count, numThreads);
+
+			auto &threadUtil = ThreadUtil::Instance();
+			if (numThreads < 2 || threadUtil == nullptr)
+			{
+				for (unsigned int i = 0; i < count; i++)
+					func(i);
+				return;
+			}
+
+			threadUtil->ParallelFor(0, count, (count + numThreads - 1) / numThreads, func);
+		}
+
+		void DecomposeMatrix(const Matrix4 &matrix, Vector4 &position, Quaternion &rotation, Vector4 &scale)
+		{
+			const float* m = matrix.Raw;
+
+			position = Vector4(m[12], m[13], m[14]);
+			scale = Vector4(
+				std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]),
+				std::sqrt(m[4] * m[4] + m[5] * m[5] + m[6] * m[6]),
+				std::sqrt(m[8] * m[8] + m[9] * m[9] + m[10] * m[10]));
+
+			float sx = scale.x > 0.0f ? 1.0f / scale.x : 0.0f;
+			float sy = scale.y > 0.0f ? 1.0f / scale.y : 0.0f;
+			float sz = scale.z > 0.0f ? 1.0f / scale.z : 0.0f;
+
+			// r[row][col]
+			float r00 = m[0] * sx, r10 = m[1] * sx, r20 = m[2] * sx;
+			float r01 = m[4] * sy, r11 = m[5] * sy, r21 = m[6] * sy;
+			float r02 = m[8] * sz, r12 = m[9] * sz, r22 = m[10] * sz;
+
+			float trace = r00 + r11 + r22;
+			if (trace > 0.0f)
+			{
+				float s = 0.5f / std::sqrt(trace + 1.0f);
+				rotation = Quaternion((r21 - r12) * s, (r02 - r20) * s, (r10 - r01) * s, 0.25f / s);
+			}
+			else if (r00 > r11 && r00 > r22)
+			{
+				float s = 2.0f * std::sqrt(1.0f + r00 - r11 - r22);
+				rotation = Quaternion(0.25f * s, (r01 + r10) / s, (r02 + r20) / s, (r21 - r12) / s);
+			}
+			else if (r11 > r22)
+			{
+				float s = 2.0f * std::sqrt(1.0f + r11 - r00 - r22);
+				rotation = Quaternion((r01 + r10) / s, 0.25f * s, (r12 + r21) / s, (r02 - r20) / s);
+			}
+			else
+			{
+				float s = 2.0f * std::sqrt(1.0f + r22 - r00 - r11);
+				rotation = Quaternion((r02 + r20) / s, (r12 + r21) / s, 0.25f * s, (r10 - r01) / s);
+			}
+		}
+
+		// obj face corner, -1 means the attribute is absent.
+		struct ObjCorner
+		{
+			int v, vt, vn;
+
+			bool operator == (const ObjCorner &other) const
+			{
+				return v == other.v && vt == other.vt && vn == other.vn;
+			}
+		};
+
+		struct ObjCornerHash
+		{
+			size_t operator()(const ObjCorner &corner) const
+			{
+				size_t hash = (size_t)corner.v * 73856093u;
+				hash ^= (size_t)corner.vt * 19349663u;
+				hash ^= (size_t)corner.vn * 83492791u;
+				return hash;
+			}
+		};
+
+		enum class ObjEventType
+		{
+			OBJECT,
+			MATERIAL
+		};
+
+		struct ObjEvent
+		{
+			ObjEventType type;
+
+			size_t corner;
+
+			std::string name;
+		};
+
+		struct ObjChunk
+		{
+			const char* begin = nullptr;
+
+			const char* end = nullptr;
+
+			size_t numV = 0, numVT = 0, numVN = 0, numF = 0;
+
+			size_t offsetV = 0, offsetVT = 0, offsetVN = 0;
+
+			std::vector<ObjCorner> corners;
+
+			std::vector<ObjEvent> events;
+
+			std::vector<std::string> mtllibs;
+		};
+
+		struct ObjRange
+		{
+			unsigned int chunk;
+
+			size_t begin, end;
+
+			std::string material;
+		};
+
+		struct ObjObject
+		{
+			std::string name;
+
+			std::vector<ObjRange> ranges;
+		};
+
+		struct GltfAccessor
+		{
+			const unsigned char* data = nullptr;
+
+			size_t count = 0;
+
+			size_t stride = 0;
+
+			unsigned int componentType = 0;
+
+			unsigned int numComponents = 0;
+
+			bool normalized = false;
+		};
+
+		inline float ReadComponent(const unsigned char* ptr, unsigned int type, bool normalized)
+		{
+			switch (type)
+			{
+			case 5120:
+			{
+				int8_t value; std::memcpy(&value, ptr, 1);
+				return normalized ? std::max(value / 127.0f, -1.0f) : (float)value;
+			}
+			case 5121:
+				return normalized ? *ptr / 255.0f : (float)*ptr;
+			case 5122:
+			{
+				int16_t value; std::memcpy(&value, ptr, 2);
+				return normalized ? std::max(value / 32767.0f, -1.0f) : (float)value;
+			}
+			case 5123:
+			{
+				uint16_t value; std::memcpy(&value, ptr, 2);
+				return normalized ? value / 65535.0f : (float)value;
+			}
+			case 5125:
+			{
+				uint32_t value; std::memcpy(&value, ptr, 4);
+				return (float)value;
+			}
+			case 5126:
+			{
+				float value; std::memcpy(&value, ptr, 4);
+				return value;
+			}
+			}
+			return 0.0f;
+		}
+
+		inline unsigned int ReadIndex(const unsigned char* ptr, unsigned int type)
+		{
+			switch (type)
+			{
+			case 5121:
+				return *ptr;
+			case 5123:
+			{
+				uint16_t value; std::memcpy(&value, ptr, 2);
+				return value;
+			}
+			case 5125:
+			{
+				uint32_t value; std::memcpy(&value, ptr, 4);
+				return value;
+			}
+			}
+			return 0;
+		}
+
+		inline unsigned int ComponentSize(unsigned int type)
+		{
+			switch (type)
+			{
+			case 5120: case 5121: return 1;
+			case 5122: case 5123: return 2;
+			default: return 4;
+			}
+		}
+
+		bool DecodeBase64(const char* str, size_t length, std::vector<unsigned char> &output)
+		{
+			static const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+			output.clear();
+			output.reserve(length * 3 / 4);
+
+			unsigned int buffer = 0;
+			int bits = 0;
+			for (size_t i = 0; i < length; i++)
+			{
+				char c = str[i];
+				if (c == '=')
+					break;
+
+				auto pos = chars.find(c);
+				if (pos == std::string::npos)
+					return false;
+
+				buffer = (buffer << 6) | (unsigned int)pos;
+				bits += 6;
+				if (bits >= 8)
+				{
+					bits -= 8;
+					output.push_back((unsigned char)((buffer >> bits) & 0xFF));
+				}
+			}
+
+			return true;
+		}
+
+		enum class GltfType
+		{
+			OBJECT, STRING, BOOL, NUMBER, NUMBER_ARRAY, UINT_ARRAY, OBJECT_ARRAY
+		};
+
+		bool IsGltfType(const rapidjson::Value &value, GltfType type)
+		{
+			switch (type)
+			{
+			case GltfType::OBJECT: return value.IsObject();
+			case GltfType::STRING: return value.IsString();
+			case GltfType::BOOL: return value.IsBool();
+			case GltfType::NUMBER: return value.IsNumber();
+			default: break;
+			}
+
+			if (!value.IsArray())
+				return false;
+
+			for (rapidjson::SizeType i = 0; i < value.Size(); i++)
+			{
+				bool valid = type == GltfType::NUMBER_ARRAY ? value[i].IsNumber() :
+					type == GltfType::UINT_ARRAY ? value[i].IsUint() : value[i].IsObject();
+				if (!valid)
+					return false;
+			}
+			return true;
+		}
+
+		// true if object's member key is missing and optional, or has the given type.
+		bool CheckGltfMember(const rapidjson::Value &object, const char* key, GltfType type, bool required,
+			const std::string &path, std::string &error)
+		{
+			auto it = object.FindMember(key);
+			if (it == object.MemberEnd() ? required : !IsGltfType(it->value, type))
+			{
+				error = path + "." + key + (it == object.MemberEnd() ? " is missing" : " has a wrong type");
+				return false;
+			}
+			return true;
+		}
+
+		// checks the parts of a gltf document the loader reads without testing them, so a malformed
+		// file fails with a message instead of tripping rapidjson's asserts.
+		bool ValidateGltf(const rapidjson::Value &dom, std::string &error)
+		{
+			using rapidjson::SizeType;
+			using rapidjson::Value;
+
+			static const char* arrays[] = { "buffers", "bufferViews", "accessors", "materials", "textures",
+				"images", "nodes", "meshes", "skins", "scenes", "animations" };
+			for (auto key : arrays)
+			{
+				if (!CheckGltfMember(dom, key, GltfType::OBJECT_ARRAY, false, "gltf", error))
+					return false;
+			}
+
+			// calls func(element, path) for every element of a validated top level array.
+			auto ForEach = [&dom](const char* key, const std::function<bool(const Value&, const std::string&)> &func) -> bool
+			{
+				auto it = dom.FindMember(key);
+				if (it != dom.MemberEnd())
+				{
+					for (SizeType i = 0; i < it->value.Size(); i++)
+					{
+						if (!func(it->value[i], std::string(key) + "[" + std::to_string(i) + "]"))
+							return false;
+					}
+				}
+				return true;
+			};
+
+			return ForEach("buffers", [&](const Value &value, const std::string &path) -> bool
+			{
+				return CheckGltfMember(value, "uri", GltfType::STRING, false, path, error);
+			}) && ForEach("accessors", [&](const Value &value, const std::string &path) -> bool
+			{
+				return CheckGltfMember(value, "type", GltfType::STRING, true, path, error) &&
+					CheckGltfMember(value, "normalized", GltfType::BOOL, false, path, error);
+			}) && ForEach("images", [&](const Value &value, const std::string &path) -> bool
+			{
+				return CheckGltfMember(value, "uri", GltfType::STRING, false, path, error);
+			}) && ForEach("materials", [&](const Value &value, const std::string &path) -> bool
+			{
+				if (!CheckGltfMember(value, "pbrMetallicRoughness", GltfType::OBJECT, false, path, error) ||
+					!CheckGltfMember(value, "emissiveFactor", GltfType::NUMBER_ARRAY, false, path, error) ||
+					!CheckGltfMember(value, "alphaMode", GltfType::STRING, false, path, error) ||
+					!CheckGltfMember(value, "normalTexture", GltfType::OBJECT, false, path, error))
+					return false;
+
+				auto pbr = value.FindMember("pbrMetallicRoughness");
+				return pbr == value.MemberEnd() ||
+					(CheckGltfMember(pbr->value, "baseColorFactor", GltfType::NUMBER_ARRAY, false, path + ".pbrMetallicRoughness", error) &&
+					CheckGltfMember(pbr->value, "roughnessFactor", GltfType::NUMBER, false, path + ".pbrMetallicRoughness", error) &&
+					CheckGltfMember(pbr->value, "baseColorTexture", GltfType::OBJECT, false, path + ".pbrMetallicRoughness", error));
+			}) && ForEach("nodes", [&](const Value &value, const std::string &path) -> bool
+			{
+				return CheckGltfMember(value, "children", GltfType::UINT_ARRAY, false, path, error) &&
+					CheckGltfMember(value, "matrix", GltfType::NUMBER_ARRAY, false, path, error) &&
+					CheckGltfMember(value, "translation", GltfType::NUMBER_ARRAY, false, path, error) &&
+					CheckGltfMember(value, "rotation", GltfType::NUMBER_ARRAY, false, path, error) &&
+					CheckGltfMember(value, "scale", GltfType::NUMBER_ARRAY, false, path, error);
+			}) && ForEach("meshes", [&](const Value &value, const std::string &path) -> bool
+			{
+				if (!CheckGltfMember(value, "primitives", GltfType::OBJECT_ARRAY, true, path, error))
+					return false;
+
+				auto &primitives = value["primitives"];
+				for (SizeType i = 0; i < primitives.Size(); i++)
+				{
+					if (!CheckGltfMember(primitives[i], "attributes", GltfType::OBJECT, true, path + ".primitives[" + std::to_string(i) + "]", error))
+						return false;
+				}
+				return true;
+			}) && ForEach("skins", [&](const Value &value, const std::string &path) -> bool
+			{
+				return CheckGltfMember(value, "joints", GltfType::UINT_ARRAY, false, path, error);
+			}) && ForEach("scenes", [&](const Value &value, const std::string &path) -> bool
+			{
+				return CheckGltfMember(value, "nodes", GltfType::UINT_ARRAY, false, path, error);
+			}) && ForEach("animations", [&](const Value &value, const std::string &path) -> bool
+			{
+				if (!CheckGltfMember(value, "samplers", GltfType::OBJECT_ARRAY, true, path, error) ||
+					!CheckGltfMember(value, "channels", GltfType::OBJECT_ARRAY, true, path, error))
+					return false;
+
+				auto &samplers = value["samplers"];
+				for (SizeType i = 0; i < samplers.Size(); i++)
+				{
+					if (!CheckGltfMember(samplers[i], "interpolation", GltfType::STRING, false, path + ".samplers[" + std::to_string(i) + "]", error))
+						return false;
+				}
+
+				auto &channels = value["channels"];
+				for (SizeType i = 0; i < channels.Size(); i++)
+				{
+					std::string channelPath = path + ".channels[" + std::to_string(i) + "]";
+					if (!CheckGltfMember(channels[i], "target", GltfType::OBJECT, true, channelPath, error) ||
+						!CheckGltfMember(channels[i]["target"], "path", GltfType::STRING, true, channelPath + ".target", error))
+						return false;
+				}
+				return true;
+			});
+		}
+	}
+
+	const char* ModelParser::ParseFloat(const char* str, const char* end, float &value)
+	{
+		const char* ptr = str;
+		bool negative = false;
+
+		if (ptr < end && (*ptr == '-' || *ptr == '+'))
+		{
+			negative = *ptr == '-';
+			ptr++;
+		}
+
+		uint64_t mantissa = 0;
+		int exponent = 0, digits = 0;
+		const char* digitStart = ptr;
+
+		while (end - ptr >= 8 && IsEightDigits(LoadEightBytes(ptr)))
+		{
+			mantissa = mantissa * 100000000 + ParseEightDigits(LoadEightBytes(ptr));
+			ptr += 8;
+		}
+		while (ptr < end && IsDigit(*ptr))
+		{
+			mantissa = mantissa * 10 + (uint64_t)(*ptr - '0');
+			ptr++;
+		}
+		digits = (int)(ptr - digitStart);
+
+		if (ptr < end && *ptr == '.')
+		{
+			ptr++;
+			const char* fracStart = ptr;
+			while (end - ptr >= 8 && IsEightDigits(LoadEightBytes(ptr)))
+			{
+				mantissa = mantissa * 100000000 + ParseEightDigits(LoadEightBytes(ptr));
+				ptr += 8;
+			}
+			while (ptr < end && IsDigit(*ptr))
+			{
+				mantissa = mantissa * 10 + (uint64_t)(*ptr - '0');
+				ptr++;
+			}
+			exponent = -(int)(ptr - fracStart);
+			digits += (int)(ptr - fracStart);
+		}
+
+		if (digits == 0)
+			return str;
+
+		if (ptr < end && (*ptr == 'e' || *ptr == 'E'))
+		{
+			const char* expPtr = ptr + 1;
+			bool expNegative = false;
+			if (expPtr < end && (*expPtr == '-' || *expPtr == '+'))
+			{
+				expNegative = *expPtr == '-';
+				expPtr++;
+			}
+
+			if (expPtr < end && IsDigit(*expPtr))
+			{
+				int expValue = 0;
+				while (expPtr < end && IsDigit(*expPtr))
+				{
+					if (expValue < 10000)
+						expValue = expValue * 10 + (*expPtr - '0');
+					expPtr++;
+				}
+				exponent += expNegative ? -expValue : expValue;
+				ptr = expPtr;
+			}
+		}
+
+		// more than 19 significant digits could overflow the mantissa, leave those to strtod.
+		if (digits > 19)
+		{
+			char* strEnd = nullptr;
+			value = std::strtof(str, &strEnd);
+			return strEnd;
+		}
+
+		double result = (double)mantissa;
+		if (exponent < 0)
+			result = exponent >= -22 ? result / Pow10Table[-exponent] : result * std::pow(10.0, exponent);
+		else if (exponent > 0)
+			result = exponent <= 22 ? result * Pow10Table[exponent] : result * std::pow(10.0, exponent);
+
+		value = (float)(negative ? -result : result);
+		return ptr;
+	}
+
+	const char* ModelParser::ParseInt(const char* str, const char* end, int &value)
+	{
+		const char* ptr = str;
+		bool negative = false;
+
+		if (ptr < end && (*ptr == '-' || *ptr == '+'))
+		{
+			negative = *ptr == '-';
+			ptr++;
+		}
+
+		if (ptr == end || !IsDigit(*ptr))
+			return str;
+
+		int result = 0;
+		while (ptr < end && IsDigit(*ptr))
+		{
+			result = result * 10 + (*ptr - '0');
+			ptr++;
+		}
+
+		value = negative ? -result : result;
+		return ptr;
+	}
+
+	bool ModelParser::LoadScene(const std::string &filePath, const std::shared_ptr<SceneNode> &rootNode, ModelImportOptions importOptions)
+	{
+		auto ext = GetExtension(filePath);
+		if (ext == "obj")
+			return LoadObj(filePath, rootNode, importOptions);
+		else if (ext == "gltf" || ext == "glb")
+			return LoadGltf(filePath, rootNode, importOptions);
+
+		FURYE << "Unsupported model format: " << filePath;
+		return false;
+	}
+
+	bool ModelParser::LoadObj(const std::string &filePath, const std::shared_ptr<SceneNode> &rootNode, ModelImportOptions importOptions)
+	{
+		if (Scene::Active == nullptr)
+		{
+			FURYW << "Active Scene is null!";
+			return false;
+		}
+
+		m_ImportOptions = importOptions;
+
+		size_t pos = filePath.find_last_of("\\/");
+		m_ModelFolder = (std::string::npos == pos) ? "" : filePath.substr(0, pos + 1);
+
+		auto startTime = std::chrono::steady_clock::now();
+
+		std::vector<char> buffer;
+		if (!ReadFile(filePath, buffer))
+			return false;
+
+		// buffer is null terminated, the terminator isn't part of the text.
+		const char* textBegin = buffer.data();
+		const char* textEnd = buffer.data() + buffer.size() - 1;
+		size_t textSize = textEnd - textBegin;
+
+		// split into chunks at line boundaries.
+		unsigned int numChunks = GetNumThreads(textSize);
+		std::vector<ObjChunk> chunks(numChunks);
+		{
+			const char* chunkBegin = textBegin;
+			for (unsigned int i = 0; i < numChunks; i++)
+			{
+				const char* chunkEnd = i == numChunks - 1 ? textEnd :
+					NextLine(std::max(chunkBegin, textBegin + textSize * (i + 1) / numChunks), textEnd);
+				chunks[i].begin = chunkBegin;
+				chunks[i].end = chunkEnd;
+				chunkBegin = chunkEnd;
+			}
+		}
+
+		// pass 1, count elements per chunk so vertex data can be written in place.
+		RunParallel(numChunks, numChunks, [&](unsigned int index)
+		{
+			auto &chunk = chunks[index];
+			const char* ptr = chunk.begin;
+			while (ptr < chunk.end)
+			{
+				ptr = SkipSpace(ptr, chunk.end);
+				if (chunk.end - ptr > 1)
+				{
+					if (ptr[0] == 'v')
+					{
+						if (IsSpace(ptr[1]))
+							chunk.numV++;
+						else if (ptr[1] == 't')
+							chunk.numVT++;
+						else if (ptr[1] == 'n')
+							chunk.numVN++;
+					}
+					else if (ptr[0] == 'f' && IsSpace(ptr[1]))
+					{
+						chunk.numF++;
+					}
+				}
+				ptr = NextLine(ptr, chunk.end);
+			}
+		});
+
+		size_t numV = 0, numVT = 0, numVN = 0;
+		for (auto &chunk : chunks)
+		{
+			chunk.offsetV = numV;
+			chunk.offsetVT = numVT;
+			chunk.offsetVN = numVN;
+			numV += chunk.numV;
+			numVT += chunk.numVT;
+			numVN += chunk.numVN;
+		}
+
+		std::vector<float> positions(numV * 3), uvs(numVT * 2), normals(numVN * 3);
+
+		// pass 2, parse.
+		RunParallel(numChunks, numChunks, [&](unsigned int index)
+		{
+			auto &chunk = chunks[index];
+			const char* ptr = chunk.begin;
+			const char* end = chunk.end;
+
+			size_t curV = chunk.offsetV, curVT = chunk.offsetVT, curVN = chunk.offsetVN;
+			std::vector<ObjCorner> polygon;
+			std::string name;
+
+			chunk.corners.reserve(chunk.numF * 3);
+
+			auto ResolveIndex = [](int value, size_t count) -> int
+			{
+				if (value > 0)
+					return value - 1;
+				if (value < 0)
+					return (int)count + value;
+				return -1;
+			};
+
+			while (ptr < end)
+			{
+				ptr = SkipSpace(ptr, end);
+				if (ptr == end)
+					break;
+
+				const char* lineEnd = NextLine(ptr, end);
+
+				if (ptr[0] == 'v' && end - ptr > 1)
+				{
+					if (IsSpace(ptr[1]))
+					{
+						float* dst = &positions[curV * 3];
+						const char* cur = ptr + 1;
+						for (int i = 0; i < 3; i++)
+							cur = ParseFloat(SkipSpace(cur, lineEnd), lineEnd, dst[i]);
+						curV++;
+					}
+					else if (ptr[1] == 't')
+					{
+						float* dst = &uvs[curVT * 2];
+						const char* cur = ptr + 2;
+						dst[0] = dst[1] = 0.0f;
+						for (int i = 0; i < 2; i++)
+							cur = ParseFloat(SkipSpace(cur, lineEnd), lineEnd, dst[i]);
+						dst[1] = 1.0f - dst[1];
+						curVT++;
+					}
+					else if (ptr[1] == 'n')
+					{
+						float* dst = &normals[curVN * 3];
+						const char* cur = ptr + 2;
+						for (int i = 0; i < 3; i++)
+							cur = ParseFloat(SkipSpace(cur, lineEnd), lineEnd, dst[i]);
+						curVN++;
+					}
+				}
+				else if (ptr[0] == 'f' && end - ptr > 1 && IsSpace(ptr[1]))
+				{
+					const char* cur = ptr + 1;
+					polygon.clear();
+
+					while (true)
+					{
+						cur = SkipSpace(cur, lineEnd);
+						int v = 0, vt = 0, vn = 0;
+						const char* next = ParseInt(cur, lineEnd, v);
+						if (next == cur)
+							break;
+						cur = next;
+
+						if (cur < lineEnd && *cur == '/')
+						{
+							cur = ParseInt(cur + 1, lineEnd, vt);
+							if (cur < lineEnd && *cur == '/')
+								cur = ParseInt(cur + 1, lineEnd, vn);
+						}
+
+						ObjCorner corner;
+						corner.v = ResolveIndex(v, curV);
+						corner.vt = ResolveIndex(vt, curVT);
+						corner.vn = ResolveIndex(vn, curVN);
+						polygon.push_back(corner);
+					}
+
+					// triangulate as fan.
+					for (unsigned int i = 2; i < polygon.size(); i++)
+					{
+						chunk.corners.push_back(polygon[0]);
+						chunk.corners.push_back(polygon[i - 1]);
+						chunk.corners.push_back(polygon[i]);
+					}
+				}
+				else if (std::strncmp(ptr, "usemtl", 6) == 0 && IsSpace(ptr[6]))
+				{
+					ParseName(ptr + 6, lineEnd, name);
+					chunk.events.push_back({ ObjEventType::MATERIAL, chunk.corners.size(), name });
+				}
+				else if ((ptr[0] == 'o' || ptr[0] == 'g') && end - ptr > 1 && IsSpace(ptr[1]))
+				{
+					ParseName(ptr + 1, lineEnd, name);
+					chunk.events.push_back({ ObjEventType::OBJECT, chunk.corners.size(), name });
+				}
+				else if (std::strncmp(ptr, "mtllib", 6) == 0 && IsSpace(ptr[6]))
+				{
+					ParseName(ptr + 6, lineEnd, name);
+					chunk.mtllibs.push_back(name);
+				}
+
+				ptr = lineEnd;
+			}
+		});
+
+		auto parseTime = std::chrono::steady_clock::now();
+
+		// group faces by object and material, in file order.
+		std::vector<ObjObject> objects;
+		{
+			std::string curObject = GetStem(filePath), curMaterial;
+			objects.push_back({ curObject, {} });
+
+			for (unsigned int i = 0; i < numChunks; i++)
+			{
+				auto &chunk = chunks[i];
+				size_t begin = 0;
+
+				auto Flush = [&](size_t end)
+				{
+					if (end > begin)
+						objects.back().ranges.push_back({ i, begin, end, curMaterial });
+					begin = end;
+				};
+
+				for (auto &event : chunk.events)
+				{
+					Flush(event.corner);
+					if (event.type == ObjEventType::OBJECT)
+					{
+						auto name = event.name.size() > 0 ? event.name : GetStem(filePath) + "_" + std::to_string(objects.size());
+						if (objects.back().ranges.size() == 0)
+							objects.back().name = name;
+						else
+							objects.push_back({ name, {} });
+					}
+					else
+					{
+						curMaterial = event.name;
+					}
+				}
+				Flush(chunk.corners.size());
+			}
+
+			objects.erase(std::remove_if(objects.begin(), objects.end(),
+				[](const ObjObject &object) { return object.ranges.size() == 0; }), objects.end());
+		}
+
+		std::unordered_map<std::string, std::shared_ptr<Material>> materials;
+		for (auto &chunk : chunks)
+			for (auto &mtllib : chunk.mtllibs)
+				LoadObjMaterials(m_ModelFolder + mtllib, materials);
+
+		// create mesh objects here, fill them in parallel.
+		std::vector<Mesh::Ptr> meshes(objects.size());
+		std::vector<bool> fillMesh(objects.size(), false);
+		std::vector<std::vector<std::string>> objectMaterials(objects.size());
+		std::vector<std::vector<SubMesh::Ptr>> objectSubMeshes(objects.size());
+
+		for (unsigned int i = 0; i < objects.size(); i++)
+		{
+			// one submesh per material, in order of first use.
+			auto &usedMaterials = objectMaterials[i];
+			for (auto &range : objects[i].ranges)
+				if (std::find(usedMaterials.begin(), usedMaterials.end(), range.material) == usedMaterials.end())
+					usedMaterials.push_back(range.material);
+
+			meshes[i] = Scene::Manager()->Get<Mesh>(objects[i].name);
+			if (meshes[i] == nullptr)
+			{
+				meshes[i] = Mesh::Create(objects[i].name);
+				fillMesh[i] = true;
+
+				if (usedMaterials.size() > 1)
+					for (unsigned int j = 0; j < usedMaterials.size(); j++)
+						objectSubMeshes[i].push_back(SubMesh::Create());
+			}
+		}
+
+		bool importUV = m_ImportOptions.ImportUV && numVT > 0;
+		bool importNormal = m_ImportOptions.ImportNormal && numVN > 0;
+
+		RunParallel(objects.size(), GetNumThreads(textSize), [&](unsigned int index)
+		{
+			if (!fillMesh[index])
+				return;
+
+			auto &object = objects[index];
+			auto &mesh = meshes[index];
+			auto &usedMaterials = objectMaterials[index];
+			auto &subMeshes = objectSubMeshes[index];
+
+			std::unordered_map<ObjCorner, unsigned int, ObjCornerHash> vertexMap;
+
+			size_t numCorners = 0;
+			for (auto &range : object.ranges)
+				numCorners += range.end - range.begin;
+
+			vertexMap.reserve(numCorners);
+			mesh->Indices.Data.reserve(numCorners);
+
+			for (auto &range : object.ranges)
+			{
+				std::vector<unsigned int>* subIndices = nullptr;
+				if (subMeshes.size() > 0)
+				{
+					auto it = std::find(usedMaterials.begin(), usedMaterials.end(), range.material);
+					subIndices = &subMeshes[it - usedMaterials.begin()]->Indices.Data;
+				}
+
+				auto &corners = chunks[range.chunk].corners;
+				for (size_t i = range.begin; i < range.end; i++)
+				{
+					ObjCorner corner = corners[i];
+					if (!importUV) corner.vt = -1;
+					if (!importNormal) corner.vn = -1;
+
+					auto result = vertexMap.emplace(corner, (unsigned int)vertexMap.size());
+					if (result.second)
+					{
+						bool validV = corner.v >= 0 && (size_t)corner.v < numV;
+						for (int j = 0; j < 3; j++)
+							mesh->Positions.Data.push_back(validV ? positions[corner.v * 3 + j] : 0.0f);
+
+						if (importUV)
+						{
+							bool valid = corner.vt >= 0 && (size_t)corner.vt < numVT;
+							for (int j = 0; j < 2; j++)
+								mesh->UVs.Data.push_back(valid ? uvs[corner.vt * 2 + j] : 0.0f);
+						}
+
+						if (importNormal)
+						{
+							bool valid = corner.vn >= 0 && (size_t)corner.vn < numVN;
+							for (int j = 0; j < 3; j++)
+								mesh->Normals.Data.push_back(valid ? normals[corner.vn * 3 + j] : 0.0f);
+						}
+					}
+
+					mesh->Indices.Data.push_back(result.first->second);
+					if (subIndices != nullptr)
+						subIndices->push_back(result.first->second);
+				}
+			}
+
+			for (auto &subMesh : subMeshes)
+				mesh->AddSubMesh(subMesh);
+
+			PostProcessMesh(mesh, importNormal, importUV);
+		});
+
+		for (unsigned int i = 0; i < objects.size(); i++)
+		{
+			auto &object = objects[i];
+			auto &mesh = meshes[i];
+
+			if (fillMesh[i])
+			{
+				Scene::Manager()->Add(mesh);
+				FURYD << mesh->GetName() << " [vtx: " << mesh->Positions.Data.size() / 3 << " tris: " << mesh->Indices.Data.size() / 3 << "]";
+			}
+
+			auto node = SceneNode::Create(object.name);
+			rootNode->AddChild(node);
+
+			auto meshRender = MeshRender::Create(nullptr, mesh);
+			node->AddComponent(meshRender);
+
+			auto &usedMaterials = objectMaterials[i];
+			for (unsigned int j = 0; j < usedMaterials.size(); j++)
+			{
+				auto it = materials.find(usedMaterials[j]);
+				if (it != materials.end())
+					meshRender->SetMaterial(it->second, j);
+			}
+
+			node->SetLocalScale(m_ImportOptions.ScaleFactor);
+			node->Recompose();
+		}
+
+		auto endTime = std::chrono::steady_clock::now();
+		double parseMs = std::chrono::duration<double, std::milli>(parseTime - startTime).count();
+		double totalMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+		double mb = textSize / (1024.0 * 1024.0);
+
+		FURYD << filePath << ": " << mb << " MB, " << numChunks << " chunks, parsed in " << parseMs << " ms ("
+			<< (parseMs > 0.0 ? mb * 1000.0 / parseMs : 0.0) << " MB/s), total " << totalMs << " ms.";
+
+		m_Textures.clear();
+
+		return true;
+	}
+
+	void ModelParser::LoadObjMaterials(const std::string &filePath, std::unordered_map<std::string, std::shared_ptr<Material>> &materials)
+	{
+		std::vector<char> buffer;
+		if (!ReadFile(filePath, buffer))
+			return;
+
+		size_t pos = filePath.find_last_of("\\/");
+		std::string folder = (std::string::npos == pos) ? "" : filePath.substr(0, pos + 1);
+
+		const char* ptr = buffer.data();
+		const char* end = buffer.data() + buffer.size() - 1;
+
+		Material::Ptr material = nullptr;
+		std::string name;
+
+		auto ParseColor = [](const char* str, const char* lineEnd) -> UniformBase::Ptr
+		{
+			float rgb[3] = { 0.0f, 0.0f, 0.0f };
+			for (int i = 0; i < 3; i++)
+				str = ParseFloat(SkipSpace(str, lineEnd), lineEnd, rgb[i]);
+			return Uniform3f::Create({ rgb[0], rgb[1], rgb[2] });
+		};
+
+		auto ParseValue = [](const char* str, const char* lineEnd) -> float
+		{
+			float value = 0.0f;
+			ParseFloat(SkipSpace(str, lineEnd), lineEnd, value);
+			return value;
+		};
+
+		auto Match = [](const char* str, const char* end, const char* token) -> bool
+		{
+			size_t length = std::strlen(token);
+			return (size_t)(end - str) > length && std::strncmp(str, token, length) == 0 && IsSpace(str[length]);
+		};
+
+		while (ptr < end)
+		{
+			ptr = SkipSpace(ptr, end);
+			const char* lineEnd = NextLine(ptr, end);
+
+			if (Match(ptr, end, "newmtl"))
+			{
+				ParseName(ptr + 6, lineEnd, name);
+				material = Scene::Manager()->Get<Material>(name);
+				if (material == nullptr)
+				{
+					material = Material::Create(name);
+					material->SetUniform(Material::AMBIENT_FACTOR, Uniform1f::Create({ 1.0f }));
+					material->SetUniform(Material::DIFFUSE_FACTOR, Uniform1f::Create({ 1.0f }));
+					material->SetUniform(Material::SPECULAR_FACTOR, Uniform1f::Create({ 1.0f }));
+					material->SetUniform(Material::EMISSIVE_FACTOR, Uniform1f::Create({ 1.0f }));
+					material->SetUniform(Material::TRANSPARENCY, Uniform1f::Create({ 0.0f }));
+					material->SetUniform(Material::MATERIAL_ID, Uniform1ui::Create({ material->GetID() }));
+					Scene::Manager()->Add(material);
+				}
+				materials[name] = material;
+			}
+			else if (material != nullptr)
+			{
+				if (Match(ptr, end, "Ka"))
+				{
+					material->SetUniform(Material::AMBIENT_COLOR, ParseColor(ptr + 2, lineEnd));
+				}
+				else if (Match(ptr, end, "Kd"))
+				{
+					material->SetUniform(Material::DIFFUSE_COLOR, ParseColor(ptr + 2, lineEnd));
+				}
+				else if (Match(ptr, end, "Ks"))
+				{
+					material->SetUniform(Material::SPECULAR_COLOR, ParseColor(ptr + 2, lineEnd));
+				}
+				else if (Match(ptr, end, "Ke"))
+				{
+					material->SetUniform(Material::EMISSIVE_COLOR, ParseColor(ptr + 2, lineEnd));
+				}
+				else if (Match(ptr, end, "Ns"))
+				{
+					material->SetUniform(Material::SHININESS, Uniform1f::Create({ ParseValue(ptr + 2, lineEnd) }));
+				}
+				else if (Match(ptr, end, "d") || Match(ptr, end, "Tr"))
+				{
+					float value = ParseValue(ptr + (ptr[0] == 'd' ? 1 : 2), lineEnd);
+					float transparency = ptr[0] == 'd' ? 1.0f - value : value;
+					material->SetUniform(Material::TRANSPARENCY, Uniform1f::Create({ transparency }));
+					if (transparency > 0.0f)
+						material->SetOpaque(false);
+				}
+				else if (Match(ptr, end, "map_Kd"))
+				{
+					ParseName(ptr + 6, lineEnd, name);
+					material->SetTexture(Material::DIFFUSE_TEXTURE, LoadTexture(folder + name, true));
+				}
+				else if (Match(ptr, end, "map_Ks"))
+				{
+					ParseName(ptr + 6, lineEnd, name);
+					material->SetTexture(Material::SPECULAR_TEXTURE, LoadTexture(folder + name, false));
+				}
+				else if (Match(ptr, end, "map_Bump") || Match(ptr, end, "map_bump") || Match(ptr, end, "bump") || Match(ptr, end, "norm"))
+				{
+					const char* cur = ptr;
+					while (cur < lineEnd && !IsSpace(*cur))
+						cur++;
+					ParseName(cur, lineEnd, name);
+					// strip options like '-bm 1.0', keep the last token.
+					auto space = name.find_last_of(" \t");
+					if (space != std::string::npos)
+						name = name.substr(space + 1);
+					material->SetTexture(Material::NORMAL_TEXTURE, LoadTexture(folder + name, false));
+				}
+			}
+
+			ptr = lineEnd;
+		}
+
+		FURYD << "Loaded " << materials.size() << " materials from " << filePath;
+	}
+
+	bool ModelParser::LoadGltf(const std::string &filePath, const std::shared_ptr<SceneNode> &rootNode, ModelImportOptions importOptions)
+	{
+		using namespace rapidjson;
+
+		if (Scene::Active == nullptr)
+		{
+			FURYW << "Active Scene is null!";
+			return false;
+		}
+
+		m_ImportOptions = importOptions;
+
+		size_t pos = filePath.find_last_of("\\/");
+		m_ModelFolder = (std::string::npos == pos) ? "" : filePath.substr(0, pos + 1);
+
+		auto startTime = std::chrono::steady_clock::now();
+
+		std::vector<char> file;
+		if (!ReadFile(filePath, file))
+			return false;
+
+		size_t fileSize = file.size() - 1;
+		const char* json = file.data();
+		size_t jsonLength = fileSize;
+		const unsigned char* binChunk = nullptr;
+		size_t binLength = 0;
+
+		// glb container: 12 bytes header, then json chunk and optional bin chunk.
+		if (fileSize >= 20 && std::memcmp(file.data(), "glTF", 4) == 0)
+		{
+			uint32_t header[3], chunkHeader[2];
+			std::memcpy(header, file.data(), 12);
+			std::memcpy(chunkHeader, file.data() + 12, 8);
+
+			if (header[1] != 2 || chunkHeader[1] != 0x4E4F534A || 20 + (size_t)chunkHeader[0] > fileSize)
+			{
+				FURYE << "Invalid glb file " << filePath;
+				return false;
+			}
+
+			json = file.data() + 20;
+			jsonLength = chunkHeader[0];
+
+			size_t binOffset = 20 + jsonLength;
+			if (binOffset + 8 <= fileSize)
+			{
+				std::memcpy(chunkHeader, file.data() + binOffset, 8);
+				if (chunkHeader[1] == 0x004E4942 && binOffset + 8 + chunkHeader[0] <= fileSize)
+				{
+					binChunk = (const unsigned char*)file.data() + binOffset + 8;
+					binLength = chunkHeader[0];
+				}
+			}
+		}
+
+		Document dom;
+		dom.Parse(json, jsonLength);
+		if (dom.HasParseError())
+		{
+			FURYE << "Error parsing gltf file " << filePath << " at offset " << dom.GetErrorOffset() << ": " <<
+				GetParseError_En(dom.GetParseError());
+			return false;
+		}
+
+		if (!dom.IsObject())
+		{
+			FURYE << "Gltf file " << filePath << " root is not an object!";
+			return false;
+		}
+
+		std::string error;
+		if (!ValidateGltf(dom, error))
+		{
+			FURYE << "Malformed gltf file " << filePath << ": " << error;
+			return false;
+		}
+
+		auto GetUInt = [](const Value &value, const char* key, unsigned int defaultValue) -> unsigned int
+		{
+			auto it = value.FindMember(key);
+			return it != value.MemberEnd() && it->value.IsUint() ? it->value.GetUint() : defaultValue;
+		};
+
+		auto GetInt = [](const Value &value, const char* key) -> int
+		{
+			auto it = value.FindMember(key);
+			return it != value.MemberEnd() && it->value.IsInt() ? it->value.GetInt() : -1;
+		};
+
+		auto GetFloats = [](const Value &value, const char* key, float* output, unsigned int count) -> bool
+		{
+			auto it = value.FindMember(key);
+			if (it == value.MemberEnd() || !it->value.IsArray() || it->value.Size() < count)
+				return false;
+			for (unsigned int i = 0; i < count; i++)
+				output[i] = (float)it->value[i].GetDouble();
+			return true;
+		};
+
+		auto GetName = [](const Value &value, const std::string &fallback) -> std::string
+		{
+			auto it = value.FindMember("name");
+			return it != value.MemberEnd() && it->value.IsString() && it->value.GetStringLength() > 0 ?
+				std::string(it->value.GetString()) : fallback;
+		};
+
+		auto GetArray = [&dom](const char* key) -> const Value*
+		{
+			auto it = dom.FindMember(key);
+			return it != dom.MemberEnd() && it->value.IsArray() ? &it->value : nullptr;
+		};
+
+		// buffers
+		std::vector<std::vector<unsigned char>> buffers;
+		if (auto jsonBuffers = GetArray("buffers"))
+		{
+			buffers.resize(jsonBuffers->Size());
+			for (unsigned int i = 0; i < jsonBuffers->Size(); i++)
+			{
+				auto &jsonBuffer = (*jsonBuffers)[i];
+				auto it = jsonBuffer.FindMember("uri");
+				if (it == jsonBuffer.MemberEnd())
+				{
+					if (binChunk != nullptr)
+						buffers[i].assign(binChunk, binChunk + binLength);
+					continue;
+				}
+
+				std::string uri = it->value.GetString();
+				if (uri.compare(0, 5, "data:") == 0)
+				{
+					auto comma = uri.find(',');
+					if (comma == std::string::npos || !DecodeBase64(uri.c_str() + comma + 1, uri.size() - comma - 1, buffers[i]))
+						FURYW << "Failed to decode embedded buffer " << i;
+				}
+				else
+				{
+					std::vector<char> data;
+					if (ReadFile(m_ModelFolder + uri, data))
+						buffers[i].assign(data.begin(), data.end() - 1);
+				}
+			}
+		}
+
+		auto jsonBufferViews = GetArray("bufferViews");
+		auto jsonAccessors = GetArray("accessors");
+
+		auto GetAccessor = [&](int index) -> GltfAccessor
+		{
+			GltfAccessor accessor;
+			if (index < 0 || jsonAccessors == nullptr || (unsigned int)index >= jsonAccessors->Size())
+				return accessor;
+
+			auto &jsonAccessor = (*jsonAccessors)[index];
+			std::string type = jsonAccessor["type"].GetString();
+
+			accessor.count = GetUInt(jsonAccessor, "count", 0);
+			accessor.componentType = GetUInt(jsonAccessor, "componentType", 5126);
+			accessor.numComponents = type == "SCALAR" ? 1 : type == "VEC2" ? 2 : type == "VEC3" ? 3 :
+				type == "VEC4" ? 4 : type == "MAT4" ? 16 : type == "MAT3" ? 9 : 4;
+
+			auto normalized = jsonAccessor.FindMember("normalized");
+			accessor.normalized = normalized != jsonAccessor.MemberEnd() && normalized->value.GetBool();
+
+			if (jsonAccessor.HasMember("sparse"))
+				FURYW << "Sparse accessor " << index << " not supported!";
+
+			int viewIndex = GetInt(jsonAccessor, "bufferView");
+			if (viewIndex < 0 || jsonBufferViews == nullptr || (unsigned int)viewIndex >= jsonBufferViews->Size())
+			{
+				accessor.count = 0;
+				return accessor;
+			}
+
+			auto &jsonView = (*jsonBufferViews)[viewIndex];
+			unsigned int bufferIndex = GetUInt(jsonView, "buffer", 0);
+			size_t offset = GetUInt(jsonView, "byteOffset", 0) + GetUInt(jsonAccessor, "byteOffset", 0);
+			size_t elementSize = ComponentSize(accessor.componentType) * accessor.numComponents;
+
+			accessor.stride = GetUInt(jsonView, "byteStride", 0);
+			if (accessor.stride == 0)
+				accessor.stride = elementSize;
+
+			if (bufferIndex >= buffers.size() || accessor.count == 0 ||
+				offset + accessor.stride * (accessor.count - 1) + elementSize > buffers[bufferIndex].size())
+			{
+				FURYW << "Accessor " << index << " out of range!";
+				accessor.count = 0;
+				return accessor;
+			}
+
+			accessor.data = buffers[bufferIndex].data() + offset;
+			return accessor;
+		};
+
+		// reads 'width' components per element into output, padding with 0.
+		auto ReadFloats = [](const GltfAccessor &accessor, unsigned int width, std::vector<float> &output)
+		{
+			size_t base = output.size();
+			output.resize(base + accessor.count * width, 0.0f);
+			unsigned int size = ComponentSize(accessor.componentType);
+			unsigned int count = std::min(width, accessor.numComponents);
+			for (size_t i = 0; i < accessor.count; i++)
+			{
+				const unsigned char* ptr = accessor.data + i * accessor.stride;
+				float* dst = &output[base + i * width];
+				for (unsigned int j = 0; j < count; j++)
+					dst[j] = ReadComponent(ptr + j * size, accessor.componentType, accessor.normalized);
+			}
+		};
+
+		// materials
+		std::vector<Material::Ptr> materials;
+		if (auto jsonMaterials = GetArray("materials"))
+		{
+			auto jsonTextures = GetArray("textures");
+			auto jsonImages = GetArray("images");
+
+			auto GetTexture = [&](const Value &value, const char* key, bool srgb) -> Texture::Ptr
+			{
+				auto it = value.FindMember(key);
+				if (it == value.MemberEnd() || jsonTextures == nullptr || jsonImages == nullptr)
+					return nullptr;
+
+				int textureIndex = GetInt(it->value, "index");
+				if (textureIndex < 0 || (unsigned int)textureIndex >= jsonTextures->Size())
+					return nullptr;
+
+				int imageIndex = GetInt((*jsonTextures)[textureIndex], "source");
+				if (imageIndex < 0 || (unsigned int)imageIndex >= jsonImages->Size())
+					return nullptr;
+
+				auto uri = (*jsonImages)[imageIndex].FindMember("uri");
+				if (uri == (*jsonImages)[imageIndex].MemberEnd() || std::strncmp(uri->value.GetString(), "data:", 5) == 0)
+				{
+					FURYW << "Embedded image " << imageIndex << " not supported!";
+					return nullptr;
+				}
+
+				return LoadTexture(m_ModelFolder + uri->value.GetString(), srgb);
+			};
+
+			for (unsigned int i = 0; i < jsonMaterials->Size(); i++)
+			{
+				auto &jsonMaterial = (*jsonMaterials)[i];
+				auto name = GetName(jsonMaterial, GetStem(filePath) + "_material_" + std::to_string(i));
+
+				auto material = Scene::Manager()->Get<Material>(name);
+				if (material == nullptr)
+				{
+					material = Material::Create(name);
+
+					float baseColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+					float emissive[3] = { 0.0f, 0.0f, 0.0f };
+					float roughness = 1.0f;
+
+					auto pbr = jsonMaterial.FindMember("pbrMetallicRoughness");
+					if (pbr != jsonMaterial.MemberEnd())
+					{
+						GetFloats(pbr->value, "baseColorFactor", baseColor, 4);
+						auto it = pbr->value.FindMember("roughnessFactor");
+						if (it != pbr->value.MemberEnd())
+							roughness = (float)it->value.GetDouble();
+						material->SetTexture(Material::DIFFUSE_TEXTURE, GetTexture(pbr->value, "baseColorTexture", true));
+					}
+					GetFloats(jsonMaterial, "emissiveFactor", emissive, 3);
+
+					auto alphaMode = jsonMaterial.FindMember("alphaMode");
+					bool blend = alphaMode != jsonMaterial.MemberEnd() && std::string(alphaMode->value.GetString()) == "BLEND";
+
+					// approximate phong from metallic-roughness.
+					float gloss = 1.0f - roughness;
+					material->SetUniform(Material::SHININESS, Uniform1f::Create({ std::max(1.0f, gloss * gloss * 128.0f) }));
+					material->SetUniform(Material::AMBIENT_FACTOR, Uniform1f::Create({ 1.0f }));
+					material->SetUniform(Material::DIFFUSE_FACTOR, Uniform1f::Create({ 1.0f }));
+					material->SetUniform(Material::SPECULAR_FACTOR, Uniform1f::Create({ gloss }));
+					material->SetUniform(Material::EMISSIVE_FACTOR, Uniform1f::Create({ 1.0f }));
+					material->SetUniform(Material::TRANSPARENCY, Uniform1f::Create({ blend ? 1.0f - baseColor[3] : 0.0f }));
+					material->SetUniform(Material::AMBIENT_COLOR, Uniform3f::Create({ 0.0f, 0.0f, 0.0f }));
+					material->SetUniform(Material::DIFFUSE_COLOR, Uniform3f::Create({ baseColor[0], baseColor[1], baseColor[2] }));
+					material->SetUniform(Material::SPECULAR_COLOR, Uniform3f::Create({ 1.0f, 1.0f, 1.0f }));
+					material->SetUniform(Material::EMISSIVE_COLOR, Uniform3f::Create({ emissive[0], emissive[1], emissive[2] }));
+					material->SetUniform(Material::MATERIAL_ID, Uniform1ui::Create({ material->GetID() }));
+					material->SetTexture(Material::NORMAL_TEXTURE, GetTexture(jsonMaterial, "normalTexture", false));
+
+					if (blend)
+						material->SetOpaque(false);
+
+					Scene::Manager()->Add(material);
+				}
+
+				materials.push_back(material);
+			}
+		}
+
+		auto jsonNodes = GetArray("nodes");
+		unsigned int nodeCount = jsonNodes == nullptr ? 0 : jsonNodes->Size();
+
+		std::vector<std::string> nodeNames(nodeCount);
+		std::vector<int> nodeParents(nodeCount, -1);
+		std::vector<Vector4> nodePositions(nodeCount, Vector4(0.0f)), nodeScales(nodeCount, Vector4(1.0f));
+		std::vector<Quaternion> nodeRotations(nodeCount);
+
+		for (unsigned int i = 0; i < nodeCount; i++)
+		{
+			auto &jsonNode = (*jsonNodes)[i];
+			nodeNames[i] = GetName(jsonNode, "node_" + std::to_string(i));
+
+			float data[16];
+			if (GetFloats(jsonNode, "matrix", data, 16))
+			{
+				DecomposeMatrix(Matrix4(data), nodePositions[i], nodeRotations[i], nodeScales[i]);
+			}
+			else
+			{
+				if (GetFloats(jsonNode, "translation", data, 3))
+					nodePositions[i] = Vector4(data[0], data[1], data[2]);
+				if (GetFloats(jsonNode, "rotation", data, 4))
+					nodeRotations[i] = Quaternion(data[0], data[1], data[2], data[3]);
+				if (GetFloats(jsonNode, "scale", data, 3))
+					nodeScales[i] = Vector4(data[0], data[1], data[2]);
+			}
+
+			auto children = jsonNode.FindMember("children");
+			if (children != jsonNode.MemberEnd())
+				for (SizeType j = 0; j < children->value.Size(); j++)
+					if (children->value[j].GetUint() < nodeCount)
+						nodeParents[children->value[j].GetUint()] = i;
+		}
+
+		auto GetNodeMatrix = [&](unsigned int index) -> Matrix4
+		{
+			Matrix4 matrix;
+			matrix.Translate(nodePositions[index]);
+			matrix.AppendRotation(nodeRotations[index]);
+			matrix.AppendScale(nodeScales[index]);
+			return matrix;
+		};
+
+		// meshes, one fury mesh per gltf mesh, primitives become submeshes.
+		auto jsonMeshes = GetArray("meshes");
+		unsigned int meshCount = jsonMeshes == nullptr ? 0 : jsonMeshes->Size();
+
+		std::vector<Mesh::Ptr> meshes(meshCount);
+		std::vector<bool> fillMesh(meshCount, false);
+		std::vector<std::vector<int>> meshMaterials(meshCount);
+		std::vector<std::vector<SubMesh::Ptr>> meshSubMeshes(meshCount);
+
+		for (unsigned int i = 0; i < meshCount; i++)
+		{
+			auto &jsonMesh = (*jsonMeshes)[i];
+			auto name = GetName(jsonMesh, GetStem(filePath) + "_mesh_" + std::to_string(i));
+
+			meshes[i] = Scene::Manager()->Get<Mesh>(name);
+			if (meshes[i] == nullptr)
+			{
+				meshes[i] = Mesh::Create(name);
+				fillMesh[i] = true;
+			}
+
+			auto &jsonPrimitives = jsonMesh["primitives"];
+			for (SizeType j = 0; j < jsonPrimitives.Size(); j++)
+			{
+				if (GetUInt(jsonPrimitives[j], "mode", 4) == 4)
+					meshMaterials[i].push_back(GetInt(jsonPrimitives[j], "material"));
+			}
+
+			if (fillMesh[i] && meshMaterials[i].size() > 1)
+				for (unsigned int j = 0; j < meshMaterials[i].size(); j++)
+					meshSubMeshes[i].push_back(SubMesh::Create());
+		}
+
+		RunParallel(meshCount, GetNumThreads(fileSize), [&](unsigned int index)
+		{
+			if (!fillMesh[index])
+				return;
+
+			auto &mesh = meshes[index];
+			auto &jsonPrimitives = (*jsonMeshes)[index]["primitives"];
+
+			bool hasNormals = m_ImportOptions.ImportNormal, hasUVs = m_ImportOptions.ImportUV;
+			bool hasTangents = m_ImportOptions.ImportTangent, hasSkin = m_ImportOptions.ImportSkin;
+
+			// an attribute is only kept if all primitives have it.
+			for (SizeType p = 0; p < jsonPrimitives.Size(); p++)
+			{
+				if (GetUInt(jsonPrimitives[p], "mode", 4) != 4)
+					continue;
+				auto &attributes = jsonPrimitives[p]["attributes"];
+				hasNormals = hasNormals && attributes.HasMember("NORMAL");
+				hasUVs = hasUVs && attributes.HasMember("TEXCOORD_0");
+				hasTangents = hasTangents && attributes.HasMember("TANGENT");
+				hasSkin = hasSkin && attributes.HasMember("JOINTS_0") && attributes.HasMember("WEIGHTS_0");
+			}
+
+			auto &subMeshes = meshSubMeshes[index];
+			unsigned int primitiveIndex = 0;
+			std::vector<float> temp;
+			std::vector<unsigned int> primitiveIndices;
+
+			for (SizeType p = 0; p < jsonPrimitives.Size(); p++)
+			{
+				auto &jsonPrimitive = jsonPrimitives[p];
+				if (GetUInt(jsonPrimitive, "mode", 4) != 4)
+					continue;
+
+				auto &subIndices = subMeshes.size() > 0 ? subMeshes[primitiveIndex]->Indices.Data : primitiveIndices;
+				primitiveIndex++;
+
+				auto &attributes = jsonPrimitive["attributes"];
+				auto positions = GetAccessor(GetInt(attributes, "POSITION"));
+				if (positions.count == 0)
+					continue;
+
+				unsigned int baseVertex = mesh->Positions.Data.size() / 3;
+				ReadFloats(positions, 3, mesh->Positions.Data);
+
+				if (hasNormals)
+					ReadFloats(GetAccessor(GetInt(attributes, "NORMAL")), 3, mesh->Normals.Data);
+				if (hasUVs)
+					ReadFloats(GetAccessor(GetInt(attributes, "TEXCOORD_0")), 2, mesh->UVs.Data);
+				if (hasTangents)
+					ReadFloats(GetAccessor(GetInt(attributes, "TANGENT")), 3, mesh->Tangents.Data);
+
+				if (hasSkin)
+				{
+					// fury keeps 4 ids and 3 weights per vertex.
+					temp.clear();
+					ReadFloats(GetAccessor(GetInt(attributes, "JOINTS_0")), 4, temp);
+					for (auto value : temp)
+						mesh->IDs.Data.push_back((unsigned int)value);
+
+					temp.clear();
+					ReadFloats(GetAccessor(GetInt(attributes, "WEIGHTS_0")), 4, temp);
+					for (size_t i = 0; i + 3 < temp.size(); i += 4)
+						mesh->Weights.Data.insert(mesh->Weights.Data.end(), temp.begin() + i, temp.begin() + i + 3);
+				}
+
+				// keep every stream the same length even if an accessor was broken.
+				unsigned int vertexCount = mesh->Positions.Data.size() / 3;
+				if (hasNormals) mesh->Normals.Data.resize(vertexCount * 3, 0.0f);
+				if (hasUVs) mesh->UVs.Data.resize(vertexCount * 2, 0.0f);
+				if (hasTangents) mesh->Tangents.Data.resize(vertexCount * 3, 0.0f);
+				if (hasSkin)
+				{
+					mesh->IDs.Data.resize(vertexCount * 4, 0);
+					mesh->Weights.Data.resize(vertexCount * 3, 0.0f);
+				}
+
+				subIndices.clear();
+				auto indices = GetAccessor(GetInt(jsonPrimitive, "indices"));
+				if (indices.count > 0)
+				{
+					subIndices.reserve(indices.count);
+					for (size_t i = 0; i < indices.count; i++)
+					{
+						unsigned int value = ReadIndex(indices.data + i * indices.stride, indices.componentType);
+						subIndices.push_back(baseVertex + std::min(value, (unsigned int)positions.count - 1));
+					}
+				}
+				else
+				{
+					subIndices.reserve(positions.count);
+					for (size_t i = 0; i < positions.count; i++)
+						subIndices.push_back(baseVertex + (unsigned int)i);
+				}
+
+				subIndices.resize(subIndices.size() / 3 * 3);
+				mesh->Indices.Data.insert(mesh->Indices.Data.end(), subIndices.begin(), subIndices.end());
+			}
+
+			for (auto &subMesh : subMeshes)
+				mesh->AddSubMesh(subMesh);
+
+			PostProcessMesh(mesh, hasNormals, hasUVs);
+		});
+
+		for (unsigned int i = 0; i < meshCount; i++)
+		{
+			if (fillMesh[i])
+			{
+				Scene::Manager()->Add(meshes[i]);
+				FURYD << meshes[i]->GetName() << " [vtx: " << meshes[i]->Positions.Data.size() / 3 << " tris: " << meshes[i]->Indices.Data.size() / 3 << "]";
+			}
+		}
+
+		// skins
+		auto jsonSkins = GetArray("skins");
+		std::vector<std::string> skinnedMeshNames;
+
+		auto CreateSkeleton = [&](const Mesh::Ptr &mesh, const Value &jsonSkin)
+		{
+			auto &jointMap = mesh->m_JointMap;
+			auto &joints = mesh->m_Joints;
+
+			auto jsonJoints = jsonSkin.FindMember("joints");
+			if (jsonJoints == jsonSkin.MemberEnd() || jsonJoints->value.Size() == 0)
+				return;
+
+			std::vector<unsigned int> jointNodes;
+			for (SizeType i = 0; i < jsonJoints->value.Size(); i++)
+				if (jsonJoints->value[i].GetUint() < nodeCount)
+					jointNodes.push_back(jsonJoints->value[i].GetUint());
+
+			std::vector<float> inverseBinds;
+			auto ibm = GetAccessor(GetInt(jsonSkin, "inverseBindMatrices"));
+			ReadFloats(ibm, 16, inverseBinds);
+
+			std::unordered_map<unsigned int, Joint::Ptr> nodeToJoint;
+			for (unsigned int i = 0; i < jointNodes.size(); i++)
+			{
+				unsigned int node = jointNodes[i];
+				auto joint = Joint::Create(nodeNames[node], mesh);
+				joint->SetLocalMatrix(GetNodeMatrix(node));
+				if (i < ibm.count)
+					joint->SetOffsetMatrix(Matrix4(&inverseBinds[i * 16]));
+
+				nodeToJoint.emplace(node, joint);
+				jointMap.emplace(nodeNames[node], joint);
+				joints.push_back(joint);
+			}
+
+			// link the tree, joints without a joint parent become siblings of the root.
+			std::unordered_map<unsigned int, Joint::Ptr> lastChild;
+			Joint::Ptr lastRoot = nullptr;
+
+			for (unsigned int node : jointNodes)
+			{
+				auto joint = nodeToJoint[node];
+				int parent = nodeParents[node];
+				auto parentIt = parent >= 0 ? nodeToJoint.find(parent) : nodeToJoint.end();
+
+				if (parentIt != nodeToJoint.end())
+				{
+					joint->SetParent(parentIt->second);
+					auto it = lastChild.find(parent);
+					if (it == lastChild.end())
+						parentIt->second->SetFirstChild(joint);
+					else
+						it->second->SetSibling(joint);
+					lastChild[parent] = joint;
+				}
+				else
+				{
+					if (lastRoot == nullptr)
+						mesh->m_RootJoint = joint;
+					else
+						lastRoot->SetSibling(joint);
+					lastRoot = joint;
+				}
+			}
+
+			mesh->m_RootJoint->Update(Matrix4());
+			skinnedMeshNames.push_back(mesh->GetName());
+
+			FURYD << "Found " << joints.size() << " joints for " << mesh->GetName();
+		};
+
+		// scene nodes
+		std::vector<bool> nodeLoaded(nodeCount, false);
+		std::function<void(const SceneNode::Ptr&, unsigned int, bool)> LoadNode =
+			[&](const SceneNode::Ptr &parent, unsigned int index, bool top)
+		{
+			// a node has one parent at most, this also stops cycles in malformed files.
+			if (nodeLoaded[index])
+			{
+				FURYW << "Gltf node " << index << " is referenced twice!";
+				return;
+			}
+			nodeLoaded[index] = true;
+
+			auto &jsonNode = (*jsonNodes)[index];
+			auto node = SceneNode::Create(nodeNames[index]);
+
+			float scale = top ? m_ImportOptions.ScaleFactor : 1.0f;
+			node->SetLocalPosition(nodePositions[index] * scale);
+			node->SetLocalRoattion(nodeRotations[index]);
+			node->SetLocalScale(Vector4(nodeScales[index] * scale, 1.0f));
+
+			parent->AddChild(node);
+
+			int meshIndex = GetInt(jsonNode, "mesh");
+			if (meshIndex >= 0 && (unsigned int)meshIndex < meshCount)
+			{
+				auto &mesh = meshes[meshIndex];
+
+				int skinIndex = GetInt(jsonNode, "skin");
+				if (m_ImportOptions.ImportSkin && fillMesh[meshIndex] && skinIndex >= 0 && jsonSkins != nullptr &&
+					(unsigned int)skinIndex < jsonSkins->Size() && mesh->m_RootJoint == nullptr && mesh->IDs.Data.size() > 0)
+					CreateSkeleton(mesh, (*jsonSkins)[skinIndex]);
+
+				auto meshRender = MeshRender::Create(nullptr, mesh);
+				node->AddComponent(meshRender);
+
+				auto &primitiveMaterials = meshMaterials[meshIndex];
+				for (unsigned int i = 0; i < primitiveMaterials.size(); i++)
+				{
+					int materialIndex = primitiveMaterials[i];
+					if (materialIndex >= 0 && (unsigned int)materialIndex < materials.size())
+						meshRender->SetMaterial(materials[materialIndex], i);
+				}
+			}
+
+			auto children = jsonNode.FindMember("children");
+			if (children != jsonNode.MemberEnd())
+				for (SizeType i = 0; i < children->value.Size(); i++)
+					if (children->value[i].GetUint() < nodeCount)
+						LoadNode(node, children->value[i].GetUint(), false);
+		};
+
+		std::vector<unsigned int> rootNodes;
+		auto jsonScenes = GetArray("scenes");
+		if (jsonScenes != nullptr && jsonScenes->Size() > 0)
+		{
+			unsigned int sceneIndex = std::min(GetUInt(dom, "scene", 0), jsonScenes->Size() - 1);
+			auto &jsonScene = (*jsonScenes)[sceneIndex];
+			auto it = jsonScene.FindMember("nodes");
+			if (it != jsonScene.MemberEnd())
+				for (SizeType i = 0; i < it->value.Size(); i++)
+					if (it->value[i].GetUint() < nodeCount)
+						rootNodes.push_back(it->value[i].GetUint());
+		}
+		else
+		{
+			for (unsigned int i = 0; i < nodeCount; i++)
+				if (nodeParents[i] < 0)
+					rootNodes.push_back(i);
+		}
+
+		for (auto index : rootNodes)
+			LoadNode(rootNode, index, true);
+
+		rootNode->Recompose();
+
+		// animations, resampled to fixed ticks like the fbx importer does.
+		auto jsonAnimations = GetArray("animations");
+		if (m_ImportOptions.ImportAnim && jsonAnimations != nullptr)
+		{
+			int ticksPerSecond = std::max(1, m_ImportOptions.TicksPerSecond);
+
+			for (unsigned int i = 0; i < jsonAnimations->Size(); i++)
+			{
+				auto &jsonAnimation = (*jsonAnimations)[i];
+				auto name = GetName(jsonAnimation, GetStem(filePath) + "_anim_" + std::to_string(i));
+				auto clip = AnimationClip::Create(name, ticksPerSecond);
+
+				auto &jsonSamplers = jsonAnimation["samplers"];
+
+				auto &jsonChannels = jsonAnimation["channels"];
+				for (SizeType c = 0; c < jsonChannels.Size(); c++)
+				{
+					auto &jsonChannel = jsonChannels[c];
+					auto &target = jsonChannel["target"];
+					int node = GetInt(target, "node");
+					int sampler = GetInt(jsonChannel, "sampler");
+					if (node < 0 || (unsigned int)node >= nodeCount || sampler < 0 || (unsigned int)sampler >= jsonSamplers.Size())
+						continue;
+
+					std::string path = target["path"].GetString();
+					bool isRotation = path == "rotation";
+					if (path == "translation" && !m_ImportOptions.ImportPosAnim)
+						continue;
+					if (path == "scale" && !m_ImportOptions.ImportSclAnim)
+						continue;
+					if (!isRotation && path != "translation" && path != "scale")
+						continue;
+
+					auto &jsonSampler = jsonSamplers[sampler];
+					auto interpolation = jsonSampler.FindMember("interpolation");
+					std::string mode = interpolation != jsonSampler.MemberEnd() ? interpolation->value.GetString() : "LINEAR";
+
+					std::vector<float> times, values;
+					ReadFloats(GetAccessor(GetInt(jsonSampler, "input")), 1, times);
+					unsigned int width = isRotation ? 4 : 3;
+					ReadFloats(GetAccessor(GetInt(jsonSampler, "output")), width, values);
+
+					// cubic spline stores in-tangent, value, out-tangent per key, keep the value only.
+					if (mode == "CUBICSPLINE")
+					{
+						std::vector<float> keys;
+						for (size_t k = 0; k + 3 * width <= values.size(); k += 3 * width)
+							keys.insert(keys.end(), values.begin() + k + width, values.begin() + k + 2 * width);
+						values.swap(keys);
+					}
+
+					size_t keyCount = std::min(times.size(), values.size() / width);
+					if (keyCount == 0)
+						continue;
+
+					auto channel = clip->GetChannel(nodeNames[node]);
+					if (channel == nullptr)
+						channel = clip->AddChannel(nodeNames[node]);
+
+					auto &frames = isRotation ? channel->rotations :
+						path == "translation" ? channel->positions : channel->scalings;
+					frames.clear();
+
+					unsigned int lastTick = (unsigned int)std::ceil(times[keyCount - 1] * ticksPerSecond);
+					size_t key = 0;
+
+					for (unsigned int tick = 0; tick <= lastTick; tick++)
+					{
+						float time = (float)tick / ticksPerSecond;
+						while (key + 1 < keyCount && times[key + 1] <= time)
+							key++;
+
+						size_t next = std::min(key + 1, keyCount - 1);
+						float t = 0.0f;
+						if (mode != "STEP" && next != key && times[next] > times[key])
+							t = std::min(1.0f, std::max(0.0f, (time - times[key]) / (times[next] - times[key])));
+
+						const float* a = &values[key * width];
+						const float* b = &values[next * width];
+
+						if (isRotation)
+						{
+							Quaternion q0(a[0], a[1], a[2], a[3]), q1(b[0], b[1], b[2], b[3]);
+							auto euler = MathUtil::QuatToEulerRad(t > 0.0f ? q0.Slerp(q1, t) : q0);
+							frames.push_back(KeyFrame(tick, euler.x, euler.y, euler.z));
+						}
+						else
+						{
+							frames.push_back(KeyFrame(tick, a[0] + (b[0] - a[0]) * t, a[1] + (b[1] - a[1]) * t, a[2] + (b[2] - a[2]) * t));
+						}
+					}
+				}
+
+				clip->CalculateDuration();
+				Scene::Manager()->Add(clip);
+
+				FURYD << "Loaded clip " << name << " [channels: " << clip->GetChannelCount() << " duration: " << clip->GetDuration() << "]";
+			}
+		}
+
+		auto endTime = std::chrono::steady_clock::now();
+		double totalMs = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+		double mb = fileSize / (1024.0 * 1024.0);
+
+		FURYD << filePath << ": " << mb << " MB, " << meshCount << " meshes, " << skinnedMeshNames.size() << " skins, loaded in "
+			<< totalMs << " ms (" << (totalMs > 0.0 ? mb * 1000.0 / totalMs : 0.0) << " MB/s).";
+
+		m_Textures.clear();
+
+		return true;
+	}
+
+	bool ModelParser::ReadFile(const std::string &filePath, std::vector<char> &output)
+	{
+		std::ifstream stream(filePath, std::ios::binary | std::ios::ate);
+		if (!stream.good())
+		{
+			FURYE << "File " << filePath << " not exist!";
+			return false;
+		}
+
+		std::streamsize size = stream.tellg();
+		stream.seekg(0, std::ios::beg);
+
+		output.resize((size_t)size + 1);
+		if (size > 0 && !stream.read(output.data(), size))
+		{
+			FURYE << "Failed to read " << filePath;
+			return false;
+		}
+
+		output[(size_t)size] = '\0';
+		return true;
+	}
+
+	std::shared_ptr<Texture> ModelParser::LoadTexture(const std::string &filePath, bool srgb)
+	{
+		auto it = m_Textures.find(filePath);
+		if (it != m_Textures.end())
+			return it->second;
+
+		auto texture = Texture::Create(GetStem(filePath));
+		texture->SetFilterMode(FilterMode::LINEAR_MIPMAP_LINEAR);
+		texture->CreateFromImage(filePath, srgb, true);
+
+		m_Textures.emplace(filePath, texture);
+		return texture;
+	}
+
+	void ModelParser::PostProcessMesh(const std::shared_ptr<Mesh> &mesh, bool hasNormals, bool hasUVs)
+	{
+		if (!hasNormals && m_ImportOptions.ImportNormal)
+			MeshUtil::CalculateNormal(mesh);
+
+		if (m_ImportOptions.OptimizeMesh)
+			MeshUtil::OptimizeMesh(mesh);
+
+		mesh->CalculateAABB();
+
+		// skinned meshes ignore it, their skeleton may be added later.
+		mesh->SetStatic(m_ImportOptions.StaticMeshes);
+	}
+
+	unsigned int ModelParser::GetNumThreads(size_t bytes) const
+	{
+		unsigned int numThreads = m_ImportOptions.NumThreads;
+		if (numThreads == 0)
+			numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+		size_t chunkSize = std::max(1u, m_ImportOptions.ChunkSize);
+		return (unsigned int)std::max((size_t)1, std::min((size_t)numThreads, bytes / chunkSize));
+	}
+}
@@ -0,0 +1,101 @@
+#ifndef _FURY_MODELPARSER_H_
+#define _FURY_MODELPARSER_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Fury/Singleton.h"
+#include "Fury/Matrix4.h"
+
+namespace fury
+{
+	class SceneNode;
+
+	class Mesh;
+
+	class Material;
+
+	class Texture;
+
+	struct ModelImportOptions
+	{
+	public:
+
+		bool ImportUV = true;
+
+		bool ImportNormal = true;
+
+		bool ImportTangent = true;
+
+		bool ImportSkin = true;
+
+		bool ImportAnim = true;
+
+		bool ImportPosAnim = true;
+
+		bool ImportSclAnim = false;
+
+		bool OptimizeMesh = false;
+
+		// mark non skinned meshes static, see Mesh::SetStatic.
+		bool StaticMeshes = false;
+
+		float ScaleFactor = 1.0f;
+
+		// glTF keys are resampled to this rate.
+		int TicksPerSecond = 24;
+
+		// files smaller than this are parsed on the calling thread.
+		unsigned int ChunkSize = 1 << 20;
+
+		// 0 means std::thread::hardware_concurrency.
+		unsigned int NumThreads = 0;
+	};
+
+	// native importer for wavefront obj and gltf 2.0 (.gltf/.glb), no fbx sdk needed.
+	class FURY_API ModelParser : public Singleton<ModelParser>
+	{
+	public:
+
+		typedef std::shared_ptr<ModelParser> Ptr;
+
+		// fast ascii float parser, consumes 8 digits per step.
+		// returns the position after the number, or str if nothing was parsed.
+		static const char* ParseFloat(const char* str, const char* end, float &value);
+
+		static const char* ParseInt(const char* str, const char* end, int &value);
+
+	protected:
+
+		ModelImportOptions m_ImportOptions;
+
+		std::string m_ModelFolder;
+
+		std::unordered_map<std::string, std::shared_ptr<Texture>> m_Textures;
+
+	public:
+
+		// dispatches by file extension: .obj, .gltf or .glb
+		bool LoadScene(const std::string &filePath, const std::shared_ptr<SceneNode> &rootNode, ModelImportOptions importOptions = ModelImportOptions());
+
+		bool LoadObj(const std::string &filePath, const std::shared_ptr<SceneNode> &rootNode, ModelImportOptions importOptions = ModelImportOptions());
+
+		bool LoadGltf(const std::string &filePath, const std::shared_ptr<SceneNode> &rootNode, ModelImportOptions importOptions = ModelImportOptions());
+
+	protected:
+
+		bool ReadFile(const std::string &filePath, std::vector<char> &output);
+
+		void LoadObjMaterials(const std::string &filePath, std::unordered_map<std::string, std::shared_ptr<Material>> &materials);
+
+		// filePath is resolved by the caller, textures are relative to the file referencing them.
+		std::shared_ptr<Texture> LoadTexture(const std::string &filePath, bool srgb);
+
+		void PostProcessMesh(const std::shared_ptr<Mesh> &mesh, bool hasNormals, bool hasUVs);
+
+		unsigned int GetNumThreads(size_t bytes) const;
+	};
+}
+
+#endif // _FURY_MODELPARSER_H_
@@ -0,0 +1,83 @@
+#include <mutex>
+#include <unordered_map>
+
+#include "Fury/Log.h"
+#include "Fury/Name.h"
+
+namespace fury
+{
+	namespace
+	{
+		// same as HashName, without recursing per character.
+		size_t HashString(const std::string &str)
+		{
+			uint64_t hash = 14695981039346656037ULL;
+			for (char c : str)
+				hash = (hash ^ (uint64_t)(unsigned char)c) * 1099511628211ULL;
+			return (size_t)hash;
+		}
+
+		std::mutex &GetTableMutex()
+		{
+			static std::mutex s_Mutex;
+			return s_Mutex;
+		}
+
+		std::unordered_map<size_t, std::string> &GetTable()
+		{
+			static std::unordered_map<size_t, std::string> s_Table;
+			return s_Table;
+		}
+
+		void RecordName(size_t hash, const std::string &str)
+		{
+			bool collision = false;
+			std::string other;
+			{
+				std::lock_guard<std::mutex> lock(GetTableMutex());
+				auto result = GetTable().emplace(hash, str);
+				if (!result.second && result.first->second != str)
+				{
+					collision = true;
+					other = result.first->second;
+				}
+			}
+
+			if (collision)
+				FURYE << "Name hash collision: " << str << " and " << other << "!";
+		}
+	}
+
+	Name Name::Intern(const std::string &str)
+	{
+		Name name(HashString(str));
+		RecordName(name.m_Hash, str);
+		return name;
+	}
+
+	std::string Name::Lookup(size_t hash)
+	{
+		std::lock_guard<std::mutex> lock(GetTableMutex());
+		auto it = GetTable().find(hash);
+		return it == GetTable().end() ? "" : it->second;
+	}
+
+	size_t Name::GetInternedCount()
+	{
+		std::lock_guard<std::mutex> lock(GetTableMutex());
+		return GetTable().size();
+	}
+
+	Name::Name(const std::string &str) : m_Hash(HashString(str))
+	{
+#ifndef NDEBUG
+		RecordName(m_Hash, str);
+#endif
+	}
+
+	std::string Name::ToString() const
+	{
+		std::string str = Lookup(m_Hash);
+		return str.empty() ? "#" + std::to_string(m_Hash) : str;
+	}
+}
@@ -0,0 +1,75 @@
+#ifndef _FURY_NAME_H_
+#define _FURY_NAME_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>
+
+#include "Macros.h"
+
+namespace fury
+{
+	// fnv-1a for constant expressions, runtime strings are hashed by a loop in Name.cpp.
+	// only constant where the result has to be, like constexpr variables or FURY_NAME.
+	constexpr uint64_t HashName(const char* str, uint64_t hash = 14695981039346656037ULL)
+	{
+		return *str == 0 ? hash : HashName(str + 1, (hash ^ (uint64_t)(unsigned char)*str) * 1099511628211ULL);
+	}
+
+	// interned string, compares and hashes as an integer.
+	// names built from runtime strings are recorded in a global table in debug builds,
+	// use Intern to record them in release builds too, the table never shrinks so keep it for
+	// bounded sets of names. literals can't be recorded at compile time,
+	// ToString prints their hash unless the same string was interned elsewhere.
+	class FURY_API Name
+	{
+	protected:
+
+		size_t m_Hash;
+
+	public:
+
+		static Name Intern(const std::string &str);
+
+		// returns an empty string when the hash wasn't interned.
+		static std::string Lookup(size_t hash);
+
+		static size_t GetInternedCount();
+
+		constexpr Name() : m_Hash(0) {}
+
+		constexpr Name(const char* str) : m_Hash((size_t)HashName(str)) {}
+
+		Name(const std::string &str);
+
+		explicit constexpr Name(size_t hash) : m_Hash(hash) {}
+
+		constexpr size_t GetHash() const { return m_Hash; }
+
+		std::string ToString() const;
+
+		constexpr bool operator == (const Name &other) const { return m_Hash == other.m_Hash; }
+
+		constexpr bool operator != (const Name &other) const { return m_Hash != other.m_Hash; }
+
+		constexpr bool operator < (const Name &other) const { return m_Hash < other.m_Hash; }
+	};
+}
+
+// name of a string literal, hashed at compile time even where it's passed as an argument.
+#define FURY_NAME(str) fury::Name(std::integral_constant<size_t, (size_t)fury::HashName(str)>::value)
+
+namespace std
+{
+	template<>
+	struct hash<fury::Name>
+	{
+		size_t operator()(const fury::Name &name) const
+		{
+			return name.GetHash();
+		}
+	};
+}
+
+#endif // _FURY_NAME_H_
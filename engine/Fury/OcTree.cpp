@@ -1,5 +1,4 @@
-#include <deque>
-
+#include "Fury/FrameArena.h"
 #include "Fury/Frustum.h"
 #include "Fury/Light.h"
 #include "Fury/Material.h"
@@ -7,6 +6,7 @@
 #include "Fury/MeshRender.h"
 #include "Fury/OcTreeNode.h"
 #include "Fury/OcTree.h"
+#include "Fury/ParticleSystem.h"
 #include "Fury/RenderQuery.h"
 #include "Fury/SceneNode.h"
 #include "Fury/SphereBounds.h"
@@ -75,7 +75,13 @@ namespace fury
 				if (render->GetRenderable())
 					renderQuery->AddRenderable(sceneNode);
 			}
-		});
+
+			if (auto particles = sceneNode->GetComponent<ParticleSystem>())
+			{
+				if (particles->GetRenderable())
+					renderQuery->AddParticles(sceneNode);
+			}
+		}, true);
 	}
 
 	void OcTree::GetVisibleSceneNodes(const Collidable &collider, SceneNodes &sceneNodes, bool clear) const
@@ -99,7 +105,7 @@ namespace fury
 			auto render = sceneNode->GetComponent<MeshRender>();
 			if (render != nullptr && render->GetRenderable())
 				renderables.push_back(sceneNode);
-		});
+		}, true);
 	}
 
 	void OcTree::GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear) const
@@ -110,7 +116,7 @@ namespace fury
 		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
 		{
 			auto render = sceneNode->GetComponent<MeshRender>();
-			if (render != nullptr && render->GetRenderable() && render->GetMesh()->GetCastShadows())
+			if (render != nullptr && render->GetRenderable() && render->GetMesh()->GetCastShadows() && IsDetailVisible(*sceneNode, true))
 				renderables.push_back(sceneNode);
 		});
 	}
@@ -144,14 +150,20 @@ namespace fury
 			else if (sceneNode->GetComponent<Light>() != nullptr)
 				lights.push_back(sceneNode);
 
-		});
+		}, true);
 	}
 
 	void OcTree::WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const
+	{
+		WalkScene(collider, filterFunc, false);
+	}
+
+	void OcTree::WalkScene(const Collidable &collider, const FilterFunc &filterFunc, bool viewCull) const
 	{
 		using TreeNodePair = std::pair<bool, OcTreeNode::Ptr>;
 
-		std::deque<TreeNodePair> possiblePairs;
+		// used as a stack, lives in frame memory since this runs many times per frame.
+		FrameVector<TreeNodePair> possiblePairs;
 		possiblePairs.push_back(std::make_pair(false, m_Root));
 
 		while (!possiblePairs.empty())
@@ -178,7 +190,8 @@ namespace fury
 					for (int i = 0; i < sceneNodeCount; i++)
 					{
 						SceneNode::Ptr sceneNode = treeNode->GetSceneNodeAt(i);
-						if (tested || collider.IsInsideFast(sceneNode->GetWorldAABB()))
+						if ((!viewCull || IsPotentiallyVisible(*sceneNode)) && (tested || sceneNode->IsInsideFast(collider)) &&
+							(!viewCull || IsDetailVisible(*sceneNode, false)))
 							filterFunc(sceneNode);
 					}
 
@@ -71,6 +71,10 @@ namespace fury
 
 		void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode, const std::shared_ptr<OcTreeNode> &treeNode, unsigned int depth);
 
+		// viewCull skips nodes the viewer's pvs cell can't see before testing them against collider,
+		// and nodes failing SceneManager::IsDetailVisible after.
+		void WalkScene(const Collidable &collider, const FilterFunc &filterFunc, bool viewCull) const;
+
 	};
 }
 
@@ -0,0 +1,370 @@
+#include <algorithm>
+#include <cmath>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/Log.h"
+#include "Fury/MeshBVH.h"
+#include "Fury/OcclusionBuffer.h"
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	OcclusionBuffer::Ptr OcclusionBuffer::Create(unsigned int width, unsigned int height)
+	{
+		return std::make_shared<OcclusionBuffer>(width, height);
+	}
+
+	OcclusionBuffer::OcclusionBuffer(unsigned int width, unsigned int height)
+		: m_Width(std::max(width, 1u)), m_Height(std::max(height, 1u))
+	{
+		unsigned int levelWidth = m_Width, levelHeight = m_Height;
+		while (true)
+		{
+			m_Levels.push_back(std::vector<float>(levelWidth * levelHeight, 1.0f));
+			m_LevelWidths.push_back(levelWidth);
+			m_LevelHeights.push_back(levelHeight);
+
+			if (levelWidth == 1 && levelHeight == 1)
+				break;
+
+			levelWidth = (levelWidth + 1) / 2;
+			levelHeight = (levelHeight + 1) / 2;
+		}
+	}
+
+	void OcclusionBuffer::Begin(const Matrix4 &viewProjection)
+	{
+		m_ViewProjection = viewProjection;
+		m_Occluders.clear();
+		m_Triangles.clear();
+
+		for (auto &level : m_Levels)
+			std::fill(level.begin(), level.end(), 1.0f);
+	}
+
+	void OcclusionBuffer::AddOccluder(const std::shared_ptr<MeshBVH> &bvh, const Matrix4 &worldMatrix)
+	{
+		if (bvh == nullptr || bvh->GetTriangleCount() == 0)
+			return;
+
+		Occluder occluder;
+		occluder.bvh = bvh;
+		occluder.worldMatrix = worldMatrix;
+		m_Occluders.push_back(occluder);
+	}
+
+	void OcclusionBuffer::Rasterize(bool allowParallel)
+	{
+		auto &threads = ThreadUtil::Instance();
+		bool parallel = allowParallel && threads != nullptr;
+
+		// transform and clip per occluder, then merge in occluder order.
+		std::vector<std::vector<Triangle>> triangles(m_Occluders.size());
+		auto setup = [&](unsigned int i)
+		{
+			SetupTriangles(m_Occluders[i], triangles[i]);
+		};
+
+		if (parallel)
+			threads->ParallelFor(0, m_Occluders.size(), 1, setup);
+		else
+			for (unsigned int i = 0; i < m_Occluders.size(); i++)
+				setup(i);
+
+		m_Triangles.clear();
+		for (auto &list : triangles)
+			m_Triangles.insert(m_Triangles.end(), list.begin(), list.end());
+
+		// bands own disjoint rows, so they write without locking.
+		unsigned int bandCount = (m_Height + BandHeight - 1) / BandHeight;
+		if (parallel)
+			threads->ParallelFor(0, bandCount, 1, [this](unsigned int band) { RasterizeBand(band); });
+		else
+			for (unsigned int i = 0; i < bandCount; i++)
+				RasterizeBand(i);
+
+		BuildPyramid();
+	}
+
+	bool OcclusionBuffer::IsVisible(const BoxBounds &aabb) const
+	{
+		if (m_Triangles.empty() || aabb.GetInfinite())
+			return true;
+
+		Vector4 min = aabb.GetMin(), max = aabb.GetMax();
+		const float* m = m_ViewProjection.Raw;
+
+		float minX = std::numeric_limits<float>::max(), maxX = -std::numeric_limits<float>::max();
+		float minY = minX, maxY = maxX, minZ = minX;
+
+		for (unsigned int i = 0; i < 8; i++)
+		{
+			float x = (i & 1) ? max.x : min.x;
+			float y = (i & 2) ? max.y : min.y;
+			float z = (i & 4) ? max.z : min.z;
+
+			float cx = x * m[0] + y * m[4] + z * m[8] + m[12];
+			float cy = x * m[1] + y * m[5] + z * m[9] + m[13];
+			float cz = x * m[2] + y * m[6] + z * m[10] + m[14];
+			float cw = x * m[3] + y * m[7] + z * m[11] + m[15];
+
+			// boxes crossing the near plane are too close to be hidden.
+			if (cw <= 1e-6f || cz < -cw)
+				return true;
+
+			float invW = 1.0f / cw;
+			float sx = (cx * invW * 0.5f + 0.5f) * m_Width;
+			float sy = (cy * invW * 0.5f + 0.5f) * m_Height;
+
+			minX = std::min(minX, sx);
+			maxX = std::max(maxX, sx);
+			minY = std::min(minY, sy);
+			maxY = std::max(maxY, sy);
+			minZ = std::min(minZ, cz * invW * 0.5f + 0.5f);
+		}
+
+		// off screen boxes are left to frustum culling.
+		if (maxX < 0.0f || maxY < 0.0f || minX > m_Width || minY > m_Height)
+			return true;
+
+		int x0 = (int)std::max(0.0f, std::floor(minX)), x1 = (int)std::min(m_Width - 1.0f, std::floor(maxX));
+		int y0 = (int)std::max(0.0f, std::floor(minY)), y1 = (int)std::min(m_Height - 1.0f, std::floor(maxY));
+
+		// coarsest level where the rect still spans at most 4x4 texels.
+		unsigned int level = 0;
+		while (level + 1 < m_Levels.size() && ((x1 >> level) - (x0 >> level) > 3 || (y1 >> level) - (y0 >> level) > 3))
+			level++;
+
+		const auto &depth = m_Levels[level];
+		unsigned int width = m_LevelWidths[level];
+		for (int y = y0 >> level; y <= (y1 >> level); y++)
+		{
+			for (int x = x0 >> level; x <= (x1 >> level); x++)
+			{
+				if (depth[y * width + x] >= minZ)
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	unsigned int OcclusionBuffer::GetWidth() const
+	{
+		return m_Width;
+	}
+
+	unsigned int OcclusionBuffer::GetHeight() const
+	{
+		return m_Height;
+	}
+
+	unsigned int OcclusionBuffer::GetLevelCount() const
+	{
+		return m_Levels.size();
+	}
+
+	float OcclusionBuffer::GetDepth(unsigned int x, unsigned int y, unsigned int level) const
+	{
+		if (level >= m_Levels.size() || x >= m_LevelWidths[level] || y >= m_LevelHeights[level])
+			return 1.0f;
+
+		return m_Levels[level][y * m_LevelWidths[level] + x];
+	}
+
+	unsigned int OcclusionBuffer::GetOccluderCount() const
+	{
+		return m_Occluders.size();
+	}
+
+	unsigned int OcclusionBuffer::GetTriangleCount() const
+	{
+		return m_Triangles.size();
+	}
+
+	void OcclusionBuffer::SetupTriangles(const Occluder &occluder, std::vector<Triangle> &triangles) const
+	{
+		const auto &vertices = occluder.bvh->GetVertices();
+		const Matrix4 matrix = m_ViewProjection * occluder.worldMatrix;
+		const float* m = matrix.Raw;
+
+		unsigned int triangleCount = vertices.size() / 9;
+		triangles.reserve(triangleCount);
+
+		for (unsigned int i = 0; i < triangleCount; i++)
+		{
+			float clip[3][4];
+			float distances[3];
+			unsigned int inside = 0;
+
+			for (unsigned int j = 0; j < 3; j++)
+			{
+				const float* p = &vertices[i * 9 + j * 3];
+				clip[j][0] = p[0] * m[0] + p[1] * m[4] + p[2] * m[8] + m[12];
+				clip[j][1] = p[0] * m[1] + p[1] * m[5] + p[2] * m[9] + m[13];
+				clip[j][2] = p[0] * m[2] + p[1] * m[6] + p[2] * m[10] + m[14];
+				clip[j][3] = p[0] * m[3] + p[1] * m[7] + p[2] * m[11] + m[15];
+
+				// distance to the near plane, z >= -w.
+				distances[j] = clip[j][2] + clip[j][3];
+				if (distances[j] >= 0.0f)
+					inside++;
+			}
+
+			if (inside == 3)
+			{
+				AddTriangle(clip[0], clip[1], clip[2], triangles);
+			}
+			else if (inside > 0)
+			{
+				// clip against the near plane, leaves a triangle or a quad.
+				float polygon[4][4];
+				unsigned int count = 0;
+
+				for (unsigned int j = 0; j < 3; j++)
+				{
+					unsigned int k = (j + 1) % 3;
+					if (distances[j] >= 0.0f)
+						std::copy(clip[j], clip[j] + 4, polygon[count++]);
+
+					if ((distances[j] >= 0.0f) != (distances[k] >= 0.0f))
+					{
+						float t = distances[j] / (distances[j] - distances[k]);
+						for (unsigned int c = 0; c < 4; c++)
+							polygon[count][c] = clip[j][c] + (clip[k][c] - clip[j][c]) * t;
+						count++;
+					}
+				}
+
+				AddTriangle(polygon[0], polygon[1], polygon[2], triangles);
+				if (count == 4)
+					AddTriangle(polygon[0], polygon[2], polygon[3], triangles);
+			}
+		}
+	}
+
+	void OcclusionBuffer::AddTriangle(const float* a, const float* b, const float* c, std::vector<Triangle> &triangles) const
+	{
+		const float* clip[3] = { a, b, c };
+
+		Triangle triangle;
+		for (unsigned int j = 0; j < 3; j++)
+		{
+			if (clip[j][3] <= 1e-6f)
+				return;
+
+			float invW = 1.0f / clip[j][3];
+			triangle.x[j] = (clip[j][0] * invW * 0.5f + 0.5f) * m_Width;
+			triangle.y[j] = (clip[j][1] * invW * 0.5f + 0.5f) * m_Height;
+			triangle.z[j] = clip[j][2] * invW * 0.5f + 0.5f;
+		}
+
+		// both faces are rasterized, flip clockwise ones.
+		float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0]) -
+			(triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+		if (std::abs(area) < 1e-8f)
+			return;
+
+		if (area < 0.0f)
+		{
+			std::swap(triangle.x[1], triangle.x[2]);
+			std::swap(triangle.y[1], triangle.y[2]);
+			std::swap(triangle.z[1], triangle.z[2]);
+		}
+
+		// pixels whose centers may be covered.
+		float minX = std::min(triangle.x[0], std::min(triangle.x[1], triangle.x[2]));
+		float maxX = std::max(triangle.x[0], std::max(triangle.x[1], triangle.x[2]));
+		float minY = std::min(triangle.y[0], std::min(triangle.y[1], triangle.y[2]));
+		float maxY = std::max(triangle.y[0], std::max(triangle.y[1], triangle.y[2]));
+
+		triangle.minX = (int)std::max(0.0f, std::ceil(minX - 0.5f));
+		triangle.maxX = (int)std::min(m_Width - 1.0f, std::floor(maxX - 0.5f));
+		triangle.minY = (int)std::max(0.0f, std::ceil(minY - 0.5f));
+		triangle.maxY = (int)std::min(m_Height - 1.0f, std::floor(maxY - 0.5f));
+
+		if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY)
+			return;
+
+		triangles.push_back(triangle);
+	}
+
+	void OcclusionBuffer::RasterizeBand(unsigned int band)
+	{
+		int bandMinY = band * BandHeight;
+		int bandMaxY = std::min(bandMinY + (int)BandHeight, (int)m_Height) - 1;
+		float* depth = &m_Levels[0][0];
+
+		for (const auto &triangle : m_Triangles)
+		{
+			if (triangle.maxY < bandMinY || triangle.minY > bandMaxY)
+				continue;
+
+			const float* x = triangle.x;
+			const float* y = triangle.y;
+			const float* z = triangle.z;
+
+			// edge functions e = a * px + b * py + c, positive inside. edge i is opposite to vertex i.
+			float a[3], b[3], c[3];
+			for (unsigned int i = 0; i < 3; i++)
+			{
+				unsigned int j = (i + 1) % 3, k = (i + 2) % 3;
+				a[i] = y[j] - y[k];
+				b[i] = x[k] - x[j];
+				c[i] = x[j] * y[k] - x[k] * y[j];
+			}
+
+			// depth is affine in screen space after the perspective divide.
+			float invArea = 1.0f / (c[0] + c[1] + c[2]);
+			float za = (a[0] * z[0] + a[1] * z[1] + a[2] * z[2]) * invArea;
+			float zb = (b[0] * z[0] + b[1] * z[1] + b[2] * z[2]) * invArea;
+			float zc = (c[0] * z[0] + c[1] * z[1] + c[2] * z[2]) * invArea;
+
+			int minY = std::max(triangle.minY, bandMinY), maxY = std::min(triangle.maxY, bandMaxY);
+			for (int py = minY; py <= maxY; py++)
+			{
+				float cx = triangle.minX + 0.5f, cy = py + 0.5f;
+				float e0 = a[0] * cx + b[0] * cy + c[0];
+				float e1 = a[1] * cx + b[1] * cy + c[1];
+				float e2 = a[2] * cx + b[2] * cy + c[2];
+				float d = za * cx + zb * cy + zc;
+
+				float* row = depth + py * m_Width;
+				for (int px = triangle.minX; px <= triangle.maxX; px++)
+				{
+					if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f && d < row[px])
+						row[px] = d;
+
+					e0 += a[0];
+					e1 += a[1];
+					e2 += a[2];
+					d += za;
+				}
+			}
+		}
+	}
+
+	void OcclusionBuffer::BuildPyramid()
+	{
+		for (unsigned int level = 1; level < m_Levels.size(); level++)
+		{
+			const auto &source = m_Levels[level - 1];
+			unsigned int sourceWidth = m_LevelWidths[level - 1], sourceHeight = m_LevelHeights[level - 1];
+
+			auto &target = m_Levels[level];
+			unsigned int width = m_LevelWidths[level], height = m_LevelHeights[level];
+
+			for (unsigned int y = 0; y < height; y++)
+			{
+				unsigned int y0 = y * 2, y1 = std::min(y0 + 1, sourceHeight - 1);
+				for (unsigned int x = 0; x < width; x++)
+				{
+					unsigned int x0 = x * 2, x1 = std::min(x0 + 1, sourceWidth - 1);
+					target[y * width + x] = std::max(
+						std::max(source[y0 * sourceWidth + x0], source[y0 * sourceWidth + x1]),
+						std::max(source[y1 * sourceWidth + x0], source[y1 * sourceWidth + x1]));
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,113 @@
+#ifndef _FURY_OCCLUSION_BUFFER_H_
+#define _FURY_OCCLUSION_BUFFER_H_
+
+#include <memory>
+#include <vector>
+
+#include "Fury/Matrix4.h"
+
+namespace fury
+{
+	class BoxBounds;
+
+	class MeshBVH;
+
+	// low resolution software depth buffer for occlusion culling, no gl involved.
+	// occluders are rasterized across workers into the depth buffer, then a hierarchical z pyramid
+	// keeping the farthest depth of each 2x2 block is built, so box tests read a handful of texels.
+	class FURY_API OcclusionBuffer
+	{
+	public:
+
+		typedef std::shared_ptr<OcclusionBuffer> Ptr;
+
+		static Ptr Create(unsigned int width = 256, unsigned int height = 128);
+
+		// rows rasterized by one task.
+		static const unsigned int BandHeight = 8;
+
+	protected:
+
+		class Occluder
+		{
+		public:
+
+			std::shared_ptr<MeshBVH> bvh;
+
+			Matrix4 worldMatrix;
+		};
+
+		// screen space triangle after near plane clipping, counter clockwise.
+		class Triangle
+		{
+		public:
+
+			float x[3];
+
+			float y[3];
+
+			float z[3];
+
+			int minX, maxX, minY, maxY;
+		};
+
+		unsigned int m_Width;
+
+		unsigned int m_Height;
+
+		Matrix4 m_ViewProjection;
+
+		std::vector<Occluder> m_Occluders;
+
+		std::vector<Triangle> m_Triangles;
+
+		// level 0 is the depth buffer, depth in [0, 1] and 1 is the far plane.
+		std::vector<std::vector<float>> m_Levels;
+
+		std::vector<unsigned int> m_LevelWidths;
+
+		std::vector<unsigned int> m_LevelHeights;
+
+	public:
+
+		OcclusionBuffer(unsigned int width, unsigned int height);
+
+		// clears the buffer and the occluder list.
+		void Begin(const Matrix4 &viewProjection);
+
+		// the bvh's triangle copy is rasterized, so evicted static meshes work too.
+		void AddOccluder(const std::shared_ptr<MeshBVH> &bvh, const Matrix4 &worldMatrix);
+
+		// rasterizes the occluders and builds the pyramid.
+		void Rasterize(bool allowParallel = true);
+
+		// conservative, false only if the whole box lies behind rasterized occluders.
+		// doesn't modify the buffer, safe to call from many threads after Rasterize.
+		bool IsVisible(const BoxBounds &aabb) const;
+
+		unsigned int GetWidth() const;
+
+		unsigned int GetHeight() const;
+
+		unsigned int GetLevelCount() const;
+
+		float GetDepth(unsigned int x, unsigned int y, unsigned int level = 0) const;
+
+		unsigned int GetOccluderCount() const;
+
+		// triangles left after clipping and rejecting those without pixel coverage.
+		unsigned int GetTriangleCount() const;
+
+	protected:
+
+		void SetupTriangles(const Occluder &occluder, std::vector<Triangle> &triangles) const;
+
+		void AddTriangle(const float* a, const float* b, const float* c, std::vector<Triangle> &triangles) const;
+
+		void RasterizeBand(unsigned int band);
+
+		void BuildPyramid();
+	};
+}
+
+#endif // _FURY_OCCLUSION_BUFFER_H_
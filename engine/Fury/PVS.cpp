@@ -0,0 +1,435 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "Fury/Log.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshBVH.h"
+#include "Fury/MeshRender.h"
+#include "Fury/PVS.h"
+#include "Fury/SceneNode.h"
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	namespace
+	{
+		// true if the segment from a to a + d crosses the box.
+		bool SegmentHitsBox(Vector4 a, Vector4 d, Vector4 min, Vector4 max)
+		{
+			const float o[3] = { a.x, a.y, a.z };
+			const float dir[3] = { d.x, d.y, d.z };
+			const float lo[3] = { min.x, min.y, min.z };
+			const float hi[3] = { max.x, max.y, max.z };
+
+			float tmin = 0.0f, tmax = 1.0f;
+			for (unsigned int k = 0; k < 3; k++)
+			{
+				if (std::abs(dir[k]) < 1e-12f)
+				{
+					if (o[k] < lo[k] || o[k] > hi[k])
+						return false;
+					continue;
+				}
+
+				float inv = 1.0f / dir[k];
+				float t0 = (lo[k] - o[k]) * inv, t1 = (hi[k] - o[k]) * inv;
+				if (t0 > t1)
+					std::swap(t0, t1);
+				tmin = std::max(tmin, t0);
+				tmax = std::min(tmax, t1);
+				if (tmin > tmax)
+					return false;
+			}
+			return true;
+		}
+	}
+
+	PVS::Ptr PVS::Create()
+	{
+		return std::make_shared<PVS>();
+	}
+
+	PVS::PVS()
+	{
+		m_CellCounts[0] = m_CellCounts[1] = m_CellCounts[2] = 0;
+	}
+
+	bool PVS::Load(const void* wrapper, bool object)
+	{
+		if (object && !IsObject(wrapper))
+		{
+			FURYE << "Json node is not an object!";
+			return false;
+		}
+
+		if (!LoadMemberValue(wrapper, "bounds", m_Bounds) || !LoadMemberValue(wrapper, "cell_size", m_CellSize))
+		{
+			FURYE << "PVS bounds or cell_size not found!";
+			return false;
+		}
+
+		std::vector<unsigned int> counts;
+		if (!LoadArray(wrapper, "cell_counts", counts) || counts.size() != 3)
+		{
+			FURYE << "PVS cell_counts not found!";
+			return false;
+		}
+		std::copy(counts.begin(), counts.end(), m_CellCounts);
+
+		std::vector<std::string> names;
+		if (!LoadArray(wrapper, "objects", names))
+		{
+			FURYE << "PVS objects not found!";
+			return false;
+		}
+		SetObjects(names);
+
+		m_Cells.clear();
+		if (!LoadArray(wrapper, "cells", [&](const void* node) -> bool
+		{
+			m_Cells.push_back(std::vector<unsigned int>());
+			return LoadArray(node, m_Cells.back());
+		}))
+		{
+			FURYE << "PVS cells not found!";
+			return false;
+		}
+
+		if (m_Cells.size() != GetCellCount())
+		{
+			FURYE << "PVS cell count miss match!";
+			return false;
+		}
+
+		return true;
+	}
+
+	void PVS::Save(void* wrapper, bool object)
+	{
+		if (object)
+			StartObject(wrapper);
+
+		SaveKey(wrapper, "bounds");
+		SaveValue(wrapper, m_Bounds);
+
+		SaveKey(wrapper, "cell_size");
+		SaveValue(wrapper, m_CellSize);
+
+		SaveKey(wrapper, "cell_counts");
+		SaveArray(wrapper, 3, [&](unsigned int index)
+		{
+			SaveValue(wrapper, m_CellCounts[index]);
+		});
+
+		SaveKey(wrapper, "objects");
+		SaveArray(wrapper, m_ObjectNames);
+
+		SaveKey(wrapper, "cells");
+		SaveArray(wrapper, m_Cells.size(), [&](unsigned int index)
+		{
+			SaveArray(wrapper, m_Cells[index]);
+		});
+
+		if (object)
+			EndObject(wrapper);
+	}
+
+	bool PVS::Bake(const std::shared_ptr<SceneNode> &root, const BoxBounds &bounds, float cellSize,
+		unsigned int raysPerObject, bool allowParallel)
+	{
+		if (cellSize <= 0.0f || bounds.GetInfinite())
+		{
+			FURYE << "PVS needs finite bounds and a positive cell size!";
+			return false;
+		}
+
+		class Object
+		{
+		public:
+
+			BoxBounds aabb;
+
+			Matrix4 invertWorldMatrix;
+
+			std::shared_ptr<MeshBVH> bvh;
+		};
+
+		// collect static renderables, a mesh without a bvh is still culled but blocks nothing.
+		std::vector<std::shared_ptr<SceneNode>> nodes;
+		CollectObjects(root, nodes);
+
+		std::vector<Object> objects(nodes.size());
+		std::vector<std::string> names(nodes.size());
+		for (unsigned int i = 0; i < nodes.size(); i++)
+		{
+			const auto &node = nodes[i];
+			objects[i].aabb = node->GetWorldAABB();
+			objects[i].invertWorldMatrix = node->GetInvertWorldMatrix();
+			objects[i].bvh = node->GetComponent<MeshRender>()->GetMesh()->GetBVH();
+			names[i] = node->GetName();
+		}
+		SetObjects(names);
+
+		for (unsigned int i = 0; i < nodes.size(); i++)
+		{
+			auto &member = m_Members[nodes[i].get()];
+			member.node = nodes[i];
+			member.index = i;
+		}
+
+		m_Bounds = bounds;
+		m_CellSize = cellSize;
+
+		Vector4 size = bounds.GetSize();
+		m_CellCounts[0] = std::max(1, (int)std::ceil(size.x / cellSize));
+		m_CellCounts[1] = std::max(1, (int)std::ceil(size.y / cellSize));
+		m_CellCounts[2] = std::max(1, (int)std::ceil(size.z / cellSize));
+
+		unsigned int cellCount = GetCellCount();
+		m_Cells.assign(cellCount, std::vector<unsigned int>());
+
+		auto IsBlocked = [&](Vector4 from, Vector4 to, unsigned int target) -> bool
+		{
+			Vector4 direction = to - from;
+			for (unsigned int i = 0; i < objects.size(); i++)
+			{
+				if (i == target)
+					continue;
+
+				const Object &object = objects[i];
+				if (object.bvh == nullptr || !SegmentHitsBox(from, direction, object.aabb.GetMin(), object.aabb.GetMax()))
+					continue;
+
+				if (object.bvh->IntersectSegment(object.invertWorldMatrix.Multiply(from), object.invertWorldMatrix.Multiply(to)))
+					return true;
+			}
+			return false;
+		};
+
+		auto BakeCell = [&](unsigned int cell)
+		{
+			unsigned int x = cell % m_CellCounts[0];
+			unsigned int y = (cell / m_CellCounts[0]) % m_CellCounts[1];
+			unsigned int z = cell / (m_CellCounts[0] * m_CellCounts[1]);
+
+			Vector4 cellMin = bounds.GetMin() + Vector4(x * cellSize, y * cellSize, z * cellSize, 0.0f);
+			Vector4 cellMax = cellMin + Vector4(cellSize, cellSize, cellSize, 0.0f);
+			BoxBounds cellBounds(cellMin, cellMax);
+
+			// seeded per cell, the result doesn't depend on the worker count.
+			std::mt19937 random(cell * 2654435761u + 1);
+			std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+			auto RandomPoint = [&](Vector4 min, Vector4 max) -> Vector4
+			{
+				return Vector4(min.x + (max.x - min.x) * unit(random), min.y + (max.y - min.y) * unit(random),
+					min.z + (max.z - min.z) * unit(random), 1.0f);
+			};
+
+			std::vector<char> visible(objects.size(), 0);
+			for (unsigned int i = 0; i < objects.size(); i++)
+			{
+				const Object &object = objects[i];
+				if (cellBounds.IsInsideFast(object.aabb))
+				{
+					visible[i] = 1;
+					continue;
+				}
+
+				for (unsigned int ray = 0; ray < raysPerObject; ray++)
+				{
+					if (!IsBlocked(RandomPoint(cellMin, cellMax), RandomPoint(object.aabb.GetMin(), object.aabb.GetMax()), i))
+					{
+						visible[i] = 1;
+						break;
+					}
+				}
+			}
+
+			Encode(visible, m_Cells[cell]);
+		};
+
+		auto &threads = ThreadUtil::Instance();
+		if (allowParallel && threads != nullptr)
+			threads->ParallelFor(0, cellCount, 1, BakeCell);
+		else
+			for (unsigned int i = 0; i < cellCount; i++)
+				BakeCell(i);
+
+		unsigned long long visibleTotal = 0;
+		for (unsigned int i = 0; i < cellCount; i++)
+			visibleTotal += GetVisibleCount(i);
+
+		FURYI << "PVS baked " << cellCount << " cells, " << objects.size() << " objects, " <<
+			(cellCount > 0 ? visibleTotal / cellCount : 0) << " visible per cell, " << GetMemoryBytes() / 1024 << " kb.";
+
+		return true;
+	}
+
+	unsigned int PVS::Bind(const std::shared_ptr<SceneNode> &root)
+	{
+		m_Members.clear();
+
+		// object indices per name, in saved order.
+		std::unordered_map<std::string, std::vector<unsigned int>> indices;
+		for (unsigned int i = 0; i < m_ObjectNames.size(); i++)
+			indices[m_ObjectNames[i]].push_back(i);
+
+		std::unordered_map<std::string, unsigned int> used;
+
+		std::vector<std::shared_ptr<SceneNode>> nodes;
+		CollectObjects(root, nodes);
+
+		for (const auto &node : nodes)
+		{
+			auto it = indices.find(node->GetName());
+			if (it == indices.end())
+				continue;
+
+			unsigned int &next = used[it->first];
+			if (next >= it->second.size())
+				continue;
+
+			auto &member = m_Members[node.get()];
+			member.node = node;
+			member.index = it->second[next++];
+		}
+
+		if (m_Members.size() != m_ObjectNames.size())
+			FURYW << "PVS bound " << m_Members.size() << " of " << m_ObjectNames.size() << " objects, the scene changed since baking.";
+
+		return m_Members.size();
+	}
+
+	int PVS::GetCellIndex(Vector4 position) const
+	{
+		if (m_Cells.empty())
+			return -1;
+
+		Vector4 local = position - m_Bounds.GetMin();
+		int x = (int)std::floor(local.x / m_CellSize);
+		int y = (int)std::floor(local.y / m_CellSize);
+		int z = (int)std::floor(local.z / m_CellSize);
+
+		if (x < 0 || y < 0 || z < 0 || x >= (int)m_CellCounts[0] || y >= (int)m_CellCounts[1] || z >= (int)m_CellCounts[2])
+			return -1;
+
+		return x + (y + z * m_CellCounts[1]) * m_CellCounts[0];
+	}
+
+	unsigned int PVS::GetCellCount() const
+	{
+		return m_CellCounts[0] * m_CellCounts[1] * m_CellCounts[2];
+	}
+
+	unsigned int PVS::GetObjectCount() const
+	{
+		return m_ObjectNames.size();
+	}
+
+	int PVS::GetObjectIndex(const SceneNode &sceneNode) const
+	{
+		auto it = m_Members.find(sceneNode.GetRenderSource());
+		if (it == m_Members.end() || it->second.node.expired())
+			return -1;
+
+		return it->second.index;
+	}
+
+	void PVS::GetVisibleObjects(int cell, std::vector<char> &visible) const
+	{
+		visible.assign(m_ObjectNames.size(), 0);
+		if (cell < 0 || cell >= (int)m_Cells.size())
+			return;
+
+		unsigned int index = 0;
+		bool state = false;
+		for (auto run : m_Cells[cell])
+		{
+			unsigned int end = std::min(index + run, (unsigned int)visible.size());
+			if (state)
+				std::fill(visible.begin() + index, visible.begin() + end, 1);
+
+			index = end;
+			state = !state;
+		}
+	}
+
+	unsigned int PVS::GetVisibleCount(int cell) const
+	{
+		if (cell < 0 || cell >= (int)m_Cells.size())
+			return 0;
+
+		unsigned int count = 0;
+		const auto &runs = m_Cells[cell];
+		for (unsigned int i = 1; i < runs.size(); i += 2)
+			count += runs[i];
+
+		return count;
+	}
+
+	BoxBounds PVS::GetBounds() const
+	{
+		return m_Bounds;
+	}
+
+	float PVS::GetCellSize() const
+	{
+		return m_CellSize;
+	}
+
+	size_t PVS::GetMemoryBytes() const
+	{
+		size_t bytes = m_Cells.capacity() * sizeof(std::vector<unsigned int>);
+		for (const auto &runs : m_Cells)
+			bytes += runs.capacity() * sizeof(unsigned int);
+
+		return bytes;
+	}
+
+	void PVS::SetObjects(const std::vector<std::string> &names)
+	{
+		m_ObjectNames = names;
+		m_Members.clear();
+	}
+
+	void PVS::CollectObjects(const std::shared_ptr<SceneNode> &root, std::vector<std::shared_ptr<SceneNode>> &nodes)
+	{
+		std::vector<std::shared_ptr<SceneNode>> stack(1, root);
+		while (!stack.empty())
+		{
+			auto node = stack.back();
+			stack.pop_back();
+
+			for (unsigned int i = 0; i < node->GetChildCount(); i++)
+				stack.push_back(node->GetChildAt(i));
+
+			auto render = node->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable() && !render->GetMesh()->IsSkinnedMesh())
+				nodes.push_back(node);
+		}
+	}
+
+	void PVS::Encode(const std::vector<char> &visible, std::vector<unsigned int> &runs)
+	{
+		runs.clear();
+
+		bool state = false;
+		unsigned int length = 0;
+		for (auto value : visible)
+		{
+			if ((value != 0) != state)
+			{
+				runs.push_back(length);
+				state = !state;
+				length = 0;
+			}
+			length++;
+		}
+
+		if (state)
+			runs.push_back(length);
+
+		runs.shrink_to_fit();
+	}
+}
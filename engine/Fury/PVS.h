@@ -0,0 +1,109 @@
+#ifndef _FURY_PVS_H_
+#define _FURY_PVS_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/Serializable.h"
+
+namespace fury
+{
+	class SceneNode;
+
+	// potentially visible set of a static scene: a uniform grid of cells over the navigable space,
+	// and for each cell the static renderables that can be seen from somewhere inside it.
+	// objects are bound to their nodes by address, Bake binds them directly, a loaded set is bound
+	// by Bind, which matches saved names in walk order, so duplicated names are fine.
+	// nodes the set doesn't know, dynamic ones, are always potentially visible.
+	class FURY_API PVS : public Serializable
+	{
+	public:
+
+		typedef std::shared_ptr<PVS> Ptr;
+
+		static Ptr Create();
+
+	protected:
+
+		BoxBounds m_Bounds;
+
+		float m_CellSize = 1.0f;
+
+		unsigned int m_CellCounts[3];
+
+		class Member
+		{
+		public:
+
+			// a destroyed member's address may be reused by an unrelated node.
+			std::weak_ptr<SceneNode> node;
+
+			unsigned int index = 0;
+		};
+
+		std::vector<std::string> m_ObjectNames;
+
+		// keyed by node address.
+		std::unordered_map<const SceneNode*, Member> m_Members;
+
+		// rle bitset per cell, lengths of alternating hidden and visible runs, starting with hidden.
+		// trailing hidden objects are left out.
+		std::vector<std::vector<unsigned int>> m_Cells;
+
+	public:
+
+		PVS();
+
+		virtual bool Load(const void* wrapper, bool object = true) override;
+
+		virtual void Save(void* wrapper, bool object = true) override;
+
+		// offline, casts segments from random points in each cell to random points in each object's
+		// world aabb, an object is visible if one of them isn't blocked by the other objects' mesh bvhs.
+		// objects are the renderable non skinned nodes under root. sampling isn't conservative,
+		// more rays make missing a narrow gap less likely. cells are baked in parallel.
+		bool Bake(const std::shared_ptr<SceneNode> &root, const BoxBounds &bounds, float cellSize,
+			unsigned int raysPerObject = 32, bool allowParallel = true);
+
+		// binds a loaded set's objects to the static renderables under root, the n-th node named x
+		// in walk order becomes the n-th object named x, as Bake would have found them.
+		// returns the number of objects that found their node.
+		unsigned int Bind(const std::shared_ptr<SceneNode> &root);
+
+		// -1 outside the grid.
+		int GetCellIndex(Vector4 position) const;
+
+		unsigned int GetCellCount() const;
+
+		unsigned int GetObjectCount() const;
+
+		// -1 for nodes that aren't part of the set, render frame proxies resolve to their source.
+		int GetObjectIndex(const SceneNode &sceneNode) const;
+
+		// decodes one flag per object.
+		void GetVisibleObjects(int cell, std::vector<char> &visible) const;
+
+		// number of visible objects from a cell.
+		unsigned int GetVisibleCount(int cell) const;
+
+		BoxBounds GetBounds() const;
+
+		float GetCellSize() const;
+
+		size_t GetMemoryBytes() const;
+
+	protected:
+
+		void SetObjects(const std::vector<std::string> &names);
+
+		// renderable non skinned nodes under root, in the order Bake and Bind walk them.
+		static void CollectObjects(const std::shared_ptr<SceneNode> &root, std::vector<std::shared_ptr<SceneNode>> &nodes);
+
+		static void Encode(const std::vector<char> &visible, std::vector<unsigned int> &runs);
+	};
+}
+
+#endif // _FURY_PVS_H_
@@ -0,0 +1,690 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Fury/ParticleSystem.h"
+#include "Fury/EntityManager.h"
+#include "Fury/GLLoader.h"
+#include "Fury/Log.h"
+#include "Fury/Material.h"
+#include "Fury/Scene.h"
+#include "Fury/SceneNode.h"
+#include "Fury/ThreadUtil.h"
+
+#ifdef FURY_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace fury
+{
+	std::mutex ParticleSystem::m_SystemsMutex;
+
+	std::vector<ParticleSystem::Registration> ParticleSystem::m_Systems;
+
+	ParticleSystem::Ptr ParticleSystem::Create(const std::shared_ptr<Material> &material, unsigned int maxParticles)
+	{
+		return std::make_shared<ParticleSystem>(material, maxParticles);
+	}
+
+	void ParticleSystem::SimulateAll(float dt, bool allowParallel)
+	{
+		// locked copies, waiting in ParallelFor may run other tasks here that create or destroy systems,
+		// a system released meanwhile is destroyed when this returns, on the calling thread.
+		std::vector<Ptr> systems;
+		{
+			std::lock_guard<std::mutex> lock(m_SystemsMutex);
+			systems.reserve(m_Systems.size());
+			for (const auto &registration : m_Systems)
+			{
+				if (auto ptr = registration.ptr.lock())
+					systems.push_back(ptr);
+			}
+		}
+
+		auto &threadUtil = ThreadUtil::Instance();
+		if (allowParallel && threadUtil != nullptr)
+		{
+			threadUtil->ParallelFor(0, systems.size(), 1, [&systems, dt](unsigned int i)
+			{
+				systems[i]->Simulate(dt);
+			});
+		}
+		else
+		{
+			for (const auto &system : systems)
+				system->Simulate(dt);
+		}
+	}
+
+	void ParticleSystem::RadixSort(std::vector<uint32_t> &keys, std::vector<uint32_t> &values)
+	{
+		unsigned int count = keys.size();
+		std::vector<uint32_t> tempKeys(count), tempValues(count);
+
+		for (unsigned int shift = 0; shift < 32; shift += 8)
+		{
+			unsigned int offsets[256] = { 0 };
+			for (unsigned int i = 0; i < count; i++)
+				offsets[(keys[i] >> shift) & 0xFF]++;
+
+			// every key shares this digit, the pass wouldn't move anything.
+			if (count == 0 || offsets[(keys[0] >> shift) & 0xFF] == count)
+				continue;
+
+			unsigned int sum = 0;
+			for (unsigned int i = 0; i < 256; i++)
+			{
+				unsigned int digitCount = offsets[i];
+				offsets[i] = sum;
+				sum += digitCount;
+			}
+
+			for (unsigned int i = 0; i < count; i++)
+			{
+				unsigned int index = offsets[(keys[i] >> shift) & 0xFF]++;
+				tempKeys[index] = keys[i];
+				tempValues[index] = values[i];
+			}
+
+			keys.swap(tempKeys);
+			values.swap(tempValues);
+		}
+	}
+
+	ParticleSystem::ParticleSystem(const std::shared_ptr<Material> &material, unsigned int maxParticles) :
+		m_Material(material), m_MaxParticles(0),
+		m_InstanceData("particle_data", GL_ARRAY_BUFFER, GL_STREAM_DRAW),
+		m_Corners("particle_corner", GL_ARRAY_BUFFER, GL_STATIC_DRAW),
+		m_Indices("particle_index", GL_ELEMENT_ARRAY_BUFFER, GL_STATIC_DRAW)
+	{
+		m_TypeIndex = typeid(ParticleSystem);
+		SetMaxParticles(maxParticles);
+
+		m_Corners.Data = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
+		m_Indices.Data = { 0, 1, 2, 2, 3, 0 };
+	}
+
+	ParticleSystem::~ParticleSystem()
+	{
+		Unregister();
+		DeleteBuffer();
+	}
+
+	bool ParticleSystem::Load(const void* wrapper, bool object)
+	{
+		if (object && !IsObject(wrapper))
+		{
+			FURYE << "Json node is not an object!";
+			return false;
+		}
+
+		std::string str;
+		if (!LoadMemberValue(wrapper, "type", str) || str != "ParticleSystem")
+		{
+			FURYE << "Invalide type " << str << "!";
+			return false;
+		}
+
+		if (LoadMemberValue(wrapper, "material", str))
+		{
+			if (auto material = Scene::Manager()->Get<Material>(str))
+			{
+				SetMaterial(material);
+			}
+			else
+			{
+				FURYE << "Material " << str << " not found!";
+				return false;
+			}
+		}
+
+		unsigned int maxParticles = m_MaxParticles;
+		LoadMemberValue(wrapper, "max_particles", maxParticles);
+		SetMaxParticles(maxParticles);
+
+		LoadMemberValue(wrapper, "emission_rate", m_EmissionRate);
+		LoadMemberValue(wrapper, "min_life", m_MinLife);
+		LoadMemberValue(wrapper, "max_life", m_MaxLife);
+		LoadMemberValue(wrapper, "min_speed", m_MinSpeed);
+		LoadMemberValue(wrapper, "max_speed", m_MaxSpeed);
+		LoadMemberValue(wrapper, "spread", m_Spread);
+		LoadMemberValue(wrapper, "start_size", m_StartSize);
+		LoadMemberValue(wrapper, "end_size", m_EndSize);
+		LoadMemberValue(wrapper, "start_color", m_StartColor);
+		LoadMemberValue(wrapper, "end_color", m_EndColor);
+		LoadMemberValue(wrapper, "gravity", m_Gravity);
+		LoadMemberValue(wrapper, "drag", m_Drag);
+		LoadMemberValue(wrapper, "emitting", m_Emitting);
+		LoadMemberValue(wrapper, "sort", m_SortParticles);
+
+		m_Gravity.w = 0.0f;
+		UpdateOwnerBounds();
+
+		return true;
+	}
+
+	void ParticleSystem::Save(void* wrapper, bool object)
+	{
+		if (object)
+			StartObject(wrapper);
+
+		SaveKey(wrapper, "type");
+		SaveValue(wrapper, "ParticleSystem");
+
+		if (auto ptr = m_Material.lock())
+		{
+			SaveKey(wrapper, "material");
+			SaveValue(wrapper, ptr->GetName());
+		}
+
+		SaveKey(wrapper, "max_particles");
+		SaveValue(wrapper, m_MaxParticles);
+		SaveKey(wrapper, "emission_rate");
+		SaveValue(wrapper, m_EmissionRate);
+		SaveKey(wrapper, "min_life");
+		SaveValue(wrapper, m_MinLife);
+		SaveKey(wrapper, "max_life");
+		SaveValue(wrapper, m_MaxLife);
+		SaveKey(wrapper, "min_speed");
+		SaveValue(wrapper, m_MinSpeed);
+		SaveKey(wrapper, "max_speed");
+		SaveValue(wrapper, m_MaxSpeed);
+		SaveKey(wrapper, "spread");
+		SaveValue(wrapper, m_Spread);
+		SaveKey(wrapper, "start_size");
+		SaveValue(wrapper, m_StartSize);
+		SaveKey(wrapper, "end_size");
+		SaveValue(wrapper, m_EndSize);
+		SaveKey(wrapper, "start_color");
+		SaveValue(wrapper, m_StartColor);
+		SaveKey(wrapper, "end_color");
+		SaveValue(wrapper, m_EndColor);
+		SaveKey(wrapper, "gravity");
+		SaveValue(wrapper, m_Gravity);
+		SaveKey(wrapper, "drag");
+		SaveValue(wrapper, m_Drag);
+		SaveKey(wrapper, "emitting");
+		SaveValue(wrapper, m_Emitting);
+		SaveKey(wrapper, "sort");
+		SaveValue(wrapper, m_SortParticles);
+
+		if (object)
+			EndObject(wrapper);
+	}
+
+	Component::Ptr ParticleSystem::Clone() const
+	{
+		auto clone = ParticleSystem::Create(m_Material.lock(), m_MaxParticles);
+
+		clone->m_EmissionRate = m_EmissionRate;
+		clone->m_MinLife = m_MinLife;
+		clone->m_MaxLife = m_MaxLife;
+		clone->m_MinSpeed = m_MinSpeed;
+		clone->m_MaxSpeed = m_MaxSpeed;
+		clone->m_Spread = m_Spread;
+		clone->m_StartSize = m_StartSize;
+		clone->m_EndSize = m_EndSize;
+		clone->m_StartColor = m_StartColor;
+		clone->m_EndColor = m_EndColor;
+		clone->m_Gravity = m_Gravity;
+		clone->m_Drag = m_Drag;
+		clone->m_Emitting = m_Emitting;
+		clone->m_SortParticles = m_SortParticles;
+
+		return clone;
+	}
+
+	void ParticleSystem::Simulate(float dt)
+	{
+		auto owner = m_Owner.lock();
+		if (owner == nullptr || dt <= 0.0f)
+			return;
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		Integrate(dt);
+		Kill();
+
+		if (m_Emitting)
+		{
+			m_EmitAccumulator += m_EmissionRate * dt;
+			unsigned int count = (unsigned int)m_EmitAccumulator;
+			m_EmitAccumulator -= count;
+
+			Emit(std::min(count, m_MaxParticles - m_Count), owner->GetWorldMatrix());
+		}
+	}
+
+	unsigned int ParticleSystem::PrepareDraw(Vector4 camPos, Vector4 viewDir)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		unsigned int count = m_Count;
+		if (count == 0)
+			return 0;
+
+		m_SortIndices.resize(count);
+		for (unsigned int i = 0; i < count; i++)
+			m_SortIndices[i] = i;
+
+		if (m_SortParticles)
+		{
+			// farthest first, flipped floats sort like unsigned ints.
+			m_SortKeys.resize(count);
+			for (unsigned int i = 0; i < count; i++)
+			{
+				float depth = -((m_PositionX[i] - camPos.x) * viewDir.x + (m_PositionY[i] - camPos.y) * viewDir.y +
+					(m_PositionZ[i] - camPos.z) * viewDir.z);
+
+				uint32_t bits;
+				std::memcpy(&bits, &depth, sizeof(bits));
+				m_SortKeys[i] = bits ^ ((bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u);
+			}
+
+			RadixSort(m_SortKeys, m_SortIndices);
+		}
+
+		auto &data = m_InstanceData.Data;
+		data.resize(count * 4);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			unsigned int index = m_SortIndices[i];
+			data[i * 4] = m_PositionX[index];
+			data[i * 4 + 1] = m_PositionY[index];
+			data[i * 4 + 2] = m_PositionZ[index];
+			data[i * 4 + 3] = std::min(m_Age[index] / m_Life[index], 1.0f);
+		}
+
+		m_InstanceData.SetDirty();
+		m_InstanceData.UpdateBuffer();
+
+		return m_InstanceData.GetDirty() ? 0 : count;
+	}
+
+	void ParticleSystem::UpdateBuffer()
+	{
+		m_Corners.UpdateBuffer();
+		m_Indices.UpdateBuffer();
+
+		m_Dirty = m_Corners.GetDirty() || m_Indices.GetDirty();
+
+		if (m_VAO == 0)
+			glGenVertexArrays(1, &m_VAO);
+
+		if (m_VAO == 0)
+		{
+			m_Dirty = true;
+			FURYW << "Failed to glGenVertexArrays!";
+		}
+	}
+
+	void ParticleSystem::DeleteBuffer()
+	{
+		m_Dirty = true;
+
+		if (m_VAO != 0)
+		{
+			glDeleteVertexArrays(1, &m_VAO);
+			m_VAO = 0;
+		}
+
+		m_InstanceData.DeleteBuffer();
+		m_Corners.DeleteBuffer();
+		m_Indices.DeleteBuffer();
+	}
+
+	void ParticleSystem::Clear()
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Count = 0;
+		m_EmitAccumulator = 0.0f;
+	}
+
+	unsigned int ParticleSystem::GetParticleCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		return m_Count;
+	}
+
+	unsigned int ParticleSystem::GetIndexCount() const
+	{
+		return m_Indices.GetSize();
+	}
+
+	void ParticleSystem::SetMaterial(const std::shared_ptr<Material> &material)
+	{
+		m_Material = material;
+	}
+
+	std::shared_ptr<Material> ParticleSystem::GetMaterial() const
+	{
+		return m_Material.lock();
+	}
+
+	void ParticleSystem::SetMaxParticles(unsigned int count)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_MaxParticles = count;
+		m_Count = std::min(m_Count, count);
+
+		for (auto array : { &m_PositionX, &m_PositionY, &m_PositionZ, &m_VelocityX, &m_VelocityY, &m_VelocityZ, &m_Age, &m_Life })
+			array->resize(count);
+	}
+
+	unsigned int ParticleSystem::GetMaxParticles() const
+	{
+		return m_MaxParticles;
+	}
+
+	void ParticleSystem::SetEmissionRate(float rate)
+	{
+		m_EmissionRate = rate;
+	}
+
+	float ParticleSystem::GetEmissionRate() const
+	{
+		return m_EmissionRate;
+	}
+
+	void ParticleSystem::SetLife(float min, float max)
+	{
+		m_MinLife = min;
+		m_MaxLife = max;
+		UpdateOwnerBounds();
+	}
+
+	float ParticleSystem::GetMinLife() const
+	{
+		return m_MinLife;
+	}
+
+	float ParticleSystem::GetMaxLife() const
+	{
+		return m_MaxLife;
+	}
+
+	void ParticleSystem::SetSpeed(float min, float max)
+	{
+		m_MinSpeed = min;
+		m_MaxSpeed = max;
+		UpdateOwnerBounds();
+	}
+
+	float ParticleSystem::GetMinSpeed() const
+	{
+		return m_MinSpeed;
+	}
+
+	float ParticleSystem::GetMaxSpeed() const
+	{
+		return m_MaxSpeed;
+	}
+
+	void ParticleSystem::SetSpread(float radians)
+	{
+		m_Spread = radians;
+	}
+
+	float ParticleSystem::GetSpread() const
+	{
+		return m_Spread;
+	}
+
+	void ParticleSystem::SetSize(float start, float end)
+	{
+		m_StartSize = start;
+		m_EndSize = end;
+		UpdateOwnerBounds();
+	}
+
+	float ParticleSystem::GetStartSize() const
+	{
+		return m_StartSize;
+	}
+
+	float ParticleSystem::GetEndSize() const
+	{
+		return m_EndSize;
+	}
+
+	void ParticleSystem::SetColor(Color start, Color end)
+	{
+		m_StartColor = start;
+		m_EndColor = end;
+	}
+
+	Color ParticleSystem::GetStartColor() const
+	{
+		return m_StartColor;
+	}
+
+	Color ParticleSystem::GetEndColor() const
+	{
+		return m_EndColor;
+	}
+
+	void ParticleSystem::SetGravity(Vector4 gravity)
+	{
+		m_Gravity = gravity;
+		m_Gravity.w = 0.0f;
+		UpdateOwnerBounds();
+	}
+
+	Vector4 ParticleSystem::GetGravity() const
+	{
+		return m_Gravity;
+	}
+
+	void ParticleSystem::SetDrag(float drag)
+	{
+		m_Drag = drag;
+	}
+
+	float ParticleSystem::GetDrag() const
+	{
+		return m_Drag;
+	}
+
+	void ParticleSystem::SetEmitting(bool emitting)
+	{
+		m_Emitting = emitting;
+	}
+
+	bool ParticleSystem::GetEmitting() const
+	{
+		return m_Emitting;
+	}
+
+	void ParticleSystem::SetSortParticles(bool sort)
+	{
+		m_SortParticles = sort;
+	}
+
+	bool ParticleSystem::GetSortParticles() const
+	{
+		return m_SortParticles;
+	}
+
+	bool ParticleSystem::GetRenderable() const
+	{
+		return !m_Material.expired();
+	}
+
+	BoxBounds ParticleSystem::GetBounds() const
+	{
+		// drag only shortens the path.
+		float life = std::max(m_MinLife, m_MaxLife);
+		float reach = std::max(m_MinSpeed, m_MaxSpeed) * life + 0.5f * m_Gravity.Length() * life * life +
+			0.5f * std::max(m_StartSize, m_EndSize);
+
+		return BoxBounds(Vector4(-reach, -reach, -reach), Vector4(reach, reach, reach));
+	}
+
+	void ParticleSystem::OnAttaching(const std::shared_ptr<SceneNode> &node)
+	{
+		Component::OnAttaching(node);
+		UpdateOwnerBounds();
+		Register(node->GetComponent<ParticleSystem>());
+	}
+
+	void ParticleSystem::OnDetaching(const std::shared_ptr<SceneNode> &node)
+	{
+		Unregister();
+		Component::OnDetaching(node);
+		node->SetModelAABB(BoxBounds());
+	}
+
+	void ParticleSystem::OnOwnerDestructing(SceneNode &node)
+	{
+		Unregister();
+		Component::OnOwnerDestructing(node);
+	}
+
+	void ParticleSystem::Register(const Ptr &self)
+	{
+		if (self.get() != this)
+			return;
+
+		std::lock_guard<std::mutex> lock(m_SystemsMutex);
+		for (const auto &registration : m_Systems)
+		{
+			if (registration.system == this)
+				return;
+		}
+
+		Registration registration;
+		registration.system = this;
+		registration.ptr = self;
+		m_Systems.push_back(registration);
+	}
+
+	void ParticleSystem::Unregister()
+	{
+		std::lock_guard<std::mutex> lock(m_SystemsMutex);
+		auto it = std::find_if(m_Systems.begin(), m_Systems.end(), [this](const Registration &registration)
+		{
+			return registration.system == this;
+		});
+		if (it != m_Systems.end())
+			m_Systems.erase(it);
+	}
+
+	void ParticleSystem::UpdateOwnerBounds()
+	{
+		if (auto owner = m_Owner.lock())
+			owner->SetModelAABB(GetBounds());
+	}
+
+	void ParticleSystem::Emit(unsigned int count, const Matrix4 &world)
+	{
+		const float *raw = world.Raw;
+		float cosSpread = std::cos(m_Spread);
+
+		for (unsigned int i = 0; i < count; i++)
+		{
+			// uniform direction in the cone around local +y.
+			float cosTheta = 1.0f - Random01() * (1.0f - cosSpread);
+			float sinTheta = std::sqrt(std::max(0.0f, 1.0f - cosTheta * cosTheta));
+			float phi = Random01() * 6.2831853f;
+			float lx = sinTheta * std::cos(phi), ly = cosTheta, lz = sinTheta * std::sin(phi);
+
+			Vector4 dir(lx * raw[0] + ly * raw[4] + lz * raw[8], lx * raw[1] + ly * raw[5] + lz * raw[9],
+				lx * raw[2] + ly * raw[6] + lz * raw[10], 0.0f);
+			float length = dir.Length();
+			float speed = m_MinSpeed + (m_MaxSpeed - m_MinSpeed) * Random01();
+			if (length > 0.0f)
+				speed /= length;
+
+			unsigned int index = m_Count++;
+			m_PositionX[index] = raw[12];
+			m_PositionY[index] = raw[13];
+			m_PositionZ[index] = raw[14];
+			m_VelocityX[index] = dir.x * speed;
+			m_VelocityY[index] = dir.y * speed;
+			m_VelocityZ[index] = dir.z * speed;
+			m_Age[index] = 0.0f;
+			m_Life[index] = std::max(m_MinLife + (m_MaxLife - m_MinLife) * Random01(), 1e-4f);
+		}
+	}
+
+	void ParticleSystem::Integrate(float dt)
+	{
+		float damping = std::max(0.0f, 1.0f - m_Drag * dt);
+		float gx = m_Gravity.x * dt, gy = m_Gravity.y * dt, gz = m_Gravity.z * dt;
+
+		float *px = m_PositionX.data(), *py = m_PositionY.data(), *pz = m_PositionZ.data();
+		float *vx = m_VelocityX.data(), *vy = m_VelocityY.data(), *vz = m_VelocityZ.data();
+		float *age = m_Age.data();
+
+		unsigned int i = 0;
+
+#ifdef FURY_SSE
+		__m128 damping4 = _mm_set1_ps(damping), dt4 = _mm_set1_ps(dt);
+		__m128 gx4 = _mm_set1_ps(gx), gy4 = _mm_set1_ps(gy), gz4 = _mm_set1_ps(gz);
+
+		for (; i + 4 <= m_Count; i += 4)
+		{
+			__m128 x = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vx + i), damping4), gx4);
+			__m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), damping4), gy4);
+			__m128 z = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vz + i), damping4), gz4);
+
+			_mm_storeu_ps(vx + i, x);
+			_mm_storeu_ps(vy + i, y);
+			_mm_storeu_ps(vz + i, z);
+
+			_mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_mul_ps(x, dt4)));
+			_mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_mul_ps(y, dt4)));
+			_mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_mul_ps(z, dt4)));
+
+			_mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), dt4));
+		}
+#endif
+
+		for (; i < m_Count; i++)
+		{
+			vx[i] = vx[i] * damping + gx;
+			vy[i] = vy[i] * damping + gy;
+			vz[i] = vz[i] * damping + gz;
+
+			px[i] += vx[i] * dt;
+			py[i] += vy[i] * dt;
+			pz[i] += vz[i] * dt;
+
+			age[i] += dt;
+		}
+	}
+
+	void ParticleSystem::Kill()
+	{
+		// swap the last alive particle into each dead slot.
+		unsigned int i = 0;
+		while (i < m_Count)
+		{
+			if (m_Age[i] < m_Life[i])
+			{
+				i++;
+				continue;
+			}
+
+			unsigned int last = --m_Count;
+			m_PositionX[i] = m_PositionX[last];
+			m_PositionY[i] = m_PositionY[last];
+			m_PositionZ[i] = m_PositionZ[last];
+			m_VelocityX[i] = m_VelocityX[last];
+			m_VelocityY[i] = m_VelocityY[last];
+			m_VelocityZ[i] = m_VelocityZ[last];
+			m_Age[i] = m_Age[last];
+			m_Life[i] = m_Life[last];
+		}
+	}
+
+	float ParticleSystem::Random01()
+	{
+		// xorshift32.
+		m_Random ^= m_Random << 13;
+		m_Random ^= m_Random >> 17;
+		m_Random ^= m_Random << 5;
+		return (m_Random >> 8) * (1.0f / 16777216.0f);
+	}
+}
@@ -0,0 +1,244 @@
+#ifndef _FURY_PARTICLE_SYSTEM_H_
+#define _FURY_PARTICLE_SYSTEM_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Fury/ArrayBuffers.h"
+#include "Fury/BoxBounds.h"
+#include "Fury/Buffer.h"
+#include "Fury/Color.h"
+#include "Fury/Component.h"
+#include "Fury/Matrix4.h"
+#include "Fury/Vector4.h"
+
+namespace fury
+{
+	class Material;
+
+	class Shader;
+
+	// cpu particles emitted from the owner's world position along its local +y axis, particles are
+	// simulated in world space and kept as structure of arrays so 4 of them integrate per sse op.
+	// all attached systems are stepped by SimulateAll, one system per worker task, systems shared
+	// by RenderFrame proxies lock their particles while they're copied to the instance buffer.
+	// a system draws as one instanced quad per particle, back to front, see Shader::BindParticles.
+	// the owner's bounds are a conservative box from the emitter settings, they don't follow
+	// particles left behind by a moving emitter.
+	class FURY_API ParticleSystem : public Component, public Buffer
+	{
+		friend class Shader;
+
+	public:
+
+		typedef std::shared_ptr<ParticleSystem> Ptr;
+
+		static Ptr Create(const std::shared_ptr<Material> &material, unsigned int maxParticles = 1000);
+
+		// steps every attached system, in parallel on ThreadUtil's workers if allowed.
+		static void SimulateAll(float dt, bool allowParallel = true);
+
+		// sorts values ascending by keys with 4 8-bit lsd passes, keys and values are reordered in place.
+		static void RadixSort(std::vector<uint32_t> &keys, std::vector<uint32_t> &values);
+
+	protected:
+
+		class Registration
+		{
+		public:
+
+			// compared without locking, releasing a locked system under the mutex could destroy it there.
+			ParticleSystem *system = nullptr;
+
+			// weak, a registry entry doesn't keep a detached system alive.
+			std::weak_ptr<ParticleSystem> ptr;
+		};
+
+		static std::mutex m_SystemsMutex;
+
+		static std::vector<Registration> m_Systems;
+
+		std::weak_ptr<Material> m_Material;
+
+		unsigned int m_MaxParticles;
+
+		// particles per second.
+		float m_EmissionRate = 100.0f;
+
+		float m_MinLife = 1.0f;
+
+		float m_MaxLife = 2.0f;
+
+		float m_MinSpeed = 1.0f;
+
+		float m_MaxSpeed = 2.0f;
+
+		// half angle of the emission cone in radians.
+		float m_Spread = 0.5f;
+
+		float m_StartSize = 0.2f;
+
+		float m_EndSize = 0.0f;
+
+		Color m_StartColor = Color::White;
+
+		Color m_EndColor = Color(1, 1, 1, 0);
+
+		Vector4 m_Gravity = Vector4(0, -9.8f, 0, 0);
+
+		// fraction of velocity lost per second.
+		float m_Drag = 0.0f;
+
+		bool m_Emitting = true;
+
+		bool m_SortParticles = true;
+
+		// particles, [0, m_Count) are alive.
+
+		std::vector<float> m_PositionX, m_PositionY, m_PositionZ;
+
+		std::vector<float> m_VelocityX, m_VelocityY, m_VelocityZ;
+
+		std::vector<float> m_Age, m_Life;
+
+		unsigned int m_Count = 0;
+
+		float m_EmitAccumulator = 0.0f;
+
+		uint32_t m_Random = 2463534242u;
+
+		mutable std::mutex m_Mutex;
+
+		// sort scratch.
+
+		std::vector<uint32_t> m_SortKeys;
+
+		std::vector<uint32_t> m_SortIndices;
+
+		// xyz and normalized age per instance.
+		ArrayBufferf m_InstanceData;
+
+		ArrayBufferf m_Corners;
+
+		ArrayBufferui m_Indices;
+
+		unsigned int m_VAO = 0;
+
+	public:
+
+		ParticleSystem(const std::shared_ptr<Material> &material, unsigned int maxParticles);
+
+		virtual ~ParticleSystem();
+
+		virtual bool Load(const void* wrapper, bool object = true) override;
+
+		virtual void Save(void* wrapper, bool object = true) override;
+
+		Component::Ptr Clone() const override;
+
+		// emission, forces and lifetime, called by SimulateAll.
+		void Simulate(float dt);
+
+		// fills the instance buffer back to front from camPos along viewDir, gl thread only.
+		// returns the number of instances to draw.
+		unsigned int PrepareDraw(Vector4 camPos, Vector4 viewDir);
+
+		virtual void UpdateBuffer() override;
+
+		virtual void DeleteBuffer() override;
+
+		// kills all particles.
+		void Clear();
+
+		unsigned int GetParticleCount() const;
+
+		unsigned int GetIndexCount() const;
+
+		void SetMaterial(const std::shared_ptr<Material> &material);
+
+		std::shared_ptr<Material> GetMaterial() const;
+
+		void SetMaxParticles(unsigned int count);
+
+		unsigned int GetMaxParticles() const;
+
+		void SetEmissionRate(float rate);
+
+		float GetEmissionRate() const;
+
+		void SetLife(float min, float max);
+
+		float GetMinLife() const;
+
+		float GetMaxLife() const;
+
+		void SetSpeed(float min, float max);
+
+		float GetMinSpeed() const;
+
+		float GetMaxSpeed() const;
+
+		void SetSpread(float radians);
+
+		float GetSpread() const;
+
+		void SetSize(float start, float end);
+
+		float GetStartSize() const;
+
+		float GetEndSize() const;
+
+		void SetColor(Color start, Color end);
+
+		Color GetStartColor() const;
+
+		Color GetEndColor() const;
+
+		void SetGravity(Vector4 gravity);
+
+		Vector4 GetGravity() const;
+
+		void SetDrag(float drag);
+
+		float GetDrag() const;
+
+		void SetEmitting(bool emitting);
+
+		bool GetEmitting() const;
+
+		void SetSortParticles(bool sort);
+
+		bool GetSortParticles() const;
+
+		bool GetRenderable() const;
+
+		// model space box containing every particle of a static emitter.
+		BoxBounds GetBounds() const;
+
+	protected:
+
+		virtual void OnAttaching(const std::shared_ptr<SceneNode> &node) override;
+
+		virtual void OnDetaching(const std::shared_ptr<SceneNode> &node) override;
+
+		virtual void OnOwnerDestructing(SceneNode &node) override;
+
+		void Register(const Ptr &self);
+
+		void Unregister();
+
+		void UpdateOwnerBounds();
+
+		void Emit(unsigned int count, const Matrix4 &world);
+
+		void Integrate(float dt);
+
+		void Kill();
+
+		float Random01();
+	};
+}
+
+#endif // _FURY_PARTICLE_SYSTEM_H_
@@ -14,9 +14,13 @@
 #include "Fury/Material.h"
 #include "Fury/MathUtil.h"
 #include "Fury/Mesh.h"
+#include "Fury/MeshBVH.h"
 #include "Fury/MeshRender.h"
+#include "Fury/OcclusionBuffer.h"
+#include "Fury/ParticleSystem.h"
 #include "Fury/Pipeline.h"
 #include "Fury/Pass.h"
+#include "Fury/RenderFrame.h"
 #include "Fury/RenderUtil.h"
 #include "Fury/RenderQuery.h"
 #include "SceneManager.h"
@@ -24,9 +28,96 @@
 #include "Fury/Shader.h"
 #include "Fury/SphereBounds.h"
 #include "Fury/Texture.h"
+#include "Fury/ThreadUtil.h"
 
 namespace fury
 {
+	// ViewUnion
+
+	Side Pipeline::ViewUnion::IsInside(const SphereBounds &bsphere) const
+	{
+		Side result = Side::OUT;
+		for (const auto &frustum : *frustums)
+		{
+			Side side = frustum.IsInside(bsphere);
+			if (side == Side::IN)
+				return Side::IN;
+			else if (side == Side::STRADDLE)
+				result = Side::STRADDLE;
+		}
+		return result;
+	}
+
+	Side Pipeline::ViewUnion::IsInside(const BoxBounds &aabb) const
+	{
+		Side result = Side::OUT;
+		for (const auto &frustum : *frustums)
+		{
+			Side side = frustum.IsInside(aabb);
+			if (side == Side::IN)
+				return Side::IN;
+			else if (side == Side::STRADDLE)
+				result = Side::STRADDLE;
+		}
+		return result;
+	}
+
+	Side Pipeline::ViewUnion::IsInside(Vector4 point) const
+	{
+		Side result = Side::OUT;
+		for (const auto &frustum : *frustums)
+		{
+			Side side = frustum.IsInside(point);
+			if (side == Side::IN)
+				return Side::IN;
+			else if (side == Side::STRADDLE)
+				result = Side::STRADDLE;
+		}
+		return result;
+	}
+
+	bool Pipeline::ViewUnion::IsInsideFast(const SphereBounds &bsphere) const
+	{
+		for (const auto &frustum : *frustums)
+		{
+			if (frustum.IsInsideFast(bsphere))
+				return true;
+		}
+		return false;
+	}
+
+	bool Pipeline::ViewUnion::IsInsideFast(const BoxBounds &aabb) const
+	{
+		for (const auto &frustum : *frustums)
+		{
+			if (frustum.IsInsideFast(aabb))
+				return true;
+		}
+		return false;
+	}
+
+	bool Pipeline::ViewUnion::IsInsideFast(Vector4 point) const
+	{
+		for (const auto &frustum : *frustums)
+		{
+			if (frustum.IsInsideFast(point))
+				return true;
+		}
+		return false;
+	}
+
+	unsigned int Pipeline::ViewUnion::GetFrustumCount() const
+	{
+		return frustums->size();
+	}
+
+	const Frustum* Pipeline::ViewUnion::GetFrustumAt(unsigned int index) const
+	{
+		return index < frustums->size() ? &(*frustums)[index] : nullptr;
+	}
+
+	// Pipeline
+
 	Pipeline::Ptr Pipeline::Active = nullptr;
 
 	Pipeline::Pipeline(const std::string &name) : Entity(name)
@@ -35,6 +126,11 @@ namespace fury
 
 		m_SharedPass = Pass::Create("SharedPass");
 
+		m_FrontFrame = RenderFrame::Create();
+		m_BackFrame = RenderFrame::Create();
+
+		m_OcclusionBuffer = OcclusionBuffer::Create();
+
 		m_OffsetMatrix = Matrix4({
 			0.5, 0.0, 0.0, 0.0,
 			0.0, 0.5, 0.0, 0.0,
@@ -236,17 +332,17 @@ namespace fury
 		m_DebugFrustum.push_back(bounds);
 	}
 
-	std::shared_ptr<Pass> Pipeline::GetPassByName(const std::string &name)
+	std::shared_ptr<Pass> Pipeline::GetPassByName(const Name &name)
 	{
 		return m_EntityManager->Get<Pass>(name);
 	}
 
-	std::shared_ptr<Texture> Pipeline::GetTextureByName(const std::string &name)
+	std::shared_ptr<Texture> Pipeline::GetTextureByName(const Name &name)
 	{
 		return m_EntityManager->Get<Texture>(name);
 	}
 
-	std::shared_ptr<Shader> Pipeline::GetShaderByName(const std::string &name)
+	std::shared_ptr<Shader> Pipeline::GetShaderByName(const Name &name)
 	{
 		return m_EntityManager->Get<Shader>(name);
 	}
@@ -261,18 +357,399 @@ namespace fury
 		m_CurrentCamera = ptr;
 	}
 
-	void Pipeline::FilterNodes(const Collidable &collider, std::vector<std::shared_ptr<SceneNode>> &possibles, std::vector<std::shared_ptr<SceneNode>> &collisions)
+	void Pipeline::SetViewer(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &camera)
+	{
+		auto cameraComponent = camera->GetComponent<Camera>();
+
+		float projectionScale = cameraComponent->IsPerspective() ? cameraComponent->GetProjectionMatrix().Raw[5] : 0.0f;
+		sceneManager->SetViewerPosition(camera->GetWorldPosition(), projectionScale);
+	}
+
+	void Pipeline::GetRenderQuery(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &camera,
+		const std::shared_ptr<RenderQuery> &query)
+	{
+		auto cameraComponent = camera->GetComponent<Camera>();
+
+		SetViewer(sceneManager, camera);
+
+		if (!IsSwitchOn(PipelineSwitch::OCCLUSION_CULLING))
+		{
+			sceneManager->GetRenderQuery(cameraComponent->GetFrustum(), query);
+			return;
+		}
+
+		query->Clear();
+
+		FrameNodes renderables, occluders;
+		sceneManager->WalkScene(cameraComponent->GetFrustum(), [&](const std::shared_ptr<SceneNode> &sceneNode)
+		{
+			if (sceneNode->GetComponent<Light>() != nullptr)
+				query->AddLight(sceneNode);
+
+			auto particles = sceneNode->GetComponent<ParticleSystem>();
+			if (particles != nullptr && particles->GetRenderable() && sceneManager->IsPotentiallyVisible(*sceneNode) &&
+				sceneManager->IsDetailVisible(*sceneNode, false))
+				query->AddParticles(sceneNode);
+
+			auto render = sceneNode->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable() && sceneManager->IsPotentiallyVisible(*sceneNode) &&
+				sceneManager->IsDetailVisible(*sceneNode, false))
+			{
+				if (render->GetOccluder())
+					occluders.push_back(sceneNode);
+				else
+					renderables.push_back(sceneNode);
+			}
+		});
+
+		for (const auto &node : occluders)
+			query->AddRenderable(node);
+
+		// one flag per renderable, chars since vector<bool> can't be written concurrently.
+		FrameVector<char> visible;
+		TestOcclusion(camera, occluders, renderables, visible);
+
+		for (unsigned int i = 0; i < renderables.size(); i++)
+		{
+			if (visible[i])
+				query->AddRenderable(renderables[i]);
+		}
+	}
+
+	void Pipeline::TestOcclusion(const std::shared_ptr<SceneNode> &camera, const FrameNodes &occluders, const FrameNodes &renderables,
+		FrameVector<char> &visible)
+	{
+		m_OcclusionBuffer->Begin(camera->GetComponent<Camera>()->GetProjectionMatrix() * camera->GetInvertWorldMatrix());
+
+		for (const auto &node : occluders)
+		{
+			// skinned meshes move away from their bind pose, they can't occlude safely.
+			auto mesh = node->GetComponent<MeshRender>()->GetOccluderMesh();
+			if (!mesh->IsSkinnedMesh())
+				m_OcclusionBuffer->AddOccluder(mesh->GetBVH(), node->GetWorldMatrix());
+		}
+
+		m_OcclusionBuffer->Rasterize();
+
+		visible.assign(renderables.size(), 1);
+		auto test = [&](unsigned int i)
+		{
+			visible[i] = m_OcclusionBuffer->IsVisible(renderables[i]->GetWorldAABB()) ? 1 : 0;
+		};
+
+		if (auto &threads = ThreadUtil::Instance())
+			threads->ParallelFor(0, renderables.size(), 64, test);
+		else
+			for (unsigned int i = 0; i < renderables.size(); i++)
+				test(i);
+
+		unsigned int occluded = 0;
+		for (auto flag : visible)
+			occluded += flag ? 0 : 1;
+
+		RenderUtil::Instance()->IncreaseOcclusionTestCount(renderables.size());
+		RenderUtil::Instance()->IncreaseOcclusionCullCount(occluded);
+	}
+
+	void Pipeline::GetRenderQueries(const std::shared_ptr<SceneManager> &sceneManager, const std::vector<std::shared_ptr<SceneNode>> &cameras,
+		std::vector<std::shared_ptr<RenderQuery>> &queries)
+	{
+		unsigned int viewCount = std::min<unsigned int>(cameras.size(), 32);
+		if (viewCount < cameras.size())
+			FURYW << "Only the first 32 of " << cameras.size() << " cameras are culled!";
+
+		queries.resize(viewCount);
+		for (auto &query : queries)
+		{
+			if (query == nullptr)
+				query = RenderQuery::Create();
+			else
+				query->Clear();
+		}
+
+		FrameVector<Frustum> frustums;
+		frustums.reserve(viewCount);
+		for (unsigned int i = 0; i < viewCount; i++)
+			frustums.push_back(cameras[i]->GetComponent<Camera>()->GetFrustum());
+
+		ViewUnion collider;
+		collider.frustums = &frustums;
+
+		// one bit per camera whose frustum holds the node.
+		FrameNodes renderables, particles;
+		FrameVector<uint32_t> renderableViews, particleViews;
+
+		sceneManager->WalkScene(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+		{
+			uint32_t views = 0;
+			for (unsigned int i = 0; i < viewCount; i++)
+			{
+				if (sceneNode->IsInsideFast(frustums[i]))
+					views |= 1u << i;
+			}
+
+			if (views == 0)
+				return;
+
+			if (sceneNode->GetComponent<Light>() != nullptr)
+			{
+				for (unsigned int i = 0; i < viewCount; i++)
+				{
+					if (views & (1u << i))
+						queries[i]->AddLight(sceneNode);
+				}
+			}
+
+			auto particleSystem = sceneNode->GetComponent<ParticleSystem>();
+			if (particleSystem != nullptr && particleSystem->GetRenderable())
+			{
+				particles.push_back(sceneNode);
+				particleViews.push_back(views);
+			}
+
+			auto render = sceneNode->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable())
+			{
+				renderables.push_back(sceneNode);
+				renderableViews.push_back(views);
+			}
+		});
+
+		// pvs, detail and occlusion culling depend on the viewer, clear the bits of cameras that reject a node.
+		bool occlusionCulling = IsSwitchOn(PipelineSwitch::OCCLUSION_CULLING);
+		for (unsigned int i = 0; i < viewCount; i++)
+		{
+			uint32_t bit = 1u << i;
+			SetViewer(sceneManager, cameras[i]);
+
+			auto cull = [&](const FrameNodes &nodes, FrameVector<uint32_t> &views)
+			{
+				for (unsigned int j = 0; j < nodes.size(); j++)
+				{
+					if ((views[j] & bit) && !(sceneManager->IsPotentiallyVisible(*nodes[j]) && sceneManager->IsDetailVisible(*nodes[j], false)))
+						views[j] &= ~bit;
+				}
+			};
+
+			cull(renderables, renderableViews);
+			cull(particles, particleViews);
+
+			if (!occlusionCulling)
+				continue;
+
+			FrameNodes occluders, occludees;
+			FrameVector<unsigned int> occludeeIndices;
+			for (unsigned int j = 0; j < renderables.size(); j++)
+			{
+				if (!(renderableViews[j] & bit))
+					continue;
+
+				if (renderables[j]->GetComponent<MeshRender>()->GetOccluder())
+				{
+					occluders.push_back(renderables[j]);
+				}
+				else
+				{
+					occludees.push_back(renderables[j]);
+					occludeeIndices.push_back(j);
+				}
+			}
+
+			FrameVector<char> visible;
+			TestOcclusion(cameras[i], occluders, occludees, visible);
+
+			for (unsigned int j = 0; j < occludees.size(); j++)
+			{
+				if (!visible[j])
+					renderableViews[occludeeIndices[j]] &= ~bit;
+			}
+		}
+
+		// expand every renderable once, remembering which cameras each unit belongs to.
+		auto shared = RenderQuery::Create();
+		FrameVector<uint32_t> opaqueViews, transparentViews;
+		for (unsigned int j = 0; j < renderables.size(); j++)
+		{
+			uint32_t views = renderableViews[j];
+			if (views == 0)
+				continue;
+
+			shared->AddRenderable(renderables[j]);
+			opaqueViews.resize(shared->opaqueUnits.size(), views);
+			transparentViews.resize(shared->transparentUnits.size(), views);
+
+			for (unsigned int i = 0; i < viewCount; i++)
+			{
+				if (views & (1u << i))
+					queries[i]->renderableNodes.push_back(renderables[j]);
+			}
+		}
+
+		// sort opaque units once, each camera's list is a subsequence of that order.
+		FrameVector<unsigned int> order(shared->opaqueUnits.size());
+		for (unsigned int j = 0; j < order.size(); j++)
+			order[j] = j;
+
+		const auto &units = shared->opaqueUnits;
+		std::sort(order.begin(), order.end(), [&units](unsigned int a, unsigned int b) -> bool
+		{
+			if (units[a].material != units[b].material)
+				return units[a].material < units[b].material;
+			if (units[a].mesh != units[b].mesh)
+				return units[a].mesh < units[b].mesh;
+			return a < b;
+		});
+
+		for (unsigned int i = 0; i < viewCount; i++)
+		{
+			uint32_t bit = 1u << i;
+			auto &query = queries[i];
+
+			for (auto j : order)
+			{
+				if (opaqueViews[j] & bit)
+					query->opaqueUnits.push_back(units[j]);
+			}
+
+			for (unsigned int j = 0; j < shared->transparentUnits.size(); j++)
+			{
+				if (transparentViews[j] & bit)
+					query->transparentUnits.push_back(shared->transparentUnits[j]);
+			}
+
+			for (unsigned int j = 0; j < particles.size(); j++)
+			{
+				if (particleViews[j] & bit)
+					query->AddParticles(particles[j]);
+			}
+
+			query->SortTransparent(cameras[i]->GetWorldPosition());
+		}
+	}
+
+	void Pipeline::ExecuteViews(const std::shared_ptr<SceneManager> &sceneManager, const std::vector<View> &views)
+	{
+		std::vector<std::shared_ptr<SceneNode>> cameras;
+		cameras.reserve(views.size());
+		for (const auto &view : views)
+			cameras.push_back(view.camera);
+
+		std::vector<std::shared_ptr<RenderQuery>> queries;
+		GetRenderQueries(sceneManager, cameras, queries);
+
+		auto liveCamera = m_CurrentCamera;
+		m_ShareShadows = true;
+
+		for (unsigned int i = 0; i < queries.size(); i++)
+		{
+			const auto &view = views[i];
+
+			m_CurrentCamera = view.camera;
+			m_ViewportX = view.x;
+			m_ViewportY = view.y;
+			m_ViewportWidth = view.width;
+			m_ViewportHeight = view.height;
+
+			// shadow casters are detail culled from the view drawing the light first.
+			SetViewer(sceneManager, view.camera);
+
+			Execute(sceneManager, queries[i]);
+		}
+
+		m_ShareShadows = false;
+		for (auto &pair : m_SharedShadows)
+			Texture::CollectTempory(pair.second.first);
+		m_SharedShadows.clear();
+
+		m_ViewportX = m_ViewportY = 0;
+		m_ViewportWidth = m_ViewportHeight = 0;
+		m_CurrentCamera = liveCamera;
+	}
+
+	void Pipeline::BindPass(const std::shared_ptr<Pass> &pass, bool clear)
+	{
+		bool clipped = m_ViewportWidth > 0 && m_ViewportHeight > 0 && pass->GetTextureCount(false) == 0;
+
+		// scissor so clearing the window doesn't wipe the views drawn before.
+		if (clipped)
+		{
+			glEnable(GL_SCISSOR_TEST);
+			glScissor(m_ViewportX, m_ViewportY, m_ViewportWidth, m_ViewportHeight);
+		}
+
+		pass->Bind(clear);
+
+		if (clipped)
+			glViewport(m_ViewportX, m_ViewportY, m_ViewportWidth, m_ViewportHeight);
+	}
+
+	void Pipeline::UnBindPass(const std::shared_ptr<Pass> &pass)
+	{
+		pass->UnBind();
+
+		if (m_ViewportWidth > 0 && m_ViewportHeight > 0)
+			glDisable(GL_SCISSOR_TEST);
+	}
+
+	void Pipeline::ReleaseShadowMap(const std::shared_ptr<Texture> &texture)
+	{
+		if (!m_ShareShadows)
+			Texture::CollectTempory(texture);
+	}
+
+	std::shared_ptr<OcclusionBuffer> Pipeline::GetOcclusionBuffer() const
+	{
+		return m_OcclusionBuffer;
+	}
+
+	void Pipeline::Capture(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &camera)
+	{
+		m_BackFrame->Capture(sceneManager, camera);
+	}
+
+	void Pipeline::ExecuteFrame()
+	{
+		auto camera = m_FrontFrame->GetCamera();
+		if (camera == nullptr)
+			return;
+
+		// the snapshot's camera proxy stands in for the live camera while drawing.
+		auto liveCamera = m_CurrentCamera;
+		m_CurrentCamera = camera;
+
+		Execute(m_FrontFrame);
+
+		m_CurrentCamera = liveCamera;
+	}
+
+	void Pipeline::SwapFrames()
+	{
+		std::swap(m_FrontFrame, m_BackFrame);
+	}
+
+	void Pipeline::FilterNodes(const Collidable &collider, FrameNodes &possibles, FrameNodes &collisions)
 	{
 		collisions.erase(collisions.begin(), collisions.end());
 
 		for (auto possible : possibles)
 		{
-			if (collider.IsInsideFast(possible->GetWorldAABB()))
+			if (possible->IsInsideFast(collider))
 				collisions.push_back(possible);
 		}
 	}
 
-	Matrix4 Pipeline::GetCropMatrix(Matrix4 lightMatrix, Frustum frustum, std::vector<std::shared_ptr<SceneNode>> &casters)
+	void Pipeline::GetShadowCasters(const std::shared_ptr<SceneManager> &sceneManager, const Collidable &collider, FrameNodes &casters, bool castShadows)
+	{
+		sceneManager->WalkScene(collider, [&sceneManager, &casters, castShadows](const std::shared_ptr<SceneNode> &sceneNode)
+		{
+			auto render = sceneNode->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable() && (!castShadows || render->GetMesh()->GetCastShadows()) &&
+				sceneManager->IsDetailVisible(*sceneNode, true))
+				casters.push_back(sceneNode);
+		});
+	}
+
+	Matrix4 Pipeline::GetCropMatrix(Matrix4 lightMatrix, Frustum frustum, FrameNodes &casters)
 	{
 		// limit z
 		auto corners = frustum.GetCurrentCorners();
@@ -338,12 +815,12 @@ namespace fury
 		return projMatrix * cropMatrix;
 	}
 
-	std::pair<std::shared_ptr<Texture>, std::vector<Matrix4>> Pipeline::DrawCascadedShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
+	std::pair<std::shared_ptr<Texture>, FrameVector<Matrix4>> Pipeline::DrawCascadedShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
 	{
 		const int numSplit = 4;
 
 		// get pointers
-		auto depth_shader = GetShaderByName("leagcy_depth_shader");
+		auto depth_shader = GetShaderByName(FURY_NAME("leagcy_depth_shader"));
 		auto depth_buffer = Texture::GetTempory(1024, 1024, 4, TextureFormat::DEPTH24, TextureType::TEXTURE_2D_ARRAY);
 		depth_buffer->SetBorderColor(Color::White);
 		depth_buffer->SetWrapMode(WrapMode::CLAMP_TO_BORDER);
@@ -370,10 +847,10 @@ namespace fury
 		}
 
 		// find shadow casters
-		fury::SceneManager::SceneNodes casterAll;
-		sceneManager->GetVisibleShadowCasters(camera->GetFrustum(), casterAll);
+		FrameNodes casterAll;
+		GetShadowCasters(sceneManager, camera->GetFrustum(), casterAll);
 
-		std::array<fury::SceneManager::SceneNodes, numSplit> casterArrays;
+		std::array<FrameNodes, numSplit> casterArrays;
 		for (int i = 0; i < numSplit; i++)
 		{
 			auto &casters = casterArrays[i];
@@ -383,7 +860,7 @@ namespace fury
 
 		// use camera aabb to include more possible shadow casters to cast shadows.
 		if (camera->GetShadowBounds(false).GetExtents().SquareLength() > 0)
-			sceneManager->GetVisibleShadowCasters(camera->GetShadowBounds(), casterArrays[0], false);
+			GetShadowCasters(sceneManager, camera->GetShadowBounds(), casterArrays[0]);
 
 		// build projection/crop matrices
 		std::array<Matrix4, numSplit> projMatrices;
@@ -429,10 +906,10 @@ namespace fury
 					depth_shader->BindMesh(casterMesh);
 					depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
 
-					glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+					glDrawElements(GL_TRIANGLES, casterMesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 					RenderUtil::Instance()->IncreaseDrawCall();
 
-					RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
+					RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.GetSize());
 				}
 			}
 
@@ -442,7 +919,8 @@ namespace fury
 			m_SharedPass->UnBind();
 		}
 
-		std::vector<Matrix4> matrices;
+		FrameVector<Matrix4> matrices;
+		matrices.reserve(numSplit);
 		for (int i = 0; i < numSplit; i++)
 			matrices.push_back(m_OffsetMatrix * projMatrices[i] * lightMatrix * m_CurrentCamera->GetWorldMatrix());
 
@@ -452,7 +930,7 @@ namespace fury
 	std::pair<std::shared_ptr<Texture>, Matrix4> Pipeline::DrawDirLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
 	{
 		// get pointers
-		auto depth_shader = GetShaderByName("leagcy_depth_shader");
+		auto depth_shader = GetShaderByName(FURY_NAME("leagcy_depth_shader"));
 		auto depth_buffer = Texture::GetTempory(1024, 1024, 0, TextureFormat::DEPTH24, TextureType::TEXTURE_2D);
 		depth_buffer->SetBorderColor(Color::White);
 		depth_buffer->SetWrapMode(WrapMode::CLAMP_TO_BORDER);
@@ -470,12 +948,12 @@ namespace fury
 		auto camFrustum = camera->GetFrustum(camera->GetNear(), camera->GetShadowFar());
 
 		// find shadow casters
-		fury::SceneManager::SceneNodes casters;
-		sceneManager->GetVisibleShadowCasters(camFrustum, casters, false);
+		FrameNodes casters;
+		GetShadowCasters(sceneManager, camFrustum, casters);
 
 		// use camera aabb to include more possible shadow casters to cast shadows.
 		if (camera->GetShadowBounds(false).GetExtents().SquareLength() > 0)
-			sceneManager->GetVisibleShadowCasters(camera->GetShadowBounds(), casters, false);
+			GetShadowCasters(sceneManager, camera->GetShadowBounds(), casters);
 
 		// gen projection matrix for light.
 		Matrix4 projMatrix = GetCropMatrix(lightMatrix, camFrustum, casters);
@@ -508,10 +986,10 @@ namespace fury
 				depth_shader->BindMesh(casterMesh);
 				depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
 
-				glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+				glDrawElements(GL_TRIANGLES, casterMesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 				RenderUtil::Instance()->IncreaseDrawCall();
 
-				RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
+				RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.GetSize());
 			}
 
 			glDisable(GL_POLYGON_OFFSET_FILL);
@@ -525,7 +1003,14 @@ namespace fury
 
 	std::pair<std::shared_ptr<Texture>, Matrix4> Pipeline::DrawPointLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
 	{
-		auto depth_shader = GetShaderByName("cube_depth_shader");
+		if (m_ShareShadows)
+		{
+			auto it = m_SharedShadows.find(node.get());
+			if (it != m_SharedShadows.end())
+				return std::make_pair(it->second.first, it->second.second * m_CurrentCamera->GetWorldMatrix());
+		}
+
+		auto depth_shader = GetShaderByName(FURY_NAME("cube_depth_shader"));
 		auto depth_buffer = Texture::GetTempory(512, 512, 0, TextureFormat::DEPTH24, TextureType::TEXTURE_CUBE_MAP);
 
 		// for debug
@@ -538,8 +1023,8 @@ namespace fury
 		auto lightSphere = SphereBounds(node->GetWorldPosition(), radius);
 
 		// TODO: filter casters for all six directions.
-		fury::SceneManager::SceneNodes casters;
-		sceneManager->GetVisibleShadowCasters(lightSphere, casters);
+		FrameNodes casters;
+		GetShadowCasters(sceneManager, lightSphere, casters);
 
 		float aspect = (float)depth_buffer->GetWidth() / depth_buffer->GetHeight();
 		Matrix4 projMatrix;
@@ -575,8 +1060,8 @@ namespace fury
 
 			depth_shader->Bind();
 			depth_shader->BindMatrix(Matrix4::PROJECTION_MATRIX, &projMatrix.Raw[0]);
-			depth_shader->BindFloat("light_far", radius);
-			depth_shader->BindFloat("light_pos", lightPos.x, lightPos.y, lightPos.z);
+			depth_shader->BindFloat(FURY_NAME("light_far"), radius);
+			depth_shader->BindFloat(FURY_NAME("light_pos"), lightPos.x, lightPos.y, lightPos.z);
 
 			for (int i = 0; i < 6; i++)
 			{
@@ -595,10 +1080,10 @@ namespace fury
 					depth_shader->BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &ivm.Raw[0]);
 					depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
 
-					glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+					glDrawElements(GL_TRIANGLES, casterMesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 					RenderUtil::Instance()->IncreaseDrawCall();
 
-					RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
+					RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.GetSize());
 				}
 			}
 
@@ -608,13 +1093,23 @@ namespace fury
 			m_SharedPass->UnBind();
 		}
 
+		if (m_ShareShadows)
+			m_SharedShadows[node.get()] = std::make_pair(depth_buffer, Matrix4());
+
 		return std::make_pair(depth_buffer, m_CurrentCamera->GetWorldMatrix());
 	}
 
 	std::pair<std::shared_ptr<Texture>, Matrix4> Pipeline::DrawSpotLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
 	{
+		if (m_ShareShadows)
+		{
+			auto it = m_SharedShadows.find(node.get());
+			if (it != m_SharedShadows.end())
+				return std::make_pair(it->second.first, it->second.second * m_CurrentCamera->GetWorldMatrix());
+		}
+
 		// get pointers
-		auto depth_shader = GetShaderByName("leagcy_depth_shader");
+		auto depth_shader = GetShaderByName(FURY_NAME("leagcy_depth_shader"));
 		auto depth_buffer = Texture::GetTempory(1024, 1024, 0, TextureFormat::DEPTH24, TextureType::TEXTURE_2D);
 
 		// for debug
@@ -640,8 +1135,8 @@ namespace fury
 		projMatrix.PerspectiveFov(light->GetOutterAngle(), aspect, 1.0f, radius);
 
 		// find shadow casters
-		fury::SceneManager::SceneNodes casters;
-		sceneManager->GetVisibleRenderables(frustum, casters);
+		FrameNodes casters;
+		GetShadowCasters(sceneManager, frustum, casters, false);
 
 		// draw casters to depth map, aka shadow map.
 		{
@@ -671,10 +1166,10 @@ namespace fury
 				depth_shader->BindMesh(casterMesh);
 				depth_shader->BindMatrix(Matrix4::WORLD_MATRIX, &caster->GetWorldMatrix().Raw[0]);
 
-				glDrawElements(GL_TRIANGLES, casterMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+				glDrawElements(GL_TRIANGLES, casterMesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 				RenderUtil::Instance()->IncreaseDrawCall();
 
-				RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.Data.size());
+				RenderUtil::Instance()->IncreaseTriangleCount(casterMesh->Indices.GetSize());
 			}
 
 			glDisable(GL_POLYGON_OFFSET_FILL);
@@ -683,7 +1178,12 @@ namespace fury
 			m_SharedPass->UnBind();
 		}
 
-		return std::make_pair(depth_buffer, m_OffsetMatrix * projMatrix * lightMatrix * m_CurrentCamera->GetWorldMatrix());
+		Matrix4 shadowMatrix = m_OffsetMatrix * projMatrix * lightMatrix;
+
+		if (m_ShareShadows)
+			m_SharedShadows[node.get()] = std::make_pair(depth_buffer, shadowMatrix);
+
+		return std::make_pair(depth_buffer, shadowMatrix * m_CurrentCamera->GetWorldMatrix());
 	}
 
 	void Pipeline::DrawDebug(const std::shared_ptr<RenderQuery> &query)
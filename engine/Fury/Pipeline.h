@@ -5,8 +5,11 @@
 #include <unordered_map>
 #include <string>
 #include <bitset>
+#include <vector>
 
+#include "Fury/Collidable.h"
 #include "Fury/Entity.h"
+#include "Fury/FrameArena.h"
 
 namespace fury
 {
@@ -20,6 +23,8 @@ namespace fury
 
 	class Mesh;
 
+	class OcclusionBuffer;
+
 	class Pass;
 
 	class SceneNode;
@@ -36,12 +41,15 @@ namespace fury
 
 	class RenderQuery;
 
+	class RenderFrame;
+
 	enum class PipelineSwitch : unsigned int
 	{
 		CASCADED_SHADOW_MAP = 0, 
 		MESH_BOUNDS, 
 		LIGHT_BOUNDS, 
 		CUSTOM_BOUNDS, 
+		OCCLUSION_CULLING, 
 		LENGTH
 	};
 
@@ -53,10 +61,54 @@ namespace fury
 
 		typedef std::shared_ptr<Pipeline> Ptr;
 
+		// per frame node lists, see FrameArena.
+		typedef FrameVector<std::shared_ptr<SceneNode>> FrameNodes;
+
 		static Ptr Active;
 
+		// a camera and the part of the window it draws to, see ExecuteViews.
+		class View
+		{
+		public:
+
+			std::shared_ptr<SceneNode> camera;
+
+			// pixels from the window's bottom left, a zero size covers the whole window.
+
+			int x, y;
+
+			unsigned int width, height;
+
+			View(const std::shared_ptr<SceneNode> &camera, int x = 0, int y = 0, unsigned int width = 0, unsigned int height = 0)
+				: camera(camera), x(x), y(y), width(width), height(height) {}
+		};
+
 	protected:
 
+		// inside any of the frustums, walks the scene once for several cameras.
+		class ViewUnion : public Collidable
+		{
+		public:
+
+			const FrameVector<Frustum>* frustums = nullptr;
+
+			virtual Side IsInside(const SphereBounds &bsphere) const override;
+
+			virtual Side IsInside(const BoxBounds &aabb) const override;
+
+			virtual Side IsInside(Vector4 point) const override;
+
+			virtual bool IsInsideFast(const SphereBounds &bsphere) const override;
+
+			virtual bool IsInsideFast(const BoxBounds &aabb) const override;
+
+			virtual bool IsInsideFast(Vector4 point) const override;
+
+			virtual unsigned int GetFrustumCount() const override;
+
+			virtual const Frustum* GetFrustumAt(unsigned int index) const override;
+		};
+
 		std::shared_ptr<EntityManager> m_EntityManager;
 
 		std::vector<std::string> m_SortedPasses;
@@ -77,8 +129,30 @@ namespace fury
 
 		Matrix4 m_OffsetMatrix;
 
+		// window rect of the view being drawn, a zero size covers the whole window.
+
+		int m_ViewportX = 0, m_ViewportY = 0;
+
+		unsigned int m_ViewportWidth = 0, m_ViewportHeight = 0;
+
+		// set while ExecuteViews draws, point and spot shadow maps don't depend on the camera
+		// so each is drawn once per frame and reused by every view that sees its light.
+		bool m_ShareShadows = false;
+
+		// light node to its shadow map and the camera independent part of its shadow matrix.
+		// keyed by node, imported scenes often have several lights with the same name.
+		std::unordered_map<const SceneNode*, std::pair<std::shared_ptr<Texture>, Matrix4>> m_SharedShadows;
+
 		// end rendering
 
+		// frame pipelining, Capture fills the back frame while ExecuteFrame draws the front one.
+
+		std::shared_ptr<RenderFrame> m_FrontFrame;
+
+		std::shared_ptr<RenderFrame> m_BackFrame;
+
+		std::shared_ptr<OcclusionBuffer> m_OcclusionBuffer;
+
 		// debug
 
 		std::vector<BoxBounds> m_DebugBoxBounds;
@@ -98,6 +172,28 @@ namespace fury
 		virtual void Save(void* wrapper, bool object = true) override;
 
 		virtual void Execute(const std::shared_ptr<SceneManager> &sceneManager) = 0;
+
+		// draws a query built for m_CurrentCamera.
+		virtual void Execute(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<RenderQuery> &query) = 0;
+
+		// draws several cameras into their window rects, e.g. split screen. the scene is culled once
+		// for all of them (see GetRenderQueries) and point and spot shadow maps are shared between views.
+		// each camera's aspect should match its rect, views are drawn in order, up to 32 of them.
+		void ExecuteViews(const std::shared_ptr<SceneManager> &sceneManager, const std::vector<View> &views);
+
+		// begin frame pipelining
+
+		// snapshots the scene as seen from camera into the back frame.
+		// no gl calls, may run on a worker as long as nothing else mutates the scene.
+		void Capture(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &camera);
+
+		// draws the front frame, main thread only. does nothing until a captured frame was swapped in.
+		void ExecuteFrame();
+
+		// call once both Capture and ExecuteFrame returned.
+		void SwapFrames();
+
+		// end frame pipelining
 		
 		// basiclly saves all pipeline && pass's textures, shaders
 		std::shared_ptr<EntityManager> GetEntityManager() const;
@@ -114,23 +210,43 @@ namespace fury
 
 		void AddDebugCollidable(const Frustum &bounds);
 
-		std::shared_ptr<Pass> GetPassByName(const std::string &name);
+		std::shared_ptr<Pass> GetPassByName(const Name &name);
 
-		std::shared_ptr<Texture> GetTextureByName(const std::string &name);
+		std::shared_ptr<Texture> GetTextureByName(const Name &name);
 
-		std::shared_ptr<Shader> GetShaderByName(const std::string &name);
+		std::shared_ptr<Shader> GetShaderByName(const Name &name);
 
 		std::shared_ptr<SceneNode> GetCurrentCamera() const;
 
 		void SetCurrentCamera(const std::shared_ptr<SceneNode> &ptr);
 
+		// frustum query from camera, pre filtered by the scene's pvs if it has one. with OCCLUSION_CULLING on, occluders among the visible renderables
+		// are rasterized into the occlusion buffer and the others are tested against it before they
+		// become render units. occluders themselves are always kept.
+		void GetRenderQuery(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &camera,
+			const std::shared_ptr<RenderQuery> &query);
+
+		// GetRenderQuery for several cameras in one scene walk, queries[i] is filled for cameras[i].
+		// nodes are tested against every frustum once, pvs, detail and occlusion culling run per camera.
+		// opaque units are sorted once by material and mesh, and each query takes its units from that
+		// shared order, so opaque units aren't front to back. transparent units and particles are
+		// sorted per camera. at most 32 cameras, the scene's viewer is left at the last one.
+		void GetRenderQueries(const std::shared_ptr<SceneManager> &sceneManager, const std::vector<std::shared_ptr<SceneNode>> &cameras,
+			std::vector<std::shared_ptr<RenderQuery>> &queries);
+
+		std::shared_ptr<OcclusionBuffer> GetOcclusionBuffer() const;
+
 		// begin shaodw mapping
 
-		void FilterNodes(const Collidable &collider, std::vector<std::shared_ptr<SceneNode>> &possibles, std::vector<std::shared_ptr<SceneNode>> &collisions);
+		void FilterNodes(const Collidable &collider, FrameNodes &possibles, FrameNodes &collisions);
+
+		// same as SceneManager::GetVisibleShadowCasters, but into frame memory.
+		// castShadows = false collects all renderables.
+		void GetShadowCasters(const std::shared_ptr<SceneManager> &sceneManager, const Collidable &collider, FrameNodes &casters, bool castShadows = true);
 
-		Matrix4 GetCropMatrix(Matrix4 lightMatrix, Frustum frustum, std::vector<std::shared_ptr<SceneNode>> &casters);
+		Matrix4 GetCropMatrix(Matrix4 lightMatrix, Frustum frustum, FrameNodes &casters);
 
-		std::pair<std::shared_ptr<Texture>, std::vector<Matrix4>> DrawCascadedShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
+		std::pair<std::shared_ptr<Texture>, FrameVector<Matrix4>> DrawCascadedShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
 
 		std::pair<std::shared_ptr<Texture>, Matrix4> DrawDirLightShadowMap(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
 
@@ -145,6 +261,21 @@ namespace fury
 		void DrawDebug(const std::shared_ptr<RenderQuery> &query);
 
 		void SortPassByIndex();
+
+		// SceneManager::SetViewerPosition from a camera.
+		void SetViewer(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<SceneNode> &camera);
+
+		// rasterizes occluders as seen from camera and flags which renderables pass the occlusion test.
+		void TestOcclusion(const std::shared_ptr<SceneNode> &camera, const FrameNodes &occluders, const FrameNodes &renderables,
+			FrameVector<char> &visible);
+
+		// Pass::Bind, restricted to the current view's rect if the pass draws to the window.
+		void BindPass(const std::shared_ptr<Pass> &pass, bool clear = true);
+
+		void UnBindPass(const std::shared_ptr<Pass> &pass);
+
+		// collects a point or spot shadow map, unless views still share it.
+		void ReleaseShadowMap(const std::shared_ptr<Texture> &texture);
 	};
 }
 
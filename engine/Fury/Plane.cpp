@@ -77,7 +77,7 @@ namespace fury
 
 	bool Plane::IsInsideFast(const SphereBounds &bsphere) const
 	{
-		return GetDistance(bsphere.GetCenter()) >= bsphere.GetRadius();
+		return GetDistance(bsphere.GetCenter()) >= -bsphere.GetRadius();
 	}
 
 	float Plane::GetDistance(Vector4 point) const
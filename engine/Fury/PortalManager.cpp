@@ -0,0 +1,611 @@
+#include <cmath>
+
+#include "Fury/Frustum.h"
+#include "Fury/Light.h"
+#include "Fury/Log.h"
+#include "Fury/MeshRender.h"
+#include "Fury/Mesh.h"
+#include "Fury/OcTree.h"
+#include "Fury/ParticleSystem.h"
+#include "Fury/PortalManager.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneNode.h"
+#include "Fury/SphereBounds.h"
+
+namespace fury
+{
+	// CellView
+
+	Side PortalManager::CellView::IsInside(const SphereBounds &bsphere) const
+	{
+		Side result = Side::OUT;
+		for (const auto &volume : *volumes)
+		{
+			Side side = volume.IsInside(bsphere);
+			if (side == Side::IN)
+				return Side::IN;
+			else if (side == Side::STRADDLE)
+				result = Side::STRADDLE;
+		}
+		return result;
+	}
+
+	Side PortalManager::CellView::IsInside(const BoxBounds &aabb) const
+	{
+		Side result = Side::OUT;
+		for (const auto &volume : *volumes)
+		{
+			Side side = volume.IsInside(aabb);
+			if (side == Side::IN)
+				return Side::IN;
+			else if (side == Side::STRADDLE)
+				result = Side::STRADDLE;
+		}
+		return result;
+	}
+
+	Side PortalManager::CellView::IsInside(Vector4 point) const
+	{
+		Side result = Side::OUT;
+		for (const auto &volume : *volumes)
+		{
+			Side side = volume.IsInside(point);
+			if (side == Side::IN)
+				return Side::IN;
+			else if (side == Side::STRADDLE)
+				result = Side::STRADDLE;
+		}
+		return result;
+	}
+
+	bool PortalManager::CellView::IsInsideFast(const SphereBounds &bsphere) const
+	{
+		for (const auto &volume : *volumes)
+		{
+			if (volume.IsInsideFast(bsphere))
+				return true;
+		}
+		return false;
+	}
+
+	bool PortalManager::CellView::IsInsideFast(const BoxBounds &aabb) const
+	{
+		for (const auto &volume : *volumes)
+		{
+			if (volume.IsInsideFast(aabb))
+				return true;
+		}
+		return false;
+	}
+
+	bool PortalManager::CellView::IsInsideFast(Vector4 point) const
+	{
+		for (const auto &volume : *volumes)
+		{
+			if (volume.IsInsideFast(point))
+				return true;
+		}
+		return false;
+	}
+
+	// PortalManager
+
+	PortalManager::Ptr PortalManager::Create(Vector4 min, Vector4 max, unsigned int maxDepth)
+	{
+		return std::make_shared<PortalManager>(min, max, maxDepth);
+	}
+
+	PortalManager::PortalManager(Vector4 min, Vector4 max, unsigned int maxDepth)
+		: m_Min(min), m_Max(max), m_MaxDepth(maxDepth)
+	{
+		m_Outside = OcTree::Create(min, max, maxDepth);
+	}
+
+	PortalManager::~PortalManager()
+	{
+		FURYD << "PortalManager::~PortalManager";
+	}
+
+	bool PortalManager::Load(const void* wrapper, bool object)
+	{
+		if (object && !IsObject(wrapper))
+		{
+			FURYE << "Json node is not an object!";
+			return false;
+		}
+
+		ClearCells();
+
+		std::string str;
+
+		if (!LoadArray(wrapper, "cells", [&](const void* node) -> bool
+		{
+			BoxBounds bounds;
+			if (!LoadMemberValue(node, "name", str) || !LoadMemberValue(node, "bounds", bounds))
+			{
+				FURYE << "Cell needs a name and bounds!";
+				return false;
+			}
+
+			AddCell(str, bounds);
+			return true;
+		}))
+		{
+			FURYE << "Error reading cell array!";
+			return false;
+		}
+
+		if (!LoadArray(wrapper, "portals", [&](const void* node) -> bool
+		{
+			std::vector<std::string> cells;
+			std::vector<float> raw;
+			if (!LoadArray(node, "cells", cells) || cells.size() != 2 || !LoadArray(node, "points", raw))
+			{
+				FURYE << "Portal needs 2 cells and points!";
+				return false;
+			}
+
+			std::vector<Vector4> points;
+			for (unsigned int i = 0; i + 2 < raw.size(); i += 3)
+				points.push_back(Vector4(raw[i], raw[i + 1], raw[i + 2], 1.0f));
+
+			if (!AddPortal(cells[0], cells[1], points))
+				return false;
+
+			bool open = true;
+			if (LoadMemberValue(node, "open", open))
+				SetPortalOpen(m_Portals.size() - 1, open);
+
+			return true;
+		}))
+		{
+			FURYE << "Error reading portal array!";
+			return false;
+		}
+
+		return true;
+	}
+
+	void PortalManager::Save(void* wrapper, bool object)
+	{
+		if (object)
+			StartObject(wrapper);
+
+		SaveKey(wrapper, "cells");
+		SaveArray(wrapper, m_Cells.size(), [&](unsigned int index)
+		{
+			StartObject(wrapper);
+			SaveKey(wrapper, "name");
+			SaveValue(wrapper, m_Cells[index].name);
+			SaveKey(wrapper, "bounds");
+			SaveValue(wrapper, m_Cells[index].bounds);
+			EndObject(wrapper);
+		});
+
+		SaveKey(wrapper, "portals");
+		SaveArray(wrapper, m_Portals.size(), [&](unsigned int index)
+		{
+			const auto &portal = m_Portals[index];
+
+			StartObject(wrapper);
+
+			std::vector<std::string> cells = { m_Cells[portal.cells[0]].name, m_Cells[portal.cells[1]].name };
+			SaveKey(wrapper, "cells");
+			SaveArray(wrapper, cells);
+
+			std::vector<float> raw;
+			for (auto point : portal.points)
+			{
+				raw.push_back(point.x);
+				raw.push_back(point.y);
+				raw.push_back(point.z);
+			}
+			SaveKey(wrapper, "points");
+			SaveArray(wrapper, raw);
+
+			SaveKey(wrapper, "open");
+			SaveValue(wrapper, portal.open);
+
+			EndObject(wrapper);
+		});
+
+		if (object)
+			EndObject(wrapper);
+	}
+
+	unsigned int PortalManager::AddCell(const std::string &name, const BoxBounds &bounds)
+	{
+		Cell cell;
+		cell.name = name;
+		cell.bounds = bounds;
+		cell.tree = OcTree::Create(bounds.GetMin(), bounds.GetMax(), m_MaxDepth);
+		m_Cells.push_back(cell);
+
+		return m_Cells.size() - 1;
+	}
+
+	bool PortalManager::AddPortal(const std::string &cellA, const std::string &cellB, const std::vector<Vector4> &points)
+	{
+		int indices[2] = { -1, -1 };
+		for (unsigned int i = 0; i < m_Cells.size(); i++)
+		{
+			if (m_Cells[i].name == cellA)
+				indices[0] = i;
+			if (m_Cells[i].name == cellB)
+				indices[1] = i;
+		}
+
+		if (indices[0] < 0 || indices[1] < 0 || indices[0] == indices[1])
+		{
+			FURYE << "Portal between " << cellA << " and " << cellB << " needs 2 different cells!";
+			return false;
+		}
+
+		if (points.size() < 3)
+		{
+			FURYE << "Portal between " << cellA << " and " << cellB << " needs at least 3 points!";
+			return false;
+		}
+
+		// newell's method, robust for slightly non planar polygons.
+		Vector4 normal, center;
+		for (unsigned int i = 0; i < points.size(); i++)
+		{
+			Vector4 current = points[i], next = points[(i + 1) % points.size()];
+			normal.x += (current.y - next.y) * (current.z + next.z);
+			normal.y += (current.z - next.z) * (current.x + next.x);
+			normal.z += (current.x - next.x) * (current.y + next.y);
+			center = center + current;
+		}
+		center = center * (1.0f / points.size());
+
+		float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+		if (length < 1e-6f)
+		{
+			FURYE << "Portal between " << cellA << " and " << cellB << " is degenerated!";
+			return false;
+		}
+
+		Portal portal;
+		portal.points = points;
+		for (auto &point : portal.points)
+			point.w = 1.0f;
+		portal.cells[0] = indices[0];
+		portal.cells[1] = indices[1];
+
+		normal = normal * (1.0f / length);
+		portal.plane = Plane(normal.x, normal.y, normal.z, -(normal.x * center.x + normal.y * center.y + normal.z * center.z));
+
+		m_Portals.push_back(portal);
+		m_Cells[indices[0]].portals.push_back(m_Portals.size() - 1);
+		m_Cells[indices[1]].portals.push_back(m_Portals.size() - 1);
+
+		return true;
+	}
+
+	void PortalManager::SetPortalOpen(unsigned int index, bool open)
+	{
+		if (index < m_Portals.size())
+			m_Portals[index].open = open;
+	}
+
+	bool PortalManager::GetPortalOpen(unsigned int index) const
+	{
+		return index < m_Portals.size() && m_Portals[index].open;
+	}
+
+	unsigned int PortalManager::GetCellCount() const
+	{
+		return m_Cells.size();
+	}
+
+	unsigned int PortalManager::GetPortalCount() const
+	{
+		return m_Portals.size();
+	}
+
+	int PortalManager::GetCellIndex(Vector4 position) const
+	{
+		for (unsigned int i = 0; i < m_Cells.size(); i++)
+		{
+			if (m_Cells[i].bounds.IsInsideFast(position))
+				return i;
+		}
+		return -1;
+	}
+
+	void PortalManager::ClearCells()
+	{
+		Clear();
+		m_Cells.clear();
+		m_Portals.clear();
+	}
+
+	void PortalManager::AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		GetTree(*sceneNode)->AddSceneNode(sceneNode);
+	}
+
+	void PortalManager::AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		AddSceneNode(sceneNode);
+
+		for (unsigned int i = 0; i < sceneNode->GetChildCount(); i++)
+			AddSceneNodeRecursively(sceneNode->GetChildAt(i));
+	}
+
+	void PortalManager::RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		sceneNode->RemoveFromOcTree(false);
+	}
+
+	void PortalManager::UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+		// the node may have moved to another cell.
+		sceneNode->RemoveFromOcTree(false);
+		AddSceneNode(sceneNode);
+	}
+
+	void PortalManager::GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear) const
+	{
+		if (clear)
+			renderQuery->Clear();
+
+		WalkScene(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+		{
+			if (sceneNode->GetComponent<Light>() != nullptr)
+				renderQuery->AddLight(sceneNode);
+
+			if (auto render = sceneNode->GetComponent<MeshRender>())
+			{
+				if (render->GetRenderable())
+					renderQuery->AddRenderable(sceneNode);
+			}
+
+			if (auto particles = sceneNode->GetComponent<ParticleSystem>())
+			{
+				if (particles->GetRenderable())
+					renderQuery->AddParticles(sceneNode);
+			}
+		}, true);
+	}
+
+	void PortalManager::GetVisibleSceneNodes(const Collidable &collider, SceneNodes &visibleNodes, bool clear) const
+	{
+		if (clear)
+			visibleNodes.clear();
+
+		WalkScene(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+		{
+			visibleNodes.push_back(sceneNode);
+		});
+	}
+
+	void PortalManager::GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear) const
+	{
+		if (clear)
+			renderables.clear();
+
+		WalkScene(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+		{
+			auto render = sceneNode->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable())
+				renderables.push_back(sceneNode);
+		}, true);
+	}
+
+	void PortalManager::GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear) const
+	{
+		if (clear)
+			renderables.clear();
+
+		WalkScene(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+		{
+			auto render = sceneNode->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable() && render->GetMesh()->GetCastShadows() && IsDetailVisible(*sceneNode, true))
+				renderables.push_back(sceneNode);
+		});
+	}
+
+	void PortalManager::GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear) const
+	{
+		if (clear)
+			lights.clear();
+
+		WalkScene(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+		{
+			if (sceneNode->GetComponent<Light>() != nullptr)
+				lights.push_back(sceneNode);
+		});
+	}
+
+	void PortalManager::GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear) const
+	{
+		if (clear)
+		{
+			renderables.clear();
+			lights.clear();
+		}
+
+		WalkScene(collider, [&](const std::shared_ptr<SceneNode> &sceneNode)
+		{
+			auto render = sceneNode->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable())
+				renderables.push_back(sceneNode);
+			else if (sceneNode->GetComponent<Light>() != nullptr)
+				lights.push_back(sceneNode);
+		}, true);
+	}
+
+	void PortalManager::WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const
+	{
+		WalkScene(collider, filterFunc, false);
+	}
+
+	void PortalManager::Clear()
+	{
+		for (auto &cell : m_Cells)
+			cell.tree->Clear();
+
+		m_Outside->Clear();
+	}
+
+	bool PortalManager::GetCellViews(const Collidable &collider, CellVolumes &views) const
+	{
+		unsigned int count = collider.GetFrustumCount();
+		if (count == 0)
+			return false;
+
+		// all frusta must start in a cell, otherwise some of the union isn't covered by portals.
+		FrameVector<Vector4> eyes(count);
+		FrameVector<int> starts(count);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			auto frustum = collider.GetFrustumAt(i);
+			if (frustum == nullptr)
+				return false;
+
+			// the apex is where the side edges meet, ortho frusta have none.
+			auto corners = frustum->GetCurrentCorners();
+			float nearWidth = (corners[1] - corners[0]).Length();
+			float farWidth = (corners[5] - corners[4]).Length();
+			if (farWidth - nearWidth < farWidth * 1e-4f)
+				return false;
+
+			eyes[i] = corners[0] - (corners[4] - corners[0]) * (nearWidth / (farWidth - nearWidth));
+			eyes[i].w = 1.0f;
+
+			starts[i] = GetCellIndex(eyes[i]);
+			if (starts[i] < 0)
+				return false;
+		}
+
+		views.assign(m_Cells.size(), FrameVector<ConvexVolume>());
+
+		FrameVector<char> onPath(m_Cells.size(), 0);
+		for (unsigned int i = 0; i < count; i++)
+		{
+			ConvexVolume volume(*collider.GetFrustumAt(i));
+			VisitCell(starts[i], volume, volume, eyes[i], 0, onPath, views);
+		}
+
+		return true;
+	}
+
+	void PortalManager::WalkScene(const Collidable &collider, const FilterFunc &filterFunc, bool viewCull) const
+	{
+		FilterFunc filter = filterFunc;
+		if (viewCull)
+		{
+			filter = [&](const std::shared_ptr<SceneNode> &sceneNode)
+			{
+				if (IsPotentiallyVisible(*sceneNode) && IsDetailVisible(*sceneNode, false))
+					filterFunc(sceneNode);
+			};
+		}
+
+		CellVolumes views;
+		if (GetCellViews(collider, views))
+		{
+			CellView view;
+			for (unsigned int i = 0; i < m_Cells.size(); i++)
+			{
+				if (views[i].empty())
+					continue;
+
+				view.volumes = &views[i];
+				m_Cells[i].tree->WalkScene(view, filter);
+			}
+		}
+		else
+		{
+			for (const auto &cell : m_Cells)
+				cell.tree->WalkScene(collider, filter);
+		}
+
+		m_Outside->WalkScene(collider, filter);
+	}
+
+	void PortalManager::VisitCell(unsigned int cell, const ConvexVolume &volume, const ConvexVolume &frustum, Vector4 eye,
+		unsigned int depth, FrameVector<char> &onPath, CellVolumes &views) const
+	{
+		views[cell].push_back(volume);
+
+		if (depth >= MaxPortalDepth)
+			return;
+
+		onPath[cell] = 1;
+
+		for (auto index : m_Cells[cell].portals)
+		{
+			const Portal &portal = m_Portals[index];
+			unsigned int next = portal.cells[0] == cell ? portal.cells[1] : portal.cells[0];
+			if (!portal.open || onPath[next])
+				continue;
+
+			std::vector<Vector4> polygon = portal.points;
+			volume.ClipPolygon(polygon);
+			if (polygon.empty())
+				continue;
+
+			float eyeDistance = portal.plane.GetDistance(eye);
+
+			// standing in the opening, the portal can't narrow anything.
+			if (std::abs(eyeDistance) < 1e-3f)
+			{
+				VisitCell(next, volume, frustum, eye, depth + 1, onPath, views);
+				continue;
+			}
+
+			Vector4 center;
+			for (auto point : polygon)
+				center = center + point;
+			center = center * (1.0f / polygon.size());
+			center.w = 1.0f;
+
+			// the camera frustum, one plane through the eye per clipped portal edge, and the portal itself.
+			ConvexVolume narrowed = frustum;
+			for (unsigned int i = 0; i < polygon.size(); i++)
+			{
+				Vector4 a = polygon[i] - eye, b = polygon[(i + 1) % polygon.size()] - eye;
+				Vector4 normal(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x, 0.0f);
+				float length = normal.Length();
+				if (length < 1e-8f)
+					continue;
+
+				normal = normal * (1.0f / length);
+				Plane plane(normal.x, normal.y, normal.z, -(normal.x * eye.x + normal.y * eye.y + normal.z * eye.z));
+				if (plane.GetDistance(center) < 0.0f)
+					plane = Plane(-normal.x, -normal.y, -normal.z, -plane.GetDistance());
+
+				narrowed.AddPlane(plane);
+			}
+
+			Vector4 normal = portal.plane.GetNormal();
+			float sign = eyeDistance > 0.0f ? -1.0f : 1.0f;
+			narrowed.AddPlane(Plane(normal.x * sign, normal.y * sign, normal.z * sign, portal.plane.GetDistance() * sign));
+
+			VisitCell(next, narrowed, frustum, eye, depth + 1, onPath, views);
+		}
+
+		onPath[cell] = 0;
+	}
+
+	std::shared_ptr<OcTree> PortalManager::GetTree(const SceneNode &sceneNode) const
+	{
+		BoxBounds aabb = sceneNode.GetWorldAABB();
+		if (aabb.GetInfinite())
+			return m_Outside;
+
+		Vector4 min = aabb.GetMin(), max = aabb.GetMax();
+		for (const auto &cell : m_Cells)
+		{
+			Vector4 cellMin = cell.bounds.GetMin(), cellMax = cell.bounds.GetMax();
+			if (min.x >= cellMin.x && min.y >= cellMin.y && min.z >= cellMin.z &&
+				max.x <= cellMax.x && max.y <= cellMax.y && max.z <= cellMax.z)
+				return cell.tree;
+		}
+
+		return m_Outside;
+	}
+}
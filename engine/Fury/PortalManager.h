@@ -0,0 +1,172 @@
+#ifndef _FURY_PORTAL_MANAGER_H_
+#define _FURY_PORTAL_MANAGER_H_
+
+#include <string>
+#include <vector>
+
+#include "Fury/BoxBounds.h"
+#include "Fury/ConvexVolume.h"
+#include "Fury/FrameArena.h"
+#include "Fury/Plane.h"
+#include "Fury/Serializable.h"
+#include "SceneManager.h"
+
+namespace fury
+{
+	class OcTree;
+
+	// scene manager for indoor levels: box shaped cells connected by convex portals, each cell
+	// keeps its nodes in its own octree. a perspective frustum starting inside a cell only sees
+	// that cell and the cells behind portals it sees, through frusta narrowed to the portal openings.
+	// colliders made of several frusta, see Collidable::GetFrustumAt, see the union of their views.
+	// nodes that don't fit a single cell are kept in an outside octree that's always frustum tested.
+	// other colliders (shadow boxes, light volumes, ortho frusta) test all cells.
+	// add cells and portals before nodes, nodes aren't moved when cells change.
+	class FURY_API PortalManager : public SceneManager, public Serializable
+	{
+	public:
+
+		typedef std::shared_ptr<PortalManager> Ptr;
+
+		static Ptr Create(Vector4 min, Vector4 max, unsigned int maxDepth = 4);
+
+		// limits portal recursion in cyclic cell graphs.
+		static const unsigned int MaxPortalDepth = 16;
+
+		// per cell, the volumes it's seen through, see FrameArena.
+		typedef FrameVector<FrameVector<ConvexVolume>> CellVolumes;
+
+	protected:
+
+		class Cell
+		{
+		public:
+
+			std::string name;
+
+			BoxBounds bounds;
+
+			std::shared_ptr<OcTree> tree;
+
+			std::vector<unsigned int> portals;
+		};
+
+		class Portal
+		{
+		public:
+
+			// convex and planar, in winding order.
+			std::vector<Vector4> points;
+
+			unsigned int cells[2];
+
+			Plane plane;
+
+			bool open = true;
+		};
+
+		// the narrowed volumes a cell is seen through, a node is visible if it's inside any of them.
+		class CellView : public Collidable
+		{
+		public:
+
+			const FrameVector<ConvexVolume>* volumes = nullptr;
+
+			virtual Side IsInside(const SphereBounds &bsphere) const override;
+
+			virtual Side IsInside(const BoxBounds &aabb) const override;
+
+			virtual Side IsInside(Vector4 point) const override;
+
+			virtual bool IsInsideFast(const SphereBounds &bsphere) const override;
+
+			virtual bool IsInsideFast(const BoxBounds &aabb) const override;
+
+			virtual bool IsInsideFast(Vector4 point) const override;
+		};
+
+		Vector4 m_Min;
+
+		Vector4 m_Max;
+
+		unsigned int m_MaxDepth;
+
+		std::vector<Cell> m_Cells;
+
+		std::vector<Portal> m_Portals;
+
+		std::shared_ptr<OcTree> m_Outside;
+
+	public:
+
+		PortalManager(Vector4 min, Vector4 max, unsigned int maxDepth);
+
+		virtual ~PortalManager();
+
+		// cells and portals only, nodes come from the scene.
+		virtual bool Load(const void* wrapper, bool object = true) override;
+
+		virtual void Save(void* wrapper, bool object = true) override;
+
+		// returns the cell index.
+		unsigned int AddCell(const std::string &name, const BoxBounds &bounds);
+
+		// connects both cells, returns false if a cell isn't found or the polygon is degenerated.
+		bool AddPortal(const std::string &cellA, const std::string &cellB, const std::vector<Vector4> &points);
+
+		// closed portals, e.g. shut doors, block visibility.
+		void SetPortalOpen(unsigned int index, bool open);
+
+		bool GetPortalOpen(unsigned int index) const;
+
+		unsigned int GetCellCount() const;
+
+		unsigned int GetPortalCount() const;
+
+		// first cell containing position, -1 if none.
+		int GetCellIndex(Vector4 position) const;
+
+		// removes cells, portals and nodes.
+		void ClearCells();
+
+		virtual void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear = true) const override;
+
+		virtual void GetVisibleSceneNodes(const Collidable &collider, SceneNodes &visibleNodes, bool clear = true) const override;
+
+		virtual void GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear = true) const override;
+
+		virtual void GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear = true) const override;
+
+		virtual void GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear = true) const override;
+
+		virtual void GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear = true) const override;
+
+		virtual void WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const override;
+
+		// removes nodes, keeps cells and portals.
+		virtual void Clear() override;
+
+		// volumes each cell is seen through from collider's frusta, empty for unseen cells.
+		// returns false unless collider has frusta and all of them are perspective ones whose apex is inside a cell.
+		bool GetCellViews(const Collidable &collider, CellVolumes &views) const;
+
+	protected:
+
+		void WalkScene(const Collidable &collider, const FilterFunc &filterFunc, bool viewCull) const;
+
+		void VisitCell(unsigned int cell, const ConvexVolume &volume, const ConvexVolume &frustum, Vector4 eye,
+			unsigned int depth, FrameVector<char> &onPath, CellVolumes &views) const;
+
+		std::shared_ptr<OcTree> GetTree(const SceneNode &sceneNode) const;
+	};
+}
+
+#endif // _FURY_PORTAL_MANAGER_H_
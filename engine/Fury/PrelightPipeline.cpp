@@ -13,6 +13,7 @@
 #include "Fury/Mesh.h"
 #include "Fury/MeshRender.h"
 #include "Fury/MeshUtil.h"
+#include "Fury/ParticleSystem.h"
 #include "Fury/Pass.h"
 #include "Fury/PrelightPipeline.h"
 #include "Fury/RenderQuery.h"
@@ -75,17 +76,24 @@ namespace fury
 	{
 		ASSERT_MSG(m_CurrentCamera != nullptr, "PrelightPipeline.m_CurrentCamera not found!");
 
+		// find visible nodes
+		RenderQuery::Ptr query = RenderQuery::Create();
+		GetRenderQuery(sceneManager, m_CurrentCamera, query);
+		query->Sort(m_CurrentCamera->GetWorldPosition());
+
+		Execute(sceneManager, query);
+	}
+
+	void PrelightPipeline::Execute(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<RenderQuery> &query)
+	{
+		ASSERT_MSG(m_CurrentCamera != nullptr, "PrelightPipeline.m_CurrentCamera not found!");
+
 		// pre
 		m_CurrentShader = nullptr;
 		m_CurrentMateral = nullptr;
 		m_CurrentMesh = nullptr;
 		SortPassByIndex();
 
-		// find visible nodes
-		RenderQuery::Ptr query = RenderQuery::Create();
-		sceneManager->GetRenderQuery(m_CurrentCamera->GetComponent<Camera>()->GetFrustum(), query);
-		query->Sort(m_CurrentCamera->GetWorldPosition());
-
 		// draw passes
 
 		unsigned int passCount = m_SortedPasses.size();
@@ -101,33 +109,44 @@ namespace fury
 			if (m_CurrentCamera == nullptr)
 				continue;
 
-			// enable gamma correction on last pass
-			if (i == passCount - 1)
+			// enable gamma correction on last pass, and on particle passes blending onto the screen
+			bool screenPass = i == passCount - 1 || (drawMode == DrawMode::PARTICLE && pass->GetTextureCount(false) == 0);
+			if (screenPass)
 				glEnable(GL_FRAMEBUFFER_SRGB);
 
 			if (drawMode == DrawMode::OPAQUE)
 			{
-				pass->Bind();
+				BindPass(pass);
 				for (const auto &unit : query->opaqueUnits)
 					DrawUnit(pass, unit);
-				pass->UnBind();
+				UnBindPass(pass);
 			}
 			else if (drawMode == DrawMode::TRANSPARENT)
 			{
-				pass->Bind();
+				BindPass(pass);
 				for (const auto &unit : query->transparentUnits)
 					DrawUnit(pass, unit);
-				pass->UnBind();
+				UnBindPass(pass);
 			}
 			else if (drawMode == DrawMode::QUAD)
 			{
-				pass->Bind();
+				BindPass(pass);
 				DrawQuad(pass);
-				pass->UnBind();
+				UnBindPass(pass);
+			}
+			else if (drawMode == DrawMode::PARTICLE)
+			{
+				// particles test depth but don't write it, they're sorted back to front instead.
+				BindPass(pass);
+				glDepthMask(GL_FALSE);
+				for (const auto &node : query->particleNodes)
+					DrawParticles(pass, node);
+				glDepthMask(GL_TRUE);
+				UnBindPass(pass);
 			}
 			else if (drawMode == DrawMode::LIGHT)
 			{
-				pass->Bind(true);
+				BindPass(pass, true);
 
 				for (const auto &node : query->lightNodes)
 				{
@@ -143,7 +162,7 @@ namespace fury
 				}
 			}
 
-			if (i == passCount - 1)
+			if (screenPass)
 				glDisable(GL_FRAMEBUFFER_SRGB);
 
 			if (m_CurrentShader != nullptr)
@@ -202,7 +221,7 @@ namespace fury
 			for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 			{
 				auto ptr = pass->GetTextureAt(i, true);
-				shader->BindTexture(ptr->GetName(), ptr);
+				shader->BindTexture(Name(ptr->GetHashCode()), ptr);
 			}
 		}
 
@@ -214,19 +233,22 @@ namespace fury
 		if (meshChanged)
 			shader->BindMesh(mesh);
 
+		// per node, nodes sharing a skinned mesh have their own pose.
+		shader->BindJoints(node, mesh);
+
 		if (mesh->GetSubMeshCount() > 0)
 		{
 			auto subMesh = mesh->GetSubMeshAt(unit.subMesh);
 			shader->BindSubMesh(mesh, unit.subMesh);
-			glDrawElements(GL_TRIANGLES, subMesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+			glDrawElements(GL_TRIANGLES, subMesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 
-			RenderUtil::Instance()->IncreaseTriangleCount(subMesh->Indices.Data.size());
+			RenderUtil::Instance()->IncreaseTriangleCount(subMesh->Indices.GetSize());
 		}
 		else
 		{
-			glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+			glDrawElements(GL_TRIANGLES, mesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 
-			RenderUtil::Instance()->IncreaseTriangleCount(mesh->Indices.Data.size());
+			RenderUtil::Instance()->IncreaseTriangleCount(mesh->Indices.GetSize());
 		}
 
 		//shader->UnBind();
@@ -265,7 +287,7 @@ namespace fury
 			shadowData = DrawPointLightShadowMap(sceneManager, pass, node);
 
 		// ready to draw light volumn
-		pass->Bind(false);
+		BindPass(pass, false);
 
 		// change depthTest && face culling state.
 		{
@@ -291,8 +313,8 @@ namespace fury
 
 		if (castShadows && shadowData.first != nullptr)
 		{
-			shader->BindTexture("shadow_buffer", shadowData.first);
-			shader->BindMatrix("shadow_matrix", &shadowData.second.Raw[0]);
+			shader->BindTexture(FURY_NAME("shadow_buffer"), shadowData.first);
+			shader->BindMatrix(FURY_NAME("shadow_matrix"), &shadowData.second.Raw[0]);
 		}
 
 		shader->BindLight(node);
@@ -301,21 +323,21 @@ namespace fury
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 		{
 			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
+			shader->BindTexture(Name(ptr->GetHashCode()), ptr);
 		}
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, mesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 
 		shader->UnBind();
 
 		RenderUtil::Instance()->IncreaseDrawCall();
 		RenderUtil::Instance()->IncreaseLightCount();
 
-		pass->UnBind();
+		UnBindPass(pass);
 
 		// collect used shadow buffer
 		if (castShadows)
-			Texture::CollectTempory(shadowData.first);
+			ReleaseShadowMap(shadowData.first);
 	}
 
 	void PrelightPipeline::DrawDirLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
@@ -340,7 +362,7 @@ namespace fury
 		}
 
 		// draw shadowMap if we castShadows.
-		std::pair<Texture::Ptr, std::vector<Matrix4>> cascadedShadowData;
+		std::pair<Texture::Ptr, FrameVector<Matrix4>> cascadedShadowData;
 		std::pair<Texture::Ptr, Matrix4> shadowData;
 		if (castShadows)
 		{
@@ -351,7 +373,7 @@ namespace fury
 		}
 
 		// ready to draw light volumn
-		pass->Bind(false);
+		BindPass(pass, false);
 
 		// change depthTest && face culling state.
 		glEnable(GL_DEPTH_TEST);
@@ -366,17 +388,17 @@ namespace fury
 		{
 			if (useCascaded && cascadedShadowData.first != nullptr)
 			{
-				shader->BindTexture("shadow_buffer", cascadedShadowData.first);
+				shader->BindTexture(FURY_NAME("shadow_buffer"), cascadedShadowData.first);
 				// for cacasded shadow maps
-				shader->BindMatrices("shadow_matrix", cascadedShadowData.second.size(), &cascadedShadowData.second[0]);
+				shader->BindMatrices(FURY_NAME("shadow_matrix"), cascadedShadowData.second.size(), &cascadedShadowData.second[0]);
 				float base = camPtr->GetFar() - camPtr->GetNear();
 				float average = base / 4.0f;
-				shader->BindFloat("shadow_far", average, average * 2, average * 3, average * 4);
+				shader->BindFloat(FURY_NAME("shadow_far"), average, average * 2, average * 3, average * 4);
 			}
 			else if (shadowData.first != nullptr)
 			{
-				shader->BindTexture("shadow_buffer", shadowData.first);
-				shader->BindMatrix("shadow_matrix", &shadowData.second.Raw[0]);
+				shader->BindTexture(FURY_NAME("shadow_buffer"), shadowData.first);
+				shader->BindMatrix(FURY_NAME("shadow_matrix"), &shadowData.second.Raw[0]);
 			}
 		}
 
@@ -386,17 +408,17 @@ namespace fury
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 		{
 			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
+			shader->BindTexture(Name(ptr->GetHashCode()), ptr);
 		}
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, mesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 
 		shader->UnBind();
 
 		RenderUtil::Instance()->IncreaseDrawCall();
 		RenderUtil::Instance()->IncreaseLightCount();
 
-		pass->UnBind();
+		UnBindPass(pass);
 
 		// collect used shadow buffer
 		if (castShadows)
@@ -433,7 +455,7 @@ namespace fury
 			shadowData = DrawSpotLightShadowMap(sceneManager, pass, node);
 
 		// ready to draw light volumn
-		pass->Bind(false);
+		BindPass(pass, false);
 
 		// change depthTest && face culling state.
 		{
@@ -467,8 +489,8 @@ namespace fury
 
 		if (castShadows && shadowData.first != nullptr)
 		{
-			shader->BindTexture("shadow_buffer", shadowData.first);
-			shader->BindMatrix("shadow_matrix", &shadowData.second.Raw[0]);
+			shader->BindTexture(FURY_NAME("shadow_buffer"), shadowData.first);
+			shader->BindMatrix(FURY_NAME("shadow_matrix"), &shadowData.second.Raw[0]);
 		}
 
 		shader->BindLight(node);
@@ -477,21 +499,77 @@ namespace fury
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 		{
 			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
+			shader->BindTexture(Name(ptr->GetHashCode()), ptr);
 		}
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, mesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 
 		shader->UnBind();
 
 		RenderUtil::Instance()->IncreaseDrawCall();
 		RenderUtil::Instance()->IncreaseLightCount();
 
-		pass->UnBind();
+		UnBindPass(pass);
 
 		// collect used shadow buffer
 		if (castShadows)
-			Texture::CollectTempory(shadowData.first);
+			ReleaseShadowMap(shadowData.first);
+	}
+
+	void PrelightPipeline::DrawParticles(const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node)
+	{
+		auto particles = node->GetComponent<ParticleSystem>();
+		auto material = particles->GetMaterial();
+		if (material == nullptr)
+			return;
+
+		auto shader = material->GetShaderForPass(pass->GetRenderIndex());
+
+		if (shader == nullptr)
+			shader = pass->GetShader(ShaderType::PARTICLE, material->GetTextureFlags());
+
+		if (shader == nullptr)
+		{
+			FURYW << "Failed to draw " << node->GetName() << ", shader not found!";
+			return;
+		}
+
+		Vector4 camPos = m_CurrentCamera->GetWorldPosition();
+		Vector4 viewDir = m_CurrentCamera->GetWorldMatrix().Multiply(Vector4(0.0f, 0.0f, -1.0f, 0.0f)).Normalized();
+
+		unsigned int count = particles->PrepareDraw(camPos, viewDir);
+		if (count == 0)
+			return;
+
+		if (shader != m_CurrentShader)
+		{
+			m_CurrentShader = shader;
+
+			shader->Bind();
+			shader->BindCamera(m_CurrentCamera);
+
+			for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
+			{
+				auto ptr = pass->GetTextureAt(i, true);
+				shader->BindTexture(Name(ptr->GetHashCode()), ptr);
+			}
+		}
+
+		if (material != m_CurrentMateral)
+		{
+			m_CurrentMateral = material;
+			shader->BindMaterial(material);
+		}
+
+		// the vao is the system's own, the next mesh always rebinds.
+		m_CurrentMesh = nullptr;
+		shader->BindParticles(particles);
+
+		glDrawElementsInstanced(GL_TRIANGLES, particles->GetIndexCount(), GL_UNSIGNED_INT, 0, count);
+
+		RenderUtil::Instance()->IncreaseDrawCall();
+		RenderUtil::Instance()->IncreaseTriangleCount(particles->GetIndexCount() * count);
+		RenderUtil::Instance()->IncreaseParticleCount(count);
 	}
 
 	void PrelightPipeline::DrawQuad(const std::shared_ptr<Pass> &pass)
@@ -513,14 +591,14 @@ namespace fury
 		for (unsigned int i = 0; i < pass->GetTextureCount(true); i++)
 		{
 			auto ptr = pass->GetTextureAt(i, true);
-			shader->BindTexture(ptr->GetName(), ptr);
+			shader->BindTexture(Name(ptr->GetHashCode()), ptr);
 		}
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, mesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 
 		shader->UnBind();
 
 		RenderUtil::Instance()->IncreaseDrawCall();
-		RenderUtil::Instance()->IncreaseTriangleCount(mesh->Indices.Data.size());
+		RenderUtil::Instance()->IncreaseTriangleCount(mesh->Indices.GetSize());
 	}
 }
\ No newline at end of file
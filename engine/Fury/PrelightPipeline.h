@@ -36,6 +36,8 @@ namespace fury
 
 		virtual void Execute(const std::shared_ptr<SceneManager> &sceneManager) override;
 
+		virtual void Execute(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<RenderQuery> &query) override;
+
 	protected:
 
 		void DrawUnit(const std::shared_ptr<Pass> &pass, const RenderUnit &unit);
@@ -47,6 +49,8 @@ namespace fury
 		void DrawSpotLight(const std::shared_ptr<SceneManager> &sceneManager, const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
 
 		void DrawQuad(const std::shared_ptr<Pass> &pass);
+
+		void DrawParticles(const std::shared_ptr<Pass> &pass, const std::shared_ptr<SceneNode> &node);
 	};
 }
 
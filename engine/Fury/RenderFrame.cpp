@@ -0,0 +1,296 @@
+#include "Fury/Camera.h"
+#include "Fury/Frustum.h"
+#include "Fury/Joint.h"
+#include "Fury/Light.h"
+#include "Fury/Log.h"
+#include "Fury/Mesh.h"
+#include "Fury/MeshRender.h"
+#include "Fury/ParticleSystem.h"
+#include "Fury/RenderFrame.h"
+#include "Fury/RenderQuery.h"
+#include "Fury/SceneNode.h"
+
+namespace fury
+{
+	RenderFrame::Ptr RenderFrame::Create()
+	{
+		return std::make_shared<RenderFrame>();
+	}
+
+	RenderFrame::RenderFrame()
+	{
+
+	}
+
+	RenderFrame::~RenderFrame()
+	{
+		Clear();
+	}
+
+	void RenderFrame::Capture(const std::shared_ptr<SceneManager> &source, const std::shared_ptr<SceneNode> &camera)
+	{
+		m_FrameIndex++;
+		m_Nodes.clear();
+
+		auto cameraComponent = camera != nullptr ? camera->GetComponent<Camera>() : nullptr;
+		if (cameraComponent == nullptr)
+		{
+			FURYW << "RenderFrame needs a camera!";
+			m_Camera = nullptr;
+			return;
+		}
+
+		if (m_Camera == nullptr)
+		{
+			m_Camera = SceneNode::Create(camera->GetName());
+			m_Camera->m_RenderProxy = true;
+		}
+
+		m_Camera->m_RenderSource = camera.get();
+
+		CopyState(m_Camera, *camera);
+		// the live camera's frustum follows its node, so the proxy needs its own copy.
+		m_Camera->m_Components[typeid(Camera)] = cameraComponent->Clone();
+
+		// proxies keep their live nodes' names, so the pvs resolves them the same way.
+		SetPVS(source->GetPVS());
+		SetHLOD(source->GetHLOD());
+		SetMinScreenSize(source->GetMinScreenSize(false), false);
+		SetMinScreenSize(source->GetMinScreenSize(true), true);
+
+		// everything the pipeline might ask for: the view, the shadow range and the volumes of visible lights.
+		auto addProxy = [this](const SceneNode::Ptr &node)
+		{
+			AddProxy(node);
+		};
+
+		source->WalkScene(cameraComponent->GetFrustum(), addProxy);
+
+		if (cameraComponent->GetShadowFar() > cameraComponent->GetFar())
+			source->WalkScene(cameraComponent->GetFrustum(cameraComponent->GetNear(), cameraComponent->GetShadowFar()), addProxy);
+
+		if (cameraComponent->GetShadowBounds(false).GetExtents().SquareLength() > 0)
+			source->WalkScene(cameraComponent->GetShadowBounds(), addProxy);
+
+		unsigned int viewCount = m_Nodes.size();
+		for (unsigned int i = 0; i < viewCount; i++)
+		{
+			auto &node = m_Nodes[i];
+			auto worldAABB = node->GetWorldAABB();
+			if (node->GetComponent<Light>() != nullptr && !worldAABB.GetInfinite())
+				source->WalkScene(worldAABB, addProxy);
+		}
+
+		// drop proxies of nodes that left the view.
+		for (auto it = m_Proxies.begin(); it != m_Proxies.end();)
+		{
+			if (it->second.frame != m_FrameIndex)
+				it = m_Proxies.erase(it);
+			else
+				++it;
+		}
+	}
+
+	std::shared_ptr<SceneNode> RenderFrame::GetCamera() const
+	{
+		return m_Camera;
+	}
+
+	unsigned int RenderFrame::GetNodeCount() const
+	{
+		return m_Nodes.size();
+	}
+
+	void RenderFrame::AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+
+	}
+
+	void RenderFrame::AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+
+	}
+
+	void RenderFrame::RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+
+	}
+
+	void RenderFrame::UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode)
+	{
+
+	}
+
+	void RenderFrame::GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear) const
+	{
+		if (clear)
+			renderQuery->Clear();
+
+		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			if (sceneNode->GetComponent<Light>() != nullptr)
+				renderQuery->AddLight(sceneNode);
+
+			if (auto render = sceneNode->GetComponent<MeshRender>())
+			{
+				if (render->GetRenderable())
+					renderQuery->AddRenderable(sceneNode);
+			}
+
+			if (auto particles = sceneNode->GetComponent<ParticleSystem>())
+			{
+				if (particles->GetRenderable())
+					renderQuery->AddParticles(sceneNode);
+			}
+		}, true);
+	}
+
+	void RenderFrame::GetVisibleSceneNodes(const Collidable &collider, SceneNodes &visibleNodes, bool clear) const
+	{
+		if (clear)
+			visibleNodes.clear();
+
+		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			visibleNodes.push_back(sceneNode);
+		});
+	}
+
+	void RenderFrame::GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear) const
+	{
+		if (clear)
+			renderables.clear();
+
+		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			auto render = sceneNode->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable())
+				renderables.push_back(sceneNode);
+		}, true);
+	}
+
+	void RenderFrame::GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear) const
+	{
+		if (clear)
+			renderables.clear();
+
+		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			auto render = sceneNode->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable() && render->GetMesh()->GetCastShadows() && IsDetailVisible(*sceneNode, true))
+				renderables.push_back(sceneNode);
+		});
+	}
+
+	void RenderFrame::GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear) const
+	{
+		if (clear)
+			lights.clear();
+
+		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			if (sceneNode->GetComponent<Light>() != nullptr)
+				lights.push_back(sceneNode);
+		});
+	}
+
+	void RenderFrame::GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear) const
+	{
+		if (clear)
+		{
+			renderables.clear();
+			lights.clear();
+		}
+
+		WalkScene(collider, [&](const SceneNode::Ptr &sceneNode)
+		{
+			auto render = sceneNode->GetComponent<MeshRender>();
+			if (render != nullptr && render->GetRenderable())
+				renderables.push_back(sceneNode);
+			else if (sceneNode->GetComponent<Light>() != nullptr)
+				lights.push_back(sceneNode);
+		}, true);
+	}
+
+	void RenderFrame::WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const
+	{
+		WalkScene(collider, filterFunc, false);
+	}
+
+	void RenderFrame::WalkScene(const Collidable &collider, const FilterFunc &filterFunc, bool viewCull) const
+	{
+		for (const auto &node : m_Nodes)
+		{
+			if ((!viewCull || IsPotentiallyVisible(*node)) && node->IsInsideFast(collider) &&
+				(!viewCull || IsDetailVisible(*node, false)))
+				filterFunc(node);
+		}
+	}
+
+	void RenderFrame::Clear()
+	{
+		m_Proxies.clear();
+		m_Nodes.clear();
+		m_Camera = nullptr;
+	}
+
+	void RenderFrame::AddProxy(const std::shared_ptr<SceneNode> &source)
+	{
+		auto &proxy = m_Proxies[source.get()];
+		if (proxy.frame == m_FrameIndex)
+			return;
+
+		if (proxy.node == nullptr)
+		{
+			proxy.node = SceneNode::Create(source->GetName());
+			proxy.node->m_RenderProxy = true;
+		}
+
+		proxy.node->m_RenderSource = source.get();
+		proxy.frame = m_FrameIndex;
+		CopyState(proxy.node, *source);
+
+		// the worker may change light properties while this frame draws, so lights are copied.
+		// the volume mesh is built on the live light first so every capture's copy shares it.
+		if (auto light = source->GetComponent<Light>())
+		{
+			light->GetMesh();
+			proxy.node->m_Components[typeid(Light)] = light->Clone();
+		}
+
+		m_Nodes.push_back(proxy.node);
+	}
+
+	void RenderFrame::CopyState(const std::shared_ptr<SceneNode> &proxy, const SceneNode &source)
+	{
+		proxy->m_ModelAABB = source.m_ModelAABB;
+		proxy->m_LocalAABB = source.m_LocalAABB;
+		proxy->m_WorldAABB = source.m_WorldAABB;
+		proxy->m_ModelSphere = source.m_ModelSphere;
+		proxy->m_WorldSphere = source.m_WorldSphere;
+		proxy->m_WorldPosition = source.m_WorldPosition;
+		proxy->m_WorldScale = source.m_WorldScale;
+		proxy->m_WorldRotation = source.m_WorldRotation;
+		proxy->m_LocalPosition = source.m_LocalPosition;
+		proxy->m_LocalScale = source.m_LocalScale;
+		proxy->m_LocalRotation = source.m_LocalRotation;
+		proxy->m_LocalMatrix = source.m_LocalMatrix;
+		proxy->m_InvertLocalMatrix = source.m_InvertLocalMatrix;
+		proxy->m_WorldMatrix = source.m_WorldMatrix;
+		proxy->m_InvertWorldMatrix = source.m_InvertWorldMatrix;
+		proxy->m_TransformDirty = false;
+
+		// shared, not owned, see SceneNode::m_RenderProxy.
+		proxy->m_Components = source.m_Components;
+
+		// skinned meshes are posed on the live joints, which the next update may change while this frame draws.
+		proxy->m_JointMatrices.clear();
+		auto render = source.GetComponent<MeshRender>();
+		auto mesh = render != nullptr ? render->GetMesh() : nullptr;
+		if (mesh != nullptr && mesh->IsSkinnedMesh())
+		{
+			for (unsigned int i = 0; i < mesh->GetJointCount(); i++)
+				proxy->m_JointMatrices.push_back(mesh->GetJointAt(i)->GetFinalMatrix());
+		}
+	}
+}
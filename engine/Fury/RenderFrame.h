@@ -0,0 +1,98 @@
+#ifndef _FURY_RENDER_FRAME_H_
+#define _FURY_RENDER_FRAME_H_
+
+#include <unordered_map>
+
+#include "SceneManager.h"
+
+namespace fury
+{
+	// snapshot of everything a pipeline reads from the scene: camera, visible renderables, lights and
+	// their shadow casters. nodes are proxies that copy the live nodes' transforms and bounds, so the
+	// live scene can be simulated while the snapshot is being rendered. cameras and lights are copied,
+	// other components are shared: MeshRender, its meshes and materials must not change while a frame
+	// draws (change them between frames), ParticleSystem locks its particles while they're uploaded.
+	class FURY_API RenderFrame : public SceneManager
+	{
+	public:
+
+		typedef std::shared_ptr<RenderFrame> Ptr;
+
+		static Ptr Create();
+
+	protected:
+
+		class Proxy
+		{
+		public:
+
+			std::shared_ptr<SceneNode> node;
+
+			unsigned int frame = 0;
+		};
+
+		// proxies are reused across captures, keyed by their live node.
+		std::unordered_map<const SceneNode*, Proxy> m_Proxies;
+
+		SceneNodes m_Nodes;
+
+		std::shared_ptr<SceneNode> m_Camera;
+
+		unsigned int m_FrameIndex = 0;
+
+	public:
+
+		RenderFrame();
+
+		virtual ~RenderFrame();
+
+		// copies the scene state visible from camera, call this while nothing mutates the scene.
+		// doesn't touch gl, so it can run on a worker.
+		void Capture(const std::shared_ptr<SceneManager> &source, const std::shared_ptr<SceneNode> &camera);
+
+		// camera proxy, nullptr if nothing was captured yet.
+		std::shared_ptr<SceneNode> GetCamera() const;
+
+		unsigned int GetNodeCount() const;
+
+		// the snapshot is read only, these do nothing.
+
+		virtual void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void RemoveSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		virtual void UpdateSceneNode(const std::shared_ptr<SceneNode> &sceneNode) override;
+
+		// queries test the captured nodes one by one.
+
+		virtual void GetRenderQuery(const Collidable &collider, const std::shared_ptr<RenderQuery> &renderQuery, bool clear = true) const override;
+
+		virtual void GetVisibleSceneNodes(const Collidable &collider, SceneNodes &visibleNodes, bool clear = true) const override;
+
+		virtual void GetVisibleRenderables(const Collidable &collider, SceneNodes &renderables, bool clear = true) const override;
+
+		virtual void GetVisibleShadowCasters(const Collidable &collider, SceneNodes &renderables, bool clear = true) const override;
+
+		virtual void GetVisibleLights(const Collidable &collider, SceneNodes &lights, bool clear = true) const override;
+
+		virtual void GetVisibleRenderableAndLights(const Collidable &collider, SceneNodes &renderables, SceneNodes &lights, bool clear = true) const override;
+
+		virtual void WalkScene(const Collidable &collider, const FilterFunc &filterFunc) const override;
+
+		virtual void Clear() override;
+
+	protected:
+
+		// viewCull skips nodes the viewer's pvs cell can't see before testing them against collider,
+		// and nodes failing SceneManager::IsDetailVisible after.
+		void WalkScene(const Collidable &collider, const FilterFunc &filterFunc, bool viewCull) const;
+
+		void AddProxy(const std::shared_ptr<SceneNode> &source);
+
+		void CopyState(const std::shared_ptr<SceneNode> &proxy, const SceneNode &source);
+	};
+}
+
+#endif // _FURY_RENDER_FRAME_H_
@@ -14,7 +14,7 @@ namespace fury
 {
 	RenderQuery::Ptr RenderQuery::Create()
 	{
-		return std::make_shared<RenderQuery>();
+		return std::allocate_shared<RenderQuery>(FrameAllocator<RenderQuery>());
 	}
 
 	void RenderQuery::AddRenderable(const std::shared_ptr<SceneNode> &node)
@@ -51,6 +51,11 @@ namespace fury
 		lightNodes.push_back(node);
 	}
 
+	void RenderQuery::AddParticles(const std::shared_ptr<SceneNode> &node)
+	{
+		particleNodes.push_back(node);
+	}
+
 	void RenderQuery::Sort(Vector4 camPos)
 	{
 		std::sort(opaqueUnits.begin(), opaqueUnits.end(), [&camPos](const RenderUnit &a, const RenderUnit &b) -> bool
@@ -58,15 +63,25 @@ namespace fury
 			return a.node->GetWorldPosition().Distance(camPos) < b.node->GetWorldPosition().Distance(camPos);
 		});
 
+		SortTransparent(camPos);
+
+		/*std::sort(lightNodes.begin(), lightNodes.end(), [](const SceneNode::Ptr &a, const SceneNode::Ptr &b) -> bool
+		{
+			return b->GetComponent<Light>()->GetCastShadows();
+		});*/
+	}
+
+	void RenderQuery::SortTransparent(Vector4 camPos)
+	{
 		std::sort(transparentUnits.begin(), transparentUnits.end(), [&camPos](const RenderUnit &a, const RenderUnit &b) -> bool
 		{
 			return a.node->GetWorldPosition().Distance(camPos) > b.node->GetWorldPosition().Distance(camPos);
 		});
 
-		/*std::sort(lightNodes.begin(), lightNodes.end(), [](const SceneNode::Ptr &a, const SceneNode::Ptr &b) -> bool
+		std::sort(particleNodes.begin(), particleNodes.end(), [&camPos](const std::shared_ptr<SceneNode> &a, const std::shared_ptr<SceneNode> &b) -> bool
 		{
-			return b->GetComponent<Light>()->GetCastShadows();
-		});*/
+			return a->GetWorldPosition().Distance(camPos) > b->GetWorldPosition().Distance(camPos);
+		});
 	}
 
 	void RenderQuery::Clear()
@@ -75,5 +90,6 @@ namespace fury
 		transparentUnits.clear();
 		renderableNodes.clear();
 		lightNodes.clear();
+		particleNodes.clear();
 	}
 }
@@ -4,6 +4,7 @@
 #include <memory>
 #include <vector>
 
+#include "Fury/FrameArena.h"
 #include "Fury/Vector4.h"
 
 namespace fury
@@ -34,6 +35,7 @@ namespace fury
 		}
 	};
 
+	// transient, the query and its lists live in the calling thread's FrameArena, don't keep it across frames.
 	class FURY_API RenderQuery
 	{
 	public:
@@ -42,20 +44,27 @@ namespace fury
 
 		static Ptr Create();
 
-		std::vector<RenderUnit> opaqueUnits;
+		FrameVector<RenderUnit> opaqueUnits;
 
-		std::vector<RenderUnit> transparentUnits;
+		FrameVector<RenderUnit> transparentUnits;
 
-		std::vector<std::shared_ptr<SceneNode>> renderableNodes;
+		FrameVector<std::shared_ptr<SceneNode>> renderableNodes;
 
-		std::vector<std::shared_ptr<SceneNode>> lightNodes;
+		FrameVector<std::shared_ptr<SceneNode>> lightNodes;
+
+		FrameVector<std::shared_ptr<SceneNode>> particleNodes;
 
 		void AddRenderable(const std::shared_ptr<SceneNode> &node);
 
 		void AddLight(const std::shared_ptr<SceneNode> &node);
 
+		void AddParticles(const std::shared_ptr<SceneNode> &node);
+
 		void Sort(Vector4 camPos);
 
+		// back to front sorts only, opaque units keep their order.
+		void SortTransparent(Vector4 camPos);
+
 		void Clear();
 	};
 }
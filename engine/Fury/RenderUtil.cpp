@@ -1,6 +1,7 @@
 #include <SFML/System/Time.hpp>
 
 #include "Fury/RenderUtil.h"
+#include "Fury/FrameArena.h"
 #include "Fury/GLLoader.h"
 #include "Fury/Log.h"
 #include "Fury/Vector4.h"
@@ -13,7 +14,8 @@
 
 namespace fury
 {
-	RenderUtil::RenderUtil()
+	RenderUtil::RenderUtil() : m_CullTestCount(0), m_SphereCullCount(0), m_DistanceCullCount(0), 
+		m_ScreenSizeCullCount(0), m_ShadowDistanceCullCount(0), m_ShadowScreenSizeCullCount(0)
 	{
 		const char *debug_vs =
 			"#version 330\n"
@@ -87,7 +89,7 @@ namespace fury
 		shader->BindTexture(src);
 		shader->BindMesh(MeshUtil::GetUnitQuad());
 
-		glDrawElements(GL_TRIANGLES, MeshUtil::GetUnitQuad()->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, MeshUtil::GetUnitQuad()->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 
 		shader->UnBind();
 
@@ -126,7 +128,7 @@ namespace fury
 		glBufferData(GL_ARRAY_BUFFER, dataSize, 0, GL_STREAM_DRAW);
 		glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, positions);
 
-		m_DebugShader->BindFloat("color", color.r, color.g, color.b);
+		m_DebugShader->BindFloat(FURY_NAME("color"), color.r, color.g, color.b);
 		
 		glDrawArrays(EnumUtil::LineModeToUnit(lineMode), 0, size / 3);
 
@@ -209,11 +211,11 @@ namespace fury
 		if (!m_DrawingMesh || mesh->IsSkinnedMesh() || mesh->GetSubMeshCount() > 0)
 			return;
 
-		m_DebugShader->BindFloat("color", color.r, color.g, color.b);
+		m_DebugShader->BindFloat(FURY_NAME("color"), color.r, color.g, color.b);
 		m_DebugShader->BindMatrix(Matrix4::WORLD_MATRIX, worldMatrix);
 		m_DebugShader->BindMesh(mesh);
 
-		glDrawElements(GL_TRIANGLES, mesh->Indices.Data.size(), GL_UNSIGNED_INT, 0);
+		glDrawElements(GL_TRIANGLES, mesh->Indices.GetSize(), GL_UNSIGNED_INT, 0);
 
 		m_DrawCall++;
 	}
@@ -233,9 +235,20 @@ namespace fury
 		m_TriangleCount = 0;
 		m_SkinnedMeshCount = 0;
 		m_LightCount = 0;
+		m_ParticleCount = 0;
+		m_CullTestCount = 0;
+		m_SphereCullCount = 0;
+		m_DistanceCullCount = 0;
+		m_ScreenSizeCullCount = 0;
+		m_ShadowDistanceCullCount = 0;
+		m_ShadowScreenSizeCullCount = 0;
+		m_OcclusionTestCount = 0;
+		m_OcclusionCullCount = 0;
 
 		m_FrameClock.restart();
 
+		FrameArena::BeginFrame();
+
 		OnBeginFrame->Emit();
 	}
 
@@ -294,4 +307,94 @@ namespace fury
 	{
 		return m_LightCount;
 	}
+
+	void RenderUtil::IncreaseParticleCount(unsigned int count)
+	{
+		m_ParticleCount += count;
+	}
+
+	unsigned int RenderUtil::GetParticleCount()
+	{
+		return m_ParticleCount;
+	}
+
+	void RenderUtil::IncreaseCullTestCount(unsigned int count)
+	{
+		m_CullTestCount.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	unsigned int RenderUtil::GetCullTestCount()
+	{
+		return m_CullTestCount.load(std::memory_order_relaxed);
+	}
+
+	void RenderUtil::IncreaseSphereCullCount(unsigned int count)
+	{
+		m_SphereCullCount.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	unsigned int RenderUtil::GetSphereCullCount()
+	{
+		return m_SphereCullCount.load(std::memory_order_relaxed);
+	}
+
+	void RenderUtil::IncreaseOcclusionTestCount(unsigned int count)
+	{
+		m_OcclusionTestCount += count;
+	}
+
+	unsigned int RenderUtil::GetOcclusionTestCount()
+	{
+		return m_OcclusionTestCount;
+	}
+
+	void RenderUtil::IncreaseOcclusionCullCount(unsigned int count)
+	{
+		m_OcclusionCullCount += count;
+	}
+
+	unsigned int RenderUtil::GetOcclusionCullCount()
+	{
+		return m_OcclusionCullCount;
+	}
+
+	void RenderUtil::IncreaseDistanceCullCount(unsigned int count)
+	{
+		m_DistanceCullCount.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	unsigned int RenderUtil::GetDistanceCullCount()
+	{
+		return m_DistanceCullCount.load(std::memory_order_relaxed);
+	}
+
+	void RenderUtil::IncreaseScreenSizeCullCount(unsigned int count)
+	{
+		m_ScreenSizeCullCount.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	unsigned int RenderUtil::GetScreenSizeCullCount()
+	{
+		return m_ScreenSizeCullCount.load(std::memory_order_relaxed);
+	}
+
+	void RenderUtil::IncreaseShadowDistanceCullCount(unsigned int count)
+	{
+		m_ShadowDistanceCullCount.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	unsigned int RenderUtil::GetShadowDistanceCullCount()
+	{
+		return m_ShadowDistanceCullCount.load(std::memory_order_relaxed);
+	}
+
+	void RenderUtil::IncreaseShadowScreenSizeCullCount(unsigned int count)
+	{
+		m_ShadowScreenSizeCullCount.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	unsigned int RenderUtil::GetShadowScreenSizeCullCount()
+	{
+		return m_ShadowScreenSizeCullCount.load(std::memory_order_relaxed);
+	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #ifndef _FURY_RENDER_UTIL_H_
 #define _FURY_RENDER_UTIL_H_
 
+#include <atomic>
 #include <vector>
 
 #include <SFML/Window/Keyboard.hpp>
@@ -57,6 +58,25 @@ namespace fury
 
 		unsigned int m_LightCount = 0;
 
+		unsigned int m_ParticleCount = 0;
+
+		unsigned int m_OcclusionTestCount = 0;
+
+		unsigned int m_OcclusionCullCount = 0;
+
+		// culling may run on workers.
+		std::atomic<unsigned int> m_CullTestCount;
+
+		std::atomic<unsigned int> m_SphereCullCount;
+
+		std::atomic<unsigned int> m_DistanceCullCount;
+
+		std::atomic<unsigned int> m_ScreenSizeCullCount;
+
+		std::atomic<unsigned int> m_ShadowDistanceCullCount;
+
+		std::atomic<unsigned int> m_ShadowScreenSizeCullCount;
+
 		sf::Clock m_FrameClock;
 
 		bool m_DrawingLine = false;
@@ -117,6 +137,47 @@ namespace fury
 		void IncreaseLightCount(unsigned int count = 1);
 
 		unsigned int GetLightCount();
+
+		void IncreaseParticleCount(unsigned int count = 1);
+
+		unsigned int GetParticleCount();
+
+		void IncreaseCullTestCount(unsigned int count = 1);
+
+		unsigned int GetCullTestCount();
+
+		// nodes rejected by their world sphere, those would have been aabb-only false positives.
+		void IncreaseSphereCullCount(unsigned int count = 1);
+
+		unsigned int GetSphereCullCount();
+
+		void IncreaseOcclusionTestCount(unsigned int count = 1);
+
+		unsigned int GetOcclusionTestCount();
+
+		// nodes inside the frustum but hidden behind occluders.
+		void IncreaseOcclusionCullCount(unsigned int count = 1);
+
+		unsigned int GetOcclusionCullCount();
+
+		// nodes inside the collider but beyond their max draw distance, or too small on screen.
+		// see SceneManager::IsDetailVisible.
+		void IncreaseDistanceCullCount(unsigned int count = 1);
+
+		unsigned int GetDistanceCullCount();
+
+		void IncreaseScreenSizeCullCount(unsigned int count = 1);
+
+		unsigned int GetScreenSizeCullCount();
+
+		// same for shadow casters, which use their own thresholds.
+		void IncreaseShadowDistanceCullCount(unsigned int count = 1);
+
+		unsigned int GetShadowDistanceCullCount();
+
+		void IncreaseShadowScreenSizeCullCount(unsigned int count = 1);
+
+		unsigned int GetShadowScreenSizeCullCount();
 	};
 }
 
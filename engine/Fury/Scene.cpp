@@ -5,6 +5,8 @@
 #include "Fury/Log.h"
 #include "Fury/Material.h"
 #include "Fury/Mesh.h"
+#include "Fury/PVS.h"
+#include "Fury/PortalManager.h"
 
 namespace fury
 {
@@ -52,6 +54,8 @@ namespace fury
 	{
 		m_EntityManager->RemoveAll();
 		m_SceneManager->Clear();
+		m_SceneManager->SetPVS(nullptr);
+		m_SceneManager->SetHLOD(nullptr);
 		m_RootNode->RemoveAllChilds();
 		m_RootNode->RemoveAllComponents();
 	}
@@ -111,9 +115,32 @@ namespace fury
 			return false;
 		}
 
+		// cells have to exist before nodes are sorted into them
+		if (auto portalManager = std::dynamic_pointer_cast<PortalManager>(m_SceneManager))
+		{
+			if (auto cellsWrapper = FindMember(wrapper, "portal_cells"))
+			{
+				if (!portalManager->Load(cellsWrapper))
+					return false;
+			}
+		}
+
 		// setup scene manager
 		m_SceneManager->AddSceneNodeRecursively(m_RootNode);
 
+		// baked visibility is optional
+		if (auto pvsWrapper = FindMember(wrapper, "pvs"))
+		{
+			auto pvs = PVS::Create();
+			if (pvs->Load(pvsWrapper))
+			{
+				pvs->Bind(m_RootNode);
+				m_SceneManager->SetPVS(pvs);
+			}
+			else
+				FURYW << "Error serializing pvs, scene is culled without it.";
+		}
+
 		return true;
 	}
 
@@ -148,6 +175,18 @@ namespace fury
 		SaveKey(wrapper, "nodes");
 		m_RootNode->Save(wrapper);
 
+		if (auto portalManager = std::dynamic_pointer_cast<PortalManager>(m_SceneManager))
+		{
+			SaveKey(wrapper, "portal_cells");
+			portalManager->Save(wrapper);
+		}
+
+		if (auto pvs = m_SceneManager->GetPVS())
+		{
+			SaveKey(wrapper, "pvs");
+			pvs->Save(wrapper);
+		}
+
 		if (object)
 			EndObject(wrapper);
 	}
@@ -0,0 +1,163 @@
+#include <cmath>
+
+#include "Fury/HLOD.h"
+#include "Fury/MeshRender.h"
+#include "Fury/PVS.h"
+#include "Fury/RenderUtil.h"
+#include "Fury/SceneNode.h"
+#include "Fury/Vector4.h"
+#include "SceneManager.h"
+
+namespace fury
+{
+	void SceneManager::SetPVS(const std::shared_ptr<PVS> &pvs)
+	{
+		if (m_PVS == pvs)
+			return;
+
+		m_PVS = pvs;
+		m_PVSCell = -1;
+		m_PVSVisible.clear();
+	}
+
+	std::shared_ptr<PVS> SceneManager::GetPVS() const
+	{
+		return m_PVS;
+	}
+
+	void SceneManager::SetViewerPosition(const Vector4 &position, float projectionScale)
+	{
+		m_ViewerPosition = position;
+		m_ProjectionScale = projectionScale;
+		m_HasViewer = true;
+
+		if (m_HLOD != nullptr)
+		{
+			m_HLODFar.resize(m_HLOD->GetClusterCount());
+			for (unsigned int i = 0; i < m_HLODFar.size(); i++)
+				m_HLODFar[i] = m_HLOD->IsFar(i, position) ? 1 : 0;
+		}
+
+		if (m_PVS == nullptr)
+			return;
+
+		// decode only when the viewer moves to another cell.
+		int cell = m_PVS->GetCellIndex(position);
+		if (cell == m_PVSCell)
+			return;
+
+		m_PVSCell = cell;
+		if (cell < 0)
+			m_PVSVisible.clear();
+		else
+			m_PVS->GetVisibleObjects(cell, m_PVSVisible);
+	}
+
+	bool SceneManager::IsPotentiallyVisible(const SceneNode &sceneNode) const
+	{
+		if (m_PVSVisible.empty())
+			return true;
+
+		int index = m_PVS->GetObjectIndex(sceneNode);
+		return index < 0 || m_PVSVisible[index] != 0;
+	}
+
+	void SceneManager::SetMinScreenSize(float size, bool shadow)
+	{
+		if (shadow)
+			m_MinShadowScreenSize = size;
+		else
+			m_MinScreenSize = size;
+	}
+
+	float SceneManager::GetMinScreenSize(bool shadow) const
+	{
+		return shadow ? m_MinShadowScreenSize : m_MinScreenSize;
+	}
+
+	void SceneManager::SetHLOD(const std::shared_ptr<HLOD> &hlod)
+	{
+		if (m_HLOD == hlod)
+			return;
+
+		m_HLOD = hlod;
+		m_HLODFar.clear();
+	}
+
+	std::shared_ptr<HLOD> SceneManager::GetHLOD() const
+	{
+		return m_HLOD;
+	}
+
+	bool SceneManager::IsDetailVisible(const SceneNode &sceneNode, bool shadow) const
+	{
+		if (m_HLOD != nullptr)
+		{
+			bool proxy;
+			int cluster = m_HLOD->GetClusterIndex(sceneNode, proxy);
+			if (cluster >= 0)
+			{
+				bool far = (unsigned int)cluster < m_HLODFar.size() && m_HLODFar[cluster] != 0;
+				if (far != proxy)
+					return false;
+			}
+		}
+
+		if (!m_HasViewer)
+			return true;
+
+		auto render = sceneNode.GetComponent<MeshRender>();
+		if (render == nullptr)
+			return true;
+
+		float maxDistance = shadow ? render->GetMaxShadowDistance() : render->GetMaxDrawDistance();
+		float minSize = m_ProjectionScale > 0.0f ? GetMinScreenSize(shadow) : 0.0f;
+		if (maxDistance <= 0.0f && minSize <= 0.0f)
+			return true;
+
+		// meshes without a sphere use the one around their aabb.
+		Vector4 center;
+		float radius;
+		SphereBounds bsphere = sceneNode.GetWorldSphere();
+		if (!bsphere.GetInfinite())
+		{
+			center = bsphere.GetCenter();
+			radius = bsphere.GetRadius();
+		}
+		else
+		{
+			BoxBounds aabb = sceneNode.GetWorldAABB();
+			if (aabb.GetInfinite())
+				return true;
+
+			center = aabb.GetCenter();
+			radius = aabb.GetExtents().Length();
+		}
+
+		float dx = center.x - m_ViewerPosition.x, dy = center.y - m_ViewerPosition.y, dz = center.z - m_ViewerPosition.z;
+		float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+		auto &renderUtil = RenderUtil::Instance();
+
+		if (maxDistance > 0.0f && distance - radius > maxDistance)
+		{
+			if (renderUtil != nullptr && shadow)
+				renderUtil->IncreaseShadowDistanceCullCount();
+			else if (renderUtil != nullptr)
+				renderUtil->IncreaseDistanceCullCount();
+			return false;
+		}
+
+		// projected diameter over screen height is radius * scale / distance.
+		if (minSize > 0.0f && distance > radius && radius * m_ProjectionScale < minSize * distance)
+		{
+			if (renderUtil != nullptr && shadow)
+				renderUtil->IncreaseShadowScreenSizeCullCount();
+			else if (renderUtil != nullptr)
+				renderUtil->IncreaseScreenSizeCullCount();
+			return false;
+		}
+
+		return true;
+	}
+}
@@ -6,11 +6,16 @@
 #include <functional>
 
 #include "Macros.h"
+#include "Fury/Vector4.h"
 
 namespace fury
 {
 	class Collidable;
 
+	class HLOD;
+
+	class PVS;
+
 	class RenderQuery;
 
 	class SceneNode;
@@ -25,8 +30,65 @@ namespace fury
 
 		typedef std::function<void(const std::shared_ptr<SceneNode>&)> FilterFunc;
 
+	protected:
+
+		std::shared_ptr<PVS> m_PVS;
+
+		// one flag per pvs object for the viewer's cell, empty if the viewer is outside the grid.
+		std::vector<char> m_PVSVisible;
+
+		int m_PVSCell = -1;
+
+		// detail culling, see IsDetailVisible.
+
+		Vector4 m_ViewerPosition;
+
+		float m_ProjectionScale = 0.0f;
+
+		bool m_HasViewer = false;
+
+		float m_MinScreenSize = 0.0f;
+
+		float m_MinShadowScreenSize = 0.0f;
+
+		std::shared_ptr<HLOD> m_HLOD;
+
+		// one flag per hlod cluster, set when the viewer is beyond its switch distance.
+		std::vector<char> m_HLODFar;
+
 	public:
 
+		// static scenes can bake a pvs, camera queries (GetRenderQuery, GetVisibleRenderables,
+		// GetVisibleRenderableAndLights) then skip static nodes the viewer's cell can't see
+		// before testing them against the collider. shadow and light queries aren't filtered.
+		void SetPVS(const std::shared_ptr<PVS> &pvs);
+
+		std::shared_ptr<PVS> GetPVS() const;
+
+		// selects the pvs cell and the origin of detail culling, usually from the camera.
+		// projectionScale is the projection's y scale (Raw[5]), 0 skips screen size culling, e.g. for ortho cameras.
+		void SetViewerPosition(const Vector4 &position, float projectionScale = 0.0f);
+
+		// true for nodes the pvs doesn't know, or when there's no cell selected.
+		bool IsPotentiallyVisible(const SceneNode &sceneNode) const;
+
+		// smallest projected diameter of a mesh's world sphere still drawn, as a fraction of the screen height.
+		// shadow casters have their own threshold, 0 disables.
+		void SetMinScreenSize(float size, bool shadow = false);
+
+		float GetMinScreenSize(bool shadow = false) const;
+
+		// far hlod clusters draw their proxy instead of their members, proxies must be added as nodes.
+		void SetHLOD(const std::shared_ptr<HLOD> &hlod);
+
+		std::shared_ptr<HLOD> GetHLOD() const;
+
+		// false for hlod members of far clusters and proxies of near ones, all clusters are near until a viewer is set.
+		// false for mesh renders beyond their max draw (or shadow) distance, or smaller than the min screen size,
+		// each rejection is counted in RenderUtil. camera queries apply it after the collider test,
+		// shadow casters are filtered by Pipeline::GetShadowCasters.
+		bool IsDetailVisible(const SceneNode &sceneNode, bool shadow) const;
+
 		virtual void AddSceneNode(const std::shared_ptr<SceneNode> &sceneNode) = 0;
 
 		virtual void AddSceneNodeRecursively(const std::shared_ptr<SceneNode> &sceneNode) = 0;
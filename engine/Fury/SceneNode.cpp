@@ -1,22 +1,29 @@
+#include <algorithm>
+#include <cmath>
+
 #include "Fury/MathUtil.h"
+#include "Fury/BufferManager.h"
 #include "Fury/Component.h"
 #include "Fury/Log.h"
 #include "Fury/Light.h"
 #include "Fury/OcTreeNode.h"
 #include "Fury/OcTree.h"
+#include "Fury/RenderUtil.h"
 #include "Fury/SceneNode.h"
 #include "Fury/EntityManager.h"
 #include "Fury/Scene.h"
 #include "Fury/MeshRender.h"
 #include "Fury/Mesh.h"
 #include "Fury/Material.h"
+#include "Fury/ParticleSystem.h"
 
 namespace fury
 {
 	std::unordered_map<std::string, std::function<Component::Ptr()>> SceneNode::ComponentRegistry = 
 	{
 		{ "MeshRender", []() -> Component::Ptr { return MeshRender::Create(nullptr, nullptr); } },
-		{ "Light", []() -> Component::Ptr { return Light::Create(); } }
+		{ "Light", []() -> Component::Ptr { return Light::Create(); } },
+		{ "ParticleSystem", []() -> Component::Ptr { return ParticleSystem::Create(nullptr); } }
 	};
 
 	SceneNode::Ptr SceneNode::Create(const std::string &name)
@@ -29,13 +36,26 @@ namespace fury
 	{
 		m_TypeIndex = typeid(SceneNode);
 		OnTransformChange = Signal<const Ptr&>::Create();
+
+		m_ModelSphere.SetInfinite(true);
+		m_WorldSphere.SetInfinite(true);
+
+		if (auto manager = BufferManager::Instance())
+			manager->IncreaseMemory(sizeof(SceneNode), MemoryCategory::SCENE_GRAPH);
 	}
 
 	SceneNode::~SceneNode()
 	{
-		RemoveAllComponents(true);
+		// proxies must not detach components from their live node.
+		if (m_RenderProxy)
+			m_Components.clear();
+		else
+			RemoveAllComponents(true);
 		RemoveAllChilds();
 		//FURYD << m_Name << " destoried.";
+
+		if (auto manager = BufferManager::Instance())
+			manager->DecreaseMemory(sizeof(SceneNode), MemoryCategory::SCENE_GRAPH);
 	}
 
 	bool SceneNode::Load(const void* wrapper, bool object)
@@ -233,6 +253,58 @@ namespace fury
 		return m_WorldAABB;
 	}
 
+	void SceneNode::SetModelSphere(const SphereBounds &bsphere)
+	{
+		m_ModelSphere = m_WorldSphere = bsphere;
+		if (bsphere.GetInfinite())
+			return;
+
+		// the radius grows by the largest axis scale of the world matrix.
+		const float* raw = m_WorldMatrix.Raw;
+		float scale = std::max(raw[0] * raw[0] + raw[1] * raw[1] + raw[2] * raw[2],
+			std::max(raw[4] * raw[4] + raw[5] * raw[5] + raw[6] * raw[6], raw[8] * raw[8] + raw[9] * raw[9] + raw[10] * raw[10]));
+
+		Vector4 center = bsphere.GetCenter();
+		center.w = 1.0f;
+		m_WorldSphere.SetCenterRadius(m_WorldMatrix.Multiply(center), bsphere.GetRadius() * std::sqrt(scale));
+	}
+
+	SphereBounds SceneNode::GetModelSphere() const
+	{
+		return m_ModelSphere;
+	}
+
+	SphereBounds SceneNode::GetWorldSphere() const
+	{
+		return m_WorldSphere;
+	}
+
+	bool SceneNode::IsInsideFast(const Collidable &collider) const
+	{
+		auto &renderUtil = RenderUtil::Instance();
+		if (renderUtil != nullptr)
+			renderUtil->IncreaseCullTestCount();
+
+		if (!collider.IsInsideFast(m_WorldSphere))
+		{
+			if (renderUtil != nullptr)
+				renderUtil->IncreaseSphereCullCount();
+			return false;
+		}
+
+		return collider.IsInsideFast(m_WorldAABB);
+	}
+
+	const SceneNode *SceneNode::GetRenderSource() const
+	{
+		return m_RenderSource != nullptr ? m_RenderSource : this;
+	}
+
+	const std::vector<Matrix4> &SceneNode::GetJointMatrices() const
+	{
+		return m_JointMatrices;
+	}
+
 	//////////////////////////////////
 	// Transforms
 	//////////////////////////////////
@@ -250,6 +322,11 @@ namespace fury
 		m_LocalMatrix.AppendRotation(m_LocalRotation);
 		m_LocalMatrix.AppendScale(m_LocalScale);
 
+		RecomposeWorld();
+	}
+
+	void SceneNode::RecomposeWorld()
+	{
 		m_InvertLocalMatrix = m_LocalMatrix.Inverse();
 
 		// update world matrix
@@ -272,6 +349,7 @@ namespace fury
 
 		// update bounding box
 		SetModelAABB(m_ModelAABB);
+		SetModelSphere(m_ModelSphere);
 
 		// update octree info
 		if (!m_OcTreeNode.expired())
@@ -378,6 +456,17 @@ namespace fury
 		}
 	}
 
+	void SceneNode::SetLocalTransform(Vector4 position, Quaternion rotation, Vector4 scale, const Matrix4 &localMatrix)
+	{
+		m_LocalPosition = position;
+		m_LocalRotation = rotation;
+		m_LocalScale = scale;
+		m_LocalMatrix = localMatrix;
+		m_TransformDirty = false;
+
+		RecomposeWorld();
+	}
+
 	void SceneNode::SetLocalScale(float factor)
 	{
 		SetLocalScale(Vector4(factor));
@@ -480,12 +569,12 @@ namespace fury
 
 	SceneNode::Ptr SceneNode::FindChild(const std::string &name) const 
 	{
-		return FindChild(std::hash<std::string>()(name));
+		return FindChild(Name(name).GetHash());
 	}
 
 	SceneNode::Ptr SceneNode::FindChildRecursively(const std::string &name) const
 	{
-		return FindChildRecursively(std::hash<std::string>()(name));
+		return FindChildRecursively(Name(name).GetHash());
 	}
 
 	SceneNode::Ptr SceneNode::FindChild(size_t hashcode) const
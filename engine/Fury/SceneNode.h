@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "Fury/BoxBounds.h"
+#include "Fury/SphereBounds.h"
 #include "Fury/Entity.h"
 #include "Fury/Quaternion.h"
 #include "Fury/Matrix4.h"
@@ -14,6 +15,8 @@
 
 namespace fury
 {
+	class Collidable;
+
 	class Component;
 
 	class OcTreeNode;
@@ -25,6 +28,8 @@ namespace fury
 	{
 		friend class OcTreeNode;
 
+		friend class RenderFrame;
+
 	public:
 
 		typedef std::shared_ptr<SceneNode> Ptr;
@@ -50,6 +55,11 @@ namespace fury
 
 		BoxBounds m_WorldAABB;
 
+		// infinite unless a component sets it, see SetModelSphere.
+		SphereBounds m_ModelSphere;
+
+		SphereBounds m_WorldSphere;
+
 		bool m_TransformDirty;
 
 		Vector4 m_WorldPosition;
@@ -72,6 +82,15 @@ namespace fury
 
 		Matrix4 m_InvertWorldMatrix;
 
+		// RenderFrame snapshot, shares the live node's components without owning them.
+		bool m_RenderProxy = false;
+
+		// the live node a RenderFrame proxy was copied from, never dereferenced after capture.
+		const SceneNode *m_RenderSource = nullptr;
+
+		// RenderFrame snapshot of the skinned mesh's joint matrices, empty for live nodes.
+		std::vector<Matrix4> m_JointMatrices;
+
 	public:
 
 		Signal<const Ptr&>::Ptr OnTransformChange;
@@ -99,6 +118,23 @@ namespace fury
 
 		BoxBounds GetWorldAABB() const;
 
+		void SetModelSphere(const SphereBounds &bsphere);
+
+		SphereBounds GetModelSphere() const;
+
+		SphereBounds GetWorldSphere() const;
+
+		// culling test, rejects by the world sphere first since it's cheaper and much tighter
+		// than the world aabb of rotated nodes, then by the world aabb.
+		bool IsInsideFast(const Collidable &collider) const;
+
+		// the live node's address for RenderFrame proxies, this otherwise. identifies a node
+		// across the live scene and its snapshots where names needn't be unique, don't dereference.
+		const SceneNode *GetRenderSource() const;
+
+		// pose captured by RenderFrame, empty for live nodes which use their mesh's joints.
+		const std::vector<Matrix4> &GetJointMatrices() const;
+
 		//////////////////////////////////
 		// Transforms
 		//////////////////////////////////
@@ -141,6 +177,10 @@ namespace fury
 		// uniform scale
 		void SetLocalScale(float factor = 1.0f);
 
+		// sets local trs together with their matrix, built elsewhere from the same trs
+		// (see Transform::InterpolateAll), and recomposes without rebuilding the local matrix.
+		void SetLocalTransform(Vector4 position, Quaternion rotation, Vector4 scale, const Matrix4 &localMatrix);
+
 		//////////////////////////////////
 		// Hierarchy
 		//////////////////////////////////
@@ -199,6 +239,9 @@ namespace fury
 
 	protected:
 
+		// world matrices, bounds, octree and children from the current local matrix.
+		void RecomposeWorld();
+
 		void SetOcTreeNode(const std::shared_ptr<OcTreeNode> &ocTreeNode);
 
 		void SetParent(const Ptr &parent);
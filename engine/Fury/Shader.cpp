@@ -7,6 +7,7 @@
 #include "Fury/Light.h"
 #include "Fury/Material.h"
 #include "Fury/Mesh.h"
+#include "Fury/ParticleSystem.h"
 #include "Fury/SceneNode.h"
 #include "Fury/Shader.h"
 #include "Fury/Texture.h"
@@ -333,6 +334,8 @@ namespace fury
 			return false;
 		}
 		
+		CacheUniformLocations();
+
 		m_Dirty = false;
 		FURYD << m_Name << " compile & link success!";
 		return true;
@@ -346,6 +349,7 @@ namespace fury
 			m_Program = 0;
 		}
 
+		m_UniformLocations.clear();
 		m_Dirty = true;
 	}
 
@@ -366,9 +370,9 @@ namespace fury
 		Vector4 camPos = camNode->GetWorldPosition();
 		if (auto camera = camNode->GetComponent<Camera>())
 		{
-			BindFloat("camera_pos", camPos.x, camPos.y, camPos.z);
-			BindFloat("camera_far", camera->GetFar());
-			BindFloat("camera_near", camera->GetNear());
+			BindFloat(FURY_NAME("camera_pos"), camPos.x, camPos.y, camPos.z);
+			BindFloat(FURY_NAME("camera_far"), camera->GetFar());
+			BindFloat(FURY_NAME("camera_near"), camera->GetNear());
 			BindMatrix(Matrix4::INVERT_VIEW_MATRIX, &camNode->GetInvertWorldMatrix().Raw[0]);
 			BindMatrix(Matrix4::PROJECTION_MATRIX, &camera->GetProjectionMatrix().Raw[0]);
 		}
@@ -384,14 +388,14 @@ namespace fury
 		if (auto light = lightNode->GetComponent<Light>())
 		{
 			Color color = light->GetColor();
-			BindFloat("light_pos", lightPos.x, lightPos.y, lightPos.z);
-			BindFloat("light_dir", lightDir.x, lightDir.y, lightDir.z);
-			BindFloat("light_color", color.r / pi, color.g / pi, color.b / pi);
-			BindFloat("light_intensity", light->GetIntensity());
-			BindFloat("light_innerangle", light->GetInnerAngle());
-			BindFloat("light_outterangle", light->GetOutterAngle());
-			BindFloat("light_falloff", light->GetFalloff());
-			BindFloat("light_radius", light->GetRadius());
+			BindFloat(FURY_NAME("light_pos"), lightPos.x, lightPos.y, lightPos.z);
+			BindFloat(FURY_NAME("light_dir"), lightDir.x, lightDir.y, lightDir.z);
+			BindFloat(FURY_NAME("light_color"), color.r / pi, color.g / pi, color.b / pi);
+			BindFloat(FURY_NAME("light_intensity"), light->GetIntensity());
+			BindFloat(FURY_NAME("light_innerangle"), light->GetInnerAngle());
+			BindFloat(FURY_NAME("light_outterangle"), light->GetOutterAngle());
+			BindFloat(FURY_NAME("light_falloff"), light->GetFalloff());
+			BindFloat(FURY_NAME("light_radius"), light->GetRadius());
 		}
 	}
 
@@ -407,7 +411,7 @@ namespace fury
 		glBindTexture(EnumUtil::TextureTypeToUnit(type), textureId);
 	}
 
-	void Shader::BindTexture(const std::string &name, const std::shared_ptr<Texture> &texture)
+	void Shader::BindTexture(const Name &name, const std::shared_ptr<Texture> &texture)
 	{
 		if (texture->GetDirty())
 		{
@@ -427,7 +431,7 @@ namespace fury
 		}
 	}
 
-	void Shader::BindTexture(const std::string &name, size_t textureId, TextureType type)
+	void Shader::BindTexture(const Name &name, size_t textureId, TextureType type)
 	{
 		int id = GetUniformLocation(name);
 
@@ -562,34 +566,37 @@ namespace fury
 				FURYW << "Can't find " << mesh->Weights.Name << " in " << m_Name;
 			}
 
-			if (idFlag != -1 && weightFlag != -1)
-			{
-				int jointCount = (int)mesh->GetJointCount();
-				if (jointCount > 35)
-				{
-					FURYW << "Max joint count 35!";
-					jointCount = 35;
-				}
+		}
+		
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
 
-				std::vector<float> raw(jointCount * 16);
+	void Shader::BindJoints(const std::shared_ptr<SceneNode> &node, const std::shared_ptr<Mesh> &mesh)
+	{
+		if (!mesh->IsSkinnedMesh() || GetUniformLocation(FURY_NAME("bone_matrices")) == -1)
+			return;
 
-				for (int i = 0; i < jointCount; i++)
-				{
-					auto joint = mesh->GetJointAt(i);
-					auto matrix = joint->GetFinalMatrix();
-					int index = i * 16;
-
-					for (int j = 0; j < 16; j++)
-					{
-						raw[index + j] = matrix.Raw[j];
-					}
-				}
+		// render frame proxies carry the pose they were captured with, the live joints may be
+		// posed by the next frame's update meanwhile.
+		std::vector<Matrix4> liveMatrices;
+		const std::vector<Matrix4> *matrices = &node->GetJointMatrices();
+		if (matrices->empty())
+		{
+			liveMatrices.reserve(mesh->GetJointCount());
+			for (unsigned int i = 0; i < mesh->GetJointCount(); i++)
+				liveMatrices.push_back(mesh->GetJointAt(i)->GetFinalMatrix());
+			matrices = &liveMatrices;
+		}
 
-				BindMatrices("bone_matrices", jointCount, &raw[0]);
-			}
+		int jointCount = (int)matrices->size();
+		if (jointCount > 35)
+		{
+			FURYW << "Max joint count 35!";
+			jointCount = 35;
 		}
-		
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		if (jointCount > 0)
+			BindMatrices(FURY_NAME("bone_matrices"), jointCount, &(*matrices)[0]);
 	}
 
 	void Shader::BindMesh(const std::shared_ptr<Mesh> &mesh)
@@ -623,26 +630,62 @@ namespace fury
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, subMesh->Indices.GetID());
 	}
 
-	void Shader::BindMatrix(const std::string &name, const Matrix4 &matrix)
+	void Shader::BindParticles(const std::shared_ptr<ParticleSystem> &particles)
+	{
+		if (particles->GetDirty())
+			particles->UpdateBuffer();
+
+		if (m_Dirty || particles->GetDirty() || particles->m_InstanceData.GetDirty())
+			return;
+
+		int cornerFlag = glGetAttribLocation(m_Program, particles->m_Corners.Name.c_str());
+		int dataFlag = glGetAttribLocation(m_Program, particles->m_InstanceData.Name.c_str());
+
+		glBindVertexArray(particles->m_VAO);
+
+		if (cornerFlag != -1)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, particles->m_Corners.GetID());
+			glVertexAttribPointer(cornerFlag, 2, GL_FLOAT, GL_FALSE, 0, 0);
+			glEnableVertexAttribArray(cornerFlag);
+		}
+		if (dataFlag != -1)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, particles->m_InstanceData.GetID());
+			glVertexAttribPointer(dataFlag, 4, GL_FLOAT, GL_FALSE, 0, 0);
+			glEnableVertexAttribArray(dataFlag);
+			glVertexAttribDivisor(dataFlag, 1);
+		}
+
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, particles->m_Indices.GetID());
+
+		auto start = particles->GetStartColor();
+		auto end = particles->GetEndColor();
+		BindFloat(FURY_NAME("particle_start_color"), start.r, start.g, start.b, start.a);
+		BindFloat(FURY_NAME("particle_end_color"), end.r, end.g, end.b, end.a);
+		BindFloat(FURY_NAME("particle_size"), particles->GetStartSize(), particles->GetEndSize());
+	}
+
+	void Shader::BindMatrix(const Name &name, const Matrix4 &matrix)
 	{
 		BindMatrix(name, &matrix.Raw[0]);
 	}
 
-	void Shader::BindMatrix(const std::string &name, const float *raw)
+	void Shader::BindMatrix(const Name &name, const float *raw)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniformMatrix4fv(id, 1, false, raw);
 	}
 
-	void Shader::BindMatrices(const std::string &name, int count, const float *raw)
+	void Shader::BindMatrices(const Name &name, int count, const float *raw)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniformMatrix4fv(id, count, false, raw);
 	}
 
-	void Shader::BindMatrices(const std::string &name, const int count, const Matrix4 *matrices)
+	void Shader::BindMatrices(const Name &name, const int count, const Matrix4 *matrices)
 	{
 		std::vector<float> raw(count * 16);
 		for (int i = 0; i < count; i++)
@@ -657,35 +700,35 @@ namespace fury
 			glUniformMatrix4fv(id, count, false, &raw[0]);
 	}
 
-	void Shader::BindFloat(const std::string &name, float v0)
+	void Shader::BindFloat(const Name &name, float v0)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform1f(id, v0);
 	}
 
-	void Shader::BindFloat(const std::string &name, float v0, float v1)
+	void Shader::BindFloat(const Name &name, float v0, float v1)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform2f(id, v0, v1);
 	}
 
-	void Shader::BindFloat(const std::string &name, float v0, float v1, float v2)
+	void Shader::BindFloat(const Name &name, float v0, float v1, float v2)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform3f(id, v0, v1, v2);
 	}
 
-	void Shader::BindFloat(const std::string &name, float v0, float v1, float v2, float v3)
+	void Shader::BindFloat(const Name &name, float v0, float v1, float v2, float v3)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform4f(id, v0, v1, v2, v3);
 	}
 
-	void Shader::BindFloat(const std::string &name, int size, int count, const float *value)
+	void Shader::BindFloat(const Name &name, int size, int count, const float *value)
 	{
 		int id = GetUniformLocation(name);
 		if (id == -1) return;
@@ -710,35 +753,35 @@ namespace fury
 		}
 	}
 
-	void Shader::BindInt(const std::string &name, int v0)
+	void Shader::BindInt(const Name &name, int v0)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform1i(id, v0);
 	}
 
-	void Shader::BindInt(const std::string &name, int v0, int v1)
+	void Shader::BindInt(const Name &name, int v0, int v1)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform2i(id, v0, v1);
 	}
 
-	void Shader::BindInt(const std::string &name, int v0, int v1, int v2)
+	void Shader::BindInt(const Name &name, int v0, int v1, int v2)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform3i(id, v0, v1, v2);
 	}
 
-	void Shader::BindInt(const std::string &name, int v0, int v1, int v2, int v3)
+	void Shader::BindInt(const Name &name, int v0, int v1, int v2, int v3)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform4i(id, v0, v1, v2, v3);
 	}
 
-	void Shader::BindInt(const std::string &name, int size, int count, const int *value)
+	void Shader::BindInt(const Name &name, int size, int count, const int *value)
 	{
 		int id = GetUniformLocation(name);
 		if (id == -1) return;
@@ -763,35 +806,35 @@ namespace fury
 		}
 	}
 
-	void Shader::BindUInt(const std::string &name, unsigned int v0)
+	void Shader::BindUInt(const Name &name, unsigned int v0)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform1ui(id, v0);
 	}
 
-	void Shader::BindUInt(const std::string &name, unsigned int v0, unsigned int v1)
+	void Shader::BindUInt(const Name &name, unsigned int v0, unsigned int v1)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform2ui(id, v0, v1);
 	}
 
-	void Shader::BindUInt(const std::string &name, unsigned int v0, unsigned int v1, unsigned int v2)
+	void Shader::BindUInt(const Name &name, unsigned int v0, unsigned int v1, unsigned int v2)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform3ui(id, v0, v1, v2);
 	}
 
-	void Shader::BindUInt(const std::string &name, unsigned int v0, unsigned int v1, unsigned int v2, unsigned int v3)
+	void Shader::BindUInt(const Name &name, unsigned int v0, unsigned int v1, unsigned int v2, unsigned int v3)
 	{
 		int id = GetUniformLocation(name);
 		if (id != -1)
 			glUniform4ui(id, v0, v1, v2, v3);
 	}
 
-	void Shader::BindUInt(const std::string &name, int size, int count, const unsigned int *value)
+	void Shader::BindUInt(const Name &name, int size, int count, const unsigned int *value)
 	{
 		int id = GetUniformLocation(name);
 		if (id == -1) return;
@@ -826,12 +869,42 @@ namespace fury
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 	}
 
-	int Shader::GetUniformLocation(const std::string &name) const
+	int Shader::GetUniformLocation(const Name &name) const
 	{
 		if (m_Dirty)
 			return -1;
 
-		return glGetUniformLocation(m_Program, name.c_str());
+		auto it = m_UniformLocations.find(name);
+		return it == m_UniformLocations.end() ? -1 : it->second;
+	}
+
+	void Shader::CacheUniformLocations()
+	{
+		m_UniformLocations.clear();
+
+		GLint count = 0, maxLength = 0;
+		glGetProgramiv(m_Program, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(m_Program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+		std::vector<char> buffer(maxLength + 1);
+		for (GLint i = 0; i < count; i++)
+		{
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_Program, i, (GLsizei)buffer.size(), &length, &size, &type, &buffer[0]);
+
+			std::string name(&buffer[0], length);
+			int location = glGetUniformLocation(m_Program, name.c_str());
+			if (location == -1)
+				continue;
+
+			// arrays are reported as "name[0]", bind calls use the plain name.
+			if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0)
+				name.resize(name.size() - 3);
+
+			m_UniformLocations[Name::Intern(name)] = location;
+		}
 	}
 
 	void Shader::GetVersionInfo(const std::string &source, std::string &versionStr, std::string &mainStr)
@@ -2,6 +2,7 @@
 #define _FURY_SHADER_H_
 
 #include <iostream>
+#include <unordered_map>
 
 #include "Fury/Entity.h"
 #include "Fury/EnumUtil.h"
@@ -13,6 +14,8 @@ namespace fury
 
 	class Mesh;
 
+	class ParticleSystem;
+
 	class SceneNode;
 
 	class Texture;
@@ -44,6 +47,9 @@ namespace fury
 
 		bool m_UseGeomShader = false;
 
+		// active uniforms of the linked program, filled once after linking.
+		std::unordered_map<Name, int> m_UniformLocations;
+
 	public:
 
 		Shader(const std::string &name, ShaderType type, unsigned int textureFlags = 0);
@@ -86,53 +92,60 @@ namespace fury
 		// bind texture to 1st texture
 		void BindTexture(size_t textureId, TextureType type);
 
-		void BindTexture(const std::string &name, const std::shared_ptr<Texture> &texture);
+		void BindTexture(const Name &name, const std::shared_ptr<Texture> &texture);
 
-		void BindTexture(const std::string &name, size_t textureId, TextureType type);
+		void BindTexture(const Name &name, size_t textureId, TextureType type);
 
 		void BindMaterial(const std::shared_ptr<Material> &material);
 
 		void BindMesh(const std::shared_ptr<Mesh> &mesh);
 
+		// skinning matrices of node's pose, the ones captured for render frame proxies.
+		void BindJoints(const std::shared_ptr<SceneNode> &node, const std::shared_ptr<Mesh> &mesh);
+
 		void BindSubMesh(const std::shared_ptr<Mesh> &mesh, unsigned int index);
 
-		void BindMatrix(const std::string &name, const Matrix4 &matrix);
+		// binds the system's quad corners, one particle_data instance per particle and its
+		// size and color ramps, fill the instances with ParticleSystem::PrepareDraw first.
+		void BindParticles(const std::shared_ptr<ParticleSystem> &particles);
 
-		void BindMatrix(const std::string &name, const float *raw);
+		void BindMatrix(const Name &name, const Matrix4 &matrix);
 
-		void BindMatrices(const std::string &name, int count, const float *raw);
+		void BindMatrix(const Name &name, const float *raw);
 
-		void BindMatrices(const std::string &name, int count, const Matrix4 *matrices);
+		void BindMatrices(const Name &name, int count, const float *raw);
 
-		void BindFloat(const std::string &name, float v0);
+		void BindMatrices(const Name &name, int count, const Matrix4 *matrices);
 
-		void BindFloat(const std::string &name, float v0, float v1);
+		void BindFloat(const Name &name, float v0);
 
-		void BindFloat(const std::string &name, float v0, float v1, float v2);
+		void BindFloat(const Name &name, float v0, float v1);
 
-		void BindFloat(const std::string &name, float v0, float v1, float v2, float v3);
+		void BindFloat(const Name &name, float v0, float v1, float v2);
 
-		void BindFloat(const std::string &name, int size, int count, const float *value);
+		void BindFloat(const Name &name, float v0, float v1, float v2, float v3);
 
-		void BindInt(const std::string &name, int v0);
+		void BindFloat(const Name &name, int size, int count, const float *value);
 
-		void BindInt(const std::string &name, int v0, int v1);
+		void BindInt(const Name &name, int v0);
 
-		void BindInt(const std::string &name, int v0, int v1, int v2);
+		void BindInt(const Name &name, int v0, int v1);
 
-		void BindInt(const std::string &name, int v0, int v1, int v2, int v3);
+		void BindInt(const Name &name, int v0, int v1, int v2);
 
-		void BindInt(const std::string &name, int size, int count, const int *value);
+		void BindInt(const Name &name, int v0, int v1, int v2, int v3);
 
-		void BindUInt(const std::string &name, unsigned int v0);
+		void BindInt(const Name &name, int size, int count, const int *value);
 
-		void BindUInt(const std::string &name, unsigned int v0, unsigned int v1);
+		void BindUInt(const Name &name, unsigned int v0);
 
-		void BindUInt(const std::string &name, unsigned int v0, unsigned int v1, unsigned int v2);
+		void BindUInt(const Name &name, unsigned int v0, unsigned int v1);
 
-		void BindUInt(const std::string &name, unsigned int v0, unsigned int v1, unsigned int v2, unsigned int v3);
+		void BindUInt(const Name &name, unsigned int v0, unsigned int v1, unsigned int v2);
 
-		void BindUInt(const std::string &name, int size, int count, const unsigned int *value);
+		void BindUInt(const Name &name, unsigned int v0, unsigned int v1, unsigned int v2, unsigned int v3);
+
+		void BindUInt(const Name &name, int size, int count, const unsigned int *value);
 
 		void UnBind();
 
@@ -140,7 +153,9 @@ namespace fury
 
 		void BindMeshData(const std::shared_ptr<Mesh> &mesh);
 
-		int GetUniformLocation(const std::string &name) const;
+		int GetUniformLocation(const Name &name) const;
+
+		void CacheUniformLocations();
 
 		void GetVersionInfo(const std::string &source, std::string &versionStr, std::string &mainStr);
 
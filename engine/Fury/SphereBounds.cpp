@@ -180,9 +180,8 @@ namespace fury
 
 	SphereBounds &SphereBounds::operator = (const SphereBounds &data)
 	{
-		if (data.GetInfinite())
-			SetInfinite(true);
-		else 
+		SetInfinite(data.GetInfinite());
+		if (!data.GetInfinite())
 			SetCenterRadius(data.GetCenter(), data.GetRadius());
 
 		return *this;
@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+#include "Fury/Log.h"
+#include "Fury/TaskGraph.h"
+#include "Fury/ThreadUtil.h"
+
+namespace fury
+{
+	TaskGraph::Ptr TaskGraph::Create(const std::string &name)
+	{
+		return std::make_shared<TaskGraph>(name);
+	}
+
+	TaskGraph::TaskGraph(const std::string &name)
+		: m_Name(name), m_Remaining(0)
+	{
+
+	}
+
+	TaskGraph::~TaskGraph()
+	{
+		Wait();
+	}
+
+	unsigned int TaskGraph::AddTask(const std::string &name, std::function<void()> func, bool mainThread)
+	{
+		ASSERT_MSG(IsFinished(), "Can't modify a running TaskGraph!");
+
+		m_Nodes.emplace_back();
+		auto &node = m_Nodes.back();
+		node.name = name;
+		node.func = std::move(func);
+		node.mainThread = mainThread;
+
+		m_Validated = false;
+		return m_Nodes.size() - 1;
+	}
+
+	void TaskGraph::AddDependency(unsigned int task, unsigned int predecessor)
+	{
+		ASSERT_MSG(IsFinished(), "Can't modify a running TaskGraph!");
+
+		if (task >= m_Nodes.size() || predecessor >= m_Nodes.size())
+		{
+			FURYE << "TaskGraph " << m_Name << ": invalid dependency " << predecessor << " -> " << task;
+			return;
+		}
+
+		auto &successors = m_Nodes[predecessor].successors;
+		if (std::find(successors.begin(), successors.end(), task) != successors.end())
+			return;
+
+		successors.push_back(task);
+		m_Nodes[task].numPredecessors++;
+		m_Validated = false;
+	}
+
+	bool TaskGraph::Validate()
+	{
+		if (m_Validated)
+			return true;
+
+		// kahn's algorithm, whatever can't be sorted is part of or behind a cycle.
+		std::vector<unsigned int> inDegrees(m_Nodes.size());
+		std::vector<unsigned int> ready;
+
+		for (unsigned int i = 0; i < m_Nodes.size(); i++)
+		{
+			inDegrees[i] = m_Nodes[i].numPredecessors;
+			if (inDegrees[i] == 0)
+				ready.push_back(i);
+		}
+
+		unsigned int sorted = 0;
+		while (!ready.empty())
+		{
+			unsigned int index = ready.back();
+			ready.pop_back();
+			sorted++;
+
+			for (auto successor : m_Nodes[index].successors)
+				if (--inDegrees[successor] == 0)
+					ready.push_back(successor);
+		}
+
+		if (sorted != m_Nodes.size())
+		{
+			std::string names;
+			for (unsigned int i = 0; i < m_Nodes.size(); i++)
+				if (inDegrees[i] > 0)
+					names += m_Nodes[i].name + " ";
+
+			FURYE << "TaskGraph " << m_Name << " has a cycle: " << names;
+			return false;
+		}
+
+		m_Waiting.reset(new std::atomic<int>[m_Nodes.size()]);
+		m_Validated = true;
+		return true;
+	}
+
+	bool TaskGraph::Execute()
+	{
+		ASSERT_MSG(IsFinished(), "TaskGraph is already running!");
+
+		if (!Validate())
+			return false;
+
+		if (m_Nodes.empty())
+			return true;
+
+		for (unsigned int i = 0; i < m_Nodes.size(); i++)
+			m_Waiting[i].store(m_Nodes[i].numPredecessors, std::memory_order_relaxed);
+
+		m_Remaining.store(m_Nodes.size(), std::memory_order_release);
+
+		for (unsigned int i = 0; i < m_Nodes.size(); i++)
+			if (m_Nodes[i].numPredecessors == 0)
+				Spawn(i);
+
+		return true;
+	}
+
+	void TaskGraph::Wait()
+	{
+		if (IsFinished())
+			return;
+
+		auto &threadUtil = ThreadUtil::Instance();
+		bool mainThread = threadUtil->IsMainThread();
+
+		while (!IsFinished())
+		{
+			bool worked = threadUtil->RunPendingTask();
+			if (mainThread)
+				worked = threadUtil->RunMainThreadTasks() > 0 || worked;
+
+			if (!worked)
+				std::this_thread::yield();
+		}
+	}
+
+	bool TaskGraph::IsFinished() const
+	{
+		return m_Remaining.load(std::memory_order_acquire) == 0;
+	}
+
+	void TaskGraph::Clear()
+	{
+		ASSERT_MSG(IsFinished(), "Can't modify a running TaskGraph!");
+
+		m_Nodes.clear();
+		m_Waiting.reset();
+		m_Validated = false;
+	}
+
+	unsigned int TaskGraph::GetTaskCount() const
+	{
+		return m_Nodes.size();
+	}
+
+	std::string TaskGraph::GetName() const
+	{
+		return m_Name;
+	}
+
+	std::string TaskGraph::Dump() const
+	{
+		std::stringstream stream;
+		stream << "digraph \"" << m_Name << "\" {\n";
+
+		for (unsigned int i = 0; i < m_Nodes.size(); i++)
+		{
+			auto &node = m_Nodes[i];
+			stream << "\tn" << i << " [label=\"" << node.name << "\"" << (node.mainThread ? ", shape=box" : "") << "];\n";
+		}
+
+		for (unsigned int i = 0; i < m_Nodes.size(); i++)
+			for (auto successor : m_Nodes[i].successors)
+				stream << "\tn" << i << " -> n" << successor << ";\n";
+
+		stream << "}\n";
+		return stream.str();
+	}
+
+	void TaskGraph::Spawn(unsigned int index)
+	{
+		if (m_Nodes[index].mainThread)
+			ThreadUtil::Instance()->SpawnOnMainThread([this, index] { Run(index); });
+		else
+			ThreadUtil::Instance()->Spawn([this, index] { Run(index); });
+	}
+
+	void TaskGraph::Run(unsigned int index)
+	{
+		auto &node = m_Nodes[index];
+		if (node.func)
+			node.func();
+
+		// continuations start right here, on whichever thread finished the last input.
+		for (auto successor : node.successors)
+			if (m_Waiting[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+				Spawn(successor);
+
+		m_Remaining.fetch_sub(1, std::memory_order_acq_rel);
+	}
+}
@@ -0,0 +1,94 @@
+#ifndef _FURY_TASK_GRAPH_H_
+#define _FURY_TASK_GRAPH_H_
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Macros.h"
+
+namespace fury
+{
+	// tasks with explicit predecessors, scheduled on ThreadUtil.
+	// a task is spawned as soon as all its predecessors finish, main thread tasks wait for
+	// ThreadUtil::Update (or TaskGraph::Wait on the main thread), so only use them for gl work.
+	class FURY_API TaskGraph final
+	{
+	public:
+
+		typedef std::shared_ptr<TaskGraph> Ptr;
+
+		static Ptr Create(const std::string &name);
+
+	protected:
+
+		class Node
+		{
+		public:
+
+			std::string name;
+
+			std::function<void()> func;
+
+			bool mainThread = false;
+
+			std::vector<unsigned int> successors;
+
+			unsigned int numPredecessors = 0;
+		};
+
+		std::string m_Name;
+
+		std::vector<Node> m_Nodes;
+
+		// remaining predecessors per node, reset on each Execute.
+		std::unique_ptr<std::atomic<int>[]> m_Waiting;
+
+		std::atomic<int> m_Remaining;
+
+		bool m_Validated = false;
+
+	public:
+
+		TaskGraph(const std::string &name);
+
+		~TaskGraph();
+
+		// returns the task's id.
+		unsigned int AddTask(const std::string &name, std::function<void()> func, bool mainThread = false);
+
+		// task won't start before predecessor finishes.
+		void AddDependency(unsigned int task, unsigned int predecessor);
+
+		// returns false and logs the tasks involved if the graph has a cycle.
+		bool Validate();
+
+		// starts all tasks without predecessors and returns immediately.
+		bool Execute();
+
+		// helps executing tasks until the whole graph is done.
+		// calling this from a worker while main thread tasks are pending waits for the next ThreadUtil::Update.
+		void Wait();
+
+		bool IsFinished() const;
+
+		void Clear();
+
+		unsigned int GetTaskCount() const;
+
+		std::string GetName() const;
+
+		// graphviz dot format, main thread tasks are drawn as boxes.
+		std::string Dump() const;
+
+	protected:
+
+		void Spawn(unsigned int index);
+
+		void Run(unsigned int index);
+	};
+}
+
+#endif // _FURY_TASK_GRAPH_H_
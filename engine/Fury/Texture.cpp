@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <array>
 #include <sstream>
 
@@ -198,66 +199,74 @@ namespace fury
 	}
 
 	void Texture::CreateFromImage(const std::string &filePath, bool srgb, bool mipMap)
+	{
+		int width, height, channels;
+		std::vector<unsigned char> pixels;
+
+		if (FileUtil::LoadImage(Scene::Path(filePath), pixels, width, height, channels))
+			CreateFromPixels(filePath, pixels, width, height, channels, srgb, mipMap);
+		else
+			DeleteBuffer();
+	}
+
+	void Texture::CreateFromPixels(const std::string &filePath, const std::vector<unsigned char> &pixels, int width, int height, int channels, bool srgb, bool mipMap)
 	{
 		DeleteBuffer();
 
-		int channels;
-		std::vector<unsigned char> pixels;
+		m_Width = width;
+		m_Height = height;
 
-		if (FileUtil::LoadImage(Scene::Path(filePath), pixels, m_Width, m_Height, channels))
-		{
-			unsigned int internalFormat, imageFormat;
+		unsigned int internalFormat, imageFormat;
 
-			switch (channels)
-			{
-			case 3:
-				m_Format = srgb ? TextureFormat::SRGB8 : TextureFormat::RGB8;
-				internalFormat = srgb ? GL_SRGB8 : GL_RGB8;
-				imageFormat = GL_RGB;
-				break;
-			case 4:
-				m_Format = srgb ? TextureFormat::SRGB8_ALPHA8 : TextureFormat::RGBA8;
-				internalFormat = srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
-				imageFormat = GL_RGBA;
-				break;
-			default:
-				m_Format = TextureFormat::UNKNOW;
-				FURYW << channels << " channel image not supported!";
-				return;
-			}
+		switch (channels)
+		{
+		case 3:
+			m_Format = srgb ? TextureFormat::SRGB8 : TextureFormat::RGB8;
+			internalFormat = srgb ? GL_SRGB8 : GL_RGB8;
+			imageFormat = GL_RGB;
+			break;
+		case 4:
+			m_Format = srgb ? TextureFormat::SRGB8_ALPHA8 : TextureFormat::RGBA8;
+			internalFormat = srgb ? GL_SRGB8_ALPHA8 : GL_RGBA8;
+			imageFormat = GL_RGBA;
+			break;
+		default:
+			m_Format = TextureFormat::UNKNOW;
+			FURYW << channels << " channel image not supported!";
+			return;
+		}
 
-			m_Depth = 0;
-			m_Mipmap = mipMap;
-			m_FilePath = filePath;
-			m_Dirty = false;
+		m_Depth = 0;
+		m_Mipmap = mipMap;
+		m_FilePath = filePath;
+		m_Dirty = false;
 
-			glGenTextures(1, &m_ID);
-			glBindTexture(m_TypeUint, m_ID);
+		glGenTextures(1, &m_ID);
+		glBindTexture(m_TypeUint, m_ID);
 
-			glTexStorage2D(m_TypeUint, m_Mipmap ? FURY_MIPMAP_LEVEL : 1, internalFormat, m_Width, m_Height);
-			glTexSubImage2D(m_TypeUint, 0, 0, 0, m_Width, m_Height, imageFormat, GL_UNSIGNED_BYTE, &pixels[0]);
+		glTexStorage2D(m_TypeUint, m_Mipmap ? FURY_MIPMAP_LEVEL : 1, internalFormat, m_Width, m_Height);
+		glTexSubImage2D(m_TypeUint, 0, 0, 0, m_Width, m_Height, imageFormat, GL_UNSIGNED_BYTE, &pixels[0]);
 
-			unsigned int filterMode = EnumUtil::FilterModeToUint(m_FilterMode);
-			unsigned int wrapMode = EnumUtil::WrapModeToUint(m_WrapMode);
+		unsigned int filterMode = EnumUtil::FilterModeToUint(m_FilterMode);
+		unsigned int wrapMode = EnumUtil::WrapModeToUint(m_WrapMode);
 
-			glTexParameteri(m_TypeUint, GL_TEXTURE_MIN_FILTER, filterMode);
-			glTexParameteri(m_TypeUint, GL_TEXTURE_MAG_FILTER, filterMode);
-			glTexParameteri(m_TypeUint, GL_TEXTURE_WRAP_S, wrapMode);
-			glTexParameteri(m_TypeUint, GL_TEXTURE_WRAP_T, wrapMode);
-			glTexParameteri(m_TypeUint, GL_TEXTURE_WRAP_R, wrapMode);
+		glTexParameteri(m_TypeUint, GL_TEXTURE_MIN_FILTER, filterMode);
+		glTexParameteri(m_TypeUint, GL_TEXTURE_MAG_FILTER, filterMode);
+		glTexParameteri(m_TypeUint, GL_TEXTURE_WRAP_S, wrapMode);
+		glTexParameteri(m_TypeUint, GL_TEXTURE_WRAP_T, wrapMode);
+		glTexParameteri(m_TypeUint, GL_TEXTURE_WRAP_R, wrapMode);
 
-			float color[] = { m_BorderColor.r, m_BorderColor.g, m_BorderColor.b, m_BorderColor.a };
-			glTexParameterfv(m_TypeUint, GL_TEXTURE_BORDER_COLOR, color);
+		float color[] = { m_BorderColor.r, m_BorderColor.g, m_BorderColor.b, m_BorderColor.a };
+		glTexParameterfv(m_TypeUint, GL_TEXTURE_BORDER_COLOR, color);
 
-			if (m_Mipmap)
-				glGenerateMipmap(m_TypeUint);
+		if (m_Mipmap)
+			glGenerateMipmap(m_TypeUint);
 
-			glBindTexture(m_TypeUint, 0);
+		glBindTexture(m_TypeUint, 0);
 
-			FURYD << m_Name << " [" << m_Width << " x " << m_Height << " x " << EnumUtil::TextureTypeToString(m_Type) << "]";
+		FURYD << m_Name << " [" << m_Width << " x " << m_Height << " x " << EnumUtil::TextureTypeToString(m_Type) << "]";
 
-			IncreaseMemory();
-		}
+		IncreaseMemory();
 	}
 
 	void Texture::CreateEmpty(int width, int height, int depth, TextureFormat format, TextureType type, bool mipMap)
@@ -491,13 +500,25 @@ namespace fury
 
 	void Texture::IncreaseMemory()
 	{
-		unsigned int bitPerPixel = EnumUtil::TextureBitPerPixel(m_Format);
-		BufferManager::Instance()->IncreaseMemory(m_Width * m_Height * (m_Depth + 1) * bitPerPixel / 8);
+		uint64_t bitPerPixel = EnumUtil::TextureBitPerPixel(m_Format);
+		uint64_t layers = m_Type == TextureType::TEXTURE_CUBE_MAP ? 6 : std::max(m_Depth, 1);
+
+		m_MemoryBytes = (uint64_t)m_Width * m_Height * layers * bitPerPixel / 8;
+		if (m_Mipmap)
+			m_MemoryBytes = m_MemoryBytes * 4 / 3;
+
+		// textures without a source image are render targets.
+		m_MemoryCategory = m_FilePath.empty() ? MemoryCategory::RENDER_TARGET : MemoryCategory::TEXTURE;
+
+		if (auto manager = BufferManager::Instance())
+			manager->IncreaseMemory(m_MemoryBytes, m_MemoryCategory);
 	}
 
 	void Texture::DecreaseMemory()
 	{
-		unsigned int bitPerPixel = EnumUtil::TextureBitPerPixel(m_Format);
-		BufferManager::Instance()->DecreaseMemory(m_Width * m_Height * (m_Depth + 1) * bitPerPixel / 8);
+		if (auto manager = BufferManager::Instance())
+			manager->DecreaseMemory(m_MemoryBytes, m_MemoryCategory);
+
+		m_MemoryBytes = 0;
 	}
 }
\ No newline at end of file
@@ -1,8 +1,10 @@
 #ifndef _FURY_TEXTURE_H_
 #define _FURY_TEXTURE_H_
 
+#include <cstdint>
 #include <stack>
 #include <unordered_map>
+#include <vector>
 
 #include "Fury/Buffer.h"
 #include "Fury/Color.h"
@@ -65,6 +67,11 @@ namespace fury
 
 		std::string m_FilePath;
 
+		// what IncreaseMemory reported, so DecreaseMemory gives back the same.
+		uint64_t m_MemoryBytes = 0;
+
+		MemoryCategory m_MemoryCategory = MemoryCategory::TEXTURE;
+
 	public:
 
 		Texture(const std::string &name);
@@ -77,6 +84,9 @@ namespace fury
 
 		void CreateFromImage(const std::string &filePath, bool srgb, bool mipMap);
 
+		// uploads already decoded pixels, lets the decoding happen on a worker thread.
+		void CreateFromPixels(const std::string &filePath, const std::vector<unsigned char> &pixels, int width, int height, int channels, bool srgb, bool mipMap);
+
 		void CreateEmpty(int width, int height, int depth, TextureFormat format = TextureFormat::RGBA8, TextureType type = TextureType::TEXTURE_2D, bool mipMap = false);
 
 		void SetPixels(const void* pixels);
@@ -1,17 +1,33 @@
-#include <stack>
-#include <list>
-
 #include "Fury/Log.h"
 #include "Fury/ThreadUtil.h"
 
 namespace fury
 {
+	namespace
+	{
+		// slot owned by the calling thread, -1 for threads unknown to ThreadUtil.
+		thread_local int t_SlotIndex = -1;
+
+		thread_local unsigned int t_Random = 0;
+
+		inline unsigned int NextRandom()
+		{
+			// xorshift32
+			unsigned int x = t_Random == 0 ? (unsigned int)std::hash<std::thread::id>()(std::this_thread::get_id()) | 1u : t_Random;
+			x ^= x << 13;
+			x ^= x >> 17;
+			x ^= x << 5;
+			t_Random = x;
+			return x;
+		}
+	}
+
 	std::thread::id ThreadUtil::m_MainThreadId;
 
-	size_t ThreadUtil::m_TaskKey = 0;
+	std::atomic<size_t> ThreadUtil::m_TaskKey(0);
 
 	ThreadUtil::ThreadUtil(unsigned int numThreads)
-		: m_Stop(false)
+		: m_TaskEvents(nullptr), m_InjectedCount(0), m_PendingTasks(0), m_Sleepers(0), m_Stop(false)
 	{
 		unsigned int maxThreads = std::thread::hardware_concurrency();
 		if (numThreads > maxThreads)
@@ -20,30 +36,15 @@ namespace fury
 			FURYW << "Hardware supports " << maxThreads << " threads at most!";
 		}
 
+		// one extra slot for the main thread.
+		for (unsigned int i = 0; i <= numThreads; i++)
+			m_Slots.emplace_back(new WorkerSlot());
+
 		for (unsigned int i = 0; i < numThreads; i++)
 		{
-			m_Workers.emplace_back([this]
+			m_Workers.emplace_back([this, i]
 			{
-				while (true)
-				{
-					std::function<void()> task;
-
-					{
-						std::unique_lock<std::mutex> lock(this->m_QueueMutex);
-						this->m_Condiction.wait(lock, [this]
-						{
-							return this->m_Stop || !this->m_Tasks.empty();
-						});
-
-						if (this->m_Stop && this->m_Tasks.empty())
-							return;
-
-						task = std::move(this->m_Tasks.front());
-						this->m_Tasks.pop();
-					}
-
-					task();
-				}
+				WorkerLoop(i);
 			});
 		}
 	}
@@ -53,74 +54,157 @@ namespace fury
 		{
 			std::unique_lock<std::mutex> lock(m_QueueMutex);
 			m_Stop = true;
-			m_TaskStates.clear();
 		}
 
 		m_Condiction.notify_all();
 		for (std::thread &worker : m_Workers)
 			worker.join();
+
+		// run whatever is left, tasks might own resources.
+		for (auto &slot : m_Slots)
+			while (Task* task = slot->queue.Steal())
+				Execute(task);
+
+		for (auto task : m_Injected)
+			Execute(task);
+		m_Injected.clear();
+
+		// nobody is going to report these anymore.
+		TaskEvent* event = m_TaskEvents.exchange(nullptr);
+		while (event != nullptr)
+		{
+			TaskEvent* next = event->next;
+			delete event;
+			event = next;
+		}
+
+		for (auto &slot : m_Slots)
+		{
+			Task* task = slot->remoteFreeList.exchange(nullptr);
+			while (task != nullptr)
+			{
+				Task* next = task->next;
+				delete task;
+				task = next;
+			}
+
+			task = slot->freeList;
+			while (task != nullptr)
+			{
+				Task* next = task->next;
+				delete task;
+				task = next;
+			}
+			slot->freeList = nullptr;
+		}
 	}
 
-	size_t ThreadUtil::Enqueue(std::function<void(int&)> task, std::function<void()> callback, std::function<void(int)> progressChanged)
+	size_t ThreadUtil::Enqueue(std::function<void(Progress&)> task, std::function<void()> callback, std::function<void(int)> progressChanged)
 	{
-		std::unique_lock<std::mutex> lock(m_QueueMutex);
-
 		// don't allow enqueueing after stopping the pool
 		if (m_Stop)
 			throw std::runtime_error("Enqueue on stopped ThreadPool");
 
-		size_t key = m_TaskKey++;
-		auto state = std::make_shared<TaskState>(key, nullptr);
+		auto state = std::make_shared<TaskState>(this, m_TaskKey.fetch_add(1, std::memory_order_relaxed));
 		state->callback = callback;
 		state->progressChanged = progressChanged;
 
-		m_Tasks.emplace([task, state]()
+		Spawn([this, task, state]()
 		{
 			task(state->progress);
-			state->finished = true;
+			PushTaskEvent(state, true);
 		});
 
-		m_TaskStates.emplace(key, state);
-		m_Condiction.notify_one();
-		return key;
+		return state->id;
 	}
 
-	void ThreadUtil::Update()
+	ThreadUtil::Progress &ThreadUtil::Progress::operator = (int value)
+	{
+		m_Value.store(value, std::memory_order_seq_cst);
+
+		// one queued event per state is enough, Update reads the latest value.
+		if (m_State->progressChanged && !m_State->progressQueued.exchange(true, std::memory_order_seq_cst))
+			m_Owner->PushTaskEvent(m_State->shared_from_this(), false);
+
+		return *this;
+	}
+
+	void ThreadUtil::SpawnOnMainThread(std::function<void()> func)
 	{
-		std::unique_lock<std::mutex> lock(m_QueueMutex);
+		std::lock_guard<std::mutex> lock(m_MainTaskMutex);
+		m_MainTasks.push_back(std::move(func));
+	}
 
-		std::list<size_t> finishedTasks;
-		for (auto &pair : m_TaskStates)
+	void ThreadUtil::Wait(Counter &counter)
+	{
+		int slotIndex = t_SlotIndex;
+		while (counter.load(std::memory_order_acquire) > 0)
 		{
-			auto id = pair.first;
-			auto &state = pair.second;
+			if (Task* task = FindTask(slotIndex))
+				Execute(task);
+			else
+				std::this_thread::yield();
+		}
+	}
 
-			if (state->progressChanged)
-			{
-				auto it = m_TaskProgresses.find(id);
-				if (it == m_TaskProgresses.end())
-				{
-					m_TaskProgresses.emplace(id, state->progress);
-					state->progressChanged(state->progress);
-				}
-				else if (it->second != state->progress)
-				{
-					m_TaskProgresses[id] = state->progress;
-					state->progressChanged(state->progress);
-				}
-			}
+	bool ThreadUtil::RunPendingTask()
+	{
+		if (Task* task = FindTask(t_SlotIndex))
+		{
+			Execute(task);
+			return true;
+		}
 
-			if (state->finished)
-				finishedTasks.emplace_back(id);
+		return false;
+	}
+
+	size_t ThreadUtil::RunMainThreadTasks()
+	{
+		ASSERT_MSG(IsMainThread(), "RunMainThreadTasks called outside main thread!");
+
+		std::vector<std::function<void()>> tasks;
+		{
+			std::lock_guard<std::mutex> lock(m_MainTaskMutex);
+			tasks.swap(m_MainTasks);
 		}
 
-		for (auto &id : finishedTasks)
+		// tasks might spawn more main thread tasks, those run next time.
+		for (auto &task : tasks)
+			task();
+
+		return tasks.size();
+	}
+
+	void ThreadUtil::Update()
+	{
+		RunMainThreadTasks();
+
+		// take everything at once, events pushed by callbacks below are handled next frame.
+		TaskEvent* event = m_TaskEvents.exchange(nullptr, std::memory_order_acquire);
+
+		// the stack is lifo, reverse it so events come in push order.
+		TaskEvent* ordered = nullptr;
+		while (event != nullptr)
 		{
-			auto state = m_TaskStates[id];
-			m_TaskStates.erase(id);
-			m_TaskProgresses.erase(id);
-			if (state->callback)
-				state->callback();
+			TaskEvent* next = event->next;
+			event->next = ordered;
+			ordered = event;
+			event = next;
+		}
+
+		while (ordered != nullptr)
+		{
+			std::unique_ptr<TaskEvent> current(ordered);
+			ordered = ordered->next;
+
+			auto &state = *current->state;
+			if (!current->finished)
+				state.progressQueued.store(false, std::memory_order_seq_cst);
+
+			ReportProgress(state);
+
+			if (current->finished && state.callback)
+				state.callback();
 		}
 	}
 
@@ -132,10 +216,205 @@ namespace fury
 	void ThreadUtil::SetMainThread()
 	{
 		m_MainThreadId = std::this_thread::get_id();
+		t_SlotIndex = (int)m_Slots.size() - 1;
 	}
 
 	bool ThreadUtil::IsMainThread()
 	{
 		return std::this_thread::get_id() == m_MainThreadId;
 	}
-}
\ No newline at end of file
+
+	void ThreadUtil::WorkerLoop(int slotIndex)
+	{
+		t_SlotIndex = slotIndex;
+
+		while (true)
+		{
+			Task* task = FindTask(slotIndex);
+
+			// spin a bit before going to sleep, spawns usually come in bursts.
+			for (int i = 0; task == nullptr && i < 64 && m_PendingTasks.load() > 0; i++)
+			{
+				std::this_thread::yield();
+				task = FindTask(slotIndex);
+			}
+
+			if (task != nullptr)
+			{
+				Execute(task);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(m_QueueMutex);
+			m_Sleepers++;
+			m_Condiction.wait(lock, [this]
+			{
+				return m_Stop || m_PendingTasks.load() > 0;
+			});
+			m_Sleepers--;
+
+			if (m_Stop && m_PendingTasks.load() <= 0)
+				return;
+		}
+	}
+
+	void ThreadUtil::PushTaskEvent(const std::shared_ptr<TaskState> &state, bool finished)
+	{
+		TaskEvent* event = new TaskEvent();
+		event->state = state;
+		event->finished = finished;
+
+		TaskEvent* head = m_TaskEvents.load(std::memory_order_relaxed);
+		do
+		{
+			event->next = head;
+		} while (!m_TaskEvents.compare_exchange_weak(head, event, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	void ThreadUtil::ReportProgress(TaskState &state)
+	{
+		if (!state.progressChanged)
+			return;
+
+		int progress = state.progress.m_Value.load(std::memory_order_seq_cst);
+		if (progress != state.reportedProgress)
+		{
+			state.reportedProgress = progress;
+			state.progressChanged(progress);
+		}
+	}
+
+	ThreadUtil::Task* ThreadUtil::AllocTask()
+	{
+		int slotIndex = t_SlotIndex;
+		if (slotIndex < 0)
+			return new Task();
+
+		auto &slot = m_Slots[slotIndex];
+		if (slot->freeList == nullptr)
+			slot->freeList = slot->remoteFreeList.exchange(nullptr, std::memory_order_acquire);
+
+		Task* task = slot->freeList;
+		if (task != nullptr)
+		{
+			slot->freeList = task->next;
+			task->next = nullptr;
+		}
+		else
+		{
+			task = new Task();
+			task->owner = slotIndex;
+		}
+
+		return task;
+	}
+
+	void ThreadUtil::FreeTask(Task* task)
+	{
+		int owner = task->owner;
+		if (owner < 0)
+		{
+			delete task;
+			return;
+		}
+
+		auto &slot = m_Slots[owner];
+		if (owner == t_SlotIndex)
+		{
+			task->next = slot->freeList;
+			slot->freeList = task;
+		}
+		else
+		{
+			// the owner only ever takes the whole list, so a plain cas push is aba safe.
+			Task* head = slot->remoteFreeList.load(std::memory_order_relaxed);
+			do
+			{
+				task->next = head;
+			} while (!slot->remoteFreeList.compare_exchange_weak(head, task, std::memory_order_release, std::memory_order_relaxed));
+		}
+	}
+
+	void ThreadUtil::Submit(Task* task)
+	{
+		// nothing would run it.
+		if (m_Workers.empty())
+		{
+			Execute(task);
+			return;
+		}
+
+		m_PendingTasks.fetch_add(1);
+
+		int slotIndex = t_SlotIndex;
+		if (slotIndex >= 0)
+		{
+			m_Slots[slotIndex]->queue.Push(task);
+		}
+		else
+		{
+			std::lock_guard<std::mutex> lock(m_QueueMutex);
+			m_Injected.push_back(task);
+			m_InjectedCount++;
+		}
+
+		if (m_Sleepers.load() > 0)
+		{
+			std::lock_guard<std::mutex> lock(m_QueueMutex);
+			m_Condiction.notify_one();
+		}
+	}
+
+	ThreadUtil::Task* ThreadUtil::FindTask(int slotIndex)
+	{
+		Task* task = nullptr;
+
+		if (slotIndex >= 0)
+			task = m_Slots[slotIndex]->queue.Pop();
+
+		if (task == nullptr && m_InjectedCount.load(std::memory_order_relaxed) > 0)
+		{
+			std::lock_guard<std::mutex> lock(m_QueueMutex);
+			if (!m_Injected.empty())
+			{
+				task = m_Injected.front();
+				m_Injected.pop_front();
+				m_InjectedCount--;
+			}
+		}
+
+		if (task == nullptr)
+		{
+			unsigned int numSlots = m_Slots.size();
+			unsigned int start = NextRandom() % numSlots;
+			for (unsigned int i = 0; i < numSlots && task == nullptr; i++)
+			{
+				unsigned int victim = (start + i) % numSlots;
+				if ((int)victim != slotIndex)
+					task = m_Slots[victim]->queue.Steal();
+			}
+		}
+
+		if (task != nullptr)
+			m_PendingTasks.fetch_sub(1);
+
+		return task;
+	}
+
+	void ThreadUtil::Execute(Task* task)
+	{
+		Counter* counter = task->counter;
+		task->Run();
+		FreeTask(task);
+
+		if (counter != nullptr)
+			counter->fetch_sub(1, std::memory_order_release);
+	}
+
+	unsigned int ThreadUtil::GetGrainSize(unsigned int count) const
+	{
+		// roughly 4 tasks per thread, leaves room for stealing to balance uneven work.
+		unsigned int numTasks = (unsigned int)m_Slots.size() * 4;
+		return std::max(1u, count / numTasks);
+	}
+}
@@ -1,38 +1,84 @@
 #ifndef _FURY_THREAD_UTIL_H_
 #define _FURY_THREAD_UTIL_H_
 
-// Implimentation refers to: https://github.com/progschj/ThreadPool
-
 #include <vector>
-#include <queue>
+#include <deque>
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <atomic>
 #include <condition_variable>
 #include <functional>
-#include <unordered_map>
+#include <type_traits>
+#include <algorithm>
+#include <climits>
 
 #include "Fury/Singleton.h"
+#include "Fury/WorkStealingQueue.h"
 
 namespace fury
 {
+	// work stealing scheduler, each worker (and the main thread) owns a chase-lev deque.
 	class FURY_API ThreadUtil : public Singleton<ThreadUtil, size_t>
 	{
 	public:
 
 		typedef std::shared_ptr<ThreadUtil> Ptr;
 
+		// counts unfinished tasks spawned against it, see Spawn & Wait.
+		typedef std::atomic<int> Counter;
+
+	protected:
+
+		class TaskState;
+
+	public:
+
+		// progress of an Enqueue task, assigning it from the worker notifies the next Update.
+		class FURY_API Progress
+		{
+			friend class ThreadUtil;
+
+		protected:
+
+			std::atomic<int> m_Value;
+
+			ThreadUtil* m_Owner;
+
+			TaskState* m_State;
+
+			Progress(ThreadUtil* owner, TaskState* state)
+				: m_Value(0), m_Owner(owner), m_State(state) {}
+
+		public:
+
+			Progress(const Progress&) = delete;
+
+			Progress &operator = (const Progress&) = delete;
+
+			Progress &operator = (int value);
+
+			operator int() const
+			{
+				return m_Value.load(std::memory_order_relaxed);
+			}
+		};
+
 	protected:
 
-		class TaskState
+		class TaskState : public std::enable_shared_from_this<TaskState>
 		{
 		public:
 
 			size_t id = 0;
 
-			int progress = 0;
+			Progress progress;
 
-			bool finished = false;
+			// set while a progress event is in the completion queue, so fast writers don't flood it.
+			std::atomic<bool> progressQueued;
+
+			// last value handed to progressChanged, main thread only.
+			int reportedProgress = INT_MIN;
 
 			std::shared_ptr<void> data;
 
@@ -40,27 +86,120 @@ namespace fury
 
 			std::function<void(int)> progressChanged;
 
-			TaskState(size_t id, std::shared_ptr<void> data)
-				: id(id), data(data) {}
+			TaskState(ThreadUtil* owner, size_t id)
+				: id(id), progress(owner, this), progressQueued(false) {}
+		};
+
+		// pushed by workers, drained by Update.
+		class TaskEvent
+		{
+		public:
+
+			std::shared_ptr<TaskState> state;
+
+			bool finished = false;
+
+			TaskEvent* next = nullptr;
+		};
+
+		// type erased callable, small captures are stored inline so spawning doesn't touch the heap.
+		class Task
+		{
+		public:
+
+			static const size_t StorageSize = 64;
+
+			typename std::aligned_storage<StorageSize>::type storage;
+
+			void(*invoke)(void*) = nullptr;
+
+			void(*destroy)(void*) = nullptr;
+
+			Counter* counter = nullptr;
+
+			Task* next = nullptr;
+
+			int owner = -1;
+
+			template<class Func>
+			void Bind(Func &&func)
+			{
+				typedef typename std::decay<Func>::type FuncType;
+				Bind<FuncType>(std::forward<Func>(func), std::integral_constant<bool,
+					sizeof(FuncType) <= StorageSize && std::alignment_of<FuncType>::value <= std::alignment_of<decltype(storage)>::value>());
+			}
+
+			void Run()
+			{
+				invoke(&storage);
+				destroy(&storage);
+			}
+
+		protected:
+
+			template<class FuncType, class Func>
+			void Bind(Func &&func, std::true_type)
+			{
+				new (&storage) FuncType(std::forward<Func>(func));
+				invoke = [](void* ptr) { (*static_cast<FuncType*>(ptr))(); };
+				destroy = [](void* ptr) { static_cast<FuncType*>(ptr)->~FuncType(); };
+			}
+
+			template<class FuncType, class Func>
+			void Bind(Func &&func, std::false_type)
+			{
+				new (&storage) FuncType*(new FuncType(std::forward<Func>(func)));
+				invoke = [](void* ptr) { (**static_cast<FuncType**>(ptr))(); };
+				destroy = [](void* ptr) { delete *static_cast<FuncType**>(ptr); };
+			}
+		};
+
+		class WorkerSlot
+		{
+		public:
+
+			WorkStealingQueue<Task*> queue;
+
+			// owner only.
+			Task* freeList = nullptr;
+
+			// tasks freed by other threads, owner takes them all at once.
+			std::atomic<Task*> remoteFreeList;
+
+			WorkerSlot() : remoteFreeList(nullptr) {}
 		};
 
 		static std::thread::id m_MainThreadId;
 
-		static size_t m_TaskKey;
+		static std::atomic<size_t> m_TaskKey;
+
+		// lock free mpsc stack of progress and completion events, Update takes all of them at once.
+		std::atomic<TaskEvent*> m_TaskEvents;
+
+		// tasks that must run on the main thread, e.g. gl calls.
+		std::vector<std::function<void()>> m_MainTasks;
+
+		// workers first, the last one belongs to the main thread.
+		std::vector<std::unique_ptr<WorkerSlot>> m_Slots;
+
+		// tasks from threads that own no slot.
+		std::deque<Task*> m_Injected;
 
-		std::unordered_map<size_t, std::shared_ptr<TaskState>> m_TaskStates;
+		std::atomic<int> m_InjectedCount;
 
-		std::unordered_map<size_t, int> m_TaskProgresses;
+		std::atomic<int> m_PendingTasks;
 
-		std::queue<std::function<void()>> m_Tasks;
+		std::atomic<int> m_Sleepers;
 
 		std::vector<std::thread> m_Workers;
 
 		std::mutex m_QueueMutex;
 
+		std::mutex m_MainTaskMutex;
+
 		std::condition_variable m_Condiction;
 
-		bool m_Stop;
+		std::atomic<bool> m_Stop;
 
 	public:
 
@@ -68,35 +207,124 @@ namespace fury
 
 		~ThreadUtil();
 		
-		size_t Enqueue(std::function<void(int&)> task, std::function<void()> callback, std::function<void(int)> progressChanged = nullptr);
+		// callback and progressChanged run on the main thread during Update.
+		size_t Enqueue(std::function<void(Progress&)> task, std::function<void()> callback, std::function<void(int)> progressChanged = nullptr);
 
 		template<class ReturnType>
-		size_t Enqueue(std::function<std::shared_ptr<ReturnType>(int&)> task, std::function<void(std::shared_ptr<ReturnType>)> callback, 
+		size_t Enqueue(std::function<std::shared_ptr<ReturnType>(Progress&)> task, std::function<void(std::shared_ptr<ReturnType>)> callback, 
 			std::function<void(int)> progressChanged = nullptr)
 		{
-			std::unique_lock<std::mutex> lock(m_QueueMutex);
-
 			// don't allow enqueueing after stopping the pool
 			if (m_Stop)
 				throw std::runtime_error("Enqueue on stopped ThreadPool");
 
-			size_t key = m_TaskKey++;
-			auto state = std::make_shared<TaskState>(key, nullptr);
-			state->callback = [callback, state]
+			auto state = std::make_shared<TaskState>(this, m_TaskKey.fetch_add(1, std::memory_order_relaxed));
+			auto rawState = state.get();
+			// raw pointer, capturing the shared_ptr would make the state own itself.
+			state->callback = [callback, rawState]
 			{
-				callback(std::static_pointer_cast<ReturnType>(state->data));
+				callback(std::static_pointer_cast<ReturnType>(rawState->data));
 			};
 			state->progressChanged = progressChanged;
 
-			m_Tasks.emplace([task, state]()
+			Spawn([this, task, state]()
 			{
 				state->data = task(state->progress);
-				state->finished = true;
+				PushTaskEvent(state, true);
 			});
 
-			m_TaskStates.emplace(key, state);
-			m_Condiction.notify_one();
-			return key;
+			return state->id;
+		}
+
+		// runs func on any worker, counter is decreased when it's done.
+		template<class Func>
+		void Spawn(Func &&func, Counter* counter = nullptr)
+		{
+			Task* task = AllocTask();
+			task->Bind(std::forward<Func>(func));
+			task->counter = counter;
+			if (counter != nullptr)
+				counter->fetch_add(1, std::memory_order_relaxed);
+			Submit(task);
+		}
+
+		// func runs on the main thread, during Update or RunMainThreadTasks.
+		void SpawnOnMainThread(std::function<void()> func);
+
+		// executes pending tasks on the calling thread until counter reaches 0.
+		void Wait(Counter &counter);
+
+		// executes one pending task on the calling thread, returns false if there was none.
+		bool RunPendingTask();
+
+		// main thread only, returns the number of tasks executed.
+		size_t RunMainThreadTasks();
+
+		// calls func(index) for each index in [begin, end), grainSize indices per task.
+		// grainSize 0 picks one from the worker count.
+		template<class Func>
+		void ParallelFor(unsigned int begin, unsigned int end, unsigned int grainSize, Func &&func)
+		{
+			if (end <= begin)
+				return;
+
+			unsigned int count = end - begin;
+			if (grainSize == 0)
+				grainSize = GetGrainSize(count);
+
+			if (count <= grainSize || m_Workers.empty())
+			{
+				for (unsigned int i = begin; i < end; i++)
+					func(i);
+				return;
+			}
+
+			Counter counter(0);
+			for (unsigned int chunk = begin + grainSize; chunk < end && chunk >= begin + grainSize; chunk += grainSize)
+			{
+				unsigned int chunkEnd = end - chunk > grainSize ? chunk + grainSize : end;
+				Spawn([&func, chunk, chunkEnd]
+				{
+					for (unsigned int i = chunk; i < chunkEnd; i++)
+						func(i);
+				}, &counter);
+			}
+
+			// the calling thread takes the first range.
+			for (unsigned int i = begin; i < begin + grainSize; i++)
+				func(i);
+
+			Wait(counter);
+		}
+
+		// map(rangeBegin, rangeEnd) returns a partial value for each range,
+		// partials are combined with reduce in range order, so the result is deterministic.
+		template<class ValueType, class MapFunc, class ReduceFunc>
+		ValueType ParallelReduce(unsigned int begin, unsigned int end, unsigned int grainSize, ValueType identity, 
+			MapFunc &&map, ReduceFunc &&reduce)
+		{
+			if (end <= begin)
+				return identity;
+
+			unsigned int count = end - begin;
+			if (grainSize == 0)
+				grainSize = GetGrainSize(count);
+
+			unsigned int numChunks = count / grainSize + (count % grainSize != 0 ? 1 : 0);
+			std::vector<ValueType> partials(numChunks, identity);
+
+			ParallelFor(0, numChunks, 1, [&](unsigned int chunk)
+			{
+				unsigned int chunkBegin = begin + chunk * grainSize;
+				unsigned int chunkEnd = end - chunkBegin > grainSize ? chunkBegin + grainSize : end;
+				partials[chunk] = map(chunkBegin, chunkEnd);
+			});
+
+			ValueType result = identity;
+			for (auto &partial : partials)
+				result = reduce(result, partial);
+
+			return result;
 		}
 
 		void Update();
@@ -105,7 +333,27 @@ namespace fury
 
 		void SetMainThread();
 
-		bool IsMainThread();
+		static bool IsMainThread();
+
+	protected:
+
+		void WorkerLoop(int slotIndex);
+
+		void PushTaskEvent(const std::shared_ptr<TaskState> &state, bool finished);
+
+		void ReportProgress(TaskState &state);
+
+		Task* AllocTask();
+
+		void FreeTask(Task* task);
+
+		void Submit(Task* task);
+
+		Task* FindTask(int slotIndex);
+
+		void Execute(Task* task);
+
+		unsigned int GetGrainSize(unsigned int count) const;
 	};
 }
 
@@ -1,9 +1,93 @@
+#include <cmath>
+#include <cstdlib>
+
 #include "Fury/Log.h"
 #include "Fury/Transform.h"
 #include "Fury/SceneNode.h"
+#include "Fury/ThreadUtil.h"
+
+#ifdef FURY_SSE
+#include <xmmintrin.h>
+#endif
 
 namespace fury
 {
+	std::mutex Transform::m_StoreMutex;
+
+	Transform::Store Transform::m_Store;
+
+	const unsigned int Transform::Store::PageSize;
+
+	const unsigned int Transform::Store::MaxPages;
+
+	Transform::Store::~Store()
+	{
+		for (auto page : pages)
+			delete page;
+	}
+
+	unsigned int Transform::Store::Allocate()
+	{
+		if (!freeSlots.empty())
+		{
+			unsigned int slot = freeSlots.back();
+			freeSlots.pop_back();
+			return slot;
+		}
+
+		if (count % PageSize == 0)
+		{
+			unsigned int page = count / PageSize;
+			if (page >= MaxPages)
+			{
+				FURYE << "Transform store is full, " << count << " transforms!";
+				std::abort();
+			}
+
+			pages[page] = new Page();
+			for (unsigned int slot = count; slot < count + PageSize; slot++)
+				Reset(slot);
+		}
+
+		return count++;
+	}
+
+	void Transform::Store::Free(unsigned int slot)
+	{
+		Reset(slot);
+		freeSlots.push_back(slot);
+	}
+
+	void Transform::Store::Reset(unsigned int slot)
+	{
+		Page &page = GetPage(slot);
+		unsigned int index = slot % PageSize;
+
+		// identity, so padding and free lanes blend to finite values.
+		for (int i = 0; i < 3; i++)
+		{
+			page.prePosition[i][index] = page.postPosition[i][index] = page.position[i][index] = 0.0f;
+			page.preScale[i][index] = page.postScale[i][index] = page.scale[i][index] = 1.0f;
+		}
+
+		for (int i = 0; i < 4; i++)
+			page.preRotation[i][index] = page.postRotation[i][index] = page.rotation[i][index] = i == 3 ? 1.0f : 0.0f;
+
+		for (int i = 0; i < 12; i++)
+			page.matrix[i][index] = i == 0 || i == 4 || i == 8 ? 1.0f : 0.0f;
+
+		page.dt[index] = 0.0f;
+		page.dirty[index] = 1;
+		page.stationary[index] = 0;
+		page.pending[index] = 0;
+		page.nodes[index] = nullptr;
+	}
+
+	Transform::Store::Page &Transform::Store::GetPage(unsigned int slot) const
+	{
+		return *pages[slot / PageSize];
+	}
+
 	Transform::Ptr Transform::Create()
 	{
 		return std::make_shared<Transform>();
@@ -14,203 +98,536 @@ namespace fury
 		return std::make_shared<Transform>(position, rotation, scale);
 	}
 
+	void Transform::SyncAll()
+	{
+		std::lock_guard<std::mutex> lock(m_StoreMutex);
+
+		for (unsigned int slot = 0; slot < m_Store.count; slot++)
+		{
+			Store::Page &page = m_Store.GetPage(slot);
+			unsigned int index = slot % Store::PageSize;
+			if (page.nodes[index] == nullptr)
+				continue;
+
+			for (int i = 0; i < 3; i++)
+			{
+				page.prePosition[i][index] = page.postPosition[i][index];
+				page.preScale[i][index] = page.postScale[i][index];
+			}
+
+			for (int i = 0; i < 4; i++)
+				page.preRotation[i][index] = page.postRotation[i][index];
+
+			page.dirty[index] = 1;
+		}
+	}
+
+	void Transform::InterpolateAll(float dt)
+	{
+		std::unique_lock<std::mutex> lock(m_StoreMutex);
+
+		unsigned int count = m_Store.count;
+		unsigned int blockCount = (count + 3) / 4;
+
+		auto blendBlock = [dt](unsigned int block)
+		{
+			unsigned int slot = block * 4;
+			Store::Page &page = m_Store.GetPage(slot);
+			unsigned int index = slot % Store::PageSize;
+			bool blend = false;
+
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				page.pending[index + i] = page.nodes[index + i] != nullptr && NeedsBlend(slot + i, dt);
+				blend = blend || page.pending[index + i];
+			}
+
+			if (blend)
+				Blend(slot, 4, dt);
+		};
+
+		// a block is a few dozen sse ops, only worth a task in large groups.
+		auto &threadUtil = ThreadUtil::Instance();
+		if (threadUtil != nullptr && blockCount >= 1024)
+		{
+			threadUtil->ParallelFor(0, blockCount, 256, blendBlock);
+		}
+		else
+		{
+			for (unsigned int block = 0; block < blockCount; block++)
+				blendBlock(block);
+		}
+
+		// recomposing touches the octree and fires signals, so nodes are written in order.
+		// unlocked, listeners may create or destroy transforms.
+		lock.unlock();
+
+		for (unsigned int slot = 0; slot < count; slot++)
+		{
+			char &pending = m_Store.GetPage(slot).pending[slot % Store::PageSize];
+			if (pending)
+			{
+				pending = 0;
+				WriteNode(slot);
+			}
+		}
+	}
+
+	void Transform::Blend(unsigned int slot, unsigned int count, float dt)
+	{
+		Store::Page &page = m_Store.GetPage(slot);
+		unsigned int index = slot % Store::PageSize;
+
+#ifdef FURY_SSE
+		if (count == 4)
+		{
+			__m128 t = _mm_set1_ps(dt);
+			__m128 one = _mm_set1_ps(1.0f);
+			__m128 signMask = _mm_set1_ps(-0.0f);
+			__m128 same = _mm_cmpeq_ps(one, one);
+
+			__m128 position[3], scale[3], rotation[4];
+
+			for (int i = 0; i < 3; i++)
+			{
+				__m128 pre = _mm_loadu_ps(&page.prePosition[i][index]);
+				__m128 post = _mm_loadu_ps(&page.postPosition[i][index]);
+				same = _mm_and_ps(same, _mm_cmpeq_ps(pre, post));
+				position[i] = _mm_add_ps(pre, _mm_mul_ps(_mm_sub_ps(post, pre), t));
+				_mm_storeu_ps(&page.position[i][index], position[i]);
+
+				pre = _mm_loadu_ps(&page.preScale[i][index]);
+				post = _mm_loadu_ps(&page.postScale[i][index]);
+				same = _mm_and_ps(same, _mm_cmpeq_ps(pre, post));
+				scale[i] = _mm_add_ps(pre, _mm_mul_ps(_mm_sub_ps(post, pre), t));
+				_mm_storeu_ps(&page.scale[i][index], scale[i]);
+			}
+
+			__m128 a[4], b[4];
+			__m128 cosAngle = _mm_setzero_ps();
+			for (int i = 0; i < 4; i++)
+			{
+				a[i] = _mm_loadu_ps(&page.preRotation[i][index]);
+				b[i] = _mm_loadu_ps(&page.postRotation[i][index]);
+				same = _mm_and_ps(same, _mm_cmpeq_ps(a[i], b[i]));
+				cosAngle = _mm_add_ps(cosAngle, _mm_mul_ps(a[i], b[i]));
+			}
+
+			// nlerp with t bent towards slerp's, fitted over |cos| by zeux.
+			__m128 d = _mm_andnot_ps(signMask, cosAngle);
+			__m128 fa = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-3.2452f),
+				_mm_mul_ps(d, _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)))))));
+			__m128 fb = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, _mm_add_ps(_mm_set1_ps(-1.06021f),
+				_mm_mul_ps(d, _mm_set1_ps(0.215638f)))));
+			__m128 h = _mm_sub_ps(t, _mm_set1_ps(0.5f));
+			__m128 k = _mm_add_ps(_mm_mul_ps(fa, _mm_mul_ps(h, h)), fb);
+			__m128 ot = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(t, h), _mm_mul_ps(_mm_sub_ps(t, one), k)));
+
+			// shortest arc, b is flipped when the quaternions are more than 180 degrees apart.
+			__m128 lt = _mm_sub_ps(one, ot);
+			__m128 rt = _mm_xor_ps(ot, _mm_and_ps(cosAngle, signMask));
+
+			__m128 lengthSq = _mm_setzero_ps();
+			for (int i = 0; i < 4; i++)
+			{
+				rotation[i] = _mm_add_ps(_mm_mul_ps(a[i], lt), _mm_mul_ps(b[i], rt));
+				lengthSq = _mm_add_ps(lengthSq, _mm_mul_ps(rotation[i], rotation[i]));
+			}
+
+			__m128 invLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSq));
+			for (int i = 0; i < 4; i++)
+			{
+				rotation[i] = _mm_mul_ps(rotation[i], invLength);
+				_mm_storeu_ps(&page.rotation[i][index], rotation[i]);
+			}
+
+			// translation * rotation * scale, same as Matrix4::Rotate with columns scaled.
+			__m128 x2 = _mm_add_ps(rotation[0], rotation[0]);
+			__m128 y2 = _mm_add_ps(rotation[1], rotation[1]);
+			__m128 z2 = _mm_add_ps(rotation[2], rotation[2]);
+			__m128 xx = _mm_mul_ps(rotation[0], x2);
+			__m128 yy = _mm_mul_ps(rotation[1], y2);
+			__m128 zz = _mm_mul_ps(rotation[2], z2);
+			__m128 xy = _mm_mul_ps(rotation[0], y2);
+			__m128 xz = _mm_mul_ps(rotation[0], z2);
+			__m128 yz = _mm_mul_ps(rotation[1], z2);
+			__m128 wx = _mm_mul_ps(rotation[3], x2);
+			__m128 wy = _mm_mul_ps(rotation[3], y2);
+			__m128 wz = _mm_mul_ps(rotation[3], z2);
+
+			_mm_storeu_ps(&page.matrix[0][index], _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, yy), zz), scale[0]));
+			_mm_storeu_ps(&page.matrix[1][index], _mm_mul_ps(_mm_add_ps(xy, wz), scale[0]));
+			_mm_storeu_ps(&page.matrix[2][index], _mm_mul_ps(_mm_sub_ps(xz, wy), scale[0]));
+			_mm_storeu_ps(&page.matrix[3][index], _mm_mul_ps(_mm_sub_ps(xy, wz), scale[1]));
+			_mm_storeu_ps(&page.matrix[4][index], _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), zz), scale[1]));
+			_mm_storeu_ps(&page.matrix[5][index], _mm_mul_ps(_mm_add_ps(yz, wx), scale[1]));
+			_mm_storeu_ps(&page.matrix[6][index], _mm_mul_ps(_mm_add_ps(xz, wy), scale[2]));
+			_mm_storeu_ps(&page.matrix[7][index], _mm_mul_ps(_mm_sub_ps(yz, wx), scale[2]));
+			_mm_storeu_ps(&page.matrix[8][index], _mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), yy), scale[2]));
+			_mm_storeu_ps(&page.matrix[9][index], position[0]);
+			_mm_storeu_ps(&page.matrix[10][index], position[1]);
+			_mm_storeu_ps(&page.matrix[11][index], position[2]);
+
+			int sameMask = _mm_movemask_ps(same);
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				page.stationary[index + i] = (sameMask >> i) & 1;
+				page.dirty[index + i] = 0;
+				page.dt[index + i] = dt;
+			}
+
+			return;
+		}
+#endif
+
+		for (unsigned int s = index; s < index + count; s++)
+		{
+			bool same = true;
+			float position[3], scale[3], rotation[4];
+
+			for (int i = 0; i < 3; i++)
+			{
+				float pre = page.prePosition[i][s], post = page.postPosition[i][s];
+				same = same && pre == post;
+				position[i] = page.position[i][s] = pre + (post - pre) * dt;
+
+				pre = page.preScale[i][s];
+				post = page.postScale[i][s];
+				same = same && pre == post;
+				scale[i] = page.scale[i][s] = pre + (post - pre) * dt;
+			}
+
+			float cosAngle = 0.0f;
+			for (int i = 0; i < 4; i++)
+			{
+				same = same && page.preRotation[i][s] == page.postRotation[i][s];
+				cosAngle += page.preRotation[i][s] * page.postRotation[i][s];
+			}
+
+			float d = std::fabs(cosAngle);
+			float fa = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+			float fb = 0.848013f + d * (-1.06021f + d * 0.215638f);
+			float h = dt - 0.5f;
+			float ot = dt + dt * h * (dt - 1.0f) * (fa * h * h + fb);
+			float lt = 1.0f - ot;
+			float rt = cosAngle < 0.0f ? -ot : ot;
+
+			float lengthSq = 0.0f;
+			for (int i = 0; i < 4; i++)
+			{
+				rotation[i] = page.preRotation[i][s] * lt + page.postRotation[i][s] * rt;
+				lengthSq += rotation[i] * rotation[i];
+			}
+
+			float invLength = 1.0f / std::sqrt(lengthSq);
+			for (int i = 0; i < 4; i++)
+				rotation[i] = page.rotation[i][s] = rotation[i] * invLength;
+
+			float x2 = rotation[0] * 2.0f, y2 = rotation[1] * 2.0f, z2 = rotation[2] * 2.0f;
+			float xx = rotation[0] * x2, yy = rotation[1] * y2, zz = rotation[2] * z2;
+			float xy = rotation[0] * y2, xz = rotation[0] * z2, yz = rotation[1] * z2;
+			float wx = rotation[3] * x2, wy = rotation[3] * y2, wz = rotation[3] * z2;
+
+			page.matrix[0][s] = (1.0f - yy - zz) * scale[0];
+			page.matrix[1][s] = (xy + wz) * scale[0];
+			page.matrix[2][s] = (xz - wy) * scale[0];
+			page.matrix[3][s] = (xy - wz) * scale[1];
+			page.matrix[4][s] = (1.0f - xx - zz) * scale[1];
+			page.matrix[5][s] = (yz + wx) * scale[1];
+			page.matrix[6][s] = (xz + wy) * scale[2];
+			page.matrix[7][s] = (yz - wx) * scale[2];
+			page.matrix[8][s] = (1.0f - xx - yy) * scale[2];
+			page.matrix[9][s] = position[0];
+			page.matrix[10][s] = position[1];
+			page.matrix[11][s] = position[2];
+
+			page.stationary[s] = same;
+			page.dirty[s] = 0;
+			page.dt[s] = dt;
+		}
+	}
+
+	bool Transform::NeedsBlend(unsigned int slot, float dt)
+	{
+		const Store::Page &page = m_Store.GetPage(slot);
+		unsigned int index = slot % Store::PageSize;
+		return page.dirty[index] || (!page.stationary[index] && page.dt[index] != dt);
+	}
+
+	void Transform::WriteNode(unsigned int slot)
+	{
+		const Store::Page &page = m_Store.GetPage(slot);
+		unsigned int index = slot % Store::PageSize;
+
+		auto node = page.nodes[index];
+		if (node == nullptr)
+			return;
+
+		Matrix4 matrix;
+		for (int column = 0; column < 4; column++)
+		{
+			for (int row = 0; row < 3; row++)
+				matrix.Raw[column * 4 + row] = page.matrix[column * 3 + row][index];
+		}
+
+		node->SetLocalTransform(GetVector(page.position, index), GetQuaternion(page.rotation, index),
+			GetVector(page.scale, index), matrix);
+	}
+
+	Vector4 Transform::GetVector(const float (&arrays)[3][Store::PageSize], unsigned int index)
+	{
+		return Vector4(arrays[0][index], arrays[1][index], arrays[2][index]);
+	}
+
+	void Transform::SetVector(float (&arrays)[3][Store::PageSize], unsigned int index, Vector4 value)
+	{
+		arrays[0][index] = value.x;
+		arrays[1][index] = value.y;
+		arrays[2][index] = value.z;
+	}
+
+	Quaternion Transform::GetQuaternion(const float (&arrays)[4][Store::PageSize], unsigned int index)
+	{
+		return Quaternion(arrays[0][index], arrays[1][index], arrays[2][index], arrays[3][index]);
+	}
+
+	void Transform::SetQuaternion(float (&arrays)[4][Store::PageSize], unsigned int index, Quaternion value)
+	{
+		arrays[0][index] = value.x;
+		arrays[1][index] = value.y;
+		arrays[2][index] = value.z;
+		arrays[3][index] = value.w;
+	}
+
 	Transform::Transform()
 	{
 		m_TypeIndex = typeid(Transform);
-		m_PreScale = m_Scale = m_PostScale = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
-		SetDeltaTime(0.0f);
+
+		std::lock_guard<std::mutex> lock(m_StoreMutex);
+		m_Slot = m_Store.Allocate();
+		m_Page = &m_Store.GetPage(m_Slot);
+		m_Index = m_Slot % Store::PageSize;
 	}
 
 	Transform::Transform(Vector4 position, Quaternion rotation, Vector4 scale)
 	{
 		m_TypeIndex = typeid(Transform);
-		
-		m_PrePosition = m_PostPosition = position;
-		m_PreRotation = m_PostRotation = rotation;
-		m_PreScale = m_PostScale = scale;
 
-		SetDeltaTime(0.0f);
+		std::lock_guard<std::mutex> lock(m_StoreMutex);
+		m_Slot = m_Store.Allocate();
+		m_Page = &m_Store.GetPage(m_Slot);
+		m_Index = m_Slot % Store::PageSize;
+
+		SetVector(m_Page->prePosition, m_Index, position);
+		SetVector(m_Page->postPosition, m_Index, position);
+		SetQuaternion(m_Page->preRotation, m_Index, rotation);
+		SetQuaternion(m_Page->postRotation, m_Index, rotation);
+		SetVector(m_Page->preScale, m_Index, scale);
+		SetVector(m_Page->postScale, m_Index, scale);
+		Blend(m_Slot, 1, 0.0f);
+	}
+
+	Transform::~Transform()
+	{
+		std::lock_guard<std::mutex> lock(m_StoreMutex);
+		m_Store.Free(m_Slot);
 	}
 
 	Component::Ptr Transform::Clone() const
 	{
-		auto ptr = Transform::Create(m_Position, m_Rotation, m_Scale);
-		ptr->SetDeltaTime(m_Dt);
+		auto ptr = Transform::Create(GetPosition(), GetRotation(), GetScale());
+		ptr->SetDeltaTime(GetDeltaTime());
 		return ptr;
 	}
 
 	void Transform::SetDeltaTime(float dt)
 	{
-		// TODO: Żdtδı  0  1 
-		if (!m_Dirty && m_Dt == dt)
+		if (!NeedsBlend(m_Slot, dt))
 			return;
 
-		m_Dirty = false;
-
-		m_Position = m_PrePosition + (m_PostPosition - m_PrePosition) * dt;
-		m_Rotation = m_PreRotation.Slerp(m_PostRotation, dt);
-		m_Scale = m_PreScale + (m_PostScale - m_PreScale) * dt;
-		m_Dt = dt;
-
-		m_Matrix.Identity();
-		m_Matrix.AppendTranslation(m_Position);
-		m_Matrix.AppendRotation(m_Rotation);
-		m_Matrix.AppendScale(m_Scale);
-
-		if (!m_Owner.expired())
-		{
-			auto node = m_Owner.lock();
-			node->SetLocalPosition(m_Position);
-			node->SetLocalRoattion(m_Rotation);
-			node->SetLocalScale(m_Scale);
-			node->Recompose(true);
-		}
+		Blend(m_Slot, 1, dt);
+		WriteNode(m_Slot);
 	}
 
 	float Transform::GetDeltaTime() const
 	{
-		return m_Dt;
+		return m_Page->dt[m_Index];
 	}
 
 	void Transform::SyncTransforms()
 	{
-		m_PrePosition = m_PostPosition;
-		m_PreRotation = m_PostRotation;
-		m_PreScale = m_PostScale;
-		m_Dirty = true;
+		for (int i = 0; i < 3; i++)
+		{
+			m_Page->prePosition[i][m_Index] = m_Page->postPosition[i][m_Index];
+			m_Page->preScale[i][m_Index] = m_Page->postScale[i][m_Index];
+		}
+
+		for (int i = 0; i < 4; i++)
+			m_Page->preRotation[i][m_Index] = m_Page->postRotation[i][m_Index];
+
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	void Transform::SyncTransforms(const std::shared_ptr<SceneNode> &sceneNode)
 	{
-		m_PrePosition = m_PostPosition = sceneNode->GetLocalPosition();
-		m_PreRotation = m_PostRotation = sceneNode->GetLocalRoattion();
-		m_PreScale = m_PostScale = sceneNode->GetLocalScale();
-		m_Dirty = true;
+		SetPosition(sceneNode->GetLocalPosition());
+		SetRotation(sceneNode->GetLocalRoattion());
+		SetScale(sceneNode->GetLocalScale());
 	}
 
 	void Transform::SetPreTransforms(Vector4 position, Quaternion rotation, Vector4 scale)
 	{
-		m_PrePosition = position;
-		m_PreRotation = rotation;
-		m_PreScale = scale;
-		m_Dirty = true;
+		SetPrePosition(position);
+		SetPreRotation(rotation);
+		SetPreScale(scale);
 	}
 
 	void Transform::SetPostTransforms(Vector4 position, Quaternion rotation, Vector4 scale)
 	{
-		m_PostPosition = position;
-		m_PostRotation = rotation;
-		m_PostScale = scale;
-		m_Dirty = true;
+		SetPostPosition(position);
+		SetPostRotation(rotation);
+		SetPostScale(scale);
 	}
 
 	void Transform::SetPrePosition(Vector4 position)
 	{
-		m_PrePosition = position;
-		m_Dirty = true;
+		SetVector(m_Page->prePosition, m_Index, position);
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	Vector4 Transform::GetPrePosition() const
 	{
-		return m_PrePosition;
+		return GetVector(m_Page->prePosition, m_Index);
 	}
 
 	void Transform::SetPostPosition(Vector4 position)
 	{
-		m_PostPosition = position;
-		m_Dirty = true;
+		SetVector(m_Page->postPosition, m_Index, position);
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	Vector4 Transform::GetPostPosition() const
 	{
-		return m_PostPosition;
+		return GetVector(m_Page->postPosition, m_Index);
 	}
 
 	void Transform::SetPosition(Vector4 position)
 	{
-		m_PrePosition = m_PostPosition = position;
-		m_Dirty = true;
+		SetVector(m_Page->prePosition, m_Index, position);
+		SetVector(m_Page->postPosition, m_Index, position);
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	Vector4 Transform::GetPosition() const
 	{
-		return m_Position;
+		return GetVector(m_Page->position, m_Index);
 	}
 
 	void Transform::SetPreRotation(Quaternion rotation)
 	{
-		m_PreRotation = rotation;
-		m_Dirty = true;
+		SetQuaternion(m_Page->preRotation, m_Index, rotation);
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	Quaternion Transform::GetPreRotation() const
 	{
-		return m_PreRotation;
+		return GetQuaternion(m_Page->preRotation, m_Index);
 	}
 
 	void Transform::SetPostRotation(Quaternion rotation)
 	{
-		m_PostRotation = rotation;
-		m_Dirty = true;
+		SetQuaternion(m_Page->postRotation, m_Index, rotation);
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	Quaternion Transform::GetPostRotation() const
 	{
-		return m_PostRotation;
+		return GetQuaternion(m_Page->postRotation, m_Index);
 	}
 
 	void Transform::SetRotation(Quaternion rotation)
 	{
-		m_PreRotation = m_PostRotation = rotation;
-		m_Dirty = true;
+		SetQuaternion(m_Page->preRotation, m_Index, rotation);
+		SetQuaternion(m_Page->postRotation, m_Index, rotation);
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	Quaternion Transform::GetRotation() const
 	{
-		return m_Rotation;
+		return GetQuaternion(m_Page->rotation, m_Index);
 	}
 
 	void Transform::SetPreScale(Vector4 scale)
 	{
-		m_PreScale = scale;
-		m_Dirty = true;
+		SetVector(m_Page->preScale, m_Index, scale);
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	Vector4 Transform::GetPreScale() const
 	{
-		return m_PreScale;
+		return GetVector(m_Page->preScale, m_Index);
 	}
 
 	void Transform::SetPostScale(Vector4 scale)
 	{
-		m_PostScale = scale;
-		m_Dirty = true;
+		SetVector(m_Page->postScale, m_Index, scale);
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	Vector4 Transform::GetPostScale() const
 	{
-		return m_PostScale;
+		return GetVector(m_Page->postScale, m_Index);
 	}
 
 	void Transform::SetScale(Vector4 scale)
 	{
-		m_PreScale = m_PostScale = scale;
-		m_Dirty = true;
+		SetVector(m_Page->preScale, m_Index, scale);
+		SetVector(m_Page->postScale, m_Index, scale);
+		m_Page->dirty[m_Index] = 1;
 	}
 
 	Vector4 Transform::GetScale() const
 	{
-		return m_Scale;
+		return GetVector(m_Page->scale, m_Index);
 	}
 
 	Matrix4 Transform::GetMatrix() const
 	{
-		return m_Matrix;
+		Matrix4 matrix;
+		for (int column = 0; column < 4; column++)
+		{
+			for (int row = 0; row < 3; row++)
+				matrix.Raw[column * 4 + row] = m_Page->matrix[column * 3 + row][m_Index];
+		}
+		return matrix;
 	}
 
 	void Transform::OnAttaching(const std::shared_ptr<SceneNode> &node)
 	{
 		Component::OnAttaching(node);
 		SyncTransforms(node);
+
+		std::lock_guard<std::mutex> lock(m_StoreMutex);
+		m_Page->nodes[m_Index] = node.get();
+	}
+
+	void Transform::OnDetaching(const std::shared_ptr<SceneNode> &node)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_StoreMutex);
+			m_Page->nodes[m_Index] = nullptr;
+			m_Page->pending[m_Index] = 0;
+		}
+		Component::OnDetaching(node);
+	}
+
+	void Transform::OnOwnerDestructing(SceneNode &node)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_StoreMutex);
+			m_Page->nodes[m_Index] = nullptr;
+			m_Page->pending[m_Index] = 0;
+		}
+		Component::OnOwnerDestructing(node);
 	}
-}
\ No newline at end of file
+}
@@ -1,6 +1,9 @@
 #ifndef _FURY_TRANSFORM_H_
 #define _FURY_TRANSFORM_H_
 
+#include <mutex>
+#include <vector>
+
 #include "Fury/Quaternion.h"
 #include "Fury/Matrix4.h"
 #include "Fury/Vector4.h"
@@ -18,19 +21,105 @@ namespace fury
 
 		static Ptr Create(Vector4 position, Quaternion rotation, Vector4 scale);
 
+		// SyncTransforms for every transform, Engine::Run calls it before each fixed step
+		// so whatever a step sets as 'target' is interpolated from where the last step ended.
+		static void SyncAll();
+
+		// SetDeltaTime for every attached transform, call it once per rendered frame. transforms are
+		// blended 4 per sse op, split across ThreadUtil's workers when there are many, then the
+		// nodes that changed get their local trs and matrix and are recomposed in order.
+		static void InterpolateAll(float dt);
+
 	protected:
 
-		Vector4 m_PrePosition, m_Position, m_PostPosition, m_WorldPosition;
+		// state of every transform as structure of arrays, a transform owns one slot from
+		// construction to destruction and freed slots are reused. slots live in fixed size pages
+		// that never move, so creating transforms doesn't disturb threads using other ones.
+		class Store
+		{
+		public:
+
+			// a multiple of 4, sse blocks never straddle pages.
+			static const unsigned int PageSize = 256;
+
+			// 4m transforms.
+			static const unsigned int MaxPages = 16384;
+
+			// one array per component, indexed by slot % PageSize.
+			class Page
+			{
+			public:
+
+				float prePosition[3][PageSize], postPosition[3][PageSize], position[3][PageSize];
+
+				float preRotation[4][PageSize], postRotation[4][PageSize], rotation[4][PageSize];
+
+				float preScale[3][PageSize], postScale[3][PageSize], scale[3][PageSize];
+
+				// top 3 rows of each slot's column major matrix.
+				float matrix[12][PageSize];
+
+				float dt[PageSize];
+
+				char dirty[PageSize];
+
+				// 'initial' and 'target' were equal at the last blend, any dt gives the same result.
+				char stationary[PageSize];
+
+				// blended by InterpolateAll, the node still needs the result.
+				char pending[PageSize];
+
+				// owner while attached, only attached slots are interpolated by InterpolateAll.
+				SceneNode* nodes[PageSize];
+			};
+
+			// a page is allocated before its first slot is handed out and kept until exit.
+			Page* pages[MaxPages] = {};
+
+			std::vector<unsigned int> freeSlots;
 
-		Quaternion m_PreRotation, m_Rotation, m_PostRotation, m_WorldRotation;
+			// slots handed out so far.
+			unsigned int count = 0;
 
-		Vector4 m_PreScale, m_Scale, m_PostScale, m_WorldScale;
+			~Store();
 
-		Matrix4 m_Matrix;
+			unsigned int Allocate();
 
-		float m_Dt = 0.0f;
-		
-		bool m_Dirty = true;
+			void Free(unsigned int slot);
+
+			void Reset(unsigned int slot);
+
+			Page &GetPage(unsigned int slot) const;
+		};
+
+		// guards slot allocation and the batch functions, setters of a single transform don't lock.
+		static std::mutex m_StoreMutex;
+
+		static Store m_Store;
+
+		// blends count slots from slot, count is 4 (sse) or 1. rotations use a corrected nlerp
+		// that stays within 0.1 degrees of slerp instead of per lane acos and sin.
+		static void Blend(unsigned int slot, unsigned int count, float dt);
+
+		static bool NeedsBlend(unsigned int slot, float dt);
+
+		// hands the slot's blended trs and matrix to its node.
+		static void WriteNode(unsigned int slot);
+
+		static Vector4 GetVector(const float (&arrays)[3][Store::PageSize], unsigned int index);
+
+		static void SetVector(float (&arrays)[3][Store::PageSize], unsigned int index, Vector4 value);
+
+		static Quaternion GetQuaternion(const float (&arrays)[4][Store::PageSize], unsigned int index);
+
+		static void SetQuaternion(float (&arrays)[4][Store::PageSize], unsigned int index, Quaternion value);
+
+		unsigned int m_Slot;
+
+		// m_Slot's page and index in it.
+		Store::Page *m_Page;
+
+		unsigned int m_Index;
 
 	public:
 
@@ -38,11 +127,13 @@ namespace fury
 
 		Transform(Vector4 position, Quaternion rotation, Vector4 scale);
 
+		virtual ~Transform();
+
 		Component::Ptr Clone() const override;
 
 		float GetDeltaTime() const;
 
-		// this'll recalculate output matrices.
+		// this'll recalculate output matrices, skipped while nothing changed and there's nothing to interpolate.
 		void SetDeltaTime(float dt);
 
 		// sync pre and post transforms.
@@ -107,6 +198,10 @@ namespace fury
 	protected:
 
 		virtual void OnAttaching(const std::shared_ptr<SceneNode> &node) override;
+
+		virtual void OnDetaching(const std::shared_ptr<SceneNode> &node) override;
+
+		virtual void OnOwnerDestructing(SceneNode &node) override;
 	};
 
 }
@@ -0,0 +1,154 @@
+#ifndef _FURY_WORK_STEALING_QUEUE_H_
+#define _FURY_WORK_STEALING_QUEUE_H_
+
+// Chase-Lev deque, memory orders follow "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al. 2013).
+
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Macros.h"
+
+namespace fury
+{
+	// the owner thread pushes and pops at the bottom, any thread may steal from the top.
+	// ItemType must be a pointer type.
+	template<class ItemType>
+	class WorkStealingQueue
+	{
+	protected:
+
+		class RingBuffer
+		{
+		public:
+
+			int64_t capacity;
+
+			int64_t mask;
+
+			std::unique_ptr<std::atomic<ItemType>[]> items;
+
+			RingBuffer(int64_t capacity) :
+				capacity(capacity), mask(capacity - 1), items(new std::atomic<ItemType>[capacity]) {}
+
+			ItemType Get(int64_t index) const
+			{
+				return items[index & mask].load(std::memory_order_relaxed);
+			}
+
+			void Put(int64_t index, ItemType item)
+			{
+				items[index & mask].store(item, std::memory_order_relaxed);
+			}
+
+			RingBuffer* Grow(int64_t bottom, int64_t top) const
+			{
+				auto buffer = new RingBuffer(capacity * 2);
+				for (int64_t i = top; i != bottom; i++)
+					buffer->Put(i, Get(i));
+				return buffer;
+			}
+		};
+
+		std::atomic<int64_t> m_Top;
+
+		std::atomic<int64_t> m_Bottom;
+
+		std::atomic<RingBuffer*> m_Buffer;
+
+		// thieves might still read retired buffers, keep them until destruction.
+		std::vector<std::unique_ptr<RingBuffer>> m_Retired;
+
+	public:
+
+		// capacity must be a power of 2.
+		WorkStealingQueue(int64_t capacity = 1024) :
+			m_Top(0), m_Bottom(0), m_Buffer(new RingBuffer(capacity)) {}
+
+		~WorkStealingQueue()
+		{
+			delete m_Buffer.load(std::memory_order_relaxed);
+		}
+
+		WorkStealingQueue(const WorkStealingQueue&) = delete;
+
+		WorkStealingQueue &operator = (const WorkStealingQueue&) = delete;
+
+		// owner only.
+		void Push(ItemType item)
+		{
+			int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			RingBuffer* buffer = m_Buffer.load(std::memory_order_relaxed);
+
+			if (bottom - top > buffer->capacity - 1)
+			{
+				m_Retired.emplace_back(buffer);
+				buffer = buffer->Grow(bottom, top);
+				m_Buffer.store(buffer, std::memory_order_release);
+			}
+
+			buffer->Put(bottom, item);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		// owner only, returns nullptr if empty.
+		ItemType Pop()
+		{
+			int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+			RingBuffer* buffer = m_Buffer.load(std::memory_order_relaxed);
+			m_Bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_Top.load(std::memory_order_relaxed);
+
+			ItemType item = nullptr;
+			if (top <= bottom)
+			{
+				item = buffer->Get(bottom);
+				if (top == bottom)
+				{
+					// last item, race against thieves.
+					if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						item = nullptr;
+					m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+			}
+			else
+			{
+				m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+
+			return item;
+		}
+
+		// any thread, returns nullptr if empty or lost the race.
+		ItemType Steal()
+		{
+			int64_t top = m_Top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+
+			if (top < bottom)
+			{
+				RingBuffer* buffer = m_Buffer.load(std::memory_order_acquire);
+				ItemType item = buffer->Get(top);
+				if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return nullptr;
+				return item;
+			}
+
+			return nullptr;
+		}
+
+		bool Empty() const
+		{
+			int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+			int64_t top = m_Top.load(std::memory_order_relaxed);
+			return bottom <= top;
+		}
+	};
+}
+
+#endif // _FURY_WORK_STEALING_QUEUE_H_
@@ -67,7 +67,7 @@ void BasicScene::FixedUpdate()
 
 void BasicScene::Update(float dt)
 {
-	m_CamNode->GetComponent<Transform>()->SetDeltaTime(dt);
+	// Engine::Run interpolates the camera's transform.
 }
 
 void BasicScene::UpdateGUI(float dt)
@@ -78,4 +78,9 @@ void BasicScene::UpdateGUI(float dt)
 void BasicScene::Draw(sf::Window &window)
 {
 
+}
+
+void BasicScene::Capture()
+{
+	m_Pipeline->Capture(m_OcTree, m_CamNode);
 }
\ No newline at end of file
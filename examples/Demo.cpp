@@ -13,10 +13,6 @@ using namespace fury;
 #undef far
 #undef max
 
-#define TICKS_PER_SECOND 25
-#define SKIP_TICKS 1000 / TICKS_PER_SECOND
-#define MAX_FRAMESKIP 5
-
 void Pause()
 {
 	std::cout << "Press ENTER to continue...";
@@ -46,58 +42,32 @@ int main(int argc, char *argv[])
 	FrameWork::Ptr example = std::make_shared<LoadScene>();
 	//FrameWork::Ptr example = std::make_shared<LoadFbxFile>();
 	example->Init(window);
+	example->pipelined = argc > 1 && std::string(argv[1]) == "--pipelined";
 
-	// Game Loop
-	sf::Clock clock;
-	sf::Event event;
-	sf::Int32 next_game_tick = clock.getElapsedTime().asMilliseconds();
-
-	bool show_test_window = true;
+	// Game Loop, 25 fixed updates per second, drawn as fast as possible.
+	Engine::LoopOptions options;
+	options.fixedStep = 1.0f / 25.0f;
+	options.maxFixedSteps = 5;
+	if (example->pipelined)
+		options.pipeline = Pipeline::Active;
 
-	while (window.isOpen() && example->running)
+	Engine::Run(window, [&]
+	{
+		example->FixedUpdate();
+		if (!example->running)
+			Engine::Stop();
+	}, [&](float dt)
 	{
-		RenderUtil::Instance()->BeginFrame();
-
-		// Sync event
-		while (window.pollEvent(event))
-		{
-			if (event.type == sf::Event::Closed)
-			{
-				example->running = false;
-				break;
-			}
-
-			Engine::HandleEvent(event);
-			Gui::HandleEvent(event);
-		}
-
-		// Update game logic TICKS_PER_SECOND times per second.
-		int numLoops = 0;
-		while (clock.getElapsedTime().asMilliseconds() > next_game_tick && numLoops < MAX_FRAMESKIP && example->running)
-		{
-			Engine::FixedUpdate();
-			example->FixedUpdate();
-			next_game_tick += SKIP_TICKS;
-			numLoops++;
-		}
-		// display game object in maximum framerate.
-		sf::Int32 elapsed = clock.getElapsedTime().asMilliseconds();
-		float dt = float(elapsed + SKIP_TICKS - next_game_tick) / float(SKIP_TICKS);
-		next_game_tick -= elapsed;
-
-		Gui::NewFrame(clock.restart().asSeconds());
-
-		Engine::Update(dt);
 		example->Update(dt);
-		example->Draw(window);
 
+		// simulate the next frame on a worker while the last captured one is drawn.
+		if (example->pipelined)
+			example->Capture();
+	}, [&](float dt)
+	{
+		example->Draw(window);
 		example->UpdateGUI(dt);
-		Gui::Render();
-
-		window.display();
-
-		RenderUtil::Instance()->EndFrame();
-	}
+	}, options);
 
 	example = nullptr;
 
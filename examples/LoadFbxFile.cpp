@@ -96,12 +96,15 @@ void LoadFbxFile::Update(float dt)
 {
 	BasicScene::Update(dt);
 	if (m_AnimPlayer)
-		m_AnimPlayer->Display(dt);
+		m_AnimPlayer->Display(Engine::GetInterpolation());
 }
 
 void LoadFbxFile::Draw(sf::Window &window)
 {
-	m_Pipeline->Execute(m_OcTree);
+	if (pipelined)
+		m_Pipeline->ExecuteFrame();
+	else
+		m_Pipeline->Execute(m_OcTree);
 }
 
 #endif // _FURY_FBXPARSER_IMP_ 
\ No newline at end of file
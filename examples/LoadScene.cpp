@@ -67,5 +67,8 @@ void LoadScene::Update(float dt)
 
 void LoadScene::Draw(sf::Window &window)
 {
-	m_Pipeline->Execute(m_OcTree);
+	if (pipelined)
+		m_Pipeline->ExecuteFrame();
+	else
+		m_Pipeline->Execute(m_OcTree);
 }
\ No newline at end of file
@@ -0,0 +1,72 @@
+#version 330
+
+#ifdef VERTEX_SHADER
+
+in vec2 particle_corner;
+// world position, normalized age
+in vec4 particle_data;
+
+out vec2 out_uv;
+out vec4 out_color;
+out vec4 ss_pos;
+out float out_depth;
+
+uniform mat4 projection_matrix;
+uniform mat4 invert_view_matrix;
+
+uniform vec4 particle_start_color;
+uniform vec4 particle_end_color;
+uniform vec2 particle_size;
+
+void main()
+{
+	float t = particle_data.w;
+	float size = mix(particle_size.x, particle_size.y, t);
+
+	// camera facing quad
+	vec4 viewPos = invert_view_matrix * vec4(particle_data.xyz, 1.0);
+	viewPos.xy += particle_corner * size;
+
+	out_uv = particle_corner + 0.5;
+	out_color = mix(particle_start_color, particle_end_color, t);
+	out_depth = -viewPos.z;
+
+	ss_pos = projection_matrix * viewPos;
+	gl_Position = ss_pos;
+}
+
+#endif
+
+#ifdef FRAGMENT_SHADER
+
+in vec2 out_uv;
+in vec4 out_color;
+in vec4 ss_pos;
+in float out_depth;
+
+out vec4 fragment_output;
+
+uniform float camera_far = 10000;
+
+#ifndef COLOR_ONLY
+uniform sampler2D diffuse_texture;
+#endif
+
+// linear depth
+uniform sampler2D gbuffer_depth;
+
+void main()
+{
+	vec2 screenUV = ss_pos.xy / ss_pos.w * 0.5 + 0.5;
+	float scene_depth = texture(gbuffer_depth, screenUV).r * camera_far;
+	if (out_depth > scene_depth)
+		discard;
+
+#ifdef COLOR_ONLY
+	fragment_output = out_color;
+#else
+	fragment_output = texture(diffuse_texture, out_uv) * out_color;
+#endif
+}
+
+#endif
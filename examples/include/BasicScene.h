@@ -42,6 +42,7 @@ public:
 
 	virtual void Draw(sf::Window &window);
 
+	virtual void Capture();
 };
 
 #endif // _BASIC_SCENE_H_
\ No newline at end of file
@@ -20,6 +20,9 @@ public:
 
 	bool running = true;
 
+	// Capture runs on a worker while Draw renders the previous capture, see Engine::UpdatePipelined.
+	bool pipelined = false;
+
 	virtual void Init(sf::Window &window) = 0;
 
 	virtual void FixedUpdate() = 0;
@@ -29,6 +32,8 @@ public:
 	virtual void UpdateGUI(float dt) = 0;
 
 	virtual void Draw(sf::Window &window) = 0;
+
+	virtual void Capture() {}
 };
 
 #endif // _FRAMEWORK_H_
\ No newline at end of file